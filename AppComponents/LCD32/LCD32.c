@@ -6,6 +6,268 @@
 
 #include "LCD32.h"
 
+/// @brief ILI9341 power-up sequence (P16COM_CL_* command list, kept in flash)
+/// @note  MADCTL takes its value from the params: it follows the orientation.
+static const uint8_t LCD32InitList[] = {
+    ILI9341_POWER_CONTROL_A,            5,  0x39, 0x2C, 0x00, 0x34, 0x02,
+    ILI9341_POWER_CONTROL_B,            3,  0x00, 0xC1, 0x30,
+    ILI9341_DRIVER_TIMING_CTRL_A_INT,   3,  0x85, 0x00, 0x78,
+    ILI9341_DRIVER_TIMING_CTRL_B,       2,  0x00, 0x00,
+    ILI9341_POWER_ON_SEQ_CTRL,          4,  0x64, 0x03, 0x12, 0x81,
+    ILI9341_PUMP_RATIO_CONTROL,         1,  0x20,
+    ILI9341_POWER_CONTROL_1,            1,  0x23,
+    ILI9341_POWER_CONTROL_2,            1,  0x10,
+    ILI9341_VCOM_CONTROL_1,             2,  0x3E, 0x28,
+    ILI9341_VCOM_CONTROL_2,             1,  0x86,
+    ILI9341_MEMORY_ACCESS_CONTROL,      1 | P16COM_CL_PARAMS,
+    ILI9341_PIXEL_FORMAT_SET,           1,  0x55,                   // 16-bit
+    ILI9341_FRAME_RATE_NORMAL,          2,  0x00, 0x18,
+    ILI9341_DISPLAY_FUNCTION_CTRL,      3,  0x08, 0x82, 0x27,
+    ILI9341_ENABLE_3G,                  1,  0x00,
+    ILI9341_GAMMA_SET,                  1,  0x01,
+    ILI9341_POSITIVE_GAMMA_CORR,        15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                                            0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+    ILI9341_NEGATIVE_GAMMA_CORR,        15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                                            0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+    ILI9341_SLEEP_OUT,                  0 | P16COM_CL_DELAY, 120,
+    ILI9341_DISPLAY_ON,                 0 | P16COM_CL_DELAY, 50,    // Delay for stability
+    P16COM_CL_END
+};
+
+/// @brief Address window, then MEMORY_WRITE (params: x0, x1, y0, y1 as high/low bytes)
+static const uint8_t LCD32WindowWriteList[] = {
+    ILI9341_COLUMN_ADDRESS_SET,         4 | P16COM_CL_PARAMS,
+    ILI9341_PAGE_ADDRESS_SET,           4 | P16COM_CL_PARAMS,
+    ILI9341_MEMORY_WRITE,               0,
+    P16COM_CL_END
+};
+
+/// @brief Address window, then MEMORY_READ (same params)
+static const uint8_t LCD32WindowReadList[] = {
+    ILI9341_COLUMN_ADDRESS_SET,         4 | P16COM_CL_PARAMS,
+    ILI9341_PAGE_ADDRESS_SET,           4 | P16COM_CL_PARAMS,
+    ILI9341_MEMORY_READ,                0,
+    P16COM_CL_END
+};
+
+/// @brief Vertical scrolling definition, then the start address (params: TFA, VSA, BFA, VSP as high/low bytes)
+static const uint8_t LCD32ScrollDefList[] = {
+    ILI9341_VERTICAL_SCROLL_DEFINITION, 6 | P16COM_CL_PARAMS,
+    ILI9341_VERTICAL_SCROLL_START,      2 | P16COM_CL_PARAMS,
+    P16COM_CL_END
+};
+
+/// @brief Vertical scrolling start address (params: VSP)
+static const uint8_t LCD32ScrollStartList[] = {
+    ILI9341_VERTICAL_SCROLL_START,      2 | P16COM_CL_PARAMS,
+    P16COM_CL_END
+};
+
+/// @brief Params of the window lists
+static inline void LCD32WindowParams(P16Data_t * p, Dim_t x, Dim_t y, Dim_t w, Dim_t h){
+    p[0] = (x >> 8) & 0xFF;             p[1] = x & 0xFF;
+    p[2] = ((x + w - 1) >> 8) & 0xFF;   p[3] = (x + w - 1) & 0xFF;
+    p[4] = (y >> 8) & 0xFF;             p[5] = y & 0xFF;
+    p[6] = ((y + h - 1) >> 8) & 0xFF;   p[7] = (y + h - 1) & 0xFF;
+}
+
+/// @brief Allocate one canvas (physical pixel count, any orientation fits) cleared to black
+static Color_t * LCD32AllocCanvas(void){
+    #if (LCD32_CANVAS_IN_PSRAM_EN == 1)
+        /// Allocate in PSRAM based on physical pixels (320*240 = 150KB)
+        Color_t * canvas = (Color_t *)heap_caps_malloc(sizeof(Color_t) * LCD32_NATIVE_W * LCD32_NATIVE_H, MALLOC_CAP_SPIRAM);
+    #else
+        /// Allocate in DRAM
+        Color_t * canvas = (Color_t *)malloc(sizeof(Color_t) * LCD32_NATIVE_W * LCD32_NATIVE_H);
+    #endif
+
+    if(IsNotNull(canvas)){
+        /// Clear Canvas (Black)
+        for(int32_t i = 0; i < (LCD32_NATIVE_W * LCD32_NATIVE_H); i++){
+            canvas[i] = COLOR_BLACK;
+        }
+    }
+    return canvas;
+}
+
+/// @brief Take the bus for a direct transfer from the drawing task
+/// @details Bus ownership follows the canvases: the flush task only drives the bus while
+///          it holds a frame. Taking the spare canvas back from FreeQ therefore means the
+///          flush task is idle, and it stays idle until LCD32GiveBus() returns the canvas.
+static inline void LCD32TakeBus(LCD32Dev_t * Dev){
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        if(IsNotNull(Dev->FlushTask)){
+            xQueueReceive(Dev->FreeQ, &(Dev->Held), portMAX_DELAY);
+        }
+    #endif
+}
+
+/// @brief Hand the spare canvas (and with it the bus) back to the flush task side
+static inline void LCD32GiveBus(LCD32Dev_t * Dev){
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        if(IsNotNull(Dev->FlushTask)){
+            xQueueSend(Dev->FreeQ, &(Dev->Held), portMAX_DELAY);
+            Dev->Held = NULL;
+        }
+    #endif
+}
+
+/// @brief Send one full frame: address window + burst (caller owns the bus)
+static void LCD32SendFrame(LCD32Dev_t * Dev, const Color_t * Frame){
+    /// 1. Set Address Window to Full Screen
+    LCD32SetAddressWindow(Dev, 0, 0, Dev->Width, Dev->Height);
+    /// 2. Start Data Stream
+    LCD32StartTransaction(Dev);
+    LCD32SetDataTransaction(Dev);
+    /// 3. Burst Write Pixels using P16Com optimized driver
+    P16ComWriteArray(&(Dev->P16Com), (P16Data_t *)Frame, (Dev->Width * Dev->Height));
+    LCD32StopTransaction(Dev);
+}
+
+/// @brief Free every canvas (both frames when double-buffered)
+static void LCD32FreeCanvases(LCD32Dev_t * Dev){
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        if(Dev->Frames[1] != NULL){
+            free(Dev->Frames[1]);
+        }
+        Dev->Canvas    = Dev->Frames[0];
+        Dev->Frames[0] = NULL;
+        Dev->Frames[1] = NULL;
+    #endif
+    if(Dev->Canvas != NULL){
+        free(Dev->Canvas);
+    }
+    Dev->Canvas = NULL;
+}
+
+#if (LCD32_STRIP_RENDER_EN == 1)
+
+/// @brief Primitive calls are recorded into the display list instead of drawn
+#define LCD32IsRecording(dev)       (IsNotNull((dev)->Strip) && !((dev)->Strip->Replaying))
+
+/// @brief Allocate the strip renderer: display list + two band buffers, all in internal RAM
+static LCD32Strip_t * LCD32StripNew(void){
+    LCD32Strip_t * strip = (LCD32Strip_t *)heap_caps_malloc(sizeof(LCD32Strip_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if(IsNull(strip)){
+        return NULL;
+    }
+
+    LCD32StripListClear(&(strip->List), COLOR_BLACK);
+    strip->Cur       = NULL;
+    strip->Y0        = 0;
+    strip->Y1        = 0;
+    strip->Width     = 0;
+    strip->Replaying = 0;
+
+    /// Bands are sent straight from these buffers by the i80 DMA backend
+    REPN(i, 2){
+        strip->Band[i] = (uint16_t *)heap_caps_malloc(sizeof(Color_t) * LCD32_STRIP_WIDTH_MAX * LCD32_STRIP_ROWS, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    }
+    if(IsNull(strip->Band[0]) || IsNull(strip->Band[1])){
+        free(strip->Band[0]);
+        free(strip->Band[1]);
+        free(strip);
+        return NULL;
+    }
+    return strip;
+}
+
+/// @brief Free the strip renderer
+static void LCD32StripDelete(LCD32Strip_t * Strip){
+    if(IsNull(Strip)){
+        return;
+    }
+    free(Strip->Band[0]);
+    free(Strip->Band[1]);
+    free(Strip);
+}
+
+/// @brief Record one primitive (rows [Top, Bottom] touched, off-screen calls are dropped)
+static DefaultRet_t LCD32Record(LCD32Dev_t * Dev, uint8_t Op, Color_t Color, int32_t Top, int32_t Bottom,
+                                const int16_t Arg[5], const void * Data, uint16_t DataLen, const GFXfont * Font){
+    if((Bottom < 0) || (Top >= Dev->Height) || (Top > Bottom)){
+        return STAT_OKE;
+    }
+
+    LCD32StripList_t * list = &(Dev->Strip->List);
+    LCD32StripCmd_t * cmd = LCD32StripListAdd(list, Op, Color, (int16_t) Max(Top, -1), (int16_t) Min(Bottom, Dev->Height), Data, DataLen);
+    if(IsNull(cmd)){
+        if(list->Dropped == 1){
+            LCD32Err("[LCD32Record] Display list full (%d commands, %d data bytes)", list->Count, list->DataUsed);
+        }
+        return STAT_ERR_OVERFLOW;
+    }
+    REPN(i, 5){
+        cmd->Arg[i] = Arg[i];
+    }
+    cmd->Font = Font;
+    return STAT_OKE;
+}
+
+/// @brief Rows [Top, Bottom] covered by LCD32DrawText() (same cursor walk)
+static void LCD32TextRows(LCD32Dev_t *Dev, Dim_t r, Dim_t c, const char *Str, const GFXfont *Font, int32_t *Top, int32_t *Bottom) {
+    Dim_t cursor_r = r, cursor_c = c;
+    *Top = INT16_MAX;
+    *Bottom = INT16_MIN;
+    while (*Str) {
+        char ch = *Str++;
+        if (ch == '\n') {
+            cursor_c = c;
+            cursor_r += Font->yAdvance;
+            continue;
+        }
+        if (ch < Font->first || ch > Font->last) continue;
+
+        GFXglyph *glyph = &Font->glyph[ch - Font->first];
+        if (cursor_c + glyph->xAdvance >= Dev->Width) {
+            cursor_c = c;
+            cursor_r += Font->yAdvance;
+        }
+        if (glyph->height > 0) {
+            *Top = Min(*Top, cursor_r + glyph->yOffset);
+            *Bottom = Max(*Bottom, cursor_r + glyph->yOffset + glyph->height - 1);
+        }
+        cursor_c += glyph->xAdvance;
+    }
+}
+
+/// @brief Draw one recorded primitive into the current band
+static void LCD32StripReplay(LCD32Dev_t * Dev, const LCD32StripCmd_t * Cmd){
+    const LCD32StripList_t * list = &(Dev->Strip->List);
+    const int16_t * a = Cmd->Arg;
+
+    switch(Cmd->Op){
+        case LCD32_STRIP_OP_PIXEL:
+            LCD32SetCanvasPixel(Dev, a[0], a[1], Cmd->Color);
+            break;
+        case LCD32_STRIP_OP_LINE:
+            LCD32DrawLine(Dev, a[0], a[1], a[2], a[3], Cmd->Color);
+            break;
+        case LCD32_STRIP_OP_THICK_LINE:
+            LCD32DrawThickLine(Dev, a[0], a[1], a[2], a[3], Cmd->Color, a[4]);
+            break;
+        case LCD32_STRIP_OP_EMPTY_RECT:
+            LCD32DrawEmptyRect(Dev, a[0], a[1], a[2], a[3], a[4], Cmd->Color);
+            break;
+        case LCD32_STRIP_OP_POLYGON:
+            LCD32DrawPolygon(Dev, (const LCDPoint_t *)LCD32StripCmdData(list, Cmd), Cmd->DataLen / sizeof(LCDPoint_t), Cmd->Color);
+            break;
+        case LCD32_STRIP_OP_FILLED_POLYGON:
+            LCD32DrawFilledPolygon(Dev, (const LCDPoint_t *)LCD32StripCmdData(list, Cmd), Cmd->DataLen / sizeof(LCDPoint_t), Cmd->Color);
+            break;
+        case LCD32_STRIP_OP_CHAR:
+            LCD32DrawChar(Dev, a[0], a[1], (char) a[2], (const GFXfont *) Cmd->Font, Cmd->Color);
+            break;
+        case LCD32_STRIP_OP_TEXT:
+            LCD32DrawText(Dev, a[0], a[1], (const char *)LCD32StripCmdData(list, Cmd), (const GFXfont *) Cmd->Font, Cmd->Color);
+            break;
+        default:
+            break;
+    }
+}
+
+#endif /// (LCD32_STRIP_RENDER_EN == 1)
+
 /// @brief Allocates memory for a new LCD32Dev_t object and Canvas
 LCD32Dev_t * LCD32New(){
     LCD32Dev_t * DevPtr = (LCD32Dev_t *) malloc(sizeof(LCD32Dev_t));
@@ -27,6 +289,9 @@ LCD32Dev_t * LCD32New(){
     (DevPtr->P16Com).CtlIOMask = 0;
     (DevPtr->P16Com).DatIOMask = 0;
     (DevPtr->P16Com).Lut = NULL;
+    (DevPtr->P16Com).LutMode = P16COM_LUT_WIDE;
+    (DevPtr->P16Com).Backend = P16COM_DEFAULT_BACKEND;
+    (DevPtr->P16Com).BackendCtx = NULL;
 
     /// Preset LCD specific fields
     DevPtr->BrightLight = -1;
@@ -34,39 +299,48 @@ LCD32Dev_t * LCD32New(){
     // Width and Height will be set properly in LCD32Init based on orientation
     DevPtr->Width       = 0;
     DevPtr->Height      = 0;
+    DevPtr->ScrollFirst = 0;
+    DevPtr->ScrollLines = 0;
+    DevPtr->ScrollPos   = 0;
+    LCD32DirtyReset(&(DevPtr->Dirty), 0, 0);
     
-    #if (LCD32_THREAD_SAFE_EN == 1)
-        /// Init Mutex
-        DevPtr->mutex = xSemaphoreCreateMutex();
-        if (IsNull(DevPtr->mutex)) {
-            LCD32Err("[LCD32New] Failed to create mutex");
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        /// Single canvas until LCD32StartFlushTask()
+        DevPtr->Frames[1]   = NULL;
+        DevPtr->FreeQ       = NULL;
+        DevPtr->ReadyQ      = NULL;
+        DevPtr->FlushTask   = NULL;
+        DevPtr->Held        = NULL;
+    #endif
+
+    #if ((LCD32_STRIP_RENDER_EN == 1) && (LCD32_DEFAULT_RENDER_MODE == LCD32_RENDER_STRIP))
+        /// No canvas at all: the primitives go to the display list
+        DevPtr->Canvas = NULL;
+        #if (LCD32_DOUBLE_BUFFER_EN == 1)
+            DevPtr->Frames[0] = NULL;
+        #endif
+        DevPtr->Strip = LCD32StripNew();
+        if(IsNull(DevPtr->Strip)){
+            LCD32Err("[LCD32New] Malloc failed for strip renderer");
             free(DevPtr);
             return NULL;
         }
-    #endif
-
-    /// Allocate Canvas
-    #if (LCD32_CANVAS_IN_PSRAM_EN == 1)
-        /// Allocate in PSRAM based on physical pixels (320*240 = 150KB)
-        DevPtr->Canvas = (Color_t *)heap_caps_malloc(sizeof(Color_t) * LCD32_NATIVE_W * LCD32_NATIVE_H, MALLOC_CAP_SPIRAM);
     #else
-        /// Allocate in DRAM
-        DevPtr->Canvas = (Color_t *)malloc(sizeof(Color_t) * LCD32_NATIVE_W * LCD32_NATIVE_H);
-    #endif
-
-    if(IsNull(DevPtr->Canvas)){
-        LCD32Err("[LCD32New] Malloc failed for Canvas");
-        #if (LCD32_THREAD_SAFE_EN == 1)
-            if (DevPtr->mutex) vSemaphoreDelete(DevPtr->mutex);
+        #if (LCD32_STRIP_RENDER_EN == 1)
+            DevPtr->Strip = NULL;
         #endif
-        free(DevPtr);
-        return NULL;
-    }
 
-    /// Clear Canvas (Black)
-    for(int32_t i = 0; i < (LCD32_NATIVE_W * LCD32_NATIVE_H); i++){
-        (DevPtr->Canvas)[i] = COLOR_BLACK;
-    }
+        /// Allocate Canvas
+        DevPtr->Canvas = LCD32AllocCanvas();
+        if(IsNull(DevPtr->Canvas)){
+            LCD32Err("[LCD32New] Malloc failed for Canvas");
+            free(DevPtr);
+            return NULL;
+        }
+        #if (LCD32_DOUBLE_BUFFER_EN == 1)
+            DevPtr->Frames[0] = DevPtr->Canvas;
+        #endif
+    #endif
 
     LCD32Log("[LCD32New] Created %p (Canvas @ %p)", DevPtr, DevPtr->Canvas);
     return DevPtr;
@@ -75,13 +349,14 @@ LCD32Dev_t * LCD32New(){
 /// @brief Deallocate memory for LCD32Dev_t object and Canvas
 void LCD32Delete(LCD32Dev_t * Dev){
     if(Dev != NULL){
-        if(Dev->Canvas != NULL){
-            free(Dev->Canvas);
-        }
-        #if (LCD32_THREAD_SAFE_EN == 1)
-            if (Dev->mutex) {
-                vSemaphoreDelete(Dev->mutex);
-            }
+        #if (LCD32_DOUBLE_BUFFER_EN == 1)
+            /// Get every canvas back before freeing them
+            LCD32StopFlushTask(Dev);
+        #endif
+        P16ComReleaseBackend(&(Dev->P16Com));
+        LCD32FreeCanvases(Dev);
+        #if (LCD32_STRIP_RENDER_EN == 1)
+            LCD32StripDelete(Dev->Strip);
         #endif
         free(Dev);
     }
@@ -211,120 +486,21 @@ DefaultRet_t LCD32Init(LCD32Dev_t * Dev){
     }
     LCD32Log("[LCD32Init] Orientation: %d, W: %d, H: %d, MADCTL: 0x%02X", Dev->Orientation, Dev->Width, Dev->Height, madctl_val);
 
-    // ILI9341 INITIALIZATION SEQUENCE
-    LCD32StartTransaction(Dev);
+    /// The hardware reset cleared the scroll area
+    Dev->ScrollFirst = 0;
+    Dev->ScrollLines = 0;
+    Dev->ScrollPos   = 0;
 
-    // Power Control A
-    LCD32WriteCmd(Dev, ILI9341_POWER_CONTROL_A);
-    LCD32WriteData(Dev, 0x39);
-    LCD32WriteData(Dev, 0x2C);
-    LCD32WriteData(Dev, 0x00);
-    LCD32WriteData(Dev, 0x34);
-    LCD32WriteData(Dev, 0x02);
-
-    // Power Control B
-    LCD32WriteCmd(Dev, ILI9341_POWER_CONTROL_B);
-    LCD32WriteData(Dev, 0x00);
-    LCD32WriteData(Dev, 0xC1);
-    LCD32WriteData(Dev, 0x30);
-
-    // Driver Timing Control A
-    LCD32WriteCmd(Dev, ILI9341_DRIVER_TIMING_CTRL_A_INT);
-    LCD32WriteData(Dev, 0x85);
-    LCD32WriteData(Dev, 0x00);
-    LCD32WriteData(Dev, 0x78);
-
-    // Driver Timing Control B
-    LCD32WriteCmd(Dev, ILI9341_DRIVER_TIMING_CTRL_B);
-    LCD32WriteData(Dev, 0x00);
-    LCD32WriteData(Dev, 0x00);
-
-    // Power On Sequence Control
-    LCD32WriteCmd(Dev, ILI9341_POWER_ON_SEQ_CTRL);
-    LCD32WriteData(Dev, 0x64);
-    LCD32WriteData(Dev, 0x03);
-    LCD32WriteData(Dev, 0x12);
-    LCD32WriteData(Dev, 0x81);
-
-    // Pump Ratio Control
-    LCD32WriteCmd(Dev, ILI9341_PUMP_RATIO_CONTROL);
-    LCD32WriteData(Dev, 0x20);
-
-    // Power Control 1
-    LCD32WriteCmd(Dev, ILI9341_POWER_CONTROL_1);
-    LCD32WriteData(Dev, 0x23);
-
-    // Power Control 2
-    LCD32WriteCmd(Dev, ILI9341_POWER_CONTROL_2);
-    LCD32WriteData(Dev, 0x10);
-
-    // VCOM Control 1
-    LCD32WriteCmd(Dev, ILI9341_VCOM_CONTROL_1);
-    LCD32WriteData(Dev, 0x3e);
-    LCD32WriteData(Dev, 0x28);
-
-    // VCOM Control 2
-    LCD32WriteCmd(Dev, ILI9341_VCOM_CONTROL_2);
-    LCD32WriteData(Dev, 0x86);
-
-    // Memory Access Control
-    LCD32WriteCmd(Dev, ILI9341_MEMORY_ACCESS_CONTROL);
-    LCD32WriteData(Dev, madctl_val);
-
-    // Pixel Format Set
-    LCD32WriteCmd(Dev, ILI9341_PIXEL_FORMAT_SET);
-    LCD32WriteData(Dev, 0x55); // 16-bit
-
-    // Frame Rate Control
-    LCD32WriteCmd(Dev, ILI9341_FRAME_RATE_NORMAL);
-    LCD32WriteData(Dev, 0x00);
-    LCD32WriteData(Dev, 0x18);
-
-    // Display Function Control
-    LCD32WriteCmd(Dev, ILI9341_DISPLAY_FUNCTION_CTRL);
-    LCD32WriteData(Dev, 0x08);
-    LCD32WriteData(Dev, 0x82);
-    LCD32WriteData(Dev, 0x27);
-
-    // 3G Gamma
-    LCD32WriteCmd(Dev, ILI9341_ENABLE_3G);
-    LCD32WriteData(Dev, 0x00);
-
-    // Gamma Set
-    LCD32WriteCmd(Dev, ILI9341_GAMMA_SET);
-    LCD32WriteData(Dev, 0x01);
-
-    // Positive Gamma Correction
-    LCD32WriteCmd(Dev, ILI9341_POSITIVE_GAMMA_CORR);
-    LCD32WriteData(Dev, 0x0F); LCD32WriteData(Dev, 0x31);
-    LCD32WriteData(Dev, 0x2B); LCD32WriteData(Dev, 0x0C);
-    LCD32WriteData(Dev, 0x0E); LCD32WriteData(Dev, 0x08);
-    LCD32WriteData(Dev, 0x4E); LCD32WriteData(Dev, 0xF1);
-    LCD32WriteData(Dev, 0x37); LCD32WriteData(Dev, 0x07);
-    LCD32WriteData(Dev, 0x10); LCD32WriteData(Dev, 0x03);
-    LCD32WriteData(Dev, 0x0E); LCD32WriteData(Dev, 0x09);
-    LCD32WriteData(Dev, 0x00);
-
-    // Negative Gamma Correction
-    LCD32WriteCmd(Dev, ILI9341_NEGATIVE_GAMMA_CORR);
-    LCD32WriteData(Dev, 0x00); LCD32WriteData(Dev, 0x0E);
-    LCD32WriteData(Dev, 0x14); LCD32WriteData(Dev, 0x03);
-    LCD32WriteData(Dev, 0x11); LCD32WriteData(Dev, 0x07);
-    LCD32WriteData(Dev, 0x31); LCD32WriteData(Dev, 0xC1);
-    LCD32WriteData(Dev, 0x48); LCD32WriteData(Dev, 0x08);
-    LCD32WriteData(Dev, 0x0F); LCD32WriteData(Dev, 0x0C);
-    LCD32WriteData(Dev, 0x31); LCD32WriteData(Dev, 0x36);
-    LCD32WriteData(Dev, 0x0F);
-
-    // Sleep Out
-    LCD32WriteCmd(Dev, ILI9341_SLEEP_OUT);
-    P16BlockingDelay(120000);
-
-    // Display On
-    LCD32WriteCmd(Dev, ILI9341_DISPLAY_ON);
-    P16BlockingDelay(50000); // Add delay for stability
+    /// Dirty map follows the orientation; the first partial flush sends everything
+    LCD32DirtyReset(&(Dev->Dirty), Dev->Width, Dev->Height);
+    LCD32DirtyMarkAll(&(Dev->Dirty));
 
-    LCD32StopTransaction(Dev);
+    // ILI9341 INITIALIZATION SEQUENCE (one CS-low transaction, MADCTL from params)
+    P16Data_t params[1] = { madctl_val };
+    ret = P16ComRunCmdList(P16Dev, LCD32InitList, params, 1);
+    if(ret != STAT_OKE){
+        LCD32ReturnWithLog(ret, "LCD32Init() : Init sequence failed");
+    }
 
     /// 6. Turn On Backlight (Active Low logic per macro)
     // LCD32SetLowBrightLightPin(Dev); // Original line (Assumes Active-Low)
@@ -357,72 +533,326 @@ void LCD32WriteData(LCD32Dev_t * Dev, uint16_t Data){
 }
 
 /// @brief Set the active drawing area window on the LCD
-void LCD32SetAddressWindow(LCD32Dev_t * Dev, Dim_t x, Dim_t y, Dim_t w, Dim_t h){
-    LCD32StartTransaction(Dev);
-
-    // Column Address Set
-    LCD32WriteCmd(Dev, ILI9341_COLUMN_ADDRESS_SET);
-    LCD32WriteData(Dev, x >> 8);
-    LCD32WriteData(Dev, x & 0xFF);
-    LCD32WriteData(Dev, (x + w - 1) >> 8);
-    LCD32WriteData(Dev, (x + w - 1) & 0xFF);
-
-    // Page Address Set
-    LCD32WriteCmd(Dev, ILI9341_PAGE_ADDRESS_SET);
-    LCD32WriteData(Dev, y >> 8);
-    LCD32WriteData(Dev, y & 0xFF);
-    LCD32WriteData(Dev, (y + h - 1) >> 8);
-    LCD32WriteData(Dev, (y + h - 1) & 0xFF);
-
-    // Memory Write
-    LCD32WriteCmd(Dev, ILI9341_MEMORY_WRITE);
-    
-    LCD32StopTransaction(Dev);
+DefaultRet_t LCD32SetAddressWindow(LCD32Dev_t * Dev, Dim_t x, Dim_t y, Dim_t w, Dim_t h){
+    /// Column / page address set and MEMORY_WRITE in one transaction
+    P16Data_t params[8];
+    LCD32WindowParams(params, x, y, w, h);
+    DefaultRet_t ret = P16ComRunCmdList(&(Dev->P16Com), LCD32WindowWriteList, params, 1);
+    if (ret != STAT_OKE) {
+        LCD32Err("[LCD32SetAddressWindow] Window (%d, %d, %d, %d) not set: %s", x, y, w, h, DefaultReturnType2Str(ret));
+    }
+    return ret;
 }
 
 /// @brief Flush the internal Canvas buffer to the display
 void LCD32FlushCanvas(LCD32Dev_t * Dev){
     // LCD32Entry("LCD32FlushCanvas(%p)", Dev);
     
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if(IsNotNull(Dev) && IsNotNull(Dev->Strip)){
+            LCD32FlushStrips(Dev);
+            return;
+        }
+    #endif
+
     if(IsNull(Dev) || IsNull(Dev->Canvas)){
         return;
     }
 
-    #if (LCD32_THREAD_SAFE_EN == 1)
-    if (xSemaphoreTake(Dev->mutex, portMAX_DELAY) != pdTRUE) {
-        LCD32Err("[LCD32FlushCanvas] Failed to take mutex");
+    LCD32TakeBus(Dev);
+
+    /// The whole canvas goes out: nothing stays dirty
+    LCD32DirtyClear(&(Dev->Dirty));
+    LCD32SendFrame(Dev, Dev->Canvas);
+
+    LCD32GiveBus(Dev);
+}
+
+/// @brief Start flushing the Canvas and return immediately
+DefaultRet_t LCD32FlushCanvasAsync(LCD32Dev_t * Dev){
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if(IsNotNull(Dev) && IsNotNull(Dev->Strip)){
+            return LCD32FlushStrips(Dev);
+        }
+    #endif
+
+    if(IsNull(Dev) || IsNull(Dev->Canvas)){
+        return STAT_ERR_NULL;
+    }
+
+    LCD32TakeBus(Dev);
+
+    /// The whole canvas goes out: nothing stays dirty
+    LCD32DirtyClear(&(Dev->Dirty));
+
+    /// 1. Set Address Window to Full Screen (waits for a previous flush)
+    DefaultRet_t ret = LCD32SetAddressWindow(Dev, 0, 0, Dev->Width, Dev->Height);
+    if(ret != STAT_OKE){
+        LCD32GiveBus(Dev);
+        return ret;
+    }
+    /// 2. Start Data Stream, CS is released when the transfer completes
+    LCD32StartTransaction(Dev);
+    LCD32SetDataTransaction(Dev);
+    ret = P16ComWriteArrayAsync(&(Dev->P16Com), (const P16Data_t *)Dev->Canvas, (Dev->Width * Dev->Height), 1);
+    if(ret != STAT_OKE){
+        LCD32Err("[LCD32FlushCanvasAsync] Write failed: %s", DefaultReturnType2Str(ret));
+        LCD32StopTransaction(Dev);
+    }
+
+    LCD32GiveBus(Dev);
+    return ret;
+}
+
+/// @brief Wait for a flush started by LCD32FlushCanvasAsync() to finish
+DefaultRet_t LCD32WaitFlush(LCD32Dev_t * Dev){
+    if(IsNull(Dev)){
+        return STAT_ERR_NULL;
+    }
+    return P16ComWaitIdle(&(Dev->P16Com));
+}
+
+#if (LCD32_DOUBLE_BUFFER_EN == 1)
+
+/// @brief Flush task body: sends every frame from ReadyQ, then hands it back on FreeQ
+/// @details A NULL frame is the stop request; it is echoed on FreeQ as acknowledgement.
+static void LCD32FlushTaskBody(void * pv){
+    LCD32Dev_t * Dev = (LCD32Dev_t *) pv;
+    Color_t * frame = NULL;
+
+    while(1){
+        xQueueReceive(Dev->ReadyQ, &frame, portMAX_DELAY);
+        if(IsNull(frame)){
+            break;
+        }
+        LCD32SendFrame(Dev, frame);
+        xQueueSend(Dev->FreeQ, &frame, portMAX_DELAY);
+    }
+
+    xQueueSend(Dev->FreeQ, &frame, portMAX_DELAY);
+    DeleteTask(NULL);
+}
+
+/// @brief Allocate the second canvas and start the flush task on CPU1
+DefaultRet_t LCD32StartFlushTask(LCD32Dev_t * Dev){
+    LCD32Entry("LCD32StartFlushTask(%p)", Dev);
+
+    if(IsNull(Dev) || IsNull(Dev->Canvas)){
+        LCD32ReturnWithLog(STAT_ERR_NULL, "LCD32StartFlushTask() : STAT_ERR_NULL");
+    }
+    if(IsNotNull(Dev->FlushTask)){
+        LCD32ReturnWithLog(STAT_OKE, "LCD32StartFlushTask() : Already running");
+    }
+
+    if(IsNull(Dev->Frames[1])){
+        Dev->Frames[1] = LCD32AllocCanvas();
+    }
+    if(IsNull(Dev->FreeQ))  Dev->FreeQ  = xQueueCreate(2, sizeof(Color_t *));
+    if(IsNull(Dev->ReadyQ)) Dev->ReadyQ = xQueueCreate(2, sizeof(Color_t *));
+    if(IsNull(Dev->Frames[1]) || IsNull(Dev->FreeQ) || IsNull(Dev->ReadyQ)){
+        LCD32Err("[LCD32StartFlushTask] Malloc failed for canvas/queues");
+        LCD32ReturnWithLog(STAT_ERR_MALLOC_FAILED, "LCD32StartFlushTask() : STAT_ERR_MALLOC_FAILED");
+    }
+
+    /// The canvas not being drawn into starts out free
+    Color_t * spare = (Dev->Canvas == Dev->Frames[0]) ? Dev->Frames[1] : Dev->Frames[0];
+    xQueueReset(Dev->FreeQ);
+    xQueueReset(Dev->ReadyQ);
+    xQueueSend(Dev->FreeQ, &spare, 0);
+
+    /// Any async flush still owns CS: let it finish before the flush task takes the bus
+    LCD32WaitFlush(Dev);
+    if(CreateTaskCPU1(LCD32FlushTaskBody, "LCD32Flush", LCD32_FLUSH_TASK_STACK, Dev, LCD32_FLUSH_TASK_PRIO, &(Dev->FlushTask)) != pdPASS){
+        Dev->FlushTask = NULL;
+        LCD32Err("[LCD32StartFlushTask] Failed to create flush task");
+        LCD32ReturnWithLog(STAT_ERR_INIT_FAILED, "LCD32StartFlushTask() : STAT_ERR_INIT_FAILED");
+    }
+
+    LCD32ReturnWithLog(STAT_OKE, "LCD32StartFlushTask() : STAT_OKE");
+}
+
+/// @brief Stop the flush task once the frames queued before have been sent
+void LCD32StopFlushTask(LCD32Dev_t * Dev){
+    if(IsNull(Dev) || IsNull(Dev->FlushTask)){
         return;
     }
+
+    /// Frames are handled in order: the NULL echo comes back after the last one
+    Color_t * frame = NULL;
+    xQueueSend(Dev->ReadyQ, &frame, portMAX_DELAY);
+    do {
+        xQueueReceive(Dev->FreeQ, &frame, portMAX_DELAY);
+    } while(IsNotNull(frame));
+    Dev->FlushTask = NULL;
+
+    vQueueDelete(Dev->FreeQ);
+    vQueueDelete(Dev->ReadyQ);
+    Dev->FreeQ  = NULL;
+    Dev->ReadyQ = NULL;
+}
+
+/// @brief Hand the finished canvas to the flush task and get a free one back
+Color_t * LCD32SwapBuffers(LCD32Dev_t * Dev){
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if(IsNotNull(Dev) && IsNotNull(Dev->Strip)){
+            LCD32FlushStrips(Dev);
+            return NULL;
+        }
     #endif
 
-    /// 1. Set Address Window to Full Screen
-    LCD32SetAddressWindow(Dev, 0, 0, Dev->Width, Dev->Height);
-    /// 2. Start Data Stream
+    if(IsNull(Dev) || IsNull(Dev->Canvas)){
+        return NULL;
+    }
+
+    if(IsNull(Dev->FlushTask)){
+        /// Single buffer: flush in place
+        LCD32FlushCanvas(Dev);
+        return Dev->Canvas;
+    }
+
+    /// The whole frame goes out: nothing stays dirty
+    LCD32DirtyClear(&(Dev->Dirty));
+    xQueueSend(Dev->ReadyQ, &(Dev->Canvas), portMAX_DELAY);
+    /// Blocks only while the flush task still owns both canvases
+    xQueueReceive(Dev->FreeQ, &(Dev->Canvas), portMAX_DELAY);
+    return Dev->Canvas;
+}
+
+#endif /// (LCD32_DOUBLE_BUFFER_EN == 1)
+
+#if (LCD32_STRIP_RENDER_EN == 1)
+
+/// @brief Switch between the full-screen canvas and the strip renderer
+DefaultRet_t LCD32SetRenderMode(LCD32Dev_t * Dev, uint32_t Mode){
+    LCD32Entry("LCD32SetRenderMode(%p, %d)", Dev, Mode);
+
+    if(IsNull(Dev)){
+        LCD32ReturnWithLog(STAT_ERR_NULL, "LCD32SetRenderMode() : STAT_ERR_NULL");
+    }
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        if(IsNotNull(Dev->FlushTask)){
+            LCD32Err("[LCD32SetRenderMode] Stop the flush task first");
+            LCD32ReturnWithLog(STAT_ERR_INVALID_STATE, "LCD32SetRenderMode() : STAT_ERR_INVALID_STATE");
+        }
+    #endif
+
+    if(Mode == LCD32_RENDER_STRIP){
+        if(Dev->ScrollLines != 0){
+            LCD32Err("[LCD32SetRenderMode] Turn the scroll area off first");
+            LCD32ReturnWithLog(STAT_ERR_INVALID_STATE, "LCD32SetRenderMode() : STAT_ERR_INVALID_STATE");
+        }
+        if(IsNull(Dev->Strip)){
+            LCD32Strip_t * strip = LCD32StripNew();
+            if(IsNull(strip)){
+                LCD32Err("[LCD32SetRenderMode] Malloc failed for strip renderer");
+                LCD32ReturnWithLog(STAT_ERR_MALLOC_FAILED, "LCD32SetRenderMode() : STAT_ERR_MALLOC_FAILED");
+            }
+            /// An async flush may still be reading the canvas
+            LCD32WaitFlush(Dev);
+            LCD32FreeCanvases(Dev);
+            Dev->Strip = strip;
+        }
+        LCD32ReturnWithLog(STAT_OKE, "LCD32SetRenderMode() : STAT_OKE");
+    }
+
+    if(Mode == LCD32_RENDER_CANVAS){
+        if(IsNotNull(Dev->Strip)){
+            Color_t * canvas = LCD32AllocCanvas();
+            if(IsNull(canvas)){
+                LCD32Err("[LCD32SetRenderMode] Malloc failed for Canvas");
+                LCD32ReturnWithLog(STAT_ERR_MALLOC_FAILED, "LCD32SetRenderMode() : STAT_ERR_MALLOC_FAILED");
+            }
+            /// The last band may still be on the bus
+            LCD32WaitFlush(Dev);
+            LCD32StripDelete(Dev->Strip);
+            Dev->Strip  = NULL;
+            Dev->Canvas = canvas;
+            #if (LCD32_DOUBLE_BUFFER_EN == 1)
+                Dev->Frames[0] = canvas;
+            #endif
+            LCD32DirtyMarkAll(&(Dev->Dirty));
+        }
+        LCD32ReturnWithLog(STAT_OKE, "LCD32SetRenderMode() : STAT_OKE");
+    }
+
+    LCD32ReturnWithLog(STAT_ERR_INVALID_ARG, "LCD32SetRenderMode() : STAT_ERR_INVALID_ARG");
+}
+
+/// @brief Rasterize the display list band by band and send each band as it completes
+DefaultRet_t LCD32FlushStrips(LCD32Dev_t * Dev){
+    if(IsNull(Dev) || IsNull(Dev->Strip)){
+        return STAT_ERR_NULL;
+    }
+
+    LCD32Strip_t * strip = Dev->Strip;
+    LCD32StripList_t * list = &(strip->List);
+    if(list->Dropped){
+        LCD32Err("[LCD32FlushStrips] %d commands were dropped (display list full)", list->Dropped);
+    }
+
+    LCD32TakeBus(Dev);
+
+    DefaultRet_t ret = LCD32SetAddressWindow(Dev, 0, 0, Dev->Width, Dev->Height);
+    if(ret != STAT_OKE){
+        LCD32GiveBus(Dev);
+        return ret;
+    }
     LCD32StartTransaction(Dev);
     LCD32SetDataTransaction(Dev);
-    /// 3. Burst Write Pixels using P16Com optimized driver
-    P16ComWriteArray(&(Dev->P16Com), (P16Data_t *)Dev->Canvas, (Dev->Width * Dev->Height));
+
+    uint32_t band = 0;
+    strip->Width = Dev->Width;
+    strip->Replaying = 1;
+    for(Dim_t y0 = 0; y0 < Dev->Height; y0 += LCD32_STRIP_ROWS){
+        Dim_t rows = Min(LCD32_STRIP_ROWS, Dev->Height - y0);
+
+        /// Free to overwrite: starting the previous band waited for the one before it
+        LCD32StripBeginBand(strip, strip->Band[band], y0, rows);
+        for(uint16_t i = 0; i < list->Count; i++){
+            const LCD32StripCmd_t * cmd = &(list->Cmd[i]);
+            if(LCD32StripCmdHits(cmd, strip->Y0, strip->Y1)){
+                LCD32StripReplay(Dev, cmd);
+            }
+        }
+
+        /// DMA backend: returns at once, the next band is rasterized meanwhile
+        ret = P16ComWriteArrayAsync(&(Dev->P16Com), (const P16Data_t *) strip->Cur, (P16Size_t) Dev->Width * rows, 0);
+        if(ret != STAT_OKE){
+            LCD32Err("[LCD32FlushStrips] Write failed: %s", DefaultReturnType2Str(ret));
+            break;
+        }
+        band ^= 1;
+    }
+    strip->Replaying = 0;
+
+    P16ComWaitIdle(&(Dev->P16Com));
     LCD32StopTransaction(Dev);
 
-    #if (LCD32_THREAD_SAFE_EN == 1)
-    xSemaphoreGive(Dev->mutex);
-    #endif
+    LCD32GiveBus(Dev);
+    return ret;
 }
 
+#endif /// (LCD32_STRIP_RENDER_EN == 1)
+
 /// @brief Flush the internal Canvas buffer to the display (Optimized, inlined)
 void LCD32FlushCanvasFast(LCD32Dev_t * Dev){
     // LCD32Entry("LCD32FlushCanvasFast(%p)", Dev);
     
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if(IsNotNull(Dev) && IsNotNull(Dev->Strip)){
+            LCD32FlushStrips(Dev);
+            return;
+        }
+    #endif
+
     if(IsNull(Dev) || IsNull(Dev->Canvas)){
         return;
     }
 
-    #if (LCD32_THREAD_SAFE_EN == 1)
-    if (xSemaphoreTake(Dev->mutex, portMAX_DELAY) != pdTRUE) {
-        LCD32Err("[LCD32FlushCanvasFast] Failed to take mutex");
-        return;
-    }
-    #endif
+    LCD32TakeBus(Dev);
+
+    /// The whole canvas goes out: nothing stays dirty
+    LCD32DirtyClear(&(Dev->Dirty));
 
     /// 1. Set Address Window to Full Screen
     LCD32SetAddressWindow(Dev, 0, 0, Dev->Width, Dev->Height);
@@ -449,71 +879,468 @@ void LCD32FlushCanvasFast(LCD32Dev_t * Dev){
             goto cleanup;
         }
 
+        #if (P16COM_I80_DMA_EN == 1)
+            /// Nothing to inline: the i80 engine is already the fast path
+            if(P16Dev->Backend == P16COM_BACKEND_I80_DMA){
+                P16ComWriteArray(P16Dev, DataArr, Size);
+                goto cleanup;
+            }
+        #endif
+
+        /// The compact LUT and the dedicated-GPIO strobes have their own loops in P16ComWriteArray
+        if((P16Dev->LutMode == P16COM_LUT_COMPACT) || (P16Dev->Backend == P16COM_BACKEND_DEDIC_GPIO)){
+            P16ComWriteArray(P16Dev, DataArr, Size);
+            goto cleanup;
+        }
+
         #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
-            IOConfigAsOutput(P16Dev->DatIOMask, -1, -1);
+            P16BusToOutput(P16Dev);
         #endif
 
+        /// Same run skipping as P16ComWriteArray: equal neighbours only cost a WR strobe
+        P16Data_t prevData = ~DataArr[0];
         REPN(j, Size){
             P16Data_t currentData = DataArr[j];
-            uint8_t low_byte = currentData & 0xFF;
-            uint8_t high_byte = (currentData >> 8) & 0xFF;
+            if (currentData != prevData) {
+                uint8_t low_byte = currentData & 0xFF;
+                uint8_t high_byte = (currentData >> 8) & 0xFF;
 
-            uint64_t MaskSet = P16Dev->Lut->LutLow[low_byte].setMask | P16Dev->Lut->LutHigh[high_byte].setMask;
-            uint64_t MaskClr = P16Dev->Lut->LutLow[low_byte].clrMask | P16Dev->Lut->LutHigh[high_byte].clrMask;
+                uint64_t MaskSet = P16Dev->Lut->LutLow[low_byte].setMask | P16Dev->Lut->LutHigh[high_byte].setMask;
+                uint64_t MaskClr = P16Dev->Lut->LutLow[low_byte].clrMask | P16Dev->Lut->LutHigh[high_byte].clrMask;
 
-            IOSet(MaskSet);
-            IOClr(MaskClr);
+                IOSet(MaskSet);
+                IOClr(MaskClr);
+                prevData = currentData;
+            }
             P16MakeWritePulse(P16Dev);
         }
         
         #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
-            IOConfigAsInput(P16Dev->DatIOMask, -1, -1);
+            P16BusToInput(P16Dev);
         #endif
     }
 
 cleanup:
     LCD32StopTransaction(Dev);
 
-    #if (LCD32_THREAD_SAFE_EN == 1)
-    xSemaphoreGive(Dev->mutex);
+    LCD32GiveBus(Dev);
+}
+
+/// @brief Flush only the Canvas tiles changed since the last flush
+DefaultRet_t LCD32FlushDirty(LCD32Dev_t * Dev){
+    /// Strip mode keeps no picture to diff against: redraw everything
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if(IsNotNull(Dev) && IsNotNull(Dev->Strip)){
+            return LCD32FlushStrips(Dev);
+        }
     #endif
+
+    if(IsNull(Dev) || IsNull(Dev->Canvas)){
+        return STAT_ERR_NULL;
+    }
+
+    LCD32TakeBus(Dev);
+
+    uint32_t cursor = 0;
+    LCD32DirtyRect_t rect;
+    DefaultRet_t ret = STAT_OKE;
+    while (LCD32DirtyNextRegion(&(Dev->Dirty), &cursor, &rect)) {
+        ret = LCD32SetAddressWindow(Dev, rect.x, rect.y, rect.w, rect.h);
+        if (ret != STAT_OKE) {
+            /// Tiles stay dirty for the next flush
+            LCD32GiveBus(Dev);
+            return ret;
+        }
+        LCD32StartTransaction(Dev);
+        LCD32SetDataTransaction(Dev);
+        P16Data_t * src = (P16Data_t *)&(Dev->Canvas[rect.y * Dev->Width + rect.x]);
+        if (rect.w == Dev->Width) {
+            /// Full-width band is contiguous in the canvas
+            P16ComWriteArray(&(Dev->P16Com), src, rect.w * rect.h);
+        } else {
+            for (Dim_t i = 0; i < rect.h; i++) {
+                P16ComWriteArray(&(Dev->P16Com), src + i * Dev->Width, rect.w);
+            }
+        }
+        LCD32StopTransaction(Dev);
+    }
+    LCD32DirtyClear(&(Dev->Dirty));
+
+    LCD32GiveBus(Dev);
+    return STAT_OKE;
+}
+
+/// @brief Mark a canvas rectangle as changed
+void LCD32MarkDirty(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w) {
+    if (IsNull(Dev)) return;
+    LCD32DirtyMarkRect(&(Dev->Dirty), r, c, h, w);
 }
 
 /// @brief Fill the entire canvas with a single color
 void LCD32FillCanvas(LCD32Dev_t *Dev, Color_t Color) {
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        /// Covers everything recorded so far: restart the list on the new background
+        if (IsNotNull(Dev) && IsNotNull(Dev->Strip)) {
+            LCD32StripListClear(&(Dev->Strip->List), Color);
+            return;
+        }
+    #endif
     if (IsNull(Dev) || IsNull(Dev->Canvas)) return;
     int32_t size = Dev->Width * Dev->Height;
     for (int32_t i = 0; i < size; i++) {
         Dev->Canvas[i] = Color;
     }
+    LCD32DirtyMarkAll(&(Dev->Dirty));
 }
 
 /// @brief Draw a single pixel on the canvas (with bounds check)
 void LCD32SetCanvasPixel(LCD32Dev_t *Dev, Dim_t Row, Dim_t Col, Color_t Color) {
     if (Row >= 0 && Row < Dev->Height && Col >= 0 && Col < Dev->Width) {
+        #if (LCD32_STRIP_RENDER_EN == 1)
+            if (IsNotNull(Dev->Strip)) {
+                if (Dev->Strip->Replaying) {
+                    LCD32StripPutPixel(Dev->Strip, Row, Col, Color);
+                } else {
+                    LCD32Record(Dev, LCD32_STRIP_OP_PIXEL, Color, Row, Row, (const int16_t[5]){ Row, Col }, NULL, 0, NULL);
+                }
+                return;
+            }
+        #endif
         Dev->Canvas[Row * Dev->Width + Col] = Color;
+        LCD32DirtyMarkPixel(&(Dev->Dirty), Row, Col);
     }
 }
 
 /// @brief Write a single pixel directly to the LCD (bypassing canvas)
 void LCD32DirectlyWritePixel(LCD32Dev_t *Dev, Dim_t Row, Dim_t Col, Color_t Color) {
     if (Row >= 0 && Row < Dev->Height && Col >= 0 && Col < Dev->Width) {
-        #if (LCD32_THREAD_SAFE_EN == 1)
-        if (xSemaphoreTake(Dev->mutex, portMAX_DELAY) != pdTRUE) {
-            LCD32Err("[LCD32DirectlyWritePixel] Failed to take mutex");
-            return;
-        }
-        #endif
+        LCD32TakeBus(Dev);
 
         LCD32SetAddressWindow(Dev, Col, Row, 1, 1); // Note: AddressWindow usually takes x, y (Col, Row)
         LCD32StartTransaction(Dev);
         LCD32SetDataTransaction(Dev);
         P16ComWrite(&(Dev->P16Com), Color);
         LCD32StopTransaction(Dev);
-        #if (LCD32_THREAD_SAFE_EN == 1)
-        xSemaphoreGive(Dev->mutex);
+        LCD32GiveBus(Dev);
+    }
+}
+
+/// @brief Fill a rectangle directly on the LCD with a single color (bypassing canvas)
+DefaultRet_t LCD32FillRectDirect(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w, Color_t Color) {
+    if (IsNull(Dev)) return STAT_ERR_NULL;
+
+    /// Clip to the screen
+    if (r < 0) { h += r; r = 0; }
+    if (c < 0) { w += c; c = 0; }
+    if (r + h > Dev->Height) h = Dev->Height - r;
+    if (c + w > Dev->Width)  w = Dev->Width - c;
+    if (h <= 0 || w <= 0) return STAT_OKE;
+
+    LCD32TakeBus(Dev);
+
+    DefaultRet_t ret = LCD32SetAddressWindow(Dev, c, r, w, h);
+    if (ret != STAT_OKE) {
+        LCD32GiveBus(Dev);
+        return ret;
+    }
+    LCD32StartTransaction(Dev);
+    LCD32SetDataTransaction(Dev);
+    /// Data lines are driven once, the rest is WR strobes
+    P16ComWriteRepeat(&(Dev->P16Com), Color, (P16Size_t) w * h);
+    LCD32StopTransaction(Dev);
+
+    LCD32GiveBus(Dev);
+    return STAT_OKE;
+}
+
+/// @brief Read a window of frame memory into `Out` (caller owns the bus, window inside the screen)
+/// @return STAT_OKE, or the error of the window command list (nothing read)
+static DefaultRet_t LCD32ReadWindow(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w, Color_t *Out) {
+    P16Data_t words[LCD32ShotWords(LCD32_SHOT_CHUNK_PX)];
+    uint32_t total = (uint32_t) w * h;
+
+    /// Window and MEMORY_READ, CS left low for the reads
+    P16Data_t params[8];
+    LCD32WindowParams(params, c, r, w, h);
+    DefaultRet_t ret = P16ComRunCmdList(&(Dev->P16Com), LCD32WindowReadList, params, 0);
+    if (ret != STAT_OKE) {
+        LCD32Err("[LCD32ReadWindow] Window (%d, %d, %d, %d) not set: %s", r, c, h, w, DefaultReturnType2Str(ret));
+        LCD32StopTransaction(Dev);
+        return ret;
+    }
+    LCD32SetDataTransaction(Dev);
+    /// The first read after MEMORY_READ is a dummy
+    (void) P16ComRead(&(Dev->P16Com));
+
+    /// RD strobes may pause between bursts while CS stays low: the panel keeps its read pointer
+    for (uint32_t done = 0; done < total; ) {
+        uint32_t num = total - done;
+        if (num > LCD32_SHOT_CHUNK_PX) num = LCD32_SHOT_CHUNK_PX;
+        P16ComReadArray(&(Dev->P16Com), words, (P16Size_t) LCD32ShotWords(num));
+        LCD32ShotUnpack(words, Out + done, num);
+        done += num;
+    }
+    LCD32StopTransaction(Dev);
+    return STAT_OKE;
+}
+
+/// @brief Read screen rows [y, y + Rows) in glass order (caller owns the bus)
+/// @details Once the scroll area has moved, each row is read in runs of columns that stay
+///          contiguous in frame memory (at most four windows per row).
+static DefaultRet_t LCD32ReadScreenRows(LCD32Dev_t *Dev, Dim_t y, Dim_t Rows, Color_t *Out) {
+    if (Dev->ScrollPos == 0) {
+        return LCD32ReadWindow(Dev, y, 0, Rows, Dev->Width, Out);
+    }
+    bool alongRows = LCD32ScrollAlongRows(Dev);
+    DefaultRet_t ret = STAT_OKE;
+    for (Dim_t i = 0; (i < Rows) && (ret == STAT_OKE); i++) {
+        Dim_t r = alongRows ? LCD32ScrollMap(Dev, y + i) : (y + i);
+        Color_t *row = Out + (int32_t) i * Dev->Width;
+        if (alongRows) {
+            ret = LCD32ReadWindow(Dev, r, 0, 1, Dev->Width, row);
+            continue;
+        }
+        for (Dim_t x = 0; (x < Dev->Width) && (ret == STAT_OKE); ) {
+            Dim_t c = LCD32ScrollMap(Dev, x);
+            Dim_t n = 1;
+            while ((x + n < Dev->Width) && (LCD32ScrollMap(Dev, x + n) == c + n)) n++;
+            ret = LCD32ReadWindow(Dev, r, c, 1, n, row + x);
+            x += n;
+        }
+    }
+    return ret;
+}
+
+/// @brief Read a rectangle back from the panel's frame memory (ILI9341 MEMORY_READ)
+DefaultRet_t LCD32ReadRect(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w, Color_t *Out) {
+    LCD32EntryHot("LCD32ReadRect(%p, %d, %d, %d, %d, %p)", Dev, r, c, h, w, Out);
+    if (IsNull(Dev) || IsNull(Out)) {
+        LCD32ReturnWithLogHot(STAT_ERR_NULL, "LCD32ReadRect() : STAT_ERR_NULL");
+    }
+    if ((r < 0) || (c < 0) || (h <= 0) || (w <= 0) || (r + h > Dev->Height) || (c + w > Dev->Width)) {
+        LCD32Err("[LCD32ReadRect] Rectangle (%d, %d, %d, %d) outside the screen", r, c, h, w);
+        LCD32ReturnWithLogHot(STAT_ERR_INVALID_ARG, "LCD32ReadRect() : STAT_ERR_INVALID_ARG");
+    }
+
+    LCD32TakeBus(Dev);
+    DefaultRet_t ret = LCD32ReadWindow(Dev, r, c, h, w, Out);
+    LCD32GiveBus(Dev);
+
+    LCD32ReturnWithLogHot(ret, "LCD32ReadRect() : %s", DefaultReturnType2Str(ret));
+}
+
+/// @brief Capture the screen as a QOI image streamed to `Sink`
+DefaultRet_t LCD32Screenshot(LCD32Dev_t *Dev, LCD32ShotSink_t Sink, void *Ctx) {
+    LCD32Entry("LCD32Screenshot(%p, %p, %p)", Dev, Sink, Ctx);
+    if (IsNull(Dev) || IsNull(Sink)) {
+        LCD32ReturnWithLog(STAT_ERR_NULL, "LCD32Screenshot() : STAT_ERR_NULL");
+    }
+    if (!((Dev->StatusFlag) & LCD32_INITIALIZED)) {
+        LCD32ReturnWithLog(STAT_ERR_INVALID_STATE, "LCD32Screenshot() : STAT_ERR_INVALID_STATE");
+    }
+
+    /// Encoder state and one band, internal RAM (about 5.7 KB for 320 px rows)
+    LCD32Qoi_t * qoi = (LCD32Qoi_t *)heap_caps_malloc(sizeof(LCD32Qoi_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    Color_t * band = (Color_t *)heap_caps_malloc(sizeof(Color_t) * Dev->Width * LCD32_SHOT_ROWS, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (IsNull(qoi) || IsNull(band)) {
+        free(qoi);
+        free(band);
+        LCD32Err("[LCD32Screenshot] Malloc failed!");
+        LCD32ReturnWithLog(STAT_ERR_MALLOC_FAILED, "LCD32Screenshot() : STAT_ERR_MALLOC_FAILED");
+    }
+
+    DefaultRet_t ret = STAT_OKE;
+    int64_t start = esp_timer_get_time();
+
+    LCD32TakeBus(Dev);
+    int32_t err = LCD32QoiBegin(qoi, Dev->Width, Dev->Height, Sink, Ctx);
+    for (Dim_t y = 0; (y < Dev->Height) && (err == 0) && (ret == STAT_OKE); y += LCD32_SHOT_ROWS) {
+        Dim_t rows = Dev->Height - y;
+        if (rows > LCD32_SHOT_ROWS) rows = LCD32_SHOT_ROWS;
+        ret = LCD32ReadScreenRows(Dev, y, rows, band);
+        if (ret == STAT_OKE) {
+            err = LCD32QoiPush(qoi, band, (uint32_t) rows * Dev->Width);
+        }
+    }
+    if ((err == 0) && (ret == STAT_OKE)) {
+        err = LCD32QoiEnd(qoi);
+    }
+    LCD32GiveBus(Dev);
+
+    if (ret != STAT_OKE) {
+        /// LCD32ReadWindow() logged the cause; the sink holds a truncated image
+        LCD32Err("[LCD32Screenshot] Frame memory read failed");
+    } else if (err != 0) {
+        LCD32Err("[LCD32Screenshot] Sink refused data (%d)", err);
+        ret = STAT_ERR_IO;
+    } else {
+        LCD32Log("[LCD32Screenshot] %dx%d captured in %lld us", Dev->Width, Dev->Height, esp_timer_get_time() - start);
+    }
+
+    free(qoi);
+    free(band);
+    LCD32ReturnWithLog(ret, "LCD32Screenshot() : %s", DefaultReturnType2Str(ret));
+}
+
+/* --- HARDWARE SCROLLING --- */
+
+/// @brief Store a 16-bit command parameter as high/low bytes
+static inline void LCD32ParamBe16(P16Data_t * p, uint32_t v){
+    p[0] = (v >> 8) & 0xFF;
+    p[1] = v & 0xFF;
+}
+
+/// @brief Frame memory line shown first in the scroll area (VSCRSADD)
+/// @details Panel lines follow the gate order. Screen lines follow it unless MADCTL_MY is
+///          set; then the area sits at 320 - First - Lines and rolls the other way.
+static uint32_t LCD32ScrollStart(const LCD32Dev_t *Dev, uint32_t *Tfa){
+    uint32_t lines = (uint32_t) Dev->ScrollLines;
+    if (lines == 0) {
+        *Tfa = 0;
+        return 0;
+    }
+    if (LCD32ScrollReversed(Dev)) {
+        *Tfa = LCD32_SCROLL_AXIS_LINES - Dev->ScrollFirst - lines;
+        return *Tfa + ((lines - Dev->ScrollPos) % lines);
+    }
+    *Tfa = Dev->ScrollFirst;
+    return *Tfa + Dev->ScrollPos;
+}
+
+/// @brief Copy pushed lines into a canvas at their frame memory place
+static void LCD32ScrollCopy(const LCD32Dev_t *Dev, Color_t *Canvas, Dim_t Line, Dim_t Num, const Color_t *Px){
+    if (IsNull(Canvas)) {
+        return;
+    }
+    if (LCD32ScrollAlongRows(Dev)) {
+        memcpy(&Canvas[(int32_t) Line * Dev->Width], Px, sizeof(Color_t) * Num * LCD32_SCROLL_LINE_PX);
+        return;
+    }
+    for (Dim_t k = 0; k < Num; k++) {
+        for (Dim_t y = 0; y < LCD32_SCROLL_LINE_PX; y++) {
+            Canvas[(int32_t) y * Dev->Width + Line + k] = Px[(int32_t) k * LCD32_SCROLL_LINE_PX + y];
+        }
+    }
+}
+
+/// @brief Set up the ILI9341 vertical scrolling area
+DefaultRet_t LCD32SetScrollArea(LCD32Dev_t *Dev, Dim_t First, Dim_t Lines) {
+    LCD32Entry("LCD32SetScrollArea(%p, %d, %d)", Dev, First, Lines);
+    if (IsNull(Dev)) {
+        LCD32ReturnWithLog(STAT_ERR_NULL, "LCD32SetScrollArea() : STAT_ERR_NULL");
+    }
+    if (!((Dev->StatusFlag) & LCD32_INITIALIZED)) {
+        LCD32ReturnWithLog(STAT_ERR_INVALID_STATE, "LCD32SetScrollArea() : STAT_ERR_INVALID_STATE");
+    }
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (IsNotNull(Dev->Strip)) {
+            LCD32Err("[LCD32SetScrollArea] Strip mode redraws every line, no scroll area");
+            LCD32ReturnWithLog(STAT_ERR_UNSUPPORTED, "LCD32SetScrollArea() : STAT_ERR_UNSUPPORTED");
+        }
+    #endif
+    if (Lines == 0) {
+        First = 0;
+    }
+    if ((First < 0) || (Lines < 0) || (First + Lines > LCD32_SCROLL_AXIS_LINES)) {
+        LCD32Err("[LCD32SetScrollArea] Area (%d, %d) outside the %d scroll lines", First, Lines, LCD32_SCROLL_AXIS_LINES);
+        LCD32ReturnWithLog(STAT_ERR_INVALID_ARG, "LCD32SetScrollArea() : STAT_ERR_INVALID_ARG");
+    }
+
+    Dev->ScrollFirst = First;
+    Dev->ScrollLines = Lines;
+    Dev->ScrollPos   = 0;
+
+    /// Scrolling off is one full-height area starting at line 0
+    uint32_t tfa;
+    uint32_t vsp = LCD32ScrollStart(Dev, &tfa);
+    uint32_t vsa = (Lines == 0) ? LCD32_SCROLL_AXIS_LINES : (uint32_t) Lines;
+    P16Data_t params[8];
+    LCD32ParamBe16(&params[0], tfa);
+    LCD32ParamBe16(&params[2], vsa);
+    LCD32ParamBe16(&params[4], LCD32_SCROLL_AXIS_LINES - tfa - vsa);
+    LCD32ParamBe16(&params[6], vsp);
+
+    LCD32TakeBus(Dev);
+    DefaultRet_t ret = P16ComRunCmdList(&(Dev->P16Com), LCD32ScrollDefList, params, 1);
+    LCD32GiveBus(Dev);
+
+    LCD32Log("[LCD32SetScrollArea] Lines %d..%d (TFA %d, VSA %d)", First, First + Lines - 1, tfa, vsa);
+    LCD32ReturnWithLog(ret, "LCD32SetScrollArea() : %s", DefaultReturnType2Str(ret));
+}
+
+/// @brief Append lines at the end of the scroll area, the oldest ones scroll out
+DefaultRet_t LCD32ScrollPush(LCD32Dev_t *Dev, const Color_t *Px, Dim_t Num) {
+    LCD32EntryHot("LCD32ScrollPush(%p, %p, %d)", Dev, Px, Num);
+    if (IsNull(Dev) || IsNull(Px)) {
+        LCD32ReturnWithLogHot(STAT_ERR_NULL, "LCD32ScrollPush() : STAT_ERR_NULL");
+    }
+    if (Dev->ScrollLines == 0) {
+        LCD32ReturnWithLogHot(STAT_ERR_INVALID_STATE, "LCD32ScrollPush() : STAT_ERR_INVALID_STATE");
+    }
+    if (Num <= 0) {
+        LCD32ReturnWithLogHot(STAT_OKE, "LCD32ScrollPush() : STAT_OKE");
+    }
+    /// Lines older than the area would scroll out unseen
+    if (Num > Dev->ScrollLines) {
+        Px += (int32_t) (Num - Dev->ScrollLines) * LCD32_SCROLL_LINE_PX;
+        Num = Dev->ScrollLines;
+    }
+
+    bool alongRows = LCD32ScrollAlongRows(Dev);
+    DefaultRet_t ret;
+    LCD32TakeBus(Dev);
+
+    for (Dim_t j = 0; j < Num; ) {
+        /// The oldest lines are overwritten: after the pointer moves they show at the end
+        Dim_t slot = (Dev->ScrollPos + j) % Dev->ScrollLines;
+        Dim_t line = Dev->ScrollFirst + slot;
+        const Color_t *src = Px + (int32_t) j * LCD32_SCROLL_LINE_PX;
+        Dim_t run = 1;
+        if (alongRows) {
+            /// Consecutive rows up to the wrap are one window
+            run = Num - j;
+            if (run > Dev->ScrollLines - slot) run = Dev->ScrollLines - slot;
+            ret = LCD32SetAddressWindow(Dev, 0, line, LCD32_SCROLL_LINE_PX, run);
+        } else {
+            ret = LCD32SetAddressWindow(Dev, line, 0, 1, LCD32_SCROLL_LINE_PX);
+        }
+        if (ret != STAT_OKE) {
+            LCD32GiveBus(Dev);
+            LCD32ReturnWithLogHot(ret, "LCD32ScrollPush() : %s", DefaultReturnType2Str(ret));
+        }
+        LCD32StartTransaction(Dev);
+        LCD32SetDataTransaction(Dev);
+        P16ComWriteArray(&(Dev->P16Com), (P16Data_t *) src, (P16Size_t) run * LCD32_SCROLL_LINE_PX);
+        LCD32StopTransaction(Dev);
+
+        /// Canvases follow frame memory, so later full flushes send the same lines
+        LCD32ScrollCopy(Dev, Dev->Canvas, line, run, src);
+        #if (LCD32_DOUBLE_BUFFER_EN == 1)
+            LCD32ScrollCopy(Dev, Dev->Held, line, run, src);
         #endif
+        j += run;
+    }
+
+    Dev->ScrollPos = (Dev->ScrollPos + Num) % Dev->ScrollLines;
+    uint32_t tfa;
+    P16Data_t params[2];
+    LCD32ParamBe16(params, LCD32ScrollStart(Dev, &tfa));
+    ret = P16ComRunCmdList(&(Dev->P16Com), LCD32ScrollStartList, params, 1);
+
+    LCD32GiveBus(Dev);
+    LCD32ReturnWithLogHot(ret, "LCD32ScrollPush() : %s", DefaultReturnType2Str(ret));
+}
+
+/// @brief Canvas (frame memory) line shown at screen line `Line` of the scroll axis
+Dim_t LCD32ScrollMap(const LCD32Dev_t *Dev, Dim_t Line) {
+    if (IsNull(Dev) || (Dev->ScrollLines == 0)) {
+        return Line;
+    }
+    Dim_t k = Line - Dev->ScrollFirst;
+    if ((k < 0) || (k >= Dev->ScrollLines)) {
+        return Line;
     }
+    return Dev->ScrollFirst + (k + Dev->ScrollPos) % Dev->ScrollLines;
 }
 
 /* --- DRAWING PRIMITIVES (Ported from Old Code) --- */
@@ -521,6 +1348,12 @@ void LCD32DirectlyWritePixel(LCD32Dev_t *Dev, Dim_t Row, Dim_t Col, Color_t Colo
 DefaultRet_t LCD32DrawLine(LCD32Dev_t *Dev, Dim_t r0, Dim_t c0, Dim_t r1, Dim_t c1, Color_t Color) {
     if (IsNull(Dev)) return STAT_ERR_NULL;
 
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            return LCD32Record(Dev, LCD32_STRIP_OP_LINE, Color, Min(r0, r1), Max(r0, r1), (const int16_t[5]){ r0, c0, r1, c1 }, NULL, 0, NULL);
+        }
+    #endif
+
     int16_t dx = abs(c1 - c0), sx = c0 < c1 ? 1 : -1;
     int16_t dy = -abs(r1 - r0), sy = r0 < r1 ? 1 : -1;
     int16_t err = dx + dy, e2;
@@ -545,6 +1378,14 @@ static void LCD32DrawQuad(LCD32Dev_t *Dev, const LCDPoint_t p[4], Color_t Color)
 
 DefaultRet_t LCD32DrawThickLine(LCD32Dev_t *Dev, Dim_t r0, Dim_t c0, Dim_t r1, Dim_t c1, Color_t Color, Dim_t Thickness) {
     if (IsNull(Dev)) return STAT_ERR_NULL;
+
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            /// Corners sit at most Thickness/2 (rounded) away from the end points
+            return LCD32Record(Dev, LCD32_STRIP_OP_THICK_LINE, Color, Min(r0, r1) - Thickness, Max(r0, r1) + Thickness,
+                               (const int16_t[5]){ r0, c0, r1, c1, Thickness }, NULL, 0, NULL);
+        }
+    #endif
     if (Thickness <= 1) return LCD32DrawLine(Dev, r0, c0, r1, c1, Color);
 
     // Advanced implementation using polygon rendering for sharp corners and flat ends
@@ -575,7 +1416,15 @@ DefaultRet_t LCD32DrawThickLine(LCD32Dev_t *Dev, Dim_t r0, Dim_t c0, Dim_t r1, D
 /// @brief Helper to draw a filled rectangle on the canvas
 static void LCD32DrawFilledRect(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w, Color_t Color) {
     if (IsNull(Dev)) return;
-    for (Dim_t i = r; i < r + h; i++) {
+    Dim_t rEnd = r + h;
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        /// Replaying: rows outside the band would be dropped anyway
+        if (IsNotNull(Dev->Strip)) {
+            r = Max(r, Dev->Strip->Y0);
+            rEnd = Min(rEnd, Dev->Strip->Y1);
+        }
+    #endif
+    for (Dim_t i = r; i < rEnd; i++) {
         for (Dim_t j = c; j < c + w; j++) {
             LCD32SetCanvasPixel(Dev, i, j, Color);
         }
@@ -586,6 +1435,14 @@ DefaultRet_t LCD32DrawEmptyRect(LCD32Dev_t *Dev, Dim_t rTopLeft, Dim_t cTopLeft,
     if (IsNull(Dev)) return STAT_ERR_NULL;
     if (EdgeSize < 1) return STAT_OKE;
 
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            return LCD32Record(Dev, LCD32_STRIP_OP_EMPTY_RECT, Color,
+                               Min(rTopLeft, rBottomRight - EdgeSize + 1), Max(rBottomRight, rTopLeft + EdgeSize - 1),
+                               (const int16_t[5]){ rTopLeft, cTopLeft, rBottomRight, cBottomRight, EdgeSize }, NULL, 0, NULL);
+        }
+    #endif
+
     Dim_t width = cBottomRight - cTopLeft + 1;
     Dim_t height = rBottomRight - rTopLeft + 1;
 
@@ -601,6 +1458,19 @@ DefaultRet_t LCD32DrawEmptyRect(LCD32Dev_t *Dev, Dim_t rTopLeft, Dim_t cTopLeft,
 DefaultRet_t LCD32DrawPolygon(LCD32Dev_t *Dev, const LCDPoint_t *Points, size_t N, Color_t Color) {
     if (IsNull(Dev) || IsNull(Points) || N < 2) return STAT_ERR_INVALID_ARG;
 
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            if (N * sizeof(LCDPoint_t) > LCD32_STRIP_DATA_MAX) return STAT_ERR_INVALID_SIZE;
+            int32_t top = Points[0].row, bottom = Points[0].row;
+            for (size_t i = 1; i < N; i++) {
+                top = Min(top, Points[i].row);
+                bottom = Max(bottom, Points[i].row);
+            }
+            return LCD32Record(Dev, LCD32_STRIP_OP_POLYGON, Color, top, bottom, (const int16_t[5]){ 0 },
+                               Points, (uint16_t)(N * sizeof(LCDPoint_t)), NULL);
+        }
+    #endif
+
     for (size_t i = 0; i < N - 1; i++) {
         LCD32DrawLine(Dev, Points[i].row, Points[i].col, Points[i+1].row, Points[i+1].col, Color);
     }
@@ -617,6 +1487,19 @@ static int compare_int32(const void *a, const void *b) {
 DefaultRet_t LCD32DrawFilledPolygon(LCD32Dev_t *Dev, const LCDPoint_t *Points, size_t N, Color_t Color) {
     if (IsNull(Dev) || IsNull(Points) || N < 3) return STAT_ERR_INVALID_ARG;
 
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            if (N * sizeof(LCDPoint_t) > LCD32_STRIP_DATA_MAX) return STAT_ERR_INVALID_SIZE;
+            int32_t top = Points[0].row, bottom = Points[0].row;
+            for (size_t i = 1; i < N; i++) {
+                top = Min(top, Points[i].row);
+                bottom = Max(bottom, Points[i].row);
+            }
+            return LCD32Record(Dev, LCD32_STRIP_OP_FILLED_POLYGON, Color, top, bottom, (const int16_t[5]){ 0 },
+                               Points, (uint16_t)(N * sizeof(LCDPoint_t)), NULL);
+        }
+    #endif
+
     Dim_t minRow = Points[0].row, maxRow = Points[0].row;
     for (size_t i = 1; i < N; i++) {
         if (Points[i].row < minRow) minRow = Points[i].row;
@@ -624,6 +1507,13 @@ DefaultRet_t LCD32DrawFilledPolygon(LCD32Dev_t *Dev, const LCDPoint_t *Points, s
     }
     if (minRow < 0) minRow = 0;
     if (maxRow >= Dev->Height) maxRow = Dev->Height - 1;
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        /// Replaying: rows outside the band would be dropped anyway
+        if (IsNotNull(Dev->Strip)) {
+            if (minRow < Dev->Strip->Y0) minRow = Dev->Strip->Y0;
+            if (maxRow >= Dev->Strip->Y1) maxRow = Dev->Strip->Y1 - 1;
+        }
+    #endif
 
     int32_t interX[128]; // Max 128 intersections
 
@@ -669,6 +1559,14 @@ DefaultRet_t LCD32DrawChar(LCD32Dev_t *Dev, Dim_t r, Dim_t c, char Ch, const GFX
     if (IsNull(Dev) || IsNull(Font)) return STAT_ERR_NULL;
     if (Ch < Font->first || Ch > Font->last) return STAT_ERR_INVALID_ARG;
 
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            const GFXglyph *g = &Font->glyph[Ch - Font->first];
+            return LCD32Record(Dev, LCD32_STRIP_OP_CHAR, Color, r + g->yOffset, r + g->yOffset + g->height - 1,
+                               (const int16_t[5]){ r, c, Ch }, NULL, 0, Font);
+        }
+    #endif
+
     GFXglyph *glyph = &Font->glyph[Ch - Font->first];
     uint8_t *bitmap = Font->bitmap;
 
@@ -697,6 +1595,16 @@ DefaultRet_t LCD32DrawChar(LCD32Dev_t *Dev, Dim_t r, Dim_t c, char Ch, const GFX
 DefaultRet_t LCD32DrawText(LCD32Dev_t *Dev, Dim_t r, Dim_t c, const char *Str, const GFXfont *Font, Color_t Color) {
     if (IsNull(Dev) || IsNull(Str) || IsNull(Font)) return STAT_ERR_NULL;
 
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        if (LCD32IsRecording(Dev)) {
+            int32_t top, bottom;
+            size_t len = strlen(Str) + 1;
+            if (len > LCD32_STRIP_DATA_MAX) return STAT_ERR_INVALID_SIZE;
+            LCD32TextRows(Dev, r, c, Str, Font, &top, &bottom);
+            return LCD32Record(Dev, LCD32_STRIP_OP_TEXT, Color, top, bottom, (const int16_t[5]){ r, c }, Str, (uint16_t) len, Font);
+        }
+    #endif
+
     Dim_t cursor_r = r, cursor_c = c;
     while (*Str) {
         char ch = *Str++;
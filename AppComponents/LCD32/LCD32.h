@@ -18,6 +18,8 @@ extern "C" {
 #include "../../AppFonts/All.h"
 
 #include "../P16Com/P16Com.h"
+#include "../P16Com/P16ComDma.h"
+#include "../P16Com/P16ComDedic.h"
 
 /// @brief Point structure for polygon drawing
 typedef struct {
@@ -28,21 +30,35 @@ typedef struct {
 #define LCD32_LOG_SECTION
 #define LCD32_UTILS_SECTION
 
-#define LCD32_THREAD_SAFE_EN        1
+/// @brief Double-buffered canvas flushed by a task on CPU1 (see LCD32StartFlushTask())
+/// @details Replaces the bus mutex: canvases move between the drawing task and the flush
+///          task through queues, and the bus belongs to whoever holds the frame being sent.
+///          All LCD32 calls must come from one drawing task.
+#define LCD32_DOUBLE_BUFFER_EN      1
+
+/// @brief Flush task priority
+#define LCD32_FLUSH_TASK_PRIO       3
+/// @brief Flush task stack size (bytes)
+#define LCD32_FLUSH_TASK_STACK      3072
 
 /// @brief Use PSRAM to store the canvas (buffer)
 #define LCD32_CANVAS_IN_PSRAM_EN    1
 
-/// @brief Enable standard logging for this module
-#define LCD32_LOG_EN                1
-/// @brief Enable verbose/detailed logging
-#define LCD32_LOG1_EN               1
-/// @brief Enable error logging
-#define LCD32_ERR_EN                1
-/// @brief Enable function entry tracing
-#define LCD32_LOG_ENTRY             1
-/// @brief Enable function exit tracing
-#define LCD32_LOG_EXIT              1
+/// @brief Strip renderer: primitives go to a display list, rasterized band by band in
+///        internal RAM at flush time (see LCD32SetRenderMode())
+#define LCD32_STRIP_RENDER_EN       1
+
+/// @brief Render Mode Options
+#define LCD32_RENDER_CANVAS         0 ///< Full-screen canvas (PSRAM), drawn immediately
+#define LCD32_RENDER_STRIP          1 ///< Display list + band buffers, no canvas
+
+/// @brief Render mode set up by LCD32New()
+#define LCD32_DEFAULT_RENDER_MODE   LCD32_RENDER_CANVAS
+
+#ifndef LCD32_LOG_LEVEL
+    /// @brief Log level of this module (SYS_LOG_LEVEL_*, set in AppConfig/SystemLog.h)
+    #define LCD32_LOG_LEVEL           SYS_LOG_LEVEL_INFO
+#endif
 
 /// @brief  Dimension type for LCD
 typedef int16_t                     Dim_t;
@@ -59,12 +75,23 @@ typedef uint16_t                    Color_t;
 #define LCD32_NATIVE_H              320
 
 #define LCD32_DEFAULT_ORIENTATION   LCD32_ORIENTATION_LANDSCAPE
+
+/// @brief Hardware scrolling runs along the panel's 320-line axis: screen rows in portrait,
+///        screen columns in landscape. A line is LCD32_SCROLL_LINE_PX pixels across it.
+#define LCD32_SCROLL_AXIS_LINES     LCD32_NATIVE_H
+#define LCD32_SCROLL_LINE_PX        LCD32_NATIVE_W
 #define LCD32_DEFAULT_COLOR_BIT     sizeof(Color_t)
 
 /// Predefined colors
 #include "LCD32Colors.h"
 /// Datasheet commands
 #include "LCD32Cmds.h"
+/// Dirty-tile tracking for partial flushes
+#include "LCD32Dirty.h"
+/// Display list for the strip renderer
+#include "LCD32Strip.h"
+/// Readback unpacking and QOI encoding for screenshots
+#include "LCD32Shot.h"
 
 /// @brief Status flags for the driver
 enum LCD320x240PositiveStatusFlag_e {
@@ -110,9 +137,20 @@ typedef struct LCD32Dev_t{
     Dim_t Width;        ///< Current display width
     Dim_t Height;       ///< Current display height
     Dim_t Orientation;  ///< Current orientation (0-3)
+    Dim_t ScrollFirst;  ///< First screen line of the hardware scroll area
+    Dim_t ScrollLines;  ///< Lines in the scroll area (0: scrolling off)
+    Dim_t ScrollPos;    ///< Lines pushed so far, modulo ScrollLines
     Color_t *Canvas;    ///< Frame buffer pointer (if used)
-    #if (LCD32_THREAD_SAFE_EN == 1)
-        SemaphoreHandle_t mutex; ///< Mutex for thread safety
+    LCD32DirtyMap_t Dirty; ///< Canvas tiles changed since the last flush
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        Color_t *Frames[2];         ///< Both canvases; `Canvas` points at the one being drawn
+        QueueHandle_t FreeQ;        ///< Canvases handed back by the flush task
+        QueueHandle_t ReadyQ;       ///< Finished frames waiting for the flush task
+        TaskHandle_t FlushTask;     ///< Flush task on CPU1 (NULL: single buffer)
+        Color_t *Held;              ///< Spare canvas held while a direct call owns the bus
+    #endif
+    #if (LCD32_STRIP_RENDER_EN == 1)
+        LCD32Strip_t *Strip;        ///< Strip renderer state (NULL: canvas mode)
     #endif
 } LCD32Dev_t;
 
@@ -150,12 +188,89 @@ DefaultRet_t        LCD32ReConfig(LCD32Dev_t * Dev);
 /// @param y (Dim_t) The starting row (y-coordinate)
 /// @param w (Dim_t) The width of the window
 /// @param h (Dim_t) The height of the window
-void                LCD32SetAddressWindow(LCD32Dev_t * Dev, Dim_t x, Dim_t y, Dim_t w, Dim_t h);
+/// @return STAT_OKE, or the P16ComRunCmdList() error (logged)
+DefaultRet_t        LCD32SetAddressWindow(LCD32Dev_t * Dev, Dim_t x, Dim_t y, Dim_t w, Dim_t h);
 
 /// @brief Flush the internal Canvas buffer to the display
 /// @param Dev (LCD32Dev_t *) Pointer to the device object
 void                LCD32FlushCanvas(LCD32Dev_t *Dev);
 
+/// @brief Start flushing the Canvas and return immediately
+/// @details With the i80 DMA backend the frame is streamed by LCD_CAM while the caller
+///          keeps running; CS is released by the end-of-transfer interrupt. Drawing into
+///          the Canvas before LCD32WaitFlush() returns may tear the frame.
+///          With the bit-bang backend this is the same as LCD32FlushCanvas().
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32FlushCanvasAsync(LCD32Dev_t *Dev);
+
+/// @brief Wait for a flush started by LCD32FlushCanvasAsync() to finish
+/// @details Any task may wait, also while the flush task is waiting on the same transfer.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @return STAT_OKE or STAT_ERR_TIMEOUT
+DefaultRet_t        LCD32WaitFlush(LCD32Dev_t *Dev);
+
+/// @brief Flush only the Canvas tiles changed since the last flush
+/// @details Every canvas primitive marks the tiles it touches; each dirty region gets its
+///          own address window. Code writing `Dev->Canvas` directly must call
+///          LCD32MarkDirty() itself.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32FlushDirty(LCD32Dev_t *Dev);
+
+/// @brief Mark a canvas rectangle as changed (for code writing `Dev->Canvas` directly)
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param r (Dim_t) The top row of the rectangle
+/// @param c (Dim_t) The left column of the rectangle
+/// @param h (Dim_t) The height of the rectangle
+/// @param w (Dim_t) The width of the rectangle
+void                LCD32MarkDirty(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w);
+
+#if (LCD32_DOUBLE_BUFFER_EN == 1)
+
+/// @brief Allocate the second canvas and start the flush task on CPU1
+/// @details From then on, LCD32SwapBuffers() queues frames for the task. Direct calls
+///          (flushes, LCD32DirectlyWritePixel, ...) wait until the task is idle.
+/// @param Dev (LCD32Dev_t *) Pointer to an initialized device object
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32StartFlushTask(LCD32Dev_t *Dev);
+
+/// @brief Stop the flush task once the frames already queued have been sent
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+void                LCD32StopFlushTask(LCD32Dev_t *Dev);
+
+/// @brief Hand the finished Canvas to the flush task and continue on a free one
+/// @details Returns as soon as a canvas is free, so drawing frame N+1 overlaps sending
+///          frame N. The returned canvas holds an older frame, not the one just handed over.
+///          Without a running flush task the Canvas is flushed in place.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @return The new `Dev->Canvas`
+Color_t *           LCD32SwapBuffers(LCD32Dev_t *Dev);
+
+#endif /// (LCD32_DOUBLE_BUFFER_EN == 1)
+
+#if (LCD32_STRIP_RENDER_EN == 1)
+
+/// @brief Switch between the full-screen canvas and the strip renderer
+/// @details In strip mode the canvas is freed (`Dev->Canvas` is NULL) and the primitives,
+///          LCD32SetCanvasPixel() and LCD32FillCanvas() are recorded into a display list.
+///          The flush calls (LCD32FlushCanvas(), LCD32FlushDirty(), LCD32SwapBuffers(), ...)
+///          then redraw the whole screen with LCD32FlushStrips(). Switching back allocates a
+///          black canvas: the recorded picture is lost. The flush task must be stopped first.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param Mode (uint32_t) LCD32_RENDER_CANVAS or LCD32_RENDER_STRIP
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32SetRenderMode(LCD32Dev_t *Dev, uint32_t Mode);
+
+/// @brief Rasterize the display list LCD32_STRIP_ROWS rows at a time and send each band
+/// @details Two band buffers in internal DMA-capable RAM: with the i80 DMA backend the
+///          next band is rasterized while the previous one is on the bus.
+/// @param Dev (LCD32Dev_t *) Pointer to a device object in strip mode
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32FlushStrips(LCD32Dev_t *Dev);
+
+#endif /// (LCD32_STRIP_RENDER_EN == 1)
+
 /// @brief Fill the entire canvas with a single color
 /// @param Dev (LCD32Dev_t *) Pointer to the device object
 /// @param Color (Color_t) The color to fill the canvas with
@@ -175,6 +290,82 @@ void                LCD32SetCanvasPixel(LCD32Dev_t *Dev, Dim_t Row, Dim_t Col, C
 /// @param Color (Color_t) The color of the pixel
 void                LCD32DirectlyWritePixel(LCD32Dev_t *Dev, Dim_t Row, Dim_t Col, Color_t Color);
 
+/// @brief Fill a rectangle directly on the LCD with a single color (bypassing canvas)
+/// @details Streams one repeated word, so the cost is one WR strobe per pixel. The canvas
+///          is not updated: a later flush overwrites the area.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param r (Dim_t) The top row of the rectangle
+/// @param c (Dim_t) The left column of the rectangle
+/// @param h (Dim_t) The height of the rectangle
+/// @param w (Dim_t) The width of the rectangle
+/// @param Color (Color_t) The fill color
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32FillRectDirect(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w, Color_t Color);
+
+/// @brief Read a rectangle back from the panel's frame memory (ILI9341 MEMORY_READ)
+/// @details Streams the window with the burst read path and unpacks the 18-bit readback to
+///          RGB565 through a small stack buffer, so `Out` is the only buffer needed. Shows what
+///          is on the glass, whatever wrote it (canvas flushes, direct calls, strip bands).
+///          Frame memory reads want a slower RD strobe than register reads (ILI9341: RD low
+///          >= 355 ns); raise P16ClockCycle if the pixels come back wrong.
+///          Coordinates are canvas (frame memory) coordinates: see LCD32ScrollMap().
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param r (Dim_t) The top row of the rectangle
+/// @param c (Dim_t) The left column of the rectangle
+/// @param h (Dim_t) The height of the rectangle
+/// @param w (Dim_t) The width of the rectangle
+/// @param Out (Color_t *) Destination, h * w pixels in row order
+/// @return STAT_OKE or Error Code (the rectangle must lie inside the screen)
+DefaultRet_t        LCD32ReadRect(LCD32Dev_t *Dev, Dim_t r, Dim_t c, Dim_t h, Dim_t w, Color_t *Out);
+
+/// @brief Capture the screen as a QOI image streamed to `Sink`
+/// @details Reads the frame memory LCD32_SHOT_ROWS rows at a time into a small internal
+///          buffer and encodes each band as it arrives (no second frame buffer). The bus is
+///          held for the whole capture, so the image is one frame even with the flush task
+///          running; a slow sink delays the display for as long.
+///          A moved scroll area is read back in glass order.
+/// @param Dev (LCD32Dev_t *) Pointer to an initialized device object
+/// @param Sink (LCD32ShotSink_t) Receives the encoded bytes in order
+/// @param Ctx (void *) Passed to `Sink`
+/// @return STAT_OKE, STAT_ERR_IO when the sink refused data, or Error Code
+DefaultRet_t        LCD32Screenshot(LCD32Dev_t *Dev, LCD32ShotSink_t Sink, void *Ctx);
+
+/* --- HARDWARE SCROLLING --- */
+
+/// @brief Set up the ILI9341 vertical scrolling area (VSCRDEF + VSCRSADD)
+/// @details Lines [First, First + Lines) of the scroll axis (rows in portrait, columns in
+///          landscape) roll; the lines before and after stay fixed. LCD32ScrollPush() then
+///          writes only the new lines and moves the panel's scroll pointer, so a roll display
+///          costs one line per update instead of a full frame.
+///          The canvas keeps frame memory order: inside the scroll area, screen line `s` shows
+///          canvas line LCD32ScrollMap(Dev, s). Full and dirty flushes stay valid, but drawing
+///          at a screen position in the area must go through LCD32ScrollMap(). Setting an area
+///          (or turning it off with `Lines` 0) rewinds it: the glass shows the canvas as is.
+///          Not available in strip mode.
+/// @param Dev (LCD32Dev_t *) Pointer to an initialized device object
+/// @param First (Dim_t) First line of the scroll area
+/// @param Lines (Dim_t) Lines in the scroll area, 0 to turn scrolling off
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32SetScrollArea(LCD32Dev_t *Dev, Dim_t First, Dim_t Lines);
+
+/// @brief Append lines at the end of the scroll area, the oldest ones scroll out
+/// @details The new lines overwrite the oldest ones in frame memory (and in the canvas,
+///          both canvases when double-buffered), then one VSCRSADD moves them to the end.
+///          In portrait consecutive lines go out as one window; in landscape each line is a
+///          1-pixel-wide window. Only the last ScrollLines lines are sent when more are given.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object, scroll area set
+/// @param Px (const Color_t *) `Num` lines of LCD32_SCROLL_LINE_PX pixels, oldest first; a line
+///           runs left to right in portrait, top to bottom in landscape
+/// @param Num (Dim_t) Number of lines
+/// @return STAT_OKE or Error Code
+DefaultRet_t        LCD32ScrollPush(LCD32Dev_t *Dev, const Color_t *Px, Dim_t Num);
+
+/// @brief Canvas (frame memory) line shown at screen line `Line` of the scroll axis
+/// @param Dev (const LCD32Dev_t *) Pointer to the device object
+/// @param Line (Dim_t) Screen row in portrait, screen column in landscape
+/// @return The canvas line; `Line` itself outside the scroll area or with scrolling off
+Dim_t               LCD32ScrollMap(const LCD32Dev_t *Dev, Dim_t Line);
+
 /* --- DRAWING PRIMITIVES --- */
 
 /// @brief Draw a line using Bresenham's algorithm
@@ -254,44 +445,54 @@ void                LCD32WriteData(LCD32Dev_t * Dev, uint16_t Data);
 
 #ifdef LCD32_LOG_SECTION
 
-    #if (LCD32_LOG_EN == 1)
+    #if SysLogLevelOn(LCD32_LOG_LEVEL, SYS_LOG_LEVEL_ERR)
+        /// @brief Log error message
+        #define LCD32Err(...)                   SysErr(__VA_ARGS__)
+    #else
+        #define LCD32Err(...)
+    #endif
+
+    #if SysLogLevelOn(LCD32_LOG_LEVEL, SYS_LOG_LEVEL_INFO)
         /// @brief Log standard info message
-        #define LCD32Log(...)                 SysLog(__VA_ARGS__)
-    #else 
+        #define LCD32Log(...)                   SysLog(__VA_ARGS__)
+
+        /// @brief Log standard info message, at most once per SYSTEM_LOG_HOT_MS from this line
+        #define LCD32LogHot(...)                SysRateMs(SYSTEM_LOG_HOT_MS, SysLog, __VA_ARGS__)
+    #else
         #define LCD32Log(...)
-    #endif 
+        #define LCD32LogHot(...)
+    #endif
 
-    #if (LCD32_ERR_EN == 1)
-        /// @brief Log error message
-        #define LCD32Err(...)                 SysErr(__VA_ARGS__)
+    #if SysLogLevelOn(LCD32_LOG_LEVEL, SYS_LOG_LEVEL_VERB)
+        /// @brief Log verbose/detailed message
+        #define LCD32Log1(...)                  SysLogVer(__VA_ARGS__)
     #else
-        #define LCD32Err(...)
-    #endif 
+        #define LCD32Log1(...)
+    #endif
+
+    #if SysLogLevelOn(LCD32_LOG_LEVEL, SYS_LOG_LEVEL_TRACE)
+        /// @brief Log function entry
+        #define LCD32Entry(...)                 SysEntry(__VA_ARGS__)
 
-    #if (LCD32_LOG_EXIT == 1)
         /// @brief Log function exit
-        #define LCD32Exit(...)                SysExit(__VA_ARGS__)
-        
+        #define LCD32Exit(...)                  SysExit(__VA_ARGS__)
+
         /// @brief Log function exit and return a value
-        #define LCD32ReturnWithLog(ret, ...)  SysExit(__VA_ARGS__); return ret;
-    #else
-        #define LCD32Exit(...)
-        #define LCD32ReturnWithLog(ret, ...)  return ret;
-    #endif 
+        #define LCD32ReturnWithLog(ret, ...)    SysExit(__VA_ARGS__); return ret;
 
-    #if (LCD32_LOG_ENTRY == 1)
-        /// @brief Log function entry
-        #define LCD32Entry(...)               SysEntry(__VA_ARGS__)
-    #else 
+        /// @brief Entry / exit of functions called per frame or per transfer: at most one line
+        ///        per SYSTEM_LOG_HOT_MS from each call site, with the count of calls skipped
+        #define LCD32EntryHot(...)              SysRateMs(SYSTEM_LOG_HOT_MS, SysEntry, __VA_ARGS__)
+        #define LCD32ExitHot(...)               SysRateMs(SYSTEM_LOG_HOT_MS, SysExit, __VA_ARGS__)
+        #define LCD32ReturnWithLogHot(ret, ...) SysRateMs(SYSTEM_LOG_HOT_MS, SysExit, __VA_ARGS__); return ret;
+    #else
         #define LCD32Entry(...)
-    #endif 
-
-    #if (LCD32_LOG1_EN == 1)
-        /// @brief Log verbose/detailed message
-        #define LCD32Log1(...)                SysLogVer(__VA_ARGS__)
-    #else 
-        #define LCD32Log1(...)
-    #endif 
+        #define LCD32Exit(...)
+        #define LCD32ReturnWithLog(ret, ...)    return ret;
+        #define LCD32EntryHot(...)
+        #define LCD32ExitHot(...)
+        #define LCD32ReturnWithLogHot(ret, ...) return ret;
+    #endif
 
 #endif /// LCD32_LOG_SECTION
 
@@ -306,9 +507,20 @@ void                LCD32WriteData(LCD32Dev_t * Dev, uint16_t Data);
     /// @brief Macros for Transaction Management
     #define LCD32SetDataTransaction(dev)            P16SetHighRegSelPin((&(dev->P16Com)))
     #define LCD32SetCommandTransaction(dev)         P16SetLowRegSelPin((&(dev->P16Com)))
-    #define LCD32StartTransaction(dev)              P16SetLowChipSelPin((&(dev->P16Com)))
+    /// @note Waits for an asynchronous flush first: it owns CS until its last word is out
+    #define LCD32StartTransaction(dev)              do { \
+                                                        P16ComWaitIdle(&((dev)->P16Com)); \
+                                                        P16SetLowChipSelPin((&(dev->P16Com))); \
+                                                    } while(0)
     #define LCD32StopTransaction(dev)               P16SetHighChipSelPin((&(dev->P16Com)))
 
+    /// @brief The scroll axis is the screen rows (portrait) rather than the columns
+    #define LCD32ScrollAlongRows(dev)               (((dev)->Orientation == LCD32_ORIENTATION_PORTRAIT) || \
+                                                     ((dev)->Orientation == LCD32_ORIENTATION_PORTRAIT_FLIP))
+    /// @brief MADCTL_MY set: screen lines run against the panel's gate order
+    #define LCD32ScrollReversed(dev)                (((dev)->Orientation == LCD32_ORIENTATION_PORTRAIT_FLIP) || \
+                                                     ((dev)->Orientation == LCD32_ORIENTATION_LANDSCAPE_FLIP))
+
 #endif /// LCD32_UTILS_SECTION
 
 #ifdef __cplusplus
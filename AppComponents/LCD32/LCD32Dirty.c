@@ -0,0 +1,127 @@
+/**
+ * @file LCD32Dirty.c
+ * @brief Dirty-tile tracking for the LCD32 canvas
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "LCD32Dirty.h"
+
+/// @brief Number of tiles covering `px` pixels
+#define LCD32DirtyTiles(px)         ((uint32_t)((px) + LCD32_DIRTY_TILE - 1) >> LCD32_DIRTY_TILE_SHIFT)
+
+/// @brief Bits [first, last] set
+#define LCD32DirtyBits(first, last) ((((last) - (first) + 1) >= 32) ? 0xFFFFFFFFUL : (((1UL << ((last) - (first) + 1)) - 1) << (first)))
+
+/// @brief Clear the map and set the screen size it covers
+void LCD32DirtyReset(LCD32DirtyMap_t * Map, int16_t Width, int16_t Height){
+    if(Map == NULL){
+        return;
+    }
+    Map->Width  = Width;
+    Map->Height = Height;
+    LCD32DirtyClear(Map);
+}
+
+/// @brief Forget every dirty tile (after a flush)
+void LCD32DirtyClear(LCD32DirtyMap_t * Map){
+    if(Map == NULL){
+        return;
+    }
+    memset(Map->Rows, 0, sizeof(Map->Rows));
+}
+
+/// @brief Mark the whole screen dirty
+void LCD32DirtyMarkAll(LCD32DirtyMap_t * Map){
+    if((Map == NULL) || (Map->Width <= 0) || (Map->Height <= 0)){
+        return;
+    }
+    uint32_t mask = LCD32DirtyBits(0, LCD32DirtyTiles(Map->Width) - 1);
+    for(uint32_t t = 0; t < LCD32DirtyTiles(Map->Height); t++){
+        Map->Rows[t] = mask;
+    }
+}
+
+/// @brief Mark the tiles covered by a rectangle (clipped to the screen)
+void LCD32DirtyMarkRect(LCD32DirtyMap_t * Map, int16_t r, int16_t c, int16_t h, int16_t w){
+    if(Map == NULL){
+        return;
+    }
+
+    /// Clip to the screen (32-bit math: r + h may not fit an int16_t)
+    int32_t r0 = r, c0 = c, r1 = (int32_t) r + h, c1 = (int32_t) c + w;
+    if(r0 < 0) r0 = 0;
+    if(c0 < 0) c0 = 0;
+    if(r1 > Map->Height) r1 = Map->Height;
+    if(c1 > Map->Width)  c1 = Map->Width;
+    if((r0 >= r1) || (c0 >= c1)){
+        return;
+    }
+
+    uint32_t mask = LCD32DirtyBits((uint32_t) c0 >> LCD32_DIRTY_TILE_SHIFT, (uint32_t)(c1 - 1) >> LCD32_DIRTY_TILE_SHIFT);
+    for(uint32_t t = (uint32_t) r0 >> LCD32_DIRTY_TILE_SHIFT; t <= ((uint32_t)(r1 - 1) >> LCD32_DIRTY_TILE_SHIFT); t++){
+        Map->Rows[t] |= mask;
+    }
+}
+
+/// @brief Fetch the next region to flush
+/// @details `Cursor` = tile row * 32 + first column still to visit. It always points into
+///          the first tile row of a band (rows sharing one mask), so bands are never split.
+int32_t LCD32DirtyNextRegion(const LCD32DirtyMap_t * Map, uint32_t * Cursor, LCD32DirtyRect_t * Out){
+    if((Map == NULL) || (Cursor == NULL) || (Out == NULL)){
+        return 0;
+    }
+
+    uint32_t tileRows = LCD32DirtyTiles(Map->Height);
+    uint32_t tr  = *Cursor >> 5;
+    uint32_t bit = *Cursor & 0x1F;
+
+    while(tr < tileRows){
+        uint32_t mask = Map->Rows[tr];
+
+        /// Stretch the band over the following rows carrying the same mask
+        uint32_t trEnd = tr + 1;
+        while((trEnd < tileRows) && (Map->Rows[trEnd] == mask)){
+            trEnd++;
+        }
+
+        uint32_t left = mask & ~((1UL << bit) - 1);
+        if(left){
+            uint32_t c0 = __builtin_ctz(left);
+            uint32_t c1 = c0;
+            while((c1 < 32) && ((mask >> c1) & 0x1)){
+                c1++;
+            }
+
+            int32_t xEnd = (int32_t)(c1 << LCD32_DIRTY_TILE_SHIFT);
+            int32_t yEnd = (int32_t)(trEnd << LCD32_DIRTY_TILE_SHIFT);
+            Out->x = (int16_t)(c0 << LCD32_DIRTY_TILE_SHIFT);
+            Out->y = (int16_t)(tr << LCD32_DIRTY_TILE_SHIFT);
+            Out->w = (int16_t)(((xEnd > Map->Width)  ? Map->Width  : xEnd) - Out->x);
+            Out->h = (int16_t)(((yEnd > Map->Height) ? Map->Height : yEnd) - Out->y);
+
+            /// Resume after this run, or at the next band once the mask is used up
+            uint32_t rest = (c1 < 32) ? (mask >> c1) : 0;
+            *Cursor = rest ? ((tr << 5) + c1) : (trEnd << 5);
+            return 1;
+        }
+
+        tr  = trEnd;
+        bit = 0;
+    }
+
+    *Cursor = tileRows << 5;
+    return 0;
+}
+
+/// @brief Number of pixels LCD32DirtyNextRegion() would hand out (words on the bus)
+uint32_t LCD32DirtyPixelCount(const LCD32DirtyMap_t * Map){
+    uint32_t cursor = 0;
+    uint32_t total = 0;
+    LCD32DirtyRect_t rect;
+    while(LCD32DirtyNextRegion(Map, &cursor, &rect)){
+        total += (uint32_t) rect.w * (uint32_t) rect.h;
+    }
+    return total;
+}
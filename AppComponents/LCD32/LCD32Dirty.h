@@ -0,0 +1,90 @@
+/**
+ * @file LCD32Dirty.h
+ * @brief Dirty-tile tracking for the LCD32 canvas
+ * @details The screen is cut into square tiles; one bit per tile records whether the
+ *          canvas changed there since the last flush. Regions are handed out as
+ *          rectangles: each run of dirty tiles in a tile row, stretched down over the
+ *          following tile rows that carry exactly the same mask. Hardware independent,
+ *          so the region logic builds on a Linux host (see LCD32DirtyPixelCount()).
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __LCD32_DIRTY_H__
+#define __LCD32_DIRTY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppComponents/LCD32/LCD32Dirty.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/// @brief Tile edge = 1 << LCD32_DIRTY_TILE_SHIFT pixels (16)
+#define LCD32_DIRTY_TILE_SHIFT      4
+#define LCD32_DIRTY_TILE            (1 << LCD32_DIRTY_TILE_SHIFT)
+
+/// @brief Tile rows/columns needed for the longest screen edge (320 px -> 20)
+/// @note  Columns are stored as bits of a uint32_t, so at most 32 tiles per row.
+#define LCD32_DIRTY_TILES_MAX       ((320 + LCD32_DIRTY_TILE - 1) >> LCD32_DIRTY_TILE_SHIFT)
+
+/// @brief Dirty tile bitmap
+typedef struct LCD32DirtyMap_s {
+    uint32_t Rows[LCD32_DIRTY_TILES_MAX];   ///< Bit n of Rows[t]: tile (row t, column n) is dirty
+    int16_t  Width;                         ///< Screen width in pixels
+    int16_t  Height;                        ///< Screen height in pixels
+} LCD32DirtyMap_t;
+
+/// @brief One region to flush, in pixels
+typedef struct LCD32DirtyRect_s {
+    int16_t x;  ///< Left column
+    int16_t y;  ///< Top row
+    int16_t w;  ///< Width
+    int16_t h;  ///< Height
+} LCD32DirtyRect_t;
+
+/// @brief Mark the tile under an in-bounds pixel (no clipping, caller checks bounds)
+#define LCD32DirtyMarkPixel(map, row, col)  ((map)->Rows[(row) >> LCD32_DIRTY_TILE_SHIFT] |= (1UL << ((col) >> LCD32_DIRTY_TILE_SHIFT)))
+
+/// @brief Clear the map and set the screen size it covers
+/// @param Map Pointer to the map
+/// @param Width Screen width in pixels
+/// @param Height Screen height in pixels
+void                LCD32DirtyReset(LCD32DirtyMap_t * Map, int16_t Width, int16_t Height);
+
+/// @brief Forget every dirty tile (after a flush)
+/// @param Map Pointer to the map
+void                LCD32DirtyClear(LCD32DirtyMap_t * Map);
+
+/// @brief Mark the whole screen dirty
+/// @param Map Pointer to the map
+void                LCD32DirtyMarkAll(LCD32DirtyMap_t * Map);
+
+/// @brief Mark the tiles covered by a rectangle (clipped to the screen)
+/// @param Map Pointer to the map
+/// @param r Top row
+/// @param c Left column
+/// @param h Height
+/// @param w Width
+void                LCD32DirtyMarkRect(LCD32DirtyMap_t * Map, int16_t r, int16_t c, int16_t h, int16_t w);
+
+/// @brief Fetch the next region to flush
+/// @param Map Pointer to the map
+/// @param Cursor Iteration state, set to 0 before the first call
+/// @param Out Region in pixels, clipped to the screen
+/// @return 1 if `Out` holds a region, 0 when the map is exhausted
+int32_t             LCD32DirtyNextRegion(const LCD32DirtyMap_t * Map, uint32_t * Cursor, LCD32DirtyRect_t * Out);
+
+/// @brief Number of pixels LCD32DirtyNextRegion() would hand out (words on the bus)
+/// @param Map Pointer to the map
+/// @return Pixel count
+uint32_t            LCD32DirtyPixelCount(const LCD32DirtyMap_t * Map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __LCD32_DIRTY_H__
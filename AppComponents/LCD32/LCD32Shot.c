@@ -0,0 +1,199 @@
+/**
+ * @file LCD32Shot.c
+ * @brief Screenshot encoding for the LCD32 driver
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "LCD32Shot.h"
+
+/// @brief QOI chunk tags
+#define LCD32_QOI_OP_INDEX          0x00
+#define LCD32_QOI_OP_DIFF           0x40
+#define LCD32_QOI_OP_LUMA           0x80
+#define LCD32_QOI_OP_RUN            0xC0
+#define LCD32_QOI_OP_RGB            0xFE
+/// @brief Longest run one chunk holds
+#define LCD32_QOI_RUN_MAX           62
+/// @brief Most bytes one pixel adds (the pending OP_RUN, then OP_RGB)
+#define LCD32_QOI_CHUNK_MAX         5
+
+/// @brief Index slot of an opaque 0xRRGGBB colour
+#define LCD32QoiHash(rgb)           (((((rgb) >> 16) & 0xFF) * 3 + (((rgb) >> 8) & 0xFF) * 5 + ((rgb) & 0xFF) * 7 + 255 * 11) & 63)
+
+/// @brief Hand the staged bytes to the sink
+static int32_t LCD32QoiFlush(LCD32Qoi_t * Qoi){
+    if((Qoi->Used != 0) && (Qoi->Err == 0)){
+        Qoi->Err = Qoi->Sink(Qoi->Ctx, Qoi->Out, Qoi->Used);
+    }
+    Qoi->Used = 0;
+    return Qoi->Err;
+}
+
+/// @brief Make room for one pixel
+static inline int32_t LCD32QoiRoom(LCD32Qoi_t * Qoi){
+    if(Qoi->Used > (LCD32_SHOT_OUT_BYTES - LCD32_QOI_CHUNK_MAX)){
+        return LCD32QoiFlush(Qoi);
+    }
+    return Qoi->Err;
+}
+
+/// @brief RGB565 to 0xRRGGBB, low bits filled from the high ones
+static inline uint32_t LCD32Qoi565To888(uint16_t c){
+    uint32_t r = (c >> 11) & 0x1F;
+    uint32_t g = (c >> 5) & 0x3F;
+    uint32_t b = c & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return (r << 16) | (g << 8) | b;
+}
+
+/// @brief Start an image and write its header
+int32_t LCD32QoiBegin(LCD32Qoi_t * Qoi, uint32_t Width, uint32_t Height, LCD32ShotSink_t Sink, void * Ctx){
+    if((Qoi == NULL) || (Sink == NULL) || (Width == 0) || (Height == 0)){
+        return -1;
+    }
+    memset(Qoi->Index, 0, sizeof(Qoi->Index));
+    Qoi->Prev    = 0;
+    /// QOI starts from opaque black, which is RGB565 0x0000
+    Qoi->Prev565 = 0;
+    Qoi->Run     = 0;
+    Qoi->Left    = Width * Height;
+    Qoi->Err     = 0;
+    Qoi->Sink    = Sink;
+    Qoi->Ctx     = Ctx;
+
+    /// "qoif", width, height (big endian), 3 channels, sRGB
+    uint8_t * o = Qoi->Out;
+    o[0] = 'q'; o[1] = 'o'; o[2] = 'i'; o[3] = 'f';
+    o[4] = (uint8_t)(Width >> 24);  o[5] = (uint8_t)(Width >> 16);  o[6] = (uint8_t)(Width >> 8);  o[7] = (uint8_t)Width;
+    o[8] = (uint8_t)(Height >> 24); o[9] = (uint8_t)(Height >> 16); o[10] = (uint8_t)(Height >> 8); o[11] = (uint8_t)Height;
+    o[12] = 3;
+    o[13] = 0;
+    Qoi->Used = 14;
+    return 0;
+}
+
+/// @brief Encode the next pixels in row order
+int32_t LCD32QoiPush(LCD32Qoi_t * Qoi, const uint16_t * Px, uint32_t Num){
+    if((Qoi == NULL) || (Px == NULL)){
+        return -1;
+    }
+    if(Num > Qoi->Left){
+        Num = Qoi->Left;
+    }
+
+    for(uint32_t i = 0; i < Num; i++){
+        /// Runs are found on the 16-bit value
+        if(Px[i] == Qoi->Prev565){
+            Qoi->Run++;
+            if(Qoi->Run == LCD32_QOI_RUN_MAX){
+                if(LCD32QoiRoom(Qoi) != 0){
+                    return Qoi->Err;
+                }
+                Qoi->Out[Qoi->Used++] = (uint8_t)(LCD32_QOI_OP_RUN | (Qoi->Run - 1));
+                Qoi->Run = 0;
+            }
+            continue;
+        }
+
+        if(LCD32QoiRoom(Qoi) != 0){
+            return Qoi->Err;
+        }
+        if(Qoi->Run > 0){
+            Qoi->Out[Qoi->Used++] = (uint8_t)(LCD32_QOI_OP_RUN | (Qoi->Run - 1));
+            Qoi->Run = 0;
+        }
+
+        uint32_t rgb = LCD32Qoi565To888(Px[i]);
+        uint32_t slot = LCD32QoiHash(rgb);
+        uint8_t * o = &Qoi->Out[Qoi->Used];
+
+        /// Index entries carry alpha: unused slots are transparent black, not black
+        if(Qoi->Index[slot] == (rgb | 0xFF000000UL)){
+            o[0] = (uint8_t)(LCD32_QOI_OP_INDEX | slot);
+            Qoi->Used += 1;
+        } else {
+            Qoi->Index[slot] = rgb | 0xFF000000UL;
+            int8_t dr = (int8_t)((rgb >> 16) - (Qoi->Prev >> 16));
+            int8_t dg = (int8_t)((rgb >> 8) - (Qoi->Prev >> 8));
+            int8_t db = (int8_t)(rgb - Qoi->Prev);
+            int8_t drDg = (int8_t)(dr - dg);
+            int8_t dbDg = (int8_t)(db - dg);
+
+            if((dr >= -2) && (dr <= 1) && (dg >= -2) && (dg <= 1) && (db >= -2) && (db <= 1)){
+                o[0] = (uint8_t)(LCD32_QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                Qoi->Used += 1;
+            } else if((dg >= -32) && (dg <= 31) && (drDg >= -8) && (drDg <= 7) && (dbDg >= -8) && (dbDg <= 7)){
+                o[0] = (uint8_t)(LCD32_QOI_OP_LUMA | (dg + 32));
+                o[1] = (uint8_t)(((drDg + 8) << 4) | (dbDg + 8));
+                Qoi->Used += 2;
+            } else {
+                o[0] = LCD32_QOI_OP_RGB;
+                o[1] = (uint8_t)(rgb >> 16);
+                o[2] = (uint8_t)(rgb >> 8);
+                o[3] = (uint8_t)rgb;
+                Qoi->Used += 4;
+            }
+        }
+        Qoi->Prev = rgb;
+        Qoi->Prev565 = Px[i];
+    }
+    Qoi->Left -= Num;
+    return Qoi->Err;
+}
+
+/// @brief Write the pending run and the end marker, and flush the staging buffer
+int32_t LCD32QoiEnd(LCD32Qoi_t * Qoi){
+    if(Qoi == NULL){
+        return -1;
+    }
+    /// A push cut short by the sink leaves pixels behind: report the sink's error
+    if(Qoi->Err != 0){
+        return Qoi->Err;
+    }
+    if(Qoi->Left != 0){
+        return -1;
+    }
+    if(LCD32QoiRoom(Qoi) != 0){
+        return Qoi->Err;
+    }
+    if(Qoi->Run > 0){
+        Qoi->Out[Qoi->Used++] = (uint8_t)(LCD32_QOI_OP_RUN | (Qoi->Run - 1));
+        Qoi->Run = 0;
+    }
+    /// End marker: seven 0x00 then 0x01
+    if(Qoi->Used > (LCD32_SHOT_OUT_BYTES - 8)){
+        if(LCD32QoiFlush(Qoi) != 0){
+            return Qoi->Err;
+        }
+    }
+    memset(&Qoi->Out[Qoi->Used], 0, 7);
+    Qoi->Out[Qoi->Used + 7] = 0x01;
+    Qoi->Used += 8;
+    return LCD32QoiFlush(Qoi);
+}
+
+/// @brief Turn ILI9341 frame memory readback into RGB565
+void LCD32ShotUnpack(const uint16_t * Words, uint16_t * Px, uint32_t Num){
+    if((Words == NULL) || (Px == NULL)){
+        return;
+    }
+    /// Two pixels per three words: [R0 G0] [B0 R1] [G1 B1]
+    uint32_t i = 0;
+    for(; (i + 1) < Num; i += 2){
+        uint16_t w0 = Words[0];
+        uint16_t w1 = Words[1];
+        uint16_t w2 = Words[2];
+        Px[i]     = (uint16_t)((w0 & 0xF800) | ((w0 & 0x00FC) << 3) | (w1 >> 11));
+        Px[i + 1] = (uint16_t)(((w1 & 0x00F8) << 8) | ((w2 & 0xFC00) >> 5) | ((w2 & 0x00F8) >> 3));
+        Words += 3;
+    }
+    if(i < Num){
+        uint16_t w0 = Words[0];
+        uint16_t w1 = Words[1];
+        Px[i] = (uint16_t)((w0 & 0xF800) | ((w0 & 0x00FC) << 3) | (w1 >> 11));
+    }
+}
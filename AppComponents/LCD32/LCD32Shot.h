@@ -0,0 +1,90 @@
+/**
+ * @file LCD32Shot.h
+ * @brief Screenshot encoding for the LCD32 driver: GRAM readback unpacking and a streaming QOI encoder
+ * @details On the 16-bit bus the ILI9341 returns frame memory as 8-bit R, G, B bytes (6 bits
+ *          used each), packed two pixels in three words: [R0 G0] [B0 R1] [G1 B1].
+ *          LCD32ShotUnpack() turns them back into RGB565.
+ *          The encoder writes a QOI image (https://qoiformat.org, RGB, sRGB) from RGB565
+ *          pixels fed in row order, any number at a time. It keeps the 64-entry colour index,
+ *          the previous pixel and a small output staging buffer, and hands the bytes to a
+ *          sink as the staging buffer fills: a full frame never needs a second frame buffer.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __LCD32_SHOT_H__
+#define __LCD32_SHOT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppComponents/LCD32/LCD32Shot.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/// @brief Bytes staged before the sink is called
+#define LCD32_SHOT_OUT_BYTES        256
+/// @brief Rows read back per band by LCD32Screenshot()
+#define LCD32_SHOT_ROWS             8
+/// @brief Pixels unpacked per burst read by LCD32ReadRect() (even: pixel pairs never straddle bursts)
+#define LCD32_SHOT_CHUNK_PX         64
+/// @brief Bus words carrying `px` pixels of GRAM readback
+#define LCD32ShotWords(px)          ((((uint32_t)(px)) * 3 + 1) / 2)
+
+/// @brief Receives encoded bytes
+/// @param Ctx Caller context given to LCD32QoiBegin()
+/// @param Data Bytes, valid during the call only
+/// @param Len Number of bytes
+/// @return 0 to go on, anything else aborts the encoding (returned by the encoder calls)
+typedef int32_t (*LCD32ShotSink_t)(void * Ctx, const uint8_t * Data, uint32_t Len);
+
+/// @brief Streaming QOI encoder state
+typedef struct LCD32Qoi_s {
+    uint32_t        Index[64];      ///< Colour index, 0xAARRGGBB (0: unused, transparent black)
+    uint32_t        Prev;           ///< Previous pixel, 0xRRGGBB
+    uint16_t        Prev565;        ///< Previous pixel as fed
+    uint16_t        Run;            ///< Repeats of Prev not written yet
+    uint32_t        Left;           ///< Pixels still expected
+    uint32_t        Used;           ///< Bytes in `Out`
+    int32_t         Err;            ///< First non-zero sink return, sticky
+    LCD32ShotSink_t Sink;
+    void *          Ctx;
+    uint8_t         Out[LCD32_SHOT_OUT_BYTES];
+} LCD32Qoi_t;
+
+/// @brief Start an image and write its header
+/// @param Qoi Pointer to the encoder
+/// @param Width Image width in pixels
+/// @param Height Image height in pixels
+/// @param Sink Byte receiver
+/// @param Ctx Passed to `Sink`
+/// @return 0, -1 for bad arguments, or the sink's error
+int32_t             LCD32QoiBegin(LCD32Qoi_t * Qoi, uint32_t Width, uint32_t Height, LCD32ShotSink_t Sink, void * Ctx);
+
+/// @brief Encode the next pixels in row order
+/// @param Qoi Pointer to the encoder
+/// @param Px RGB565 pixels
+/// @param Num Number of pixels (extra pixels past Width * Height are dropped)
+/// @return 0 or the sink's error
+int32_t             LCD32QoiPush(LCD32Qoi_t * Qoi, const uint16_t * Px, uint32_t Num);
+
+/// @brief Write the pending run and the end marker, and flush the staging buffer
+/// @param Qoi Pointer to the encoder
+/// @return 0, -1 when fewer than Width * Height pixels were pushed, or the sink's error
+int32_t             LCD32QoiEnd(LCD32Qoi_t * Qoi);
+
+/// @brief Turn ILI9341 frame memory readback into RGB565
+/// @param Words LCD32ShotWords(Num) bus words (the dummy read already dropped)
+/// @param Px Destination, `Num` pixels (may not overlap `Words`)
+/// @param Num Number of pixels
+void                LCD32ShotUnpack(const uint16_t * Words, uint16_t * Px, uint32_t Num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __LCD32_SHOT_H__
@@ -0,0 +1,65 @@
+/**
+ * @file LCD32Strip.c
+ * @brief Display list and band buffer for the LCD32 strip renderer
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "LCD32Strip.h"
+
+/// @brief Drop every command and set the color bands start from
+void LCD32StripListClear(LCD32StripList_t * List, uint16_t Background){
+    if(List == NULL){
+        return;
+    }
+    List->Count      = 0;
+    List->DataUsed   = 0;
+    List->Dropped    = 0;
+    List->Background = Background;
+}
+
+/// @brief Append a command
+LCD32StripCmd_t * LCD32StripListAdd(LCD32StripList_t * List, uint8_t Op, uint16_t Color, int16_t Top, int16_t Bottom, const void * Data, uint16_t DataLen){
+    if(List == NULL){
+        return NULL;
+    }
+
+    /// Keep the data pool 2-byte aligned (vertices are int16_t pairs)
+    uint16_t dataSpace = (uint16_t)((DataLen + 1U) & ~1U);
+    if((List->Count >= LCD32_STRIP_CMD_MAX) || ((uint32_t) List->DataUsed + dataSpace > LCD32_STRIP_DATA_MAX)){
+        List->Dropped++;
+        return NULL;
+    }
+
+    LCD32StripCmd_t * cmd = &(List->Cmd[List->Count++]);
+    memset(cmd, 0, sizeof(LCD32StripCmd_t));
+    cmd->Op      = Op;
+    cmd->Color   = Color;
+    cmd->Top     = Top;
+    cmd->Bottom  = Bottom;
+    cmd->DataOff = List->DataUsed;
+    cmd->DataLen = DataLen;
+
+    if((Data != NULL) && (DataLen > 0)){
+        memcpy(&(List->Data[List->DataUsed]), Data, DataLen);
+        List->DataUsed += dataSpace;
+    }
+    return cmd;
+}
+
+/// @brief Point the band at rows [Y0, Y0 + Rows) of `Buffer` and fill it with the background
+void LCD32StripBeginBand(LCD32Strip_t * Strip, uint16_t * Buffer, int16_t Y0, int16_t Rows){
+    if((Strip == NULL) || (Buffer == NULL)){
+        return;
+    }
+    Strip->Cur = Buffer;
+    Strip->Y0  = Y0;
+    Strip->Y1  = (int16_t)(Y0 + Rows);
+
+    uint16_t color = Strip->List.Background;
+    uint32_t size  = (uint32_t) Strip->Width * (uint32_t) Rows;
+    for(uint32_t i = 0; i < size; i++){
+        Buffer[i] = color;
+    }
+}
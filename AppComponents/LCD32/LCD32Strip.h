@@ -0,0 +1,122 @@
+/**
+ * @file LCD32Strip.h
+ * @brief Display list and band buffer for the LCD32 strip renderer
+ * @details In strip mode the primitives are not drawn into a full-screen canvas. Each
+ *          call is recorded as a command carrying the rows it touches; a flush then
+ *          rasterizes the screen LCD32_STRIP_ROWS rows at a time into a small band buffer,
+ *          replaying only the commands that reach the band, and sends each band as soon
+ *          as it is complete. The list lives until the next clear (LCD32FillCanvas() in
+ *          strip mode), so a flush shows exactly what the canvas would hold.
+ *          Hardware independent: allocation of the band buffers is left to the caller.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __LCD32_STRIP_H__
+#define __LCD32_STRIP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppComponents/LCD32/LCD32Strip.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/// @brief Rows per band (band buffer = LCD32_STRIP_ROWS * longest screen edge pixels)
+#define LCD32_STRIP_ROWS            16
+/// @brief Longest screen edge in pixels (band buffer width)
+#define LCD32_STRIP_WIDTH_MAX       320
+/// @brief Commands held by the display list
+#define LCD32_STRIP_CMD_MAX         256
+/// @brief Bytes of variable data (polygon vertices, text) held by the display list
+#define LCD32_STRIP_DATA_MAX        2048
+
+/// @brief Display list opcodes (one per LCD32 primitive)
+enum LCD32StripOp_e {
+    LCD32_STRIP_OP_PIXEL            = 0,    ///< Arg: row, col
+    LCD32_STRIP_OP_LINE             = 1,    ///< Arg: r0, c0, r1, c1
+    LCD32_STRIP_OP_THICK_LINE       = 2,    ///< Arg: r0, c0, r1, c1, thickness
+    LCD32_STRIP_OP_EMPTY_RECT       = 3,    ///< Arg: rTop, cLeft, rBottom, cRight, edge
+    LCD32_STRIP_OP_POLYGON          = 4,    ///< Data: vertices
+    LCD32_STRIP_OP_FILLED_POLYGON   = 5,    ///< Data: vertices
+    LCD32_STRIP_OP_CHAR             = 6,    ///< Arg: r, c, char; Font
+    LCD32_STRIP_OP_TEXT             = 7,    ///< Arg: r, c; Data: string (with '\0'); Font
+};
+
+/// @brief One recorded primitive
+typedef struct LCD32StripCmd_s {
+    uint8_t     Op;         ///< LCD32_STRIP_OP_*
+    uint16_t    Color;      ///< Drawing color
+    int16_t     Top;        ///< First row touched (may be off-screen)
+    int16_t     Bottom;     ///< Last row touched (inclusive)
+    int16_t     Arg[5];     ///< Opcode arguments
+    uint16_t    DataOff;    ///< Offset of the command data in the list data pool
+    uint16_t    DataLen;    ///< Length of the command data in bytes
+    const void *Font;       ///< Font for text commands
+} LCD32StripCmd_t;
+
+/// @brief Display list
+typedef struct LCD32StripList_s {
+    LCD32StripCmd_t Cmd[LCD32_STRIP_CMD_MAX];   ///< Commands in drawing order
+    uint8_t         Data[LCD32_STRIP_DATA_MAX]; ///< Variable data pool
+    uint16_t        Count;                      ///< Commands recorded
+    uint16_t        DataUsed;                   ///< Data pool bytes used
+    uint16_t        Dropped;                    ///< Commands lost since the last clear (list full)
+    uint16_t        Background;                 ///< Color every band starts from
+} LCD32StripList_t;
+
+/// @brief Strip renderer state
+typedef struct LCD32Strip_s {
+    LCD32StripList_t    List;       ///< Display list
+    uint16_t *          Band[2];    ///< Band buffers: one is rasterized while the other is sent
+    uint16_t *          Cur;        ///< Band being rasterized
+    int16_t             Y0;         ///< First row held by `Cur`
+    int16_t             Y1;         ///< Row after the last one held by `Cur`
+    int16_t             Width;      ///< Row pitch of the band buffers (screen width)
+    uint8_t             Replaying;  ///< Primitives draw into `Cur` instead of recording
+} LCD32Strip_t;
+
+/// @brief Does a command touch rows [y0, y1)
+#define LCD32StripCmdHits(cmd, y0, y1)      (((cmd)->Bottom >= (y0)) && ((cmd)->Top < (y1)))
+
+/// @brief Data pool slice of a command
+#define LCD32StripCmdData(list, cmd)        ((const void *)&((list)->Data[(cmd)->DataOff]))
+
+/// @brief Store an in-bounds pixel if its row falls in the current band (caller checks columns)
+#define LCD32StripPutPixel(strip, row, col, color)  do { \
+                                                        if (((row) >= (strip)->Y0) && ((row) < (strip)->Y1)) { \
+                                                            (strip)->Cur[((row) - (strip)->Y0) * (strip)->Width + (col)] = (color); \
+                                                        } \
+                                                    } while(0)
+
+/// @brief Drop every command and set the color bands start from
+/// @param List Pointer to the display list
+/// @param Background Color of pixels no command covers
+void                LCD32StripListClear(LCD32StripList_t * List, uint16_t Background);
+
+/// @brief Append a command
+/// @param List Pointer to the display list
+/// @param Op LCD32_STRIP_OP_* opcode
+/// @param Color Drawing color
+/// @param Top First row touched
+/// @param Bottom Last row touched (inclusive)
+/// @param Data Variable data copied into the pool (NULL if none)
+/// @param DataLen Length of `Data` in bytes
+/// @return The new command (caller fills Arg/Font), or NULL when the list is full
+LCD32StripCmd_t *   LCD32StripListAdd(LCD32StripList_t * List, uint8_t Op, uint16_t Color, int16_t Top, int16_t Bottom, const void * Data, uint16_t DataLen);
+
+/// @brief Point the band at rows [Y0, Y0 + Rows) of `Buffer` and fill it with the background
+/// @param Strip Pointer to the strip state
+/// @param Buffer Band buffer (Strip->Width * Rows pixels)
+/// @param Y0 First screen row of the band
+/// @param Rows Rows in the band
+void                LCD32StripBeginBand(LCD32Strip_t * Strip, uint16_t * Buffer, int16_t Y0, int16_t Rows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __LCD32_STRIP_H__
@@ -5,6 +5,8 @@
  */
 
 #include "P16Com.h"
+#include "P16ComDma.h"
+#include "P16ComDedic.h"
 
 /// @brief Builds the Look-Up Tables (LUTs) for GPIO mask pre-calculation.
 /// @details This is a one-time setup that dramatically speeds up write operations
@@ -42,6 +44,117 @@ static void P16ComBuildLut(const Pin_t* DatPinArr, P16Lut_t* Lut) {
     P16Log("[P16ComBuildLut] LUTs generated for fast writes.");
 }
 
+/// @brief Builds the compact LUTs (all data pins below GPIO32)
+/// @details Each entry is the bank-0 pattern of the pins that go HIGH; pins that go LOW
+///          are the rest of the data mask, cleared with the same word.
+static void P16ComBuildLut32(const Pin_t* DatPinArr, P16Lut_t* Lut) {
+    P16Entry("P16ComBuildLut32(%p, %p)", DatPinArr, Lut);
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t lowPattern = 0;
+        uint32_t highPattern = 0;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if ((i >> bit) & 1) {
+                lowPattern  |= Mask32(DatPinArr[bit]);
+                highPattern |= Mask32(DatPinArr[bit + 8]);
+            }
+        }
+        Lut->Lut32Low[i]  = lowPattern;
+        Lut->Lut32High[i] = highPattern;
+    }
+    P16Log("[P16ComBuildLut32] Compact LUTs generated (bank 0 only).");
+}
+
+/// @brief Choose how reads gather the data pins and build the read tables if needed
+/// @details Runs of consecutive GPIOs (D(i+1) on the pin after D(i), same bank) cost a shift
+///          and a mask each; with at most P16COM_RD_PART_MAX of them no table is touched.
+///          Otherwise every byte of the port holding data pins gets a 256-entry table giving
+///          the word bits of that byte; with at most P16COM_RD_PART_MAX bytes a word is that
+///          many lookups ORed (P16COM_RD_GATHER_TABLE_EN). Anything else keeps the bit loop.
+static void P16ComBuildRead(P16Dev_t * Dev) {
+    P16Entry("P16ComBuildRead(%p)", Dev);
+    const Pin_t * pins = Dev->DatPinArr;
+    uint32_t num = 0;
+
+    #if (P16COM_RD_RUNS_EN == 1)
+        /// 1. Runs of consecutive pins
+        for (uint32_t i = 0; i < P16COM_DAT_PIN_NUM; ) {
+            uint32_t len = 1;
+            while (((i + len) < P16COM_DAT_PIN_NUM) &&
+                   (pins[i + len] == pins[i] + (Pin_t) len) &&
+                   ((pins[i + len] >> 5) == (pins[i] >> 5))) {
+                len++;
+            }
+            if (num < P16COM_RD_PART_MAX) {
+                Dev->RdPart[num].Bank  = (uint8_t) (pins[i] >> 5);
+                Dev->RdPart[num].Shift = (uint8_t) (pins[i] & 31);
+                Dev->RdPart[num].Dst   = (uint8_t) i;
+                Dev->RdPart[num].Rsv   = 0;
+                Dev->RdPart[num].Mask  = (1UL << len) - 1;
+            }
+            num++;
+            i += len;
+        }
+        if (num <= P16COM_RD_PART_MAX) {
+            Dev->RdMode = P16COM_RD_RUNS;
+            Dev->RdPartNum = num;
+            P16Log("[P16ComBuildRead] %d pin runs, shift gather.", num);
+            P16Exit("P16ComBuildRead() : Done");
+            return;
+        }
+    #endif
+
+    #if (P16COM_RD_GATHER_TABLE_EN == 0)
+        Dev->RdMode = P16COM_RD_LOOP;
+        Dev->RdPartNum = 0;
+        P16Log("[P16ComBuildRead] Read tables off, bit loop.");
+        P16Exit("P16ComBuildRead() : Done");
+        return;
+    #else
+
+    /// 2. Byte slices of the port holding data pins
+    uint8_t bytes[P16COM_DAT_PIN_NUM];
+    num = 0;
+    REPN(i, P16COM_DAT_PIN_NUM){
+        uint8_t byte = (uint8_t) (pins[i] >> 3);
+        uint32_t k = 0;
+        while ((k < num) && (bytes[k] != byte)) {
+            k++;
+        }
+        if (k == num) {
+            bytes[num++] = byte;
+        }
+    }
+    if (num > P16COM_RD_PART_MAX) {
+        Dev->RdMode = P16COM_RD_LOOP;
+        Dev->RdPartNum = 0;
+        P16Log("[P16ComBuildRead] Data pins span %d bytes, bit loop.", num);
+        P16Exit("P16ComBuildRead() : Done");
+        return;
+    }
+
+    for (uint32_t n = 0; n < num; n++) {
+        Dev->RdPart[n].Bank  = (uint8_t) (bytes[n] >> 2);
+        Dev->RdPart[n].Shift = (uint8_t) ((bytes[n] & 3) * 8);
+        Dev->RdPart[n].Dst   = 0;
+        Dev->RdPart[n].Rsv   = 0;
+        Dev->RdPart[n].Mask  = 0xFF;
+        for (uint32_t v = 0; v < 256; v++) {
+            uint16_t word = 0;
+            REPN(i, P16COM_DAT_PIN_NUM){
+                if (((pins[i] >> 3) == bytes[n]) && ((v >> (pins[i] & 7)) & 1)) {
+                    word |= (uint16_t) (1 << i);
+                }
+            }
+            Dev->Lut->RdLut[n][v] = word;
+        }
+    }
+    Dev->RdMode = P16COM_RD_LUT;
+    Dev->RdPartNum = num;
+    P16Log("[P16ComBuildRead] %d byte slices, table gather.", num);
+    P16Exit("P16ComBuildRead() : Done");
+    #endif /// (P16COM_RD_GATHER_TABLE_EN == 0)
+}
+
 /// @brief Allocates a new P16Dev_t object
 P16Dev_t * P16ComNew(){
     /// Allocate memory
@@ -64,6 +177,9 @@ P16Dev_t * P16ComNew(){
     devPtr->CtlIOMask = 0;
     devPtr->DatIOMask = 0;
     devPtr->Lut = NULL;
+    devPtr->LutMode = P16COM_LUT_WIDE;
+    devPtr->Backend = P16COM_DEFAULT_BACKEND;
+    devPtr->BackendCtx = NULL;
     
     return devPtr;
 }
@@ -71,10 +187,32 @@ P16Dev_t * P16ComNew(){
 /// @brief Deallocate memory for P16Dev_t object
 void P16Delete(P16Dev_t * Dev){
     if(Dev != NULL){
+        P16ComReleaseBackend(Dev);
         free(Dev);
     }
 }
 
+/// @brief Release the resources of the active backend
+void P16ComReleaseBackend(P16Dev_t * Dev){
+    if(IsNull(Dev)){
+        return;
+    }
+    switch(Dev->Backend){
+        #if (P16COM_I80_DMA_EN == 1)
+        case P16COM_BACKEND_I80_DMA:
+            P16ComDmaDeinit(Dev);
+            break;
+        #endif
+        #if (P16COM_DEDIC_GPIO_EN == 1)
+        case P16COM_BACKEND_DEDIC_GPIO:
+            P16ComDedicDeinit(Dev);
+            break;
+        #endif
+        default:
+            break;
+    }
+}
+
 /// @brief Configure Control pins mapping and calculate IO Masks
 DefaultRet_t P16ComConfigCtl(P16Dev_t * Dev, const Pin_t * CtlPins){
     P16Entry("P16ComConfigCtl(%p, %p)", Dev, CtlPins);
@@ -109,10 +247,14 @@ DefaultRet_t P16ComConfigDat(P16Dev_t * Dev, const Pin_t * DatPins, P16Lut_t *Lu
 
     /// Configure and Mask Data Pins
     Dev->DatIOMask = 0;
+    uint32_t allStandard = 1;
     REPN(i, P16COM_DAT_PIN_NUM){
-        if(IsStandardPin(DatPins[i])){
+        if(IsValidPin(DatPins[i])){
             Dev->DatPinArr[i] = DatPins[i];
             Dev->DatIOMask |= Mask64(DatPins[i]);
+            if(!IsStandardPin(DatPins[i])){
+                allStandard = 0;
+            }
         } else {
             P16Err("[P16ComConfigDat] Invalid Data Pin at index %d", i);
             P16ReturnWithLog(STAT_ERR_INVALID_ARG, "P16ComConfigDat() : STAT_ERR_INVALID_ARG");
@@ -123,11 +265,49 @@ DefaultRet_t P16ComConfigDat(P16Dev_t * Dev, const Pin_t * DatPins, P16Lut_t *Lu
     Dev->Lut = Lut;
 
     /// Build the LUTs now that we have the pin mapping
-    P16ComBuildLut(Dev->DatPinArr, Dev->Lut);
+    /// @note Control pins are always bank 0 (see P16ComConfigCtl), so only data pins decide
+    if(allStandard){
+        Dev->LutMode = P16COM_LUT_COMPACT;
+        P16ComBuildLut32(Dev->DatPinArr, Dev->Lut);
+    } else {
+        Dev->LutMode = P16COM_LUT_WIDE;
+        P16ComBuildLut(Dev->DatPinArr, Dev->Lut);
+    }
+
+    /// Read side: shift runs, byte-slice tables or the bit loop
+    P16ComBuildRead(Dev);
 
     P16ReturnWithLog(STAT_OKE, "P16ComConfigDat() : STAT_OKE");
 }
 
+/// @brief Select the transfer backend used by the next P16ComInit()
+DefaultRet_t P16ComSelectBackend(P16Dev_t * Dev, uint32_t Backend){
+    P16Entry("P16ComSelectBackend(%p, %d)", Dev, Backend);
+
+    if(IsNull(Dev)){
+        P16ReturnWithLog(STAT_ERR_NULL, "P16ComSelectBackend() : STAT_ERR_NULL");
+    }
+
+    switch(Backend){
+        case P16COM_BACKEND_BITBANG:
+            break;
+        #if (P16COM_I80_DMA_EN == 1)
+        case P16COM_BACKEND_I80_DMA:
+            break;
+        #endif
+        #if (P16COM_DEDIC_GPIO_EN == 1)
+        case P16COM_BACKEND_DEDIC_GPIO:
+            break;
+        #endif
+        default:
+            P16Err("[P16ComSelectBackend] Backend %d is not available", Backend);
+            P16ReturnWithLog(STAT_ERR_UNSUPPORTED, "P16ComSelectBackend() : STAT_ERR_UNSUPPORTED");
+    }
+
+    Dev->Backend = Backend;
+    P16ReturnWithLog(STAT_OKE, "P16ComSelectBackend() : STAT_OKE");
+}
+
 /// @brief Initialize the driver GPIOs and Flags
 DefaultRet_t P16ComInit(P16Dev_t * Dev){
     P16Entry("P16ComInit(%p)", Dev);
@@ -143,12 +323,15 @@ DefaultRet_t P16ComInit(P16Dev_t * Dev){
         P16ReturnWithLog(STAT_ERR_INIT_FAILED, "P16ComInit() : STAT_ERR_INIT_FAILED");
     }
 
-    #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
-        /// @note Normal state is OUTPUT (optimized for write)
-        IOConfigAsOutput(Dev->DatIOMask, -1, -1);
-    #else
+    /// @note Input and output both enabled once here: input buffers, pulls and the GPIO matrix
+    ///       never change again, reads and writes only flip the output enables (P16BusToInput/Output)
+    IOConfigAsInputOutput(Dev->DatIOMask, -1, -1);
+    Dev->DatOeLo = (uint32_t) Dev->DatIOMask;
+    Dev->DatOeHi = (uint32_t) (Dev->DatIOMask >> 32);
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
         /// @note Normal state is INPUT (Safe Mode / High-Z)
-        IOConfigAsInput(Dev->DatIOMask, -1, -1);
+        P16BusToInput(Dev);
     #endif
 
     /// 2. Configure CONTROL pins
@@ -163,7 +346,26 @@ DefaultRet_t P16ComInit(P16Dev_t * Dev){
     /// Set Control pins to IDLE state (High for active-low signals)
     IOStandardSet(Dev->CtlIOMask);
 
-    /// 3. Mark as initialized 
+    /// 3. Bring up the selected backend (bit-bang stays available as fallback)
+    #if (P16COM_I80_DMA_EN == 1)
+        if(Dev->Backend == P16COM_BACKEND_I80_DMA){
+            if(P16ComDmaInit(Dev) != STAT_OKE){
+                P16Err("[P16ComInit] i80 DMA backend failed, falling back to bit-bang");
+                Dev->Backend = P16COM_BACKEND_BITBANG;
+            }
+        }
+    #endif
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        /// @note The bundle is bound to the core running this call
+        if(Dev->Backend == P16COM_BACKEND_DEDIC_GPIO){
+            if(P16ComDedicInit(Dev) != STAT_OKE){
+                P16Err("[P16ComInit] Dedicated GPIO backend failed, falling back to bit-bang");
+                Dev->Backend = P16COM_BACKEND_BITBANG;
+            }
+        }
+    #endif
+
+    /// 4. Mark as initialized 
     Dev->StatusFlag |= P16COM_INITIALIZED;
     
     P16ReturnWithLog(STAT_OKE, "P16ComInit() : STAT_OKE");
@@ -184,6 +386,8 @@ void P16ComMakeReset(P16Dev_t * Dev){
         }
     #endif
 
+    P16ComWaitIdle(Dev);
+
     /// Pulse Reset: Low -> Delay -> High
     P16SetLowResetPin(Dev);
     P16BlockingDelay(P16HalfClockCycle);
@@ -201,9 +405,12 @@ void P16ComWrite(P16Dev_t * Dev, P16Data_t Data){
         }
     #endif
 
+    /// Bus may still be owned by an asynchronous DMA burst
+    P16ComWaitIdle(Dev);
+
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
         /// Switch to OUTPUT using pre-calculated mask
-        IOConfigAsOutput(Dev->DatIOMask, -1, -1);
+        P16BusToOutput(Dev);
     #endif
 
     if (IsNull(Dev->Lut)) {
@@ -211,6 +418,22 @@ void P16ComWrite(P16Dev_t * Dev, P16Data_t Data){
         goto cleanup;
     }
 
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        if (Dev->Backend == P16COM_BACKEND_DEDIC_GPIO) {
+            if (P16ComDedicWrite(Dev, Data) == STAT_OKE) {
+                goto cleanup;
+            }
+            /// Wrong core (logged): the LUT path below strobes WR through GPIO.out
+            P16ComDedicReleaseWrite(Dev);
+        }
+    #endif
+
+    if (Dev->LutMode == P16COM_LUT_COMPACT) {
+        /// Bank 0 only: three stores, WR low folded into the data clear
+        P16Lut32WriteWord((uint32_t) Dev->DatIOMask, P16Lut32Pattern(Dev->Lut, Data), Mask32(Dev->Write));
+        goto cleanup;
+    }
+
     /// Use pre-calculated LUTs for speed
     uint8_t low_byte = Data & 0xFF;
     uint8_t high_byte = (Data >> 8) & 0xFF;
@@ -227,14 +450,14 @@ void P16ComWrite(P16Dev_t * Dev, P16Data_t Data){
 cleanup:
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
         /// Switch back to INPUT (Safe Mode)
-        IOConfigAsInput(Dev->DatIOMask, -1, -1);
+        P16BusToInput(Dev);
     #endif
 }
 
 /// @brief Write a block of data to the bus (Burst Write)
 void P16ComWriteArray(P16Dev_t * Dev, P16Data_t * DataArr, P16Size_t Size){
 
-    P16Entry("P16ComWriteArray(%p, %p, %d)", Dev, DataArr, Size);
+    P16EntryHot("P16ComWriteArray(%p, %p, %d)", Dev, DataArr, Size);
 
     #if (P16COM_INIT_CHECK_EN == 1)
         if( !((Dev->StatusFlag) & P16COM_INITIALIZED) ){
@@ -248,38 +471,270 @@ void P16ComWriteArray(P16Dev_t * Dev, P16Data_t * DataArr, P16Size_t Size){
         return;
     }
 
+    #if (P16COM_I80_DMA_EN == 1)
+        if(Dev->Backend == P16COM_BACKEND_I80_DMA){
+            /// Blocking from the caller's view, but the core sleeps on the semaphore
+            P16ComDmaWrite(Dev, DataArr, Size, 0);
+            P16ExitHot("P16ComWriteArray() : Done (DMA)");
+            return;
+        }
+    #endif
+
     if (IsNull(Dev->Lut)) {
         P16Err("[P16ComWriteArray] LUT is not configured!");
         return;
     }
 
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        if (Dev->Backend == P16COM_BACKEND_DEDIC_GPIO) {
+            if (P16ComDedicWriteArray(Dev, DataArr, Size) == STAT_OKE) {
+                P16ExitHot("P16ComWriteArray() : Done (DEDIC)");
+                return;
+            }
+            /// Wrong core (logged): the LUT path below strobes WR through GPIO.out
+            P16ComDedicReleaseWrite(Dev);
+        }
+    #endif
+
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
         /// Switch to OUTPUT ONCE for the whole burst
-        IOConfigAsOutput(Dev->DatIOMask, -1, -1);
+        P16BusToOutput(Dev);
     #endif
 
-    REPN(j, Size){
-        P16Data_t currentData = DataArr[j];
-        uint8_t low_byte = currentData & 0xFF;
-        uint8_t high_byte = (currentData >> 8) & 0xFF;
-
-        uint64_t MaskSet = Dev->Lut->LutLow[low_byte].setMask | Dev->Lut->LutHigh[high_byte].setMask;
-        uint64_t MaskClr = Dev->Lut->LutLow[low_byte].clrMask | Dev->Lut->LutHigh[high_byte].clrMask;
-
-        /// Drive Data
-        IOSet(MaskSet);
-        IOClr(MaskClr);
-        
-        /// Strobe Write
-        P16MakeWritePulse(Dev);
+    if (Dev->LutMode == P16COM_LUT_COMPACT) {
+        /// Set / clear stores only: other bank-0 outputs are left to their owners
+        const P16Lut_t * lut = Dev->Lut;
+        uint32_t wrMask = Mask32(Dev->Write);
+        uint32_t datMask = (uint32_t) Dev->DatIOMask;
+        P16Data_t prevData = DataArr[0];
+        P16Lut32WriteWord(datMask, P16Lut32Pattern(lut, prevData), wrMask);
+
+        /// Three stores for a new word, a WR strobe (two stores) for a repeated one
+        for (P16Size_t j = 1; j < Size; j++) {
+            if (DataArr[j] != prevData) {
+                prevData = DataArr[j];
+                P16Lut32WriteWord(datMask, P16Lut32Pattern(lut, prevData), wrMask);
+            } else {
+                P16MakeWritePulse(Dev);
+            }
+        }
+    } else {
+        /// Force the first word out, then only re-drive the data lines when the word changes
+        P16Data_t prevData = ~DataArr[0];
+        REPN(j, Size){
+            P16Data_t currentData = DataArr[j];
+            if (currentData != prevData) {
+                uint8_t low_byte = currentData & 0xFF;
+                uint8_t high_byte = (currentData >> 8) & 0xFF;
+
+                uint64_t MaskSet = Dev->Lut->LutLow[low_byte].setMask | Dev->Lut->LutHigh[high_byte].setMask;
+                uint64_t MaskClr = Dev->Lut->LutLow[low_byte].clrMask | Dev->Lut->LutHigh[high_byte].clrMask;
+
+                /// Drive Data
+                IOSet(MaskSet);
+                IOClr(MaskClr);
+                prevData = currentData;
+            }
+
+            /// Strobe Write
+            P16MakeWritePulse(Dev);
+        }
     }
     
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
         /// Switch back to INPUT
-        IOConfigAsInput(Dev->DatIOMask, -1, -1);
+        P16BusToInput(Dev);
+    #endif
+
+    P16ExitHot("P16ComWriteArray() : Done");
+}
+
+/// @brief Write the same word `Count` times (data lines driven once, then WR strobes only)
+void P16ComWriteRepeat(P16Dev_t * Dev, P16Data_t Value, P16Size_t Count){
+
+    P16EntryHot("P16ComWriteRepeat(%p, 0x%X, %d)", Dev, Value, Count);
+
+    #if (P16COM_INIT_CHECK_EN == 1)
+        if( !((Dev->StatusFlag) & P16COM_INITIALIZED) ){
+            P16Err("[P16ComWriteRepeat] Device not initialized!");
+            return;
+        }
+    #endif
+
+    if(IsNotPos(Count)){
+        P16Err("[P16ComWriteRepeat] Count not valid!");
+        return;
+    }
+
+    if (IsNull(Dev->Lut)) {
+        P16Err("[P16ComWriteRepeat] LUT is not configured!");
+        return;
+    }
+
+    /// Bus may still be owned by an asynchronous DMA burst; between bursts the pins are
+    /// plain GPIOs, so the strobe loop below also serves the DMA backend
+    P16ComWaitIdle(Dev);
+
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        if (Dev->Backend == P16COM_BACKEND_DEDIC_GPIO) {
+            if (P16ComDedicWriteRepeat(Dev, Value, Count) == STAT_OKE) {
+                P16ExitHot("P16ComWriteRepeat() : Done (DEDIC)");
+                return;
+            }
+            /// Wrong core (logged): the LUT path below strobes WR through GPIO.out
+            P16ComDedicReleaseWrite(Dev);
+        }
+    #endif
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToOutput(Dev);
+    #endif
+
+    /// Drive Data once
+    P16ComDriveData(Dev, Value);
+
+    /// Strobe Write
+    REPN(j, Count){
+        P16MakeWritePulse(Dev);
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToInput(Dev);
     #endif
 
-    P16Exit("P16ComWriteArray() : Done");
+    P16ExitHot("P16ComWriteRepeat() : Done");
+}
+
+/// @brief Start a burst write and return without waiting for it (DMA backend)
+DefaultRet_t P16ComWriteArrayAsync(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size, uint32_t ReleaseChipSel){
+    P16EntryHot("P16ComWriteArrayAsync(%p, %p, %d, %d)", Dev, DataArr, Size, ReleaseChipSel);
+
+    if(IsNull(Dev) || IsNull(DataArr)){
+        P16ReturnWithLog(STAT_ERR_NULL, "P16ComWriteArrayAsync() : STAT_ERR_NULL");
+    }
+
+    #if (P16COM_INIT_CHECK_EN == 1)
+        if( !((Dev->StatusFlag) & P16COM_INITIALIZED) ){
+            P16Err("[P16ComWriteArrayAsync] Device not initialized!");
+            P16ReturnWithLog(STAT_ERR_INVALID_STATE, "P16ComWriteArrayAsync() : STAT_ERR_INVALID_STATE");
+        }
+    #endif
+
+    #if (P16COM_I80_DMA_EN == 1)
+        if(Dev->Backend == P16COM_BACKEND_I80_DMA){
+            uint32_t flags = P16COM_DMA_FLAG_ASYNC;
+            if(ReleaseChipSel){
+                flags |= P16COM_DMA_FLAG_RELEASE_CS;
+            }
+            DefaultRet_t ret = P16ComDmaWrite(Dev, DataArr, Size, flags);
+            P16ReturnWithLog(ret, "P16ComWriteArrayAsync() : %s", DefaultReturnType2Str(ret));
+        }
+    #endif
+
+    /// Bit-bang fallback: synchronous
+    P16ComWriteArray(Dev, (P16Data_t *) DataArr, Size);
+    if(ReleaseChipSel){
+        P16SetHighChipSelPin(Dev);
+    }
+    P16ReturnWithLogHot(STAT_OKE, "P16ComWriteArrayAsync() : STAT_OKE");
+}
+
+/// @brief Wait for a pending asynchronous write to finish
+DefaultRet_t P16ComWaitIdle(P16Dev_t * Dev){
+    #if (P16COM_I80_DMA_EN == 1)
+        if(IsNotNull(Dev) && (Dev->Backend == P16COM_BACKEND_I80_DMA)){
+            return P16ComDmaWaitIdle(Dev, P16COM_DMA_WAIT_TIMEOUT_MS);
+        }
+    #endif
+    (void) Dev;
+    return STAT_OKE;
+}
+
+/// @brief Send a command list in a single CS-low transaction
+DefaultRet_t P16ComRunCmdList(P16Dev_t * Dev, const uint8_t * List, const P16Data_t * Params, uint32_t ReleaseChipSel){
+    P16EntryHot("P16ComRunCmdList(%p, %p, %p, %d)", Dev, List, Params, ReleaseChipSel);
+
+    if(IsNull(Dev) || IsNull(List)){
+        P16ReturnWithLogHot(STAT_ERR_NULL, "P16ComRunCmdList() : STAT_ERR_NULL");
+    }
+    #if (P16COM_INIT_CHECK_EN == 1)
+        if( !((Dev->StatusFlag) & P16COM_INITIALIZED) ){
+            P16Err("[P16ComRunCmdList] Device not initialized!");
+            P16ReturnWithLogHot(STAT_ERR_INVALID_STATE, "P16ComRunCmdList() : STAT_ERR_INVALID_STATE");
+        }
+    #endif
+    if(IsNull(Dev->Lut)){
+        P16Err("[P16ComRunCmdList] LUT is not configured!");
+        P16ReturnWithLogHot(STAT_ERR_INVALID_STATE, "P16ComRunCmdList() : STAT_ERR_INVALID_STATE");
+    }
+
+    /// Bus may still be owned by an asynchronous DMA burst
+    P16ComWaitIdle(Dev);
+
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        /// The list strobes WR through GPIO.out
+        if(Dev->Backend == P16COM_BACKEND_DEDIC_GPIO){
+            P16ComDedicReleaseWrite(Dev);
+        }
+    #endif
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToOutput(Dev);
+    #endif
+
+    P16SetLowChipSelPin(Dev);
+
+    const P16Lut_t * lut = Dev->Lut;
+    bool isCompact = (Dev->LutMode == P16COM_LUT_COMPACT);
+    uint32_t wrMask = Mask32(Dev->Write);
+    uint32_t datMask = (uint32_t) Dev->DatIOMask;
+
+    while(*List != P16COM_CL_END){
+        P16Data_t cmd = *List++;
+        uint8_t ctl = *List++;
+        uint32_t num = ctl & P16COM_CL_COUNT;
+
+        /// Command word, RS low
+        P16SetLowRegSelPin(Dev);
+        if(isCompact){
+            P16Lut32WriteWord(datMask, P16Lut32Pattern(lut, cmd), wrMask);
+        } else {
+            P16ComDriveData(Dev, cmd);
+            P16MakeWritePulse(Dev);
+        }
+
+        /// Args, RS high
+        if(num != 0){
+            P16SetHighRegSelPin(Dev);
+        }
+        for(uint32_t n = 0; n < num; n++){
+            P16Data_t arg = (ctl & P16COM_CL_PARAMS) ? *Params++ : (P16Data_t) *List++;
+            if(isCompact){
+                P16Lut32WriteWord(datMask, P16Lut32Pattern(lut, arg), wrMask);
+            } else {
+                P16ComDriveData(Dev, arg);
+                P16MakeWritePulse(Dev);
+            }
+        }
+
+        if(ctl & P16COM_CL_DELAY){
+            /// The transaction is closed while the task sleeps: the panel ignores the bus
+            /// with CS high, and a long wait (SLEEP_OUT: 120 ms) does not hold the CPU
+            P16SetHighChipSelPin(Dev);
+            P16TaskDelayMs(*List++);
+            P16SetLowChipSelPin(Dev);
+        }
+    }
+
+    if(ReleaseChipSel){
+        P16SetHighChipSelPin(Dev);
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToInput(Dev);
+    #endif
+
+    P16ReturnWithLogHot(STAT_OKE, "P16ComRunCmdList() : STAT_OKE");
 }
 
 /// @brief Read a single word from the bus
@@ -291,9 +746,11 @@ P16Data_t P16ComRead(P16Dev_t * Dev){
         }
     #endif
 
+    P16ComWaitIdle(Dev);
+
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
         /// Switch Data Bus to INPUT for reading
-        IOConfigAsInput(Dev->DatIOMask, -1, -1);
+        P16BusToInput(Dev);
     #endif
 
     /// Activate Read Strobe
@@ -301,14 +758,7 @@ P16Data_t P16ComRead(P16Dev_t * Dev){
     P16BlockingDelay(P16HalfClockCycle);
 
     /// Sample Data
-    uint64_t portState = IOStandardGet();
-    uint16_t result = 0;
-    
-    REPN(i, 16){
-        if ( (portState >> Dev->DatPinArr[i]) & 0x1 ) {
-            result |= (1 << i);
-        }
-    }
+    uint16_t result = P16ComSample(Dev);
 
     /// Deactivate Read Strobe
     P16SetHighReadPin(Dev);
@@ -316,7 +766,7 @@ P16Data_t P16ComRead(P16Dev_t * Dev){
 
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
         /// Switch back to OUTPUT (Normal State)
-        IOConfigAsOutput(Dev->DatIOMask, -1, -1);
+        P16BusToOutput(Dev);
     #endif
 
     return result;
@@ -324,7 +774,7 @@ P16Data_t P16ComRead(P16Dev_t * Dev){
 
 /// @brief Read a block of data from the bus (Burst Read)
 void P16ComReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size){
-    P16Entry("P16ComReadArray(%p, %p, %d)", Dev, pBuff, Size);
+    P16EntryHot("P16ComReadArray(%p, %p, %d)", Dev, pBuff, Size);
 
     #if (P16COM_INIT_CHECK_EN == 1)
         if( !((Dev->StatusFlag) & P16COM_INITIALIZED) ){
@@ -333,28 +783,31 @@ void P16ComReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size){
         }
     #endif
 
+    P16ComWaitIdle(Dev);
+
     if(IsNull(pBuff) || IsNotPos(Size)){
         P16Err("[P16ComReadArray] Buffer is NULL or Size not valid!");
         return;
     }
 
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        /// Wrong core (logged): falls through to the GPIO strobe path
+        if ((Dev->Backend == P16COM_BACKEND_DEDIC_GPIO) && (P16ComDedicReadArray(Dev, pBuff, Size) == STAT_OKE)) {
+            P16ExitHot("P16ComReadArray() : Done (DEDIC)");
+            return;
+        }
+    #endif
+
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
         /// Switch Data Bus to INPUT for reading
-        IOConfigAsInput(Dev->DatIOMask, -1, -1);
+        P16BusToInput(Dev);
     #endif
 
     REPN(j, Size){
         P16SetLowReadPin(Dev);
         P16BlockingDelay(P16HalfClockCycle);
 
-        uint64_t portState = IOStandardGet();
-        uint16_t val = 0;
-        REPN(i, 16){
-            if ( (portState >> Dev->DatPinArr[i]) & 0x1 ) {
-                val |= (1 << i);
-            }
-        }
-        pBuff[j] = val;
+        pBuff[j] = P16ComSample(Dev);
 
         P16SetHighReadPin(Dev);
         P16BlockingDelay(P16HalfClockCycle);
@@ -362,8 +815,83 @@ void P16ComReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size){
     
     #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
         /// Switch back to OUTPUT
-        IOConfigAsOutput(Dev->DatIOMask, -1, -1);
+        P16BusToOutput(Dev);
+    #endif
+
+    P16ExitHot("P16ComReadArray() : Done");
+}
+
+/// @brief Words per second of `Words` words that took `Us` microseconds
+static uint32_t P16ComWordsPerSec(uint64_t Words, int64_t Us){
+    if(Us <= 0){
+        return 0;
+    }
+    return (uint32_t)((Words * 1000000ULL) / (uint64_t) Us);
+}
+
+/// @brief Measure read throughput and the cost of turning the data bus around
+DefaultRet_t P16ComReadBenchmark(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size, uint32_t Rounds){
+    P16Entry("P16ComReadBenchmark(%p, %p, %d, %d)", Dev, pBuff, Size, Rounds);
+
+    if(IsNull(Dev) || IsNull(pBuff)){
+        P16ReturnWithLog(STAT_ERR_NULL, "P16ComReadBenchmark() : STAT_ERR_NULL");
+    }
+    if(IsNotPos(Size) || (Rounds == 0)){
+        P16ReturnWithLog(STAT_ERR_INVALID_SIZE, "P16ComReadBenchmark() : STAT_ERR_INVALID_SIZE");
+    }
+
+    /// Let an in-flight DMA burst finish, then deselect the panel so it ignores the traffic
+    P16ComWaitIdle(Dev);
+    P16SetHighChipSelPin(Dev);
+
+    /// Private copy: same pins and LUT, plain GPIO strobes
+    P16Dev_t bench = *Dev;
+    bench.Backend = P16COM_BACKEND_BITBANG;
+    bench.BackendCtx = NULL;
+    uint64_t words = (uint64_t) Size * Rounds;
+
+    /// 1. Burst reads: one turn-around pair per burst
+    int64_t start = esp_timer_get_time();
+    for(uint32_t r = 0; r < Rounds; r++){
+        P16ComReadArray(&bench, pBuff, Size);
+    }
+    int64_t burstUs = esp_timer_get_time() - start;
+
+    /// 2. Single reads: one turn-around pair per word
+    start = esp_timer_get_time();
+    for(uint32_t r = 0; r < Rounds; r++){
+        REPN(j, Size){
+            pBuff[j] = P16ComRead(&bench);
+        }
+    }
+    int64_t singleUs = esp_timer_get_time() - start;
+
+    /// 3. Turn-around pairs alone, driver vs registers (the driver is slow: fewer pairs)
+    uint32_t flips = Rounds * 64;
+    start = esp_timer_get_time();
+    for(uint32_t r = 0; r < flips; r++){
+        IOConfigAsInput(bench.DatIOMask, -1, -1);
+        IOConfigAsInputOutput(bench.DatIOMask, -1, -1);
+    }
+    int64_t driverUs = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for(uint32_t r = 0; r < flips; r++){
+        P16BusToInput(&bench);
+        P16BusToOutput(&bench);
+    }
+    int64_t regUs = esp_timer_get_time() - start;
+
+    /// Back to the normal bus state
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToInput(&bench);
     #endif
 
-    P16Exit("P16ComReadArray() : Done");
+    P16Log("[P16ComReadBenchmark] %d words x %d: burst %u words/s (%lld us), single %u words/s (%lld us)",
+            Size, Rounds,
+            P16ComWordsPerSec(words, burstUs), burstUs,
+            P16ComWordsPerSec(words, singleUs), singleUs);
+    P16Log("[P16ComReadBenchmark] %u turn-arounds: gpio_config %lld ns, register %lld ns",
+            flips, (driverUs * 1000) / flips, (regUs * 1000) / flips);
+    P16ReturnWithLog(STAT_OKE, "P16ComReadBenchmark() : STAT_OKE");
 }
\ No newline at end of file
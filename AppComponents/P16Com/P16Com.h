@@ -35,6 +35,11 @@ extern "C" {
     #define P16BlockingDelay(usec)      ets_delay_us(usec)
 #endif
 
+#ifndef P16TaskDelayMs
+    /// @brief Wrapper for a sleeping delay (milliseconds, at least one tick)
+    #define P16TaskDelayMs(msec)        vTaskDelay(MsToTicks(msec) + 1)
+#endif
+
 #ifndef P16ClockCycle
     /// @brief Total cycle time for write/read operation (in micro-seconds)
     /// @note Adjust this based on the speed of the external device
@@ -53,16 +58,55 @@ typedef int32_t     P16Size_t;
 /// @details 1: Default is OUTPUT (Faster writes). 0: Default is INPUT (Safe/High-Z).
 #define P16COM_DB_NORMAL_OUTPUT_EN      1
 
-/// @brief Enable standard logging for this module
-#define P16COM_LOG_EN                   1
-/// @brief Enable verbose/detailed logging
-#define P16COM_LOG1_EN                  1
-/// @brief Enable error logging
-#define P16COM_ERR_EN                   1
-/// @brief Enable function entry tracing
-#define P16COM_LOG_ENTRY                1
-/// @brief Enable function exit tracing
-#define P16COM_LOG_EXIT                 1
+#ifndef P16COM_I80_DMA_EN
+    /// @brief Compile the LCD_CAM i80 + GDMA backend (ESP32-S3)
+    #define P16COM_I80_DMA_EN           1
+#endif
+
+#ifndef P16COM_DEDIC_GPIO_EN
+    /// @brief Compile the dedicated-GPIO (CPU fast GPIO) strobe engine (ESP32-S3)
+    #define P16COM_DEDIC_GPIO_EN        1
+#endif
+
+/// @brief Transfer backends, selected with P16ComSelectBackend() before P16ComInit()
+enum P16ComBackend_e {
+    P16COM_BACKEND_BITBANG          = 0, ///< CPU drives the GPIOs through the LUT
+    P16COM_BACKEND_I80_DMA          = 1, ///< LCD_CAM i80 engine fed by GDMA (bulk writes)
+    P16COM_BACKEND_DEDIC_GPIO       = 2, ///< LUT data + WR/RD strobes on CPU dedicated GPIO
+};
+
+/// @brief Backend used by objects created with P16ComNew()
+#define P16COM_DEFAULT_BACKEND          P16COM_BACKEND_BITBANG
+
+/// @brief Command list format (P16ComRunCmdList()), one entry after the other:
+///        [Cmd] [Ctl] [Ctl & P16COM_CL_COUNT 8-bit args] [delay in ms, if Ctl has P16COM_CL_DELAY]
+/// @note  Cmd P16COM_CL_END (a NOP) ends the list.
+#define P16COM_CL_END                   0x00
+#define P16COM_CL_COUNT                 0x3F    ///< Ctl: number of args (0-63)
+#define P16COM_CL_PARAMS                0x40    ///< Ctl: args are the next words of `Params`, not list bytes
+#define P16COM_CL_DELAY                 0x80    ///< Ctl: one delay byte (ms) follows the args (slept with CS high)
+
+/// @brief Pin-order optimizer: data pins on consecutive GPIOs are read with shifts, not tables
+#define P16COM_RD_RUNS_EN               1
+
+/// @brief Byte-slice read tables (2 KB in P16Lut_t) for pin maps that are not a few runs;
+///        0 drops them and such maps read with the bit loop
+#define P16COM_RD_GATHER_TABLE_EN       1
+
+/// @brief Most shift runs / byte slices a read is gathered from (more falls back to a bit loop)
+#define P16COM_RD_PART_MAX              4
+
+/// @brief How reads turn a port snapshot into a word, chosen by P16ComConfigDat() from the pin map
+enum P16ComRdMode_e {
+    P16COM_RD_LOOP      = 0, ///< Test the 16 pins one by one (pins spread over too many bytes)
+    P16COM_RD_LUT       = 1, ///< One table lookup per byte slice of the port holding data pins
+    P16COM_RD_RUNS      = 2, ///< One shift and mask per run of consecutive data pins
+};
+
+#ifndef P16COM_LOG_LEVEL
+    /// @brief Log level of this module (SYS_LOG_LEVEL_*, set in AppConfig/SystemLog.h)
+    #define P16COM_LOG_LEVEL          SYS_LOG_LEVEL_INFO
+#endif
 
 /// @brief Number of actual Control Pins used (Read, Write, CS, RS, Reset)
 #define P16COM_CTL_PIN_NUM              5
@@ -87,12 +131,47 @@ typedef struct P16LutEntry_s {
     uint64_t clrMask; ///< Mask for pins to set LOW
 } P16LutEntry_t;
 
-/// @brief Look-Up Table structure for fast GPIO writes.
+/// @brief Compact LUT entry: GPIO 0-31 pattern of the data pins set to HIGH
+typedef uint32_t P16LutEntry32_t;
+
+/// @brief LUT layouts, chosen by P16ComConfigDat() from the data pin map
+enum P16ComLutMode_e {
+    P16COM_LUT_WIDE     = 0, ///< 64-bit set/clear masks, data pins anywhere in 0-63
+    P16COM_LUT_COMPACT  = 1, ///< 32-bit patterns, every data pin below GPIO32
+};
+
+/// @brief Look-Up Table structure for fast GPIO writes and reads.
+/// @details Both write layouts share the same storage; P16Dev_t::LutMode tells which one is built.
+///          The read tables follow them (P16COM_RD_GATHER_TABLE_EN) and are only filled in
+///          P16COM_RD_LUT mode.
 typedef struct P16Lut_s {
-    P16LutEntry_t LutLow[256];  ///< LUT for bits 0-7
-    P16LutEntry_t LutHigh[256]; ///< LUT for bits 8-15
+    union {
+        /// @brief Wide layout (P16COM_LUT_WIDE)
+        struct {
+            P16LutEntry_t LutLow[256];      ///< LUT for bits 0-7
+            P16LutEntry_t LutHigh[256];     ///< LUT for bits 8-15
+        };
+        /// @brief Compact layout (P16COM_LUT_COMPACT), 2 KB
+        struct {
+            P16LutEntry32_t Lut32Low[256];  ///< Pattern for bits 0-7
+            P16LutEntry32_t Lut32High[256]; ///< Pattern for bits 8-15
+        };
+    };
+    #if (P16COM_RD_GATHER_TABLE_EN == 1)
+    /// @brief Read tables: word bits carried by each value of the byte slice P16Dev_t::RdPart[n], 2 KB
+    uint16_t RdLut[P16COM_RD_PART_MAX][256];
+    #endif
 } P16Lut_t;
 
+/// @brief One piece of a read: `((bank >> Shift) & Mask) << Dst` (runs) or a byte slice (LUT)
+typedef struct P16RdPart_s {
+    uint8_t     Bank;   ///< 0: GPIO 0-31, 1: GPIO 32+
+    uint8_t     Shift;  ///< First bit of the piece in its bank
+    uint8_t     Dst;    ///< First word bit it lands on (runs only)
+    uint8_t     Rsv;
+    uint32_t    Mask;   ///< Bits kept after the shift (0xFF for a byte slice)
+} P16RdPart_t;
+
 /// @brief Pinout structure for 16-bit parallel communication
 /// @details Uses anonymous unions to allow access via specific names (e.g., .Read) 
 ///          or via arrays (e.g., .CtlPinArr[i]) for bulk configuration.
@@ -138,8 +217,27 @@ typedef struct P16Dev_t{
     /// @note Using uint64_t to support ESP32 pins > 31
     uint64_t DatIOMask;
 
+    /// @brief Output-enable masks of the data pins, GPIO 0-31 and 32+ words (set by P16ComInit)
+    /// @note  Bus direction is flipped with direct enable_w1ts/w1tc stores, not gpio_config()
+    uint32_t DatOeLo;
+    uint32_t DatOeHi;
+
     /// @brief Pointer to the Look-Up Table for GPIO masks.
     P16Lut_t *Lut;
+
+    /// @brief Read gather (P16ComRdMode_e) and its pieces, built by P16ComConfigDat()
+    uint32_t RdMode;
+    uint32_t RdPartNum;
+    P16RdPart_t RdPart[P16COM_RD_PART_MAX];
+
+    /// @brief Layout of *Lut (P16ComLutMode_e)
+    uint32_t LutMode;
+
+    /// @brief Active transfer backend (P16ComBackend_e)
+    uint32_t Backend;
+
+    /// @brief Backend private state (NULL for bit-bang)
+    void *BackendCtx;
 } P16Dev_t;
 
 /* --- FUNCTION PROTOTYPES --- */
@@ -160,12 +258,21 @@ DefaultRet_t        P16ComConfigCtl(P16Dev_t * Dev, const Pin_t * CtlPins);
 
 /// @brief Configure Data pins mapping and calculate IO Masks
 /// @param Dev Pointer to the P16Dev_t object
+/// @details Data pins may use both GPIO banks (0-63). When every data pin is below
+///          GPIO32 the compact LUT and the single-bank write path are selected.
 /// @param DatPins Array of 16 Data Pins (D0..D15)
 /// @param Lut Pointer to a P16Lut_t structure to be used and populated.
 /// @return STAT_OKE on success, STAT_ERR on invalid pin or NULL Lut
 DefaultRet_t        P16ComConfigDat(P16Dev_t * Dev, const Pin_t * DatPins, P16Lut_t *Lut);
 
+/// @brief Select the transfer backend used by the next P16ComInit()
+/// @param Dev Pointer to the P16Dev_t object
+/// @param Backend One of P16ComBackend_e
+/// @return STAT_OKE, or STAT_ERR_UNSUPPORTED if the backend is not compiled in
+DefaultRet_t        P16ComSelectBackend(P16Dev_t * Dev, uint32_t Backend);
+
 /// @brief Initializes the GPIOs for the parallel interface
+/// @details Also brings up the selected backend; falls back to bit-bang if it fails.
 /// @param Dev Pointer to the P16Dev_t object
 /// @return STAT_OKE on success, STAT_ERR on failure
 DefaultRet_t        P16ComInit(P16Dev_t * Dev);
@@ -185,11 +292,54 @@ void                P16ComMakeReset(P16Dev_t * Dev);
 void                P16ComWrite(P16Dev_t * Dev, P16Data_t Data);
 
 /// @brief Writes an array of 16-bit values to the bus (Burst Write)
+/// @details The bit-bang paths only re-drive the data lines when a word differs from the
+///          previous one, so runs of equal words cost one WR strobe each (two set / clear
+///          stores, against three for a new word on the compact LUT).
 /// @param Dev Pointer to the P16Dev_t object
 /// @param DataArr Pointer to the data array
 /// @param Size Number of elements to write
 void                P16ComWriteArray(P16Dev_t * Dev, P16Data_t * DataArr, P16Size_t Size);
 
+/// @brief Writes the same 16-bit value `Count` times
+/// @details The data lines are driven once, then only WR is strobed: solid fills are
+///          bound by the strobe rate instead of the LUT.
+/// @param Dev Pointer to the P16Dev_t object
+/// @param Value The 16-bit value to repeat
+/// @param Count Number of words to write
+void                P16ComWriteRepeat(P16Dev_t * Dev, P16Data_t Value, P16Size_t Count);
+
+/// @brief Start a burst write and return without waiting for it (DMA backend)
+/// @details With the bit-bang backend this degrades to a blocking P16ComWriteArray().
+///          `DataArr` must stay untouched until P16ComWaitIdle() returns.
+/// @param Dev Pointer to the P16Dev_t object
+/// @param DataArr Pointer to the data array
+/// @param Size Number of elements to write
+/// @param ReleaseChipSel Non-zero: drive CS high once the last word is out
+/// @return STAT_OKE on success, error code otherwise
+DefaultRet_t        P16ComWriteArrayAsync(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size, uint32_t ReleaseChipSel);
+
+/// @brief Send a command list (see P16COM_CL_*) in a single CS-low transaction
+/// @details Checks the device once, then drives each word straight from the LUT: RS is low
+///          for the command and high for its args (one store each time it changes). With the
+///          compact LUT, WR low rides in the data clear store, so a word is three stores.
+///          A delay entry releases CS and sleeps the task, then opens a new transaction.
+/// @param Dev Pointer to the P16Dev_t object
+/// @param List Command list, ended by P16COM_CL_END
+/// @param Params Words for P16COM_CL_PARAMS entries, used in order (NULL if there are none)
+/// @param ReleaseChipSel Non-zero: drive CS high at the end; zero: leave the transaction open
+/// @return STAT_OKE or Error Code
+DefaultRet_t        P16ComRunCmdList(P16Dev_t * Dev, const uint8_t * List, const P16Data_t * Params, uint32_t ReleaseChipSel);
+
+/// @brief Release the resources of the active backend (DMA channel, GPIO bundle, ...)
+/// @details Called by P16Delete(); the bus keeps working through the bit-bang path.
+/// @param Dev Pointer to the P16Dev_t object
+void                P16ComReleaseBackend(P16Dev_t * Dev);
+
+/// @brief Wait for a pending asynchronous write to finish
+/// @param Dev Pointer to the P16Dev_t object
+/// @return STAT_OKE, or STAT_ERR_TIMEOUT
+DefaultRet_t        P16ComWaitIdle(P16Dev_t * Dev);
+
 /// @brief Reads a single 16-bit value from the bus
 /// @param Dev Pointer to the P16Dev_t object
 /// @return The 16-bit value read from the bus
@@ -201,46 +351,71 @@ P16Data_t           P16ComRead(P16Dev_t * Dev);
 /// @param Size Number of elements to read
 void                P16ComReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size);
 
+/// @brief Measure read throughput and the cost of turning the data bus around
+/// @details Runs on a bit-bang copy of `Dev` with CS held high (the panel ignores the strobes):
+///          burst reads, single-word reads, and direction flips through gpio_config() against
+///          the output-enable register stores the driver uses.
+/// @param Dev Pointer to an initialized P16Dev_t object
+/// @param pBuff Scratch buffer of `Size` words (contents are overwritten)
+/// @param Size Words per burst
+/// @param Rounds Bursts per measurement
+/// @return STAT_OKE or Error Code
+DefaultRet_t        P16ComReadBenchmark(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size, uint32_t Rounds);
+
 #ifdef P16COM_LOG_SECTION
 
-    #if (P16COM_LOG_EN == 1)
+    #if SysLogLevelOn(P16COM_LOG_LEVEL, SYS_LOG_LEVEL_ERR)
+        /// @brief Log error message
+        #define P16Err(...)                     SysErr(__VA_ARGS__)
+
+        /// @brief Log error message, at most once per SYSTEM_LOG_HOT_MS from this line
+        #define P16ErrHot(...)                  SysRateMs(SYSTEM_LOG_HOT_MS, SysErr, __VA_ARGS__)
+    #else
+        #define P16Err(...)
+        #define P16ErrHot(...)
+    #endif
+
+    #if SysLogLevelOn(P16COM_LOG_LEVEL, SYS_LOG_LEVEL_INFO)
         /// @brief Log standard info message
-        #define P16Log(...)                 SysLog(__VA_ARGS__)
-    #else 
+        #define P16Log(...)                     SysLog(__VA_ARGS__)
+
+        /// @brief Log standard info message, at most once per SYSTEM_LOG_HOT_MS from this line
+        #define P16LogHot(...)                  SysRateMs(SYSTEM_LOG_HOT_MS, SysLog, __VA_ARGS__)
+    #else
         #define P16Log(...)
-    #endif 
+        #define P16LogHot(...)
+    #endif
 
-    #if (P16COM_ERR_EN == 1)
-        /// @brief Log error message
-        #define P16Err(...)                 SysErr(__VA_ARGS__)
+    #if SysLogLevelOn(P16COM_LOG_LEVEL, SYS_LOG_LEVEL_VERB)
+        /// @brief Log verbose/detailed message
+        #define P16Log1(...)                    SysLogVer(__VA_ARGS__)
     #else
-        #define P16Err(...)
-    #endif 
+        #define P16Log1(...)
+    #endif
+
+    #if SysLogLevelOn(P16COM_LOG_LEVEL, SYS_LOG_LEVEL_TRACE)
+        /// @brief Log function entry
+        #define P16Entry(...)                   SysEntry(__VA_ARGS__)
 
-    #if (P16COM_LOG_EXIT == 1)
         /// @brief Log function exit
-        #define P16Exit(...)                SysExit(__VA_ARGS__)
-        
+        #define P16Exit(...)                    SysExit(__VA_ARGS__)
+
         /// @brief Log function exit and return a value
-        #define P16ReturnWithLog(ret, ...)  SysExit(__VA_ARGS__); return ret;
-    #else
-        #define P16Exit(...)
-        #define P16ReturnWithLog(ret, ...)  return ret;
-    #endif 
+        #define P16ReturnWithLog(ret, ...)      SysExit(__VA_ARGS__); return ret;
 
-    #if (P16COM_LOG_ENTRY == 1)
-        /// @brief Log function entry
-        #define P16Entry(...)               SysEntry(__VA_ARGS__)
-    #else 
+        /// @brief Entry / exit of functions called per frame or per transfer: at most one line
+        ///        per SYSTEM_LOG_HOT_MS from each call site, with the count of calls skipped
+        #define P16EntryHot(...)                SysRateMs(SYSTEM_LOG_HOT_MS, SysEntry, __VA_ARGS__)
+        #define P16ExitHot(...)                 SysRateMs(SYSTEM_LOG_HOT_MS, SysExit, __VA_ARGS__)
+        #define P16ReturnWithLogHot(ret, ...)   SysRateMs(SYSTEM_LOG_HOT_MS, SysExit, __VA_ARGS__); return ret;
+    #else
         #define P16Entry(...)
-    #endif 
-
-    #if (P16COM_LOG1_EN == 1)
-        /// @brief Log verbose/detailed message
-        #define P16Log1(...)                SysLogVer(__VA_ARGS__)
-    #else 
-        #define P16Log1(...)
-    #endif 
+        #define P16Exit(...)
+        #define P16ReturnWithLog(ret, ...)      return ret;
+        #define P16EntryHot(...)
+        #define P16ExitHot(...)
+        #define P16ReturnWithLogHot(ret, ...)   return ret;
+    #endif
 
 #endif /// P16COM_LOG_SECTION
 
@@ -314,6 +489,96 @@ void                P16ComReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t
                                               P16SetHighWritePin(p16Dev); \
                                           } while(0)
     #endif
+
+    /// @brief Bus pattern of one word from the compact LUT (data pins HIGH, others 0)
+    #define P16Lut32Pattern(lut, d)       ((lut)->Lut32Low[(d) & 0xFF] | (lut)->Lut32High[((d) >> 8) & 0xFF])
+
+    /// @brief Compact path: put one word on the data lines (pins of `datMask` not in `pattern` go low)
+    /// @details Set / clear stores only: other bank-0 outputs (CS, RS, RST, pins of other
+    ///          drivers) are never written, so a task or ISR toggling them meanwhile is safe.
+    #define P16Lut32DriveWord(datMask, pattern)  do { \
+                                              IOStandardClr((datMask) & ~(pattern)); \
+                                              IOStandardSet(pattern); \
+                                          } while(0)
+
+    /// @brief Compact path: drive one word and strobe WR with three set / clear stores
+    /// @details The first store pulls the low data lines and WR down, the second raises the
+    ///          high data lines, the third only raises WR, so the data is stable across the
+    ///          latching edge. `datMask` is the bank-0 part of P16Dev_t::DatIOMask.
+    #if P16ClockCycle > 0
+    #define P16Lut32WriteWord(datMask, pattern, wrMask)  do { \
+                                              IOStandardClr(((datMask) & ~(pattern)) | (wrMask)); \
+                                              IOStandardSet(pattern); \
+                                              P16BlockingDelay(P16HalfClockCycle); \
+                                              IOStandardSet(wrMask); \
+                                              P16BlockingDelay(P16HalfClockCycle); \
+                                          } while(0)
+    #else // Optimized for speed, no explicit delay
+    #define P16Lut32WriteWord(datMask, pattern, wrMask)  do { \
+                                              IOStandardClr(((datMask) & ~(pattern)) | (wrMask)); \
+                                              IOStandardSet(pattern); \
+                                              IOStandardSet(wrMask); \
+                                          } while(0)
+    #endif
+
+    /// @brief Put one word on the data lines without strobing WR
+    #define P16ComDriveData(p16Dev, d)    do { \
+                                              if ((p16Dev)->LutMode == P16COM_LUT_COMPACT) { \
+                                                  P16Lut32DriveWord((uint32_t)(p16Dev)->DatIOMask, P16Lut32Pattern((p16Dev)->Lut, (d))); \
+                                              } else { \
+                                                  IOSet((p16Dev)->Lut->LutLow[(d) & 0xFF].setMask | (p16Dev)->Lut->LutHigh[((d) >> 8) & 0xFF].setMask); \
+                                                  IOClr((p16Dev)->Lut->LutLow[(d) & 0xFF].clrMask | (p16Dev)->Lut->LutHigh[((d) >> 8) & 0xFF].clrMask); \
+                                              } \
+                                          } while(0)
+
+    /// @brief Turn the data bus around to INPUT (drivers off, pins High-Z)
+    /// @note  Two register stores at most; the pins were set up as input/output by P16ComInit
+    #define P16BusToInput(p16Dev)         do { \
+                                              IOStandardDisableOut((p16Dev)->DatOeLo); \
+                                              if ((p16Dev)->DatOeHi) { \
+                                                  IOExtendedDisableOut((p16Dev)->DatOeHi); \
+                                              } \
+                                          } while(0)
+
+    /// @brief Turn the data bus around to OUTPUT (drivers on, levels from the out registers)
+    #define P16BusToOutput(p16Dev)        do { \
+                                              IOStandardEnableOut((p16Dev)->DatOeLo); \
+                                              if ((p16Dev)->DatOeHi) { \
+                                                  IOExtendedEnableOut((p16Dev)->DatOeHi); \
+                                              } \
+                                          } while(0)
+
+    /// @brief Turn a snapshot of the input registers into the word on the bus
+    /// @param p16Dev Configured device
+    /// @param lo GPIO 0-31 input levels
+    /// @param hi GPIO 32+ input levels (0 is fine when LutMode is P16COM_LUT_COMPACT)
+    static inline __attribute__((always_inline)) P16Data_t P16ComGather(const P16Dev_t * p16Dev, uint32_t lo, uint32_t hi){
+        uint32_t val = 0;
+        if (p16Dev->RdMode == P16COM_RD_RUNS) {
+            for (uint32_t n = 0; n < p16Dev->RdPartNum; n++) {
+                const P16RdPart_t * part = &p16Dev->RdPart[n];
+                val |= (((part->Bank ? hi : lo) >> part->Shift) & part->Mask) << part->Dst;
+            }
+        #if (P16COM_RD_GATHER_TABLE_EN == 1)
+        } else if (p16Dev->RdMode == P16COM_RD_LUT) {
+            for (uint32_t n = 0; n < p16Dev->RdPartNum; n++) {
+                const P16RdPart_t * part = &p16Dev->RdPart[n];
+                val |= p16Dev->Lut->RdLut[n][((part->Bank ? hi : lo) >> part->Shift) & 0xFF];
+            }
+        #endif
+        } else {
+            uint64_t port = ((uint64_t) hi << 32) | lo;
+            for (uint32_t i = 0; i < 16; i++) {
+                val |= (uint32_t) ((port >> p16Dev->DatPinArr[i]) & 0x1) << i;
+            }
+        }
+        return (P16Data_t) val;
+    }
+
+    /// @brief Sample the data bus (the high bank is only read when a data pin lives there)
+    #define P16ComSample(p16Dev)          P16ComGather((p16Dev), IOStandardGet(), \
+                                              ((p16Dev)->LutMode == P16COM_LUT_COMPACT) ? 0 : IOExtendedGet())
+
     /// @brief Perform a complete Read Strobe: Low -> Delay -> High -> Delay
     #define P16MakeReadPulse(p16Dev)      do { \
                                               P16SetLowReadPin(p16Dev); \
@@ -0,0 +1,349 @@
+/**
+ * @file P16ComDedic.c
+ * @brief Dedicated-GPIO (CPU fast GPIO) bit-bang engine for the 16-bit parallel bus (ESP32-S3)
+ * @author Nguyen Thanh Phu
+ */
+
+#include "P16ComDedic.h"
+
+#if (P16COM_DEDIC_GPIO_EN == 1)
+
+#include "esp_rom_gpio.h"
+#include "esp_timer.h"
+#include "driver/dedic_gpio.h"
+#include "hal/dedic_gpio_cpu_ll.h"
+#include "soc/dedic_gpio_periph.h"
+#include "soc/gpio_sig_map.h"
+
+/// @brief Bundle order: channel (offset + 0) is WR, (offset + 1) is RD
+enum P16ComDedicChannel_e {
+    P16COM_DEDIC_CH_WR  = 0,
+    P16COM_DEDIC_CH_RD  = 1,
+    P16COM_DEDIC_CH_NUM = 2,
+};
+
+/// @brief Backend private state, stored in P16Dev_t::BackendCtx
+typedef struct P16ComDedic_s {
+    dedic_gpio_bundle_handle_t  Bundle;     ///< WR + RD bundle
+    BaseType_t                  CoreId;     ///< Core owning the bundle
+    uint32_t                    WrMask;     ///< CPU channel mask of WR
+    uint32_t                    RdMask;     ///< CPU channel mask of RD
+    uint32_t                    WrSig;      ///< GPIO matrix signal of the WR channel
+    uint32_t                    RdSig;      ///< GPIO matrix signal of the RD channel
+    volatile uint32_t           WrOnCpu;    ///< 1 while WR is routed to its CPU channel
+} P16ComDedic_t;
+
+/// @brief Pull a strobe pin onto its CPU channel (true) or back onto GPIO.out (false)
+/// @details The channel is driven high first, so the hand-over happens at the idle level.
+static inline void P16ComDedicRoute(Pin_t Pin, uint32_t Mask, uint32_t Sig, bool ToDedic){
+    if(ToDedic){
+        dedic_gpio_cpu_ll_write_mask(Mask, Mask);
+        esp_rom_gpio_connect_out_signal(Pin, Sig, false, false);
+    } else {
+        IOStandardSet(Mask32(Pin));
+        esp_rom_gpio_connect_out_signal(Pin, SIG_GPIO_OUT_IDX, false, false);
+    }
+}
+
+/// @brief Context of `Dev` if it can be used from the calling core, NULL otherwise
+/// @details A call from the other core is a task pinning mistake: it is logged (rate
+///          limited) and the caller takes the LUT path.
+static inline P16ComDedic_t * P16ComDedicCtx(P16Dev_t * Dev, const char * Caller){
+    P16ComDedic_t * ctx = (P16ComDedic_t *) Dev->BackendCtx;
+    if(IsNull(ctx)){
+        return NULL;
+    }
+    if(ctx->CoreId != xPortGetCoreID()){
+        P16ErrHot("[%s] Called on CPU%d, bundle is on CPU%d: LUT path", Caller, xPortGetCoreID(), ctx->CoreId);
+        return NULL;
+    }
+    return ctx;
+}
+
+/// @brief Put WR on its CPU channel, unless it is there from an earlier call
+/// @details WR stays routed between calls, so back-to-back words and bursts skip the two
+///          GPIO matrix stores; P16ComDedicReleaseWrite() hands it back to GPIO.out.
+static inline void P16ComDedicTakeWrite(P16Dev_t * Dev, P16ComDedic_t * Ctx){
+    if( !Ctx->WrOnCpu ){
+        P16ComDedicRoute(Dev->Write, Ctx->WrMask, Ctx->WrSig, true);
+        Ctx->WrOnCpu = 1;
+    }
+}
+
+/// @brief Drain posted GPIO stores before the next CPU-channel edge
+/// @details GPIO.out is written over APB while dedicated channels switch on the CPU's own
+///          clock; without the barrier WR could rise before the data word reaches the pins.
+#if defined(__XTENSA__)
+#define P16ComDedicFence()            __asm__ __volatile__("memw" ::: "memory")
+#else
+#define P16ComDedicFence()            __sync_synchronize()
+#endif
+
+/// @brief One WR strobe on the CPU channel: Low -> (Delay) -> High -> (Delay)
+#if P16ClockCycle > 0
+#define P16ComDedicWritePulse(ctx)    do { \
+                                          dedic_gpio_cpu_ll_write_mask((ctx)->WrMask, 0); \
+                                          P16BlockingDelay(P16HalfClockCycle); \
+                                          dedic_gpio_cpu_ll_write_mask((ctx)->WrMask, (ctx)->WrMask); \
+                                          P16BlockingDelay(P16HalfClockCycle); \
+                                      } while(0)
+#else // Optimized for speed, no explicit delay
+#define P16ComDedicWritePulse(ctx)    do { \
+                                          dedic_gpio_cpu_ll_write_mask((ctx)->WrMask, 0); \
+                                          dedic_gpio_cpu_ll_write_mask((ctx)->WrMask, (ctx)->WrMask); \
+                                      } while(0)
+#endif
+
+/// @brief Set up a dedicated-GPIO bundle holding WR and RD on the calling core
+DefaultRet_t P16ComDedicInit(P16Dev_t * Dev){
+    P16Entry("P16ComDedicInit(%p)", Dev);
+
+    if(IsNull(Dev)){
+        P16ReturnWithLog(STAT_ERR_NULL, "P16ComDedicInit() : STAT_ERR_NULL");
+    }
+    if(IsNotNull(Dev->BackendCtx)){
+        P16ReturnWithLog(STAT_OKE, "P16ComDedicInit() : Already initialized");
+    }
+
+    P16ComDedic_t * ctx = (P16ComDedic_t *) calloc(1, sizeof(P16ComDedic_t));
+    if(IsNull(ctx)){
+        P16Err("[P16ComDedicInit] Malloc failed for context");
+        P16ReturnWithLog(STAT_ERR_MALLOC_FAILED, "P16ComDedicInit() : STAT_ERR_MALLOC_FAILED");
+    }
+
+    const int pins[P16COM_DEDIC_CH_NUM] = { Dev->Write, Dev->Read };
+    dedic_gpio_bundle_config_t cfg = {
+        .gpio_array = pins,
+        .array_size = P16COM_DEDIC_CH_NUM,
+        .flags = {
+            .out_en = 1,
+        },
+    };
+
+    /// Bundle is bound to this core from now on
+    ctx->CoreId = xPortGetCoreID();
+    esp_err_t err = dedic_gpio_new_bundle(&cfg, &ctx->Bundle);
+    uint32_t offset = 0;
+    if(err == ESP_OK) err = dedic_gpio_get_out_offset(ctx->Bundle, &offset);
+    if(err != ESP_OK){
+        P16Err("[P16ComDedicInit] Bundle setup failed (%s)", esp_err_to_name(err));
+        if(IsNotNull(ctx->Bundle)) dedic_gpio_del_bundle(ctx->Bundle);
+        free(ctx);
+        P16ReturnWithLog(STAT_ERR_INIT_FAILED, "P16ComDedicInit() : STAT_ERR_INIT_FAILED");
+    }
+
+    ctx->WrMask = 1UL << (offset + P16COM_DEDIC_CH_WR);
+    ctx->RdMask = 1UL << (offset + P16COM_DEDIC_CH_RD);
+    ctx->WrSig  = dedic_gpio_periph_signals.cores[ctx->CoreId].out_sig_per_channel[offset + P16COM_DEDIC_CH_WR];
+    ctx->RdSig  = dedic_gpio_periph_signals.cores[ctx->CoreId].out_sig_per_channel[offset + P16COM_DEDIC_CH_RD];
+
+    /// The driver routed both strobes to the CPU: idle them high (CS is still high), then
+    /// hand them back to GPIO.out until a transfer needs them
+    dedic_gpio_cpu_ll_write_mask(ctx->WrMask | ctx->RdMask, ctx->WrMask | ctx->RdMask);
+    P16ComDedicRoute(Dev->Write, ctx->WrMask, ctx->WrSig, false);
+    P16ComDedicRoute(Dev->Read,  ctx->RdMask, ctx->RdSig, false);
+
+    Dev->BackendCtx = ctx;
+    P16Log("[P16ComDedicInit] Dedicated GPIO ready on CPU%d (WR ch%d, RD ch%d)", ctx->CoreId, offset + P16COM_DEDIC_CH_WR, offset + P16COM_DEDIC_CH_RD);
+    P16ReturnWithLog(STAT_OKE, "P16ComDedicInit() : STAT_OKE");
+}
+
+/// @brief Release the bundle taken by P16ComDedicInit()
+void P16ComDedicDeinit(P16Dev_t * Dev){
+    if(IsNull(Dev) || IsNull(Dev->BackendCtx)){
+        return;
+    }
+    P16ComDedic_t * ctx = (P16ComDedic_t *) Dev->BackendCtx;
+
+    dedic_gpio_del_bundle(ctx->Bundle);
+    /// Deleting the bundle does not restore the matrix
+    P16ComDedicRoute(Dev->Write, ctx->WrMask, ctx->WrSig, false);
+    ctx->WrOnCpu = 0;
+    P16ComDedicRoute(Dev->Read,  ctx->RdMask, ctx->RdSig, false);
+    free(ctx);
+
+    Dev->BackendCtx = NULL;
+}
+
+/// @brief Hand WR back to GPIO.out (idle high) if a write left it on the CPU channel
+void P16ComDedicReleaseWrite(P16Dev_t * Dev){
+    P16ComDedic_t * ctx = IsNotNull(Dev) ? (P16ComDedic_t *) Dev->BackendCtx : NULL;
+    if(IsNull(ctx) || !ctx->WrOnCpu){
+        return;
+    }
+    /// GPIO.out and the matrix are shared: this works from either core
+    P16ComDedicRoute(Dev->Write, ctx->WrMask, ctx->WrSig, false);
+    ctx->WrOnCpu = 0;
+}
+
+/// @brief Write one word, strobing WR through the CPU channel
+DefaultRet_t P16ComDedicWrite(P16Dev_t * Dev, P16Data_t Data){
+    return P16ComDedicWriteArray(Dev, &Data, 1);
+}
+
+/// @brief Burst write, strobing WR through the CPU channel
+DefaultRet_t IRAM_ATTR P16ComDedicWriteArray(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size){
+    P16ComDedic_t * ctx = P16ComDedicCtx(Dev, "P16ComDedicWriteArray");
+    if(IsNull(ctx)){
+        return STAT_ERR_INVALID_STATE;
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToOutput(Dev);
+    #endif
+
+    P16ComDedicTakeWrite(Dev, ctx);
+
+    /// Data lines are only re-driven when the word changes
+    const P16Lut_t * lut = Dev->Lut;
+    P16Data_t prevData = ~DataArr[0];
+    if(Dev->LutMode == P16COM_LUT_COMPACT){
+        /// WR is off GPIO.out now: a set / clear pair per new word, edges on the CPU channel
+        uint32_t datMask = (uint32_t) Dev->DatIOMask;
+        REPN(j, Size){
+            if(DataArr[j] != prevData){
+                prevData = DataArr[j];
+                P16Lut32DriveWord(datMask, P16Lut32Pattern(lut, prevData));
+                P16ComDedicFence();
+            }
+            P16ComDedicWritePulse(ctx);
+        }
+    } else {
+        REPN(j, Size){
+            if(DataArr[j] != prevData){
+                prevData = DataArr[j];
+                uint8_t low_byte = prevData & 0xFF;
+                uint8_t high_byte = (prevData >> 8) & 0xFF;
+                IOSet(lut->LutLow[low_byte].setMask | lut->LutHigh[high_byte].setMask);
+                IOClr(lut->LutLow[low_byte].clrMask | lut->LutHigh[high_byte].clrMask);
+                P16ComDedicFence();
+            }
+            P16ComDedicWritePulse(ctx);
+        }
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToInput(Dev);
+    #endif
+
+    return STAT_OKE;
+}
+
+/// @brief Repeat one word: data lines driven once, then `Count` WR strobes on the CPU channel
+DefaultRet_t IRAM_ATTR P16ComDedicWriteRepeat(P16Dev_t * Dev, P16Data_t Value, P16Size_t Count){
+    P16ComDedic_t * ctx = P16ComDedicCtx(Dev, "P16ComDedicWriteRepeat");
+    if(IsNull(ctx)){
+        return STAT_ERR_INVALID_STATE;
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToOutput(Dev);
+    #endif
+
+    P16ComDriveData(Dev, Value);
+    P16ComDedicFence();
+
+    P16ComDedicTakeWrite(Dev, ctx);
+    REPN(j, Count){
+        P16ComDedicWritePulse(ctx);
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 0)
+        P16BusToInput(Dev);
+    #endif
+
+    return STAT_OKE;
+}
+
+/// @brief Burst read, strobing RD through the CPU channel
+DefaultRet_t IRAM_ATTR P16ComDedicReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size){
+    P16ComDedic_t * ctx = P16ComDedicCtx(Dev, "P16ComDedicReadArray");
+    if(IsNull(ctx)){
+        return STAT_ERR_INVALID_STATE;
+    }
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
+        P16BusToInput(Dev);
+    #endif
+
+    P16ComDedicRoute(Dev->Read, ctx->RdMask, ctx->RdSig, true);
+
+    REPN(j, Size){
+        dedic_gpio_cpu_ll_write_mask(ctx->RdMask, 0);
+        P16BlockingDelay(P16HalfClockCycle);
+
+        pBuff[j] = P16ComSample(Dev);
+
+        dedic_gpio_cpu_ll_write_mask(ctx->RdMask, ctx->RdMask);
+        P16BlockingDelay(P16HalfClockCycle);
+    }
+
+    P16ComDedicRoute(Dev->Read, ctx->RdMask, ctx->RdSig, false);
+
+    #if (P16COM_DB_NORMAL_OUTPUT_EN == 1)
+        P16BusToOutput(Dev);
+    #endif
+
+    return STAT_OKE;
+}
+
+/// @brief Words per second of `Rounds` bursts that took `Us` microseconds
+static uint32_t P16ComDedicWordsPerSec(P16Size_t Size, uint32_t Rounds, int64_t Us){
+    if(Us <= 0){
+        return 0;
+    }
+    return (uint32_t)(((uint64_t) Size * Rounds * 1000000ULL) / (uint64_t) Us);
+}
+
+/// @brief Measure burst write throughput of the LUT path against the dedicated-GPIO path
+DefaultRet_t P16ComDedicBenchmark(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size, uint32_t Rounds){
+    P16Entry("P16ComDedicBenchmark(%p, %p, %d, %d)", Dev, DataArr, Size, Rounds);
+
+    if(IsNull(Dev) || IsNull(DataArr)){
+        P16ReturnWithLog(STAT_ERR_NULL, "P16ComDedicBenchmark() : STAT_ERR_NULL");
+    }
+    if(IsNotPos(Size) || (Rounds == 0)){
+        P16ReturnWithLog(STAT_ERR_INVALID_SIZE, "P16ComDedicBenchmark() : STAT_ERR_INVALID_SIZE");
+    }
+
+    /// Let an in-flight DMA burst finish, then deselect the panel so it ignores the traffic
+    P16ComWaitIdle(Dev);
+    P16SetHighChipSelPin(Dev);
+    /// The copies below drive the same WR pin: take it off the owner's channel first
+    if(Dev->Backend == P16COM_BACKEND_DEDIC_GPIO){
+        P16ComDedicReleaseWrite(Dev);
+    }
+
+    /// Private copy: same pins and LUT, own backend state
+    P16Dev_t bench = *Dev;
+    bench.Backend = P16COM_BACKEND_BITBANG;
+    bench.BackendCtx = NULL;
+
+    int64_t start = esp_timer_get_time();
+    for(uint32_t r = 0; r < Rounds; r++){
+        P16ComWriteArray(&bench, (P16Data_t *) DataArr, Size);
+    }
+    int64_t lutUs = esp_timer_get_time() - start;
+
+    DefaultRet_t ret = P16ComDedicInit(&bench);
+    if(ret != STAT_OKE){
+        P16ReturnWithLog(ret, "P16ComDedicBenchmark() : %s", DefaultReturnType2Str(ret));
+    }
+    bench.Backend = P16COM_BACKEND_DEDIC_GPIO;
+
+    start = esp_timer_get_time();
+    for(uint32_t r = 0; r < Rounds; r++){
+        P16ComDedicWriteArray(&bench, DataArr, Size);
+    }
+    int64_t dedicUs = esp_timer_get_time() - start;
+
+    P16ComDedicDeinit(&bench);
+
+    P16Log("[P16ComDedicBenchmark] %d words x %d: LUT %u words/s (%lld us), DEDIC %u words/s (%lld us)",
+            Size, Rounds,
+            P16ComDedicWordsPerSec(Size, Rounds, lutUs), lutUs,
+            P16ComDedicWordsPerSec(Size, Rounds, dedicUs), dedicUs);
+    P16ReturnWithLog(STAT_OKE, "P16ComDedicBenchmark() : STAT_OKE");
+}
+
+#endif /// (P16COM_DEDIC_GPIO_EN == 1)
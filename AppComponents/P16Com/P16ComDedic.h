@@ -0,0 +1,91 @@
+/**
+ * @file P16ComDedic.h
+ * @brief Dedicated-GPIO (CPU fast GPIO) bit-bang engine for the 16-bit parallel bus (ESP32-S3)
+ * @details The ESP32-S3 CPU owns 8 output channels that are toggled by a single
+ *          instruction instead of an APB store through the GPIO block. 8 channels cannot
+ *          carry D0..D15 + WR + RS, so only the strobes (WR, RD) are bundled: the data word
+ *          still goes out through GPIO.out (a set / clear pair with the compact LUT), and each WR/RD
+ *          edge becomes a one-cycle CPU write. WR is routed to its CPU channel by the first
+ *          write and stays there, so single-word writes do not pay two GPIO matrix stores
+ *          each; P16ComDedicReleaseWrite() hands it back to GPIO.out before anything strobes
+ *          it through the out register (command lists, LUT fallbacks). RD is only routed
+ *          for the duration of a read.
+ * @warning A bundle belongs to the core that created it: every call must run on the core
+ *          that executed P16ComInit() (pin the owner task). Calls from the other core are
+ *          logged as errors and take the LUT path.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __P16_COM_DEDIC_H__
+#define __P16_COM_DEDIC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppComponents/P16Com/P16ComDedic.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "P16Com.h"
+
+#if (P16COM_DEDIC_GPIO_EN == 1)
+
+/// @brief Set up a dedicated-GPIO bundle holding WR and RD on the calling core
+/// @param Dev Pointer to a configured P16Dev_t object (pins already set)
+/// @return STAT_OKE on success, error code otherwise (caller falls back to bit-bang)
+DefaultRet_t        P16ComDedicInit(P16Dev_t * Dev);
+
+/// @brief Release the bundle taken by P16ComDedicInit()
+/// @param Dev Pointer to the P16Dev_t object
+void                P16ComDedicDeinit(P16Dev_t * Dev);
+
+/// @brief Hand WR back to GPIO.out (idle high) if a write left it on the CPU channel
+/// @details Cheap when WR is already on GPIO.out; callable from either core.
+/// @param Dev Pointer to the P16Dev_t object
+void                P16ComDedicReleaseWrite(P16Dev_t * Dev);
+
+/// @brief Write one word, strobing WR through the CPU channel
+/// @param Dev Pointer to the P16Dev_t object
+/// @param Data The 16-bit value to write
+/// @return STAT_OKE, or STAT_ERR_INVALID_STATE when called from the wrong core
+DefaultRet_t        P16ComDedicWrite(P16Dev_t * Dev, P16Data_t Data);
+
+/// @brief Burst write, strobing WR through the CPU channel
+/// @param Dev Pointer to the P16Dev_t object
+/// @param DataArr Words to send
+/// @param Size Number of words
+/// @return STAT_OKE, or STAT_ERR_INVALID_STATE when called from the wrong core
+DefaultRet_t        P16ComDedicWriteArray(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size);
+
+/// @brief Repeat one word: data lines driven once, then `Count` WR strobes on the CPU channel
+/// @param Dev Pointer to the P16Dev_t object
+/// @param Value The 16-bit value to repeat
+/// @param Count Number of words
+/// @return STAT_OKE, or STAT_ERR_INVALID_STATE when called from the wrong core
+DefaultRet_t        P16ComDedicWriteRepeat(P16Dev_t * Dev, P16Data_t Value, P16Size_t Count);
+
+/// @brief Burst read, strobing RD through the CPU channel
+/// @param Dev Pointer to the P16Dev_t object
+/// @param pBuff Destination buffer
+/// @param Size Number of words
+/// @return STAT_OKE, or STAT_ERR_INVALID_STATE when called from the wrong core
+DefaultRet_t        P16ComDedicReadArray(P16Dev_t * Dev, P16Data_t * pBuff, P16Size_t Size);
+
+/// @brief Measure burst write throughput of the LUT path against the dedicated-GPIO path
+/// @details Runs on a private copy of `Dev` with CS held high, so the panel ignores the
+///          traffic. Results are logged in words per second.
+/// @param Dev Pointer to an initialized P16Dev_t object (any backend)
+/// @param DataArr Words to send (e.g. the canvas)
+/// @param Size Number of words per round
+/// @param Rounds Number of bursts per path
+/// @return STAT_OKE, or an error if the dedicated bundle could not be created
+DefaultRet_t        P16ComDedicBenchmark(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size, uint32_t Rounds);
+
+#endif /// (P16COM_DEDIC_GPIO_EN == 1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __P16_COM_DEDIC_H__
@@ -0,0 +1,321 @@
+/**
+ * @file P16ComDma.c
+ * @brief LCD_CAM i80 + GDMA backend for the 16-bit parallel bus (ESP32-S3)
+ * @author Nguyen Thanh Phu
+ */
+
+#include "P16ComDma.h"
+
+#if (P16COM_I80_DMA_EN == 1)
+
+#include "esp_intr_alloc.h"
+#include "esp_cache.h"
+#include "esp_memory_utils.h"
+#include "esp_rom_gpio.h"
+#include "esp_private/gdma.h"
+#include "esp_private/periph_ctrl.h"
+#include "hal/lcd_ll.h"
+#include "soc/lcd_cam_struct.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/interrupts.h"
+
+/// @brief Source clock of the LCD_CAM core (PLL_F160M)
+#define P16COM_DMA_SRC_CLK_HZ       160000000
+
+/// @brief Backend private state, stored in P16Dev_t::BackendCtx
+typedef struct P16ComDma_s {
+    lcd_cam_dev_t *         Hw;             ///< LCD_CAM register block
+    gdma_channel_handle_t   Chan;           ///< TX channel bound to LCD_CAM
+    intr_handle_t           Intr;           ///< TRANS_DONE interrupt
+    SemaphoreHandle_t       Done;           ///< Given by the ISR at end of transfer, held given while idle
+    P16DmaDesc_t *          Descs;          ///< Descriptor pool (internal, DMA capable)
+    volatile uint32_t       Busy;           ///< 1 while a transfer is in flight
+    volatile uint32_t       ReleaseCs;      ///< Raise CS from the ISR when done
+    Pin_t                   DatPins[P16COM_DAT_PIN_NUM];
+    Pin_t                   WritePin;
+    Pin_t                   RegSelPin;
+    Pin_t                   ChipSelPin;
+} P16ComDma_t;
+
+/// @brief LCD_CAM output signals for DB0..DB15 (kept in DRAM, used from the ISR)
+static const DRAM_ATTR uint16_t P16ComDmaDataSig[P16COM_DAT_PIN_NUM] = {
+    LCD_DATA_OUT0_IDX,  LCD_DATA_OUT1_IDX,  LCD_DATA_OUT2_IDX,  LCD_DATA_OUT3_IDX,
+    LCD_DATA_OUT4_IDX,  LCD_DATA_OUT5_IDX,  LCD_DATA_OUT6_IDX,  LCD_DATA_OUT7_IDX,
+    LCD_DATA_OUT8_IDX,  LCD_DATA_OUT9_IDX,  LCD_DATA_OUT10_IDX, LCD_DATA_OUT11_IDX,
+    LCD_DATA_OUT12_IDX, LCD_DATA_OUT13_IDX, LCD_DATA_OUT14_IDX, LCD_DATA_OUT15_IDX,
+};
+
+/// @brief Hand DB0..15, WR and RS to LCD_CAM (true) or back to the GPIO out register (false)
+/// @note  Matrix writes only (a few register stores), safe from ISR context.
+static void IRAM_ATTR P16ComDmaRoutePins(const P16ComDma_t * Ctx, bool ToLcdCam){
+    for(uint32_t i = 0; i < P16COM_DAT_PIN_NUM; i++){
+        esp_rom_gpio_connect_out_signal(Ctx->DatPins[i], ToLcdCam ? P16ComDmaDataSig[i] : SIG_GPIO_OUT_IDX, false, false);
+    }
+    esp_rom_gpio_connect_out_signal(Ctx->WritePin,  ToLcdCam ? LCD_PCLK_IDX : SIG_GPIO_OUT_IDX, false, false);
+    esp_rom_gpio_connect_out_signal(Ctx->RegSelPin, ToLcdCam ? LCD_DC_IDX   : SIG_GPIO_OUT_IDX, false, false);
+}
+
+/// @brief TRANS_DONE handler: give the bus back to the bit-bang path
+static void IRAM_ATTR P16ComDmaIsr(void * Arg){
+    P16ComDma_t * ctx = (P16ComDma_t *) Arg;
+    BaseType_t woken = pdFALSE;
+
+    uint32_t status = lcd_ll_get_interrupt_status(ctx->Hw);
+    lcd_ll_clear_interrupt_status(ctx->Hw, status);
+    if( !(status & LCD_LL_EVENT_TRANS_DONE) ){
+        return;
+    }
+
+    P16ComDmaRoutePins(ctx, false);
+    if(ctx->ReleaseCs){
+        IOStandardSet(Mask32(ctx->ChipSelPin));
+        ctx->ReleaseCs = 0;
+    }
+    ctx->Busy = 0;
+
+    xSemaphoreGiveFromISR(ctx->Done, &woken);
+    if(woken == pdTRUE){
+        portYIELD_FROM_ISR();
+    }
+}
+
+/// @brief Program the i80 engine for a data-only, DMA-terminated stream
+static void P16ComDmaSetupLcdCam(P16ComDma_t * Ctx){
+    lcd_cam_dev_t * hw = Ctx->Hw;
+
+    PERIPH_RCC_ATOMIC() {
+        lcd_ll_enable_bus_clock(0, true);
+        lcd_ll_reset_register(0);
+    }
+
+    /// Core clock: PLL_F160M / 1, then PCLK prescaler
+    lcd_ll_enable_clock(hw, true);
+    lcd_ll_select_clk_src(hw, LCD_CLK_SRC_PLL160M);
+    lcd_ll_set_group_clock_coeff(hw, 1, 0, 0);
+    lcd_ll_set_pixel_clock_prescale(hw, P16COM_DMA_SRC_CLK_HZ / P16COM_DMA_PCLK_HZ);
+    /// WR idles high, data changes on the falling edge and is latched on the rising one
+    lcd_ll_set_clock_idle_level(hw, true);
+    lcd_ll_set_pixel_clock_edge(hw, false);
+
+    lcd_ll_reset(hw);
+    lcd_ll_fifo_reset(hw);
+    lcd_ll_enable_rgb_mode(hw, false);
+    lcd_ll_set_dma_read_stride(hw, 16);
+    lcd_ll_set_data_wire_width(hw, 16);
+
+    /// No command/dummy phase: LCD32 still sends commands through the bit-bang path
+    lcd_ll_set_phase_cycles(hw, 0, 0, 1);
+    lcd_ll_set_blank_cycles(hw, 1, 1);
+    /// Data phase length is defined by the DMA EOF, not by a counter
+    lcd_ll_enable_output_always_on(hw, true);
+    /// RS (DC) stays high (data) for the whole transfer
+    lcd_ll_set_dc_level(hw, true, false, false, true);
+
+    lcd_ll_clear_interrupt_status(hw, UINT32_MAX);
+    lcd_ll_enable_interrupt(hw, LCD_LL_EVENT_TRANS_DONE, true);
+}
+
+/// @brief Set up LCD_CAM, the GDMA channel and the descriptor pool for `Dev`
+DefaultRet_t P16ComDmaInit(P16Dev_t * Dev){
+    P16Entry("P16ComDmaInit(%p)", Dev);
+
+    if(IsNull(Dev)){
+        P16ReturnWithLog(STAT_ERR_NULL, "P16ComDmaInit() : STAT_ERR_NULL");
+    }
+    if(IsNotNull(Dev->BackendCtx)){
+        P16ReturnWithLog(STAT_OKE, "P16ComDmaInit() : Already initialized");
+    }
+
+    P16ComDma_t * ctx = (P16ComDma_t *) heap_caps_calloc(1, sizeof(P16ComDma_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if(IsNull(ctx)){
+        P16Err("[P16ComDmaInit] Malloc failed for context");
+        P16ReturnWithLog(STAT_ERR_MALLOC_FAILED, "P16ComDmaInit() : STAT_ERR_MALLOC_FAILED");
+    }
+
+    ctx->Hw = &LCD_CAM;
+    REPN(i, P16COM_DAT_PIN_NUM){
+        ctx->DatPins[i] = Dev->DatPinArr[i];
+    }
+    ctx->WritePin   = Dev->Write;
+    ctx->RegSelPin  = Dev->RegSel;
+    ctx->ChipSelPin = Dev->ChipSel;
+
+    ctx->Descs = (P16DmaDesc_t *) heap_caps_calloc(P16COM_DMA_DESC_NUM, sizeof(P16DmaDesc_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    ctx->Done  = xSemaphoreCreateBinary();
+    if(IsNull(ctx->Descs) || IsNull(ctx->Done)){
+        P16Err("[P16ComDmaInit] Malloc failed for descriptors/semaphore");
+        goto fail;
+    }
+
+    /// GDMA TX channel wired to LCD_CAM
+    gdma_channel_alloc_config_t dmaCfg = {
+        .direction = GDMA_CHANNEL_DIRECTION_TX,
+    };
+    esp_err_t err = gdma_new_ahb_channel(&dmaCfg, &ctx->Chan);
+    if(err == ESP_OK) err = gdma_connect(ctx->Chan, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_LCD, 0));
+    if(err == ESP_OK){
+        gdma_strategy_config_t strategy = {
+            .auto_update_desc = true,
+            .owner_check = true,
+        };
+        err = gdma_apply_strategy(ctx->Chan, &strategy);
+    }
+    if(err == ESP_OK){
+        /// The canvas lives in PSRAM
+        gdma_transfer_config_t xfer = {
+            .max_data_burst_size = 32,
+            .access_ext_mem = true,
+        };
+        err = gdma_config_transfer(ctx->Chan, &xfer);
+    }
+    if(err != ESP_OK){
+        P16Err("[P16ComDmaInit] GDMA setup failed (%s)", esp_err_to_name(err));
+        goto fail;
+    }
+
+    P16ComDmaSetupLcdCam(ctx);
+
+    err = esp_intr_alloc(ETS_LCD_CAM_INTR_SOURCE, ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_LOWMED, P16ComDmaIsr, ctx, &ctx->Intr);
+    if(err != ESP_OK){
+        P16Err("[P16ComDmaInit] Interrupt alloc failed (%s)", esp_err_to_name(err));
+        goto fail;
+    }
+
+    Dev->BackendCtx = ctx;
+    P16Log("[P16ComDmaInit] i80 DMA ready: PCLK %d Hz, %d descriptors", P16COM_DMA_PCLK_HZ, P16COM_DMA_DESC_NUM);
+    P16ReturnWithLog(STAT_OKE, "P16ComDmaInit() : STAT_OKE");
+
+fail:
+    if(IsNotNull(ctx->Chan)){
+        gdma_disconnect(ctx->Chan);
+        gdma_del_channel(ctx->Chan);
+    }
+    if(IsNotNull(ctx->Done))  vSemaphoreDelete(ctx->Done);
+    if(IsNotNull(ctx->Descs)) heap_caps_free(ctx->Descs);
+    heap_caps_free(ctx);
+    P16ReturnWithLog(STAT_ERR_INIT_FAILED, "P16ComDmaInit() : STAT_ERR_INIT_FAILED");
+}
+
+/// @brief Release every resource taken by P16ComDmaInit()
+void P16ComDmaDeinit(P16Dev_t * Dev){
+    /// BackendCtx is shared by every backend
+    if(IsNull(Dev) || IsNull(Dev->BackendCtx) || (Dev->Backend != P16COM_BACKEND_I80_DMA)){
+        return;
+    }
+    P16ComDma_t * ctx = (P16ComDma_t *) Dev->BackendCtx;
+
+    P16ComDmaWaitIdle(Dev, P16COM_DMA_WAIT_TIMEOUT_MS);
+
+    lcd_ll_enable_interrupt(ctx->Hw, LCD_LL_EVENT_TRANS_DONE, false);
+    esp_intr_free(ctx->Intr);
+    gdma_disconnect(ctx->Chan);
+    gdma_del_channel(ctx->Chan);
+    vSemaphoreDelete(ctx->Done);
+    heap_caps_free(ctx->Descs);
+    heap_caps_free(ctx);
+
+    Dev->BackendCtx = NULL;
+}
+
+/// @brief Kick one transfer of at most P16COM_DMA_MAX_TRANSFER_BYTES
+static DefaultRet_t P16ComDmaStart(P16ComDma_t * Ctx, const P16Data_t * DataArr, uint32_t Bytes, bool ReleaseCs){
+    int32_t used = P16ComDmaDescBuild(Ctx->Descs, P16COM_DMA_DESC_NUM, DataArr, Bytes);
+    if(used < 0){
+        return used;
+    }
+
+    /// Canvas may sit in cached PSRAM: write dirty lines back before the DMA reads them
+    if(esp_ptr_external_ram(DataArr)){
+        esp_cache_msync((void *) DataArr, Bytes, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    }
+
+    /// Busy first, then clear the completion of the previous transfer (it stays given while
+    /// idle): a waiter still passing it on sees Busy and does not give it back
+    Ctx->ReleaseCs = ReleaseCs ? 1 : 0;
+    Ctx->Busy = 1;
+    xSemaphoreTake(Ctx->Done, 0);
+
+    P16ComDmaRoutePins(Ctx, true);
+    lcd_ll_fifo_reset(Ctx->Hw);
+    gdma_reset(Ctx->Chan);
+    gdma_start(Ctx->Chan, (intptr_t) Ctx->Descs);
+    /// Give the DMA time to prefill the LCD FIFO before the engine starts clocking
+    esp_rom_delay_us(1);
+    lcd_ll_start(Ctx->Hw);
+
+    return STAT_OKE;
+}
+
+/// @brief Stream `Size` words through the i80 engine
+DefaultRet_t P16ComDmaWrite(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size, uint32_t Flags){
+    if(IsNull(Dev) || IsNull(Dev->BackendCtx) || IsNull(DataArr)){
+        return STAT_ERR_NULL;
+    }
+    if(IsNotPos(Size)){
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    P16ComDma_t * ctx = (P16ComDma_t *) Dev->BackendCtx;
+    uint32_t bytesLeft = (uint32_t) Size * sizeof(P16Data_t);
+    bool isAsync = (Flags & P16COM_DMA_FLAG_ASYNC) != 0;
+    bool releaseCs = (Flags & P16COM_DMA_FLAG_RELEASE_CS) != 0;
+
+    if(isAsync && (bytesLeft > P16COM_DMA_MAX_TRANSFER_BYTES)){
+        P16Err("[P16ComDmaWrite] Async transfer of %d words exceeds the descriptor pool", Size);
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    /// Only one transfer in flight
+    DefaultRet_t ret = P16ComDmaWaitIdle(Dev, P16COM_DMA_WAIT_TIMEOUT_MS);
+    if(ret != STAT_OKE){
+        return ret;
+    }
+
+    const uint8_t * src = (const uint8_t *) DataArr;
+    while(bytesLeft > 0){
+        uint32_t bytes = Min(bytesLeft, (uint32_t) P16COM_DMA_MAX_TRANSFER_BYTES);
+        bool isLast = (bytes == bytesLeft);
+
+        ret = P16ComDmaStart(ctx, (const P16Data_t *) src, bytes, isLast && releaseCs);
+        if(ret != STAT_OKE){
+            return ret;
+        }
+        if(isAsync){
+            return STAT_OKE;
+        }
+
+        ret = P16ComDmaWaitIdle(Dev, P16COM_DMA_WAIT_TIMEOUT_MS);
+        if(ret != STAT_OKE){
+            return ret;
+        }
+        src       += bytes;
+        bytesLeft -= bytes;
+    }
+
+    return STAT_OKE;
+}
+
+/// @brief Block until the running transfer (if any) has completed
+DefaultRet_t P16ComDmaWaitIdle(P16Dev_t * Dev, uint32_t TimeoutMs){
+    if(IsNull(Dev) || IsNull(Dev->BackendCtx)){
+        return STAT_OKE;
+    }
+    P16ComDma_t * ctx = (P16ComDma_t *) Dev->BackendCtx;
+
+    if( !ctx->Busy ){
+        return STAT_OKE;
+    }
+    if(xSemaphoreTake(ctx->Done, MsToTicks(TimeoutMs)) != pdTRUE){
+        P16Err("[P16ComDmaWaitIdle] Transfer timeout!");
+        return STAT_ERR_TIMEOUT;
+    }
+    /// Any number of tasks may wait (the flush task, LCD32WaitFlush() callers): the
+    /// completion is given back so the next waiter wakes too. P16ComDmaStart() takes it
+    /// again; once a new transfer is in flight the remaining waiters wait for that one.
+    if( !ctx->Busy ){
+        xSemaphoreGive(ctx->Done);
+    }
+    return STAT_OKE;
+}
+
+#endif /// (P16COM_I80_DMA_EN == 1)
@@ -0,0 +1,82 @@
+/**
+ * @file P16ComDma.h
+ * @brief LCD_CAM i80 + GDMA backend for the 16-bit parallel bus (ESP32-S3)
+ * @details Streams word arrays through the LCD_CAM i80 engine so bulk writes run at the
+ *          bus clock without CPU involvement. Only data lines, WR (PCLK) and RS (DC) are
+ *          handed to the peripheral, and only for the duration of a transfer; CS, RD and
+ *          RST stay plain GPIOs so the bit-bang path keeps working in between.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __P16_COM_DMA_H__
+#define __P16_COM_DMA_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppComponents/P16Com/P16ComDma.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "P16Com.h"
+#include "P16ComDmaDesc.h"
+
+#if (P16COM_I80_DMA_EN == 1)
+
+#ifndef P16COM_DMA_PCLK_HZ
+    /// @brief WR strobe frequency of the i80 engine
+    /// @note ILI9341 write cycle is >= 66 ns, 10 MHz keeps a comfortable margin
+    #define P16COM_DMA_PCLK_HZ              10000000
+#endif
+
+#ifndef P16COM_DMA_MAX_TRANSFER_BYTES
+    /// @brief Largest single transfer (sizes the descriptor pool): one 320x240 RGB565 frame
+    #define P16COM_DMA_MAX_TRANSFER_BYTES   (320 * 240 * 2)
+#endif
+
+/// @brief Number of descriptors allocated for one transfer
+#define P16COM_DMA_DESC_NUM             P16ComDmaDescCount(P16COM_DMA_MAX_TRANSFER_BYTES)
+
+/// @brief Timeout used by blocking waits on the DMA engine (ms)
+#define P16COM_DMA_WAIT_TIMEOUT_MS      1000
+
+/// @brief Flags for P16ComDmaWrite()
+enum P16ComDmaFlag_e {
+    P16COM_DMA_FLAG_ASYNC       = 0x00000001, ///< Return as soon as the transfer is started
+    P16COM_DMA_FLAG_RELEASE_CS  = 0x00000002, ///< Drive CS high from the ISR at end of transfer
+};
+
+/// @brief Set up LCD_CAM, the GDMA channel and the descriptor pool for `Dev`
+/// @param Dev Pointer to a configured P16Dev_t object (pins already set)
+/// @return STAT_OKE on success, error code otherwise (caller falls back to bit-bang)
+DefaultRet_t        P16ComDmaInit(P16Dev_t * Dev);
+
+/// @brief Release every resource taken by P16ComDmaInit()
+/// @param Dev Pointer to the P16Dev_t object
+void                P16ComDmaDeinit(P16Dev_t * Dev);
+
+/// @brief Stream `Size` words through the i80 engine
+/// @details Transfers larger than P16COM_DMA_MAX_TRANSFER_BYTES are split and sent
+///          back-to-back; they are only accepted in blocking mode.
+/// @param Dev Pointer to the P16Dev_t object
+/// @param DataArr Words to send (internal RAM or PSRAM)
+/// @param Size Number of words
+/// @param Flags OR of P16ComDmaFlag_e
+/// @return STAT_OKE, STAT_ERR_TIMEOUT or an argument error
+DefaultRet_t        P16ComDmaWrite(P16Dev_t * Dev, const P16Data_t * DataArr, P16Size_t Size, uint32_t Flags);
+
+/// @brief Block until the running transfer (if any) has completed
+/// @details Several tasks may wait on the same transfer; all of them return when it ends.
+/// @param Dev Pointer to the P16Dev_t object
+/// @param TimeoutMs Maximum time to wait
+/// @return STAT_OKE or STAT_ERR_TIMEOUT
+DefaultRet_t        P16ComDmaWaitIdle(P16Dev_t * Dev, uint32_t TimeoutMs);
+
+#endif /// (P16COM_I80_DMA_EN == 1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __P16_COM_DMA_H__
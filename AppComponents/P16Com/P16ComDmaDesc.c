@@ -0,0 +1,85 @@
+/**
+ * @file P16ComDmaDesc.c
+ * @brief GDMA descriptor chain builder for the P16Com i80 DMA backend
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "P16ComDmaDesc.h"
+
+/// @brief Build a descriptor chain covering `Bytes` bytes of `Buff`
+int32_t P16ComDmaDescBuild(P16DmaDesc_t * Descs, uint32_t DescNum, const void * Buff, uint32_t Bytes){
+    if((Descs == NULL) || (Buff == NULL)){
+        return STAT_ERR_NULL;
+    }
+
+    /// The i80 engine shifts out whole 16-bit words
+    if((Bytes == 0) || (Bytes & 0x1)){
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    uint32_t needed = P16ComDmaDescCount(Bytes);
+    if(needed > DescNum){
+        return STAT_ERR_OVERFLOW;
+    }
+
+    const uint8_t * src = (const uint8_t *) Buff;
+    uint32_t left = Bytes;
+
+    for(uint32_t i = 0; i < needed; i++){
+        uint32_t chunk = (left > P16COM_DMA_DESC_CHUNK) ? P16COM_DMA_DESC_CHUNK : left;
+
+        Descs[i].dw0.size       = chunk;
+        Descs[i].dw0.length     = chunk;
+        Descs[i].dw0.reserved24 = 0;
+        Descs[i].dw0.err_eof    = 0;
+        Descs[i].dw0.reserved29 = 0;
+        Descs[i].dw0.suc_eof    = (i == needed - 1) ? 1 : 0;
+        Descs[i].dw0.owner      = P16COM_DMA_DESC_OWNER_DMA;
+        Descs[i].buffer         = (void *) src;
+        Descs[i].next           = (i == needed - 1) ? NULL : &Descs[i + 1];
+
+        src  += chunk;
+        left -= chunk;
+    }
+
+    return (int32_t) needed;
+}
+
+/// @brief Walk a chain the way the GDMA engine would and copy the payload out
+int32_t P16ComDmaDescReplay(const P16DmaDesc_t * Head, void * Out, uint32_t OutCap){
+    if(Head == NULL){
+        return STAT_ERR_NULL;
+    }
+
+    uint8_t * dst = (uint8_t *) Out;
+    uint32_t total = 0;
+    const P16DmaDesc_t * desc = Head;
+
+    while(desc != NULL){
+        /// The engine stops (owner error) on a link it does not own
+        if(desc->dw0.owner != P16COM_DMA_DESC_OWNER_DMA){
+            return STAT_ERR_INVALID_STATE;
+        }
+        if((desc->dw0.length > desc->dw0.size) || (desc->buffer == NULL)){
+            return STAT_ERR_INVALID_SIZE;
+        }
+
+        if(dst != NULL){
+            if(total + desc->dw0.length > OutCap){
+                return STAT_ERR_OVERFLOW;
+            }
+            memcpy(dst + total, desc->buffer, desc->dw0.length);
+        }
+        total += desc->dw0.length;
+
+        if(desc->dw0.suc_eof){
+            return (int32_t) total;
+        }
+        desc = desc->next;
+    }
+
+    /// Chain ended without an EOF mark: the engine would hang waiting for more
+    return STAT_ERR_INVALID_STATE;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file P16ComDmaDesc.h
+ * @brief GDMA descriptor chain builder for the P16Com i80 DMA backend
+ * @details Hardware independent on purpose: only builds/walks linked lists laid out
+ *          like the ESP32-S3 AHB GDMA descriptor, so the chunking logic can be compiled
+ *          and checked on a Linux host (see P16ComDmaDescReplay()).
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __P16_COM_DMA_DESC_H__
+#define __P16_COM_DMA_DESC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppComponents/P16Com/P16ComDmaDesc.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../../AppUtils/ReturnType.h"
+
+/// @brief Largest buffer a single descriptor can carry (12-bit length field)
+#define P16COM_DMA_DESC_LEN_MAX         4095
+
+/// @brief Bytes carried per descriptor when chunking a stream
+/// @note 4032 = 63 * 64: fits the 12-bit field and keeps every chunk aligned to the
+///       64-byte PSRAM burst block when the source buffer itself is aligned.
+#define P16COM_DMA_DESC_CHUNK           4032
+
+/// @brief Descriptor is owned by the DMA engine (CPU must not touch it)
+#define P16COM_DMA_DESC_OWNER_DMA       1
+/// @brief Descriptor is owned by the CPU
+#define P16COM_DMA_DESC_OWNER_CPU       0
+
+/// @brief Number of descriptors needed to carry `bytes` bytes
+#define P16ComDmaDescCount(bytes)       (((bytes) + P16COM_DMA_DESC_CHUNK - 1) / P16COM_DMA_DESC_CHUNK)
+
+/// @brief One link of a GDMA descriptor chain
+/// @details Bit layout matches the AHB GDMA descriptor of the ESP32-S3 (dw0, buffer, next).
+typedef struct P16DmaDesc_s {
+    struct {
+        uint32_t size       : 12;   ///< Buffer size in bytes
+        uint32_t length     : 12;   ///< Number of valid bytes in the buffer
+        uint32_t reserved24 : 4;    ///< Reserved
+        uint32_t err_eof    : 1;    ///< Set by hardware on receive error
+        uint32_t reserved29 : 1;    ///< Reserved
+        uint32_t suc_eof    : 1;    ///< Last descriptor of the transfer
+        uint32_t owner      : 1;    ///< 1: DMA, 0: CPU
+    } dw0;
+    void *buffer;                   ///< Pointer to the payload
+    struct P16DmaDesc_s *next;      ///< Next descriptor, NULL at the end of the chain
+} P16DmaDesc_t;
+
+/// @brief Build a descriptor chain covering `Bytes` bytes of `Buff`
+/// @param Descs Descriptor storage (must be DMA reachable on target)
+/// @param DescNum Number of descriptors available in `Descs`
+/// @param Buff Source buffer
+/// @param Bytes Number of bytes to transfer (must be even for a 16-bit bus)
+/// @return Number of descriptors used (> 0), or a negative DefaultRet_e on error
+int32_t             P16ComDmaDescBuild(P16DmaDesc_t * Descs, uint32_t DescNum, const void * Buff, uint32_t Bytes);
+
+/// @brief Walk a chain the way the GDMA engine would and copy the payload out
+/// @details Host-side stand-in for the DMA engine: follows `next` until `suc_eof`,
+///          refuses CPU-owned links, and concatenates `length` bytes of every buffer.
+/// @param Head First descriptor of the chain
+/// @param Out Destination buffer (may be NULL to only count bytes)
+/// @param OutCap Capacity of `Out` in bytes
+/// @return Total payload bytes, or a negative DefaultRet_e on a malformed chain
+int32_t             P16ComDmaDescReplay(const P16DmaDesc_t * Head, void * Out, uint32_t OutCap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __P16_COM_DMA_DESC_H__
@@ -73,7 +73,28 @@ enum PIN_STATE_e {
 #endif
 
 #if FIRMWARE_TYPE == TYPE_ANALYZER_READER
-    /// Reserved
+
+    /// Logic analyzer inputs, channel n = sample bit n
+    #define AR_CH0          1
+    #define AR_CH1          2
+    #define AR_CH2          4
+    #define AR_CH3          5
+    #define AR_CH4          6
+    #define AR_CH5          7
+    #define AR_CH6          8
+    #define AR_CH7          9
+    #define AR_CH8          10
+    #define AR_CH9          11
+    #define AR_CH10         12
+    #define AR_CH11         13
+    #define AR_CH12         14
+    #define AR_CH13         15
+    #define AR_CH14         16
+    #define AR_CH15         17
+
+    /// Sample clock: CAM_CLK out, looped back into CAM_PCLK (leave unconnected)
+    #define AR_SCLK         18
+
 #endif
 
 
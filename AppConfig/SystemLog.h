@@ -12,16 +12,51 @@ extern "C" {
 #include <stdint.h>
 #include <stdlib.h>
 
-#define SYSTEM_LOG_EN               1
-#define SYSTEM_ERR_EN               1
-#define SYSTEM_LOG_L1_EN            1
-#define SYSTEM_LOG_L2_EN            1
-#define SYSTEM_LOG_EXIT_L1_EN       1
-#define SYSTEM_LOG_EXIT_L2_EN       1
-#define SYSTEM_LOG_ENTRY_L1_EN      1
-#define SYSTEM_LOG_ENTRY_L2_EN      1
-
-#define SYSTEM_SAFE_THREAD_LOG_EN   1
+/// @brief Log levels: a module logs the levels up to its own, every call above it is
+///        removed by the preprocessor (no code, no format string in the image)
+#define SYS_LOG_LEVEL_NONE          0   ///< Nothing
+#define SYS_LOG_LEVEL_ERR           1   ///< Errors
+#define SYS_LOG_LEVEL_WARN          2   ///< Warnings
+#define SYS_LOG_LEVEL_INFO          3   ///< Standard messages (Log)
+#define SYS_LOG_LEVEL_VERB          4   ///< Verbose messages (Log1 / LogVer)
+#define SYS_LOG_LEVEL_TRACE         5   ///< Function entry / exit
+
+/// @brief True in `#if` when a module at level `mod` logs level `lvl` (SYSTEM_LOG_LEVEL caps all)
+#define SysLogLevelOn(mod, lvl)     (((mod) >= (lvl)) && (SYSTEM_LOG_LEVEL >= (lvl)))
+
+/// @brief Highest level any module may log; Sys* calls outside modules use it directly
+#ifndef SYSTEM_LOG_LEVEL
+#define SYSTEM_LOG_LEVEL            SYS_LOG_LEVEL_TRACE
+#endif
+
+/// @brief Per-module levels (a build flag or a file defining one first takes precedence)
+#ifndef P16COM_LOG_LEVEL
+#define P16COM_LOG_LEVEL            SYS_LOG_LEVEL_INFO
+#endif
+#ifndef LCD32_LOG_LEVEL
+#define LCD32_LOG_LEVEL             SYS_LOG_LEVEL_INFO
+#endif
+#ifndef AR_LOG_LEVEL
+#define AR_LOG_LEVEL                SYS_LOG_LEVEL_VERB
+#endif
+
+/// @brief Shortest interval between two lines of one rate-limited (Hot) call site
+#define SYSTEM_LOG_HOT_MS           1000
+
+#define SYSTEM_LOG_EN               (SYSTEM_LOG_LEVEL > SYS_LOG_LEVEL_NONE)
+#define SYSTEM_ERR_EN               (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_ERR)
+#define SYSTEM_WARN_EN              (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_WARN)
+#define SYSTEM_INFO_EN              (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_INFO)
+#define SYSTEM_LOG_L1_EN            (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_INFO)
+#define SYSTEM_LOG_L2_EN            (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_VERB)
+#define SYSTEM_LOG_EXIT_L1_EN       (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_TRACE)
+#define SYSTEM_LOG_EXIT_L2_EN       (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_TRACE)
+#define SYSTEM_LOG_ENTRY_L1_EN      (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_TRACE)
+#define SYSTEM_LOG_ENTRY_L2_EN      (SYSTEM_LOG_LEVEL >= SYS_LOG_LEVEL_TRACE)
+
+#define SYSTEM_SAFE_THREAD_LOG_EN   1     /// 1: deferred binary log (CoreLogTask prints), 0: direct ets_printf
+#define SYSTEM_LOG_DEPTH            64    /// Deferred records per core
+#define SYSTEM_LOG_DRAIN_MS         10    /// CoreLogTask sleep when the rings are empty
 
 #ifdef __cplusplus
 }
@@ -31,32 +31,24 @@ void TaskSystemMonitor(void * pv) {
     while(1) {
         // --- Task List (like top) ---
         vTaskList(task_stats_buffer);
-        // Use a critical section to prevent log output from being interleaved by other tasks.
-        #if (SYSTEM_SAFE_THREAD_LOG_EN == 1)
-            portENTER_CRITICAL(&__LogSpinLock);
-        #endif
+        // Hold the console so the log task does not print between these lines.
+        CoreLogLock();
         ets_printf("[%lld] [log] [Monitor] --- Task States & Stack Usage (vTaskList) ---\n", esp_timer_get_time());
         ets_printf("Task Name\t\tStatus\tPrio\tHWM (bytes)\tTask#\n");
         ets_printf("****************************************************************\n");
         ets_printf("%s", task_stats_buffer);
         ets_printf("****************************************************************\n\n");
-        #if (SYSTEM_SAFE_THREAD_LOG_EN == 1)
-            portEXIT_CRITICAL(&__LogSpinLock);
-        #endif
+        CoreLogUnlock();
 
         // --- CPU Usage ---
         vTaskGetRunTimeStats(task_stats_buffer);
-        #if (SYSTEM_SAFE_THREAD_LOG_EN == 1)
-            portENTER_CRITICAL(&__LogSpinLock);
-        #endif
+        CoreLogLock();
         ets_printf("[%lld] [log] [Monitor] --- Task CPU Usage (vTaskGetRunTimeStats) ---\n", esp_timer_get_time());
         ets_printf("Task Name\t\tAbs Time (us)\t\t%%CPU\n");
         ets_printf("****************************************************************\n");
         ets_printf("%s", task_stats_buffer);
         ets_printf("****************************************************************\n\n");
-        #if (SYSTEM_SAFE_THREAD_LOG_EN == 1)
-            portEXIT_CRITICAL(&__LogSpinLock);
-        #endif
+        CoreLogUnlock();
 
         // --- Heap Memory ---
         size_t total_free_heap = esp_get_free_heap_size();
@@ -107,6 +99,9 @@ void TaskScreen(void * pv){
         return;
     }
 
+    // 3b. Stream pixels through LCD_CAM + GDMA (P16ComInit falls back to bit-bang on failure)
+    P16ComSelectBackend(&(lcd32->P16Com), P16COM_BACKEND_I80_DMA);
+
     // 4. Initialize the LCD hardware
     if (LCD32Init(lcd32) != STAT_OKE) {
         SysErr("[TaskScreen] LCD32Init failed.");
@@ -114,6 +109,28 @@ void TaskScreen(void * pv){
         vTaskDelete(NULL);
         return;
     }
+
+    #if (P16COM_DEDIC_GPIO_EN == 1)
+        // 4b. Bus throughput: LUT strobes vs dedicated-GPIO strobes (CS held high, panel ignores it)
+        P16ComDedicBenchmark(&(lcd32->P16Com), (const P16Data_t *) lcd32->Canvas, lcd32->Width * lcd32->Height, 4);
+    #endif
+
+    // 4c. Read throughput and bus turn-around cost (CS held high, scratch buffer freed right after)
+    {
+        P16Size_t benchWords = 2048;
+        P16Data_t * benchBuf = (P16Data_t *) heap_caps_malloc(benchWords * sizeof(P16Data_t), MALLOC_CAP_INTERNAL);
+        if (benchBuf != NULL) {
+            P16ComReadBenchmark(&(lcd32->P16Com), benchBuf, benchWords, 4);
+            heap_caps_free(benchBuf);
+        }
+    }
+
+    #if (LCD32_DOUBLE_BUFFER_EN == 1)
+        // 4d. Frames handed over with LCD32SwapBuffers() are sent by a task on CPU1
+        if (LCD32StartFlushTask(lcd32) != STAT_OKE) {
+            SysErr("[TaskScreen] LCD32StartFlushTask failed, staying single-buffered.");
+        }
+    #endif
     
     // 5. Main loop: Test all drawing functions cyclically
     while (1){
@@ -136,6 +153,157 @@ void TaskScreen(void * pv){
             DelayMs(1000);
         }
 
+        // --- Test 0b: LCD32FlushDirty (only the changed tiles go out) ---
+        {
+            SysLog("[TaskScreen] Testing: LCD32FlushDirty");
+            int64_t start_time = esp_timer_get_time();
+            LCD32DrawText(lcd32, 20, 10, "CH1 1.00V 10us", &fontBody, (Color_t)esp_random());
+            LCD32FlushDirty(lcd32);
+            uint32_t flush_duration_us = (uint32_t)(esp_timer_get_time() - start_time);
+            SysLog("[TaskScreen] Readout update: %u us", flush_duration_us);
+            DelayMs(500);
+        }
+
+        // --- Test 0c: LCD32SwapBuffers (drawing frame N+1 overlaps sending frame N) ---
+        {
+            SysLog("[TaskScreen] Testing: LCD32SwapBuffers");
+            int64_t start_time = esp_timer_get_time();
+            for (int f = 0; f < 20; f++) {
+                LCD32FillCanvas(lcd32, (Color_t)esp_random());
+                for (int i = 0; i < 10; i++) {
+                    LCD32DrawLine(lcd32, rand_coord(lcd32->Height, 0), rand_coord(lcd32->Width, 0),
+                                  rand_coord(lcd32->Height, 0), rand_coord(lcd32->Width, 0), (Color_t)esp_random());
+                }
+                LCD32SwapBuffers(lcd32);
+            }
+            uint32_t duration_ms = (uint32_t)((esp_timer_get_time() - start_time) / 1000);
+            SysLog("[TaskScreen] 20 double-buffered frames: %u ms", duration_ms);
+            DelayMs(500);
+        }
+
+        #if (LCD32_STRIP_RENDER_EN == 1)
+        // --- Test 0d: Strip renderer (display list rasterized in 16-row bands, no canvas) ---
+        {
+            SysLog("[TaskScreen] Testing: Strip renderer");
+            #if (LCD32_DOUBLE_BUFFER_EN == 1)
+                LCD32StopFlushTask(lcd32);
+            #endif
+            if (LCD32SetRenderMode(lcd32, LCD32_RENDER_STRIP) == STAT_OKE) {
+                int64_t start_time = esp_timer_get_time();
+                LCD32FillCanvas(lcd32, COLOR_BLACK);
+                for (int i = 0; i < 30; i++) {
+                    LCD32DrawLine(lcd32, rand_coord(lcd32->Height, 0), rand_coord(lcd32->Width, 0),
+                                  rand_coord(lcd32->Height, 0), rand_coord(lcd32->Width, 0), (Color_t)esp_random());
+                }
+                LCD32DrawText(lcd32, 20, 10, "CH1 1.00V 10us", &fontBody, COLOR_WHITE);
+                LCD32FlushCanvas(lcd32);
+                uint32_t duration_us = (uint32_t)(esp_timer_get_time() - start_time);
+                SysLog("[TaskScreen] Strip frame (30 lines + text): %u us", duration_us);
+                LCD32SetRenderMode(lcd32, LCD32_RENDER_CANVAS);
+            }
+            #if (LCD32_DOUBLE_BUFFER_EN == 1)
+                LCD32StartFlushTask(lcd32);
+            #endif
+            DelayMs(500);
+        }
+        #endif
+
+        // --- Test 0e: Scope sweep + spectrum + measurement readout overlay ---
+        {
+            SysLog("[TaskScreen] Testing: Measurement overlay + spectrum");
+            /// Sweep and spectrum of a generated 1 kHz square, generated every frame; the readout
+            /// is the latest one published by a scope task, else this square measured here
+            static ARScopeSynth_t synth;
+            static ARSample_t samples[4000];
+            static uint16_t codes[4000];
+            static ARMeasure_t meas;
+            ARMeasResult_t res;
+            uint32_t measured = ARMeasureLatest(0, &res);
+            ARScopeSynthInit(&synth, 0x0001, 1);
+            ARScopeSynthSetWave(&synth, 0, AR_WAVE_SQUARE, 40, 2048, 1200, 20);
+            if (measured == 0) {
+                ARMeasureInit(&meas, 40000, 3100);
+            }
+            for (int w = 0; w < 2; w++) {
+                ARScopeSynthFill(&synth, samples, 4000);
+                uint32_t num = ARScopeExtract(samples, 4000, 0, codes);
+                if (measured == 0) {
+                    ARMeasureFeed(&meas, codes, num);
+                    ARMeasureFinish(&meas, &res);
+                }
+            }
+            /// Spectrum of the same codes, 1024 points per run, tables built on the first pass
+            static ARSpectrum_t spec;
+            static void * specMem = NULL;
+            if (specMem == NULL) {
+                specMem = heap_caps_malloc(ARSpectrumBytes(1024), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+                if ((specMem != NULL) && (ARSpectrumInit(&spec, specMem, ARSpectrumBytes(1024), 1024, AR_WIN_HANN, 1) != STAT_OKE)) {
+                    heap_caps_free(specMem);
+                    specMem = NULL;
+                }
+            }
+            int64_t start_time = esp_timer_get_time();
+            LCD32FillCanvas(lcd32, COLOR_BLACK);
+            /// Sweep on the upper half, spectrum (0 .. -100 dBFS) on the lower half
+            Dim_t half = lcd32->Height / 2;
+            ARWaveView_t wave = { .Top = 10, .Left = 0, .Width = lcd32->Width, .Height = half - 20, .Color = COLOR_YELLOW };
+            ARTraceDrawWave(lcd32, &wave, codes, 4000, 0, 1 << AR_SCOPE_TRIG_FRAC_BITS);
+            if (specMem != NULL) {
+                ARSpectrumReset(&spec);
+                for (int k = 0; k + 1024 <= 4000; k += 1024) {
+                    ARSpectrumRun(&spec, &codes[k]);
+                }
+                ARSpecView_t view = { .Top = half + 10, .Left = 0, .Width = lcd32->Width, .Height = half - 20,
+                                      .DbTop = 0, .DbSpan = 1000, .Color = COLOR_CYAN, .PeakColor = COLOR_LRED };
+                ARTraceDrawSpectrum(lcd32, &view, &spec, 1, ARSpectrumBins(&spec));
+            }
+            ARTraceDrawReadout(lcd32, 20, 10, &fontBody, &res,
+                               (1U << AR_MEAS_FREQ) | (1U << AR_MEAS_DUTY) | (1U << AR_MEAS_VPP) | (1U << AR_MEAS_VRMS), COLOR_WHITE);
+            LCD32FlushCanvas(lcd32);
+            SysLog("[TaskScreen] Sweep + spectrum + readout frame: %u us", (uint32_t)(esp_timer_get_time() - start_time));
+            DelayMs(500);
+        }
+
+        // --- Test 0f: Decoded events handed over by TaskReader (ARDecodeLink) ---
+        {
+            SysLog("[TaskScreen] Testing: Decoded event list");
+            /// Every waiting block is read and given back; the newest lines are drawn
+            enum { LINES = 12 };
+            static char lines[LINES][32];
+            uint32_t next = 0, events = 0, blocks = 0;
+            SpscBlock_t blk;
+            while (ARLinkPop(&ARDecodeLink, &blk) == STAT_OKE) {
+                if (blk.Tag == AR_LINK_SPI) {
+                    const ARSpiEvent_t * ev = (const ARSpiEvent_t *) blk.Data;
+                    for (uint32_t i = 0; i < blk.Len / sizeof(ARSpiEvent_t); i++, events++) {
+                        if (ev[i].Kind == AR_SPI_EV_WORD) {
+                            snprintf(lines[next++ % LINES], sizeof(lines[0]), "SPI %08lX/%08lX", (unsigned long) ev[i].Mosi, (unsigned long) ev[i].Miso);
+                        }
+                    }
+                } else if (blk.Tag == AR_LINK_I2C) {
+                    const ARI2cEvent_t * ev = (const ARI2cEvent_t *) blk.Data;
+                    for (uint32_t i = 0; i < blk.Len / sizeof(ARI2cEvent_t); i++, events++) {
+                        if ((ev[i].Kind == AR_I2C_EV_ADDRESS) || (ev[i].Kind == AR_I2C_EV_DATA)) {
+                            snprintf(lines[next++ % LINES], sizeof(lines[0]), "I2C %s %02lX %s", (ev[i].Kind == AR_I2C_EV_ADDRESS) ? (ev[i].Rw ? "R" : "W") : "D",
+                                     (unsigned long) ev[i].Value, ev[i].Ack ? "ACK" : "NACK");
+                        }
+                    }
+                }
+                ARLinkRelease(&ARDecodeLink, blk.Data);
+                blocks++;
+            }
+            if (next > 0) {
+                LCD32FillCanvas(lcd32, COLOR_BLACK);
+                uint32_t shown = (next < LINES) ? next : LINES;
+                for (uint32_t l = 0; l < shown; l++) {
+                    LCD32DrawText(lcd32, 20 + l * fontBody.yAdvance, 10, lines[(next - shown + l) % LINES], &fontBody, COLOR_GREEN);
+                }
+                LCD32FlushCanvas(lcd32);
+            }
+            SysLog("[TaskScreen] %u events in %u blocks, %u dropped by the reader so far", events, blocks, ARDecodeLink.Dropped);
+            DelayMs(500);
+        }
+
         // --- Test 1: LCD32SetCanvasPixel ---
         SysLog("[TaskScreen] Testing: LCD32SetCanvasPixel");
         LCD32FillCanvas(lcd32, (Color_t)esp_random());
@@ -158,6 +326,23 @@ void TaskScreen(void * pv){
         }
         DelayMs(500);
 
+        // --- Test 2b: LCD32FillRectDirect (repeated word, strobe-bound) ---
+        {
+            SysLog("[TaskScreen] Testing: LCD32FillRectDirect");
+            int64_t start_time = esp_timer_get_time();
+            LCD32FillRectDirect(lcd32, 0, 0, lcd32->Height, lcd32->Width, (Color_t)esp_random());
+            uint32_t fill_duration_us = (uint32_t)(esp_timer_get_time() - start_time);
+            SysLog("[TaskScreen] Full screen direct fill: %u us", fill_duration_us);
+            for (int i = 0; i < 20; i++) {
+                Dim_t r = rand_coord(lcd32->Height, 50);
+                Dim_t c = rand_coord(lcd32->Width, 50);
+                Dim_t h = (esp_random() % 80) + 1;
+                Dim_t w = (esp_random() % 80) + 1;
+                LCD32FillRectDirect(lcd32, r, c, h, w, (Color_t)esp_random());
+            }
+            DelayMs(500);
+        }
+
         // --- Test 3: LCD32DrawLine ---
         SysLog("[TaskScreen] Testing: LCD32DrawLine");
         LCD32FillCanvas(lcd32, (Color_t)esp_random());
@@ -16,6 +16,8 @@ extern "C" {
 
 
 #include "../../AppComponents/LCD32/LCD32.h"
+#include "../AnalyzerReader/ARTraceView.h"
+#include "../AnalyzerReader/ARLink.h"
 
 extern LCD32Dev_t * lcd32; 
 
@@ -0,0 +1,448 @@
+/**
+ * @file ARCapture.c
+ * @brief Logic-analyzer capture engine: LCD_CAM camera interface + GDMA into a PSRAM ring
+ * @author Nguyen Thanh Phu
+ */
+
+#include "ARCapture.h"
+
+#if (AR_CAPTURE_EN == 1)
+
+#include "esp_cache.h"
+#include "esp_rom_gpio.h"
+#include "esp_private/gdma.h"
+#include "esp_private/periph_ctrl.h"
+#include "hal/dma_types.h"
+#include "hal/lcd_ll.h"
+#include "soc/lcd_cam_struct.h"
+#include "soc/gpio_sig_map.h"
+#include "soc/gpio_pins.h"
+
+/// @brief Bytes carried per descriptor (63 * 64: 12-bit length field, PSRAM burst aligned)
+#define AR_CAPTURE_DESC_CHUNK       4032
+/// @brief Largest block: cam_rec_data_bytelen is a 16-bit field holding bytes - 1
+#define AR_CAPTURE_BLOCK_BYTES_MAX  65536
+/// @brief Block size granularity: 64-byte PSRAM bursts / 2-byte samples
+#define AR_CAPTURE_BLOCK_ALIGN      32
+
+/// @brief cam_clk_sel values
+#define AR_CAPTURE_CLK_SEL_XTAL     1
+#define AR_CAPTURE_CLK_SEL_PLL160M  3
+#define AR_CAPTURE_XTAL_HZ          40000000
+#define AR_CAPTURE_PLL160M_HZ       160000000
+/// @brief Integer part of the divider (cam_clkm_div_num)
+#define AR_CAPTURE_DIV_NUM_MIN      2
+#define AR_CAPTURE_DIV_NUM_MAX      255
+/// @brief Largest fractional denominator (cam_clkm_div_a is 6 bits)
+#define AR_CAPTURE_DIV_A_MAX        63
+
+/// @brief Engine private state, stored in ARCapture_t::HwCtx
+typedef struct ARCaptureHw_s {
+    lcd_cam_dev_t *         Hw;         ///< LCD_CAM register block
+    gdma_channel_handle_t   Chan;       ///< RX channel bound to the camera
+    dma_descriptor_t *      Descs;      ///< Circular chain over the whole ring (internal RAM)
+    uint32_t                DescNum;    ///< Descriptors in the chain
+    uint32_t                ClkSel;     ///< cam_clk_sel
+    uint32_t                DivNum;     ///< cam_clkm_div_num
+    uint32_t                DivA;       ///< cam_clkm_div_a (0: integer divider)
+    uint32_t                DivB;       ///< cam_clkm_div_b
+} ARCaptureHw_t;
+
+/// @brief Camera input signals for channels 0..15
+static const uint16_t ARCaptureDataSig[AR_CHANNEL_NUM] = {
+    CAM_DATA_IN0_IDX,  CAM_DATA_IN1_IDX,  CAM_DATA_IN2_IDX,  CAM_DATA_IN3_IDX,
+    CAM_DATA_IN4_IDX,  CAM_DATA_IN5_IDX,  CAM_DATA_IN6_IDX,  CAM_DATA_IN7_IDX,
+    CAM_DATA_IN8_IDX,  CAM_DATA_IN9_IDX,  CAM_DATA_IN10_IDX, CAM_DATA_IN11_IDX,
+    CAM_DATA_IN12_IDX, CAM_DATA_IN13_IDX, CAM_DATA_IN14_IDX, CAM_DATA_IN15_IDX,
+};
+
+/// @brief GDMA EOF: the camera closed one ring block
+static bool IRAM_ATTR ARCaptureOnEof(gdma_channel_handle_t Chan, gdma_event_data_t * Event, void * Arg){
+    ARCapture_t * cap = (ARCapture_t *) Arg;
+    ARRingCommit(&(cap->Ring));
+    return false;
+}
+
+/// @brief GDMA descriptor error: the chain is broken, the block in flight is lost
+static bool IRAM_ATTR ARCaptureOnDescErr(gdma_channel_handle_t Chan, gdma_event_data_t * Event, void * Arg){
+    ARCapture_t * cap = (ARCapture_t *) Arg;
+    cap->DmaErrors = cap->DmaErrors + 1;
+    return false;
+}
+
+/// @brief Ring hook: drop the cache lines covering a block the DMA wrote behind the CPU
+static void ARCaptureSyncBlock(const void * Addr, uint32_t Bytes){
+    esp_cache_msync((void *) Addr, Bytes, ESP_CACHE_MSYNC_FLAG_DIR_M2C);
+}
+
+/// @brief Lay a circular descriptor chain over the ring, block boundaries on descriptor ends
+static void ARCaptureBuildChain(ARCapture_t * Cap){
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) Cap->HwCtx;
+    uint32_t blockBytes = Cap->Ring.BlockSamples * sizeof(ARSample_t);
+    uint8_t * buf = (uint8_t *) Cap->Ring.Buf;
+    uint32_t d = 0;
+
+    for(uint32_t b = 0; b < Cap->Ring.Blocks; b++){
+        uint32_t left = blockBytes;
+        while(left > 0){
+            uint32_t chunk = Min(left, (uint32_t) AR_CAPTURE_DESC_CHUNK);
+            dma_descriptor_t * desc = &(ctx->Descs[d]);
+            desc->dw0.size    = chunk;
+            desc->dw0.length  = 0;
+            desc->dw0.err_eof = 0;
+            desc->dw0.suc_eof = 0;
+            desc->dw0.owner   = DMA_DESCRIPTOR_BUFFER_OWNER_DMA;
+            desc->buffer      = buf;
+            desc->next        = &(ctx->Descs[(d + 1) % ctx->DescNum]);
+            buf  += chunk;
+            left -= chunk;
+            d++;
+        }
+    }
+}
+
+/// @brief Route the data inputs and loop the sample clock back through ClkPin
+static void ARCaptureSetupPins(const ARCaptureConfig_t * Cfg){
+    uint64_t inMask = 0;
+    REPN(i, AR_CHANNEL_NUM){
+        Pin_t pin = Cfg->DatPins[i];
+        if(((uint32_t) i < Cfg->Width) && IsValidPin(pin)){
+            inMask |= Mask64(pin);
+            esp_rom_gpio_connect_in_signal(pin, ARCaptureDataSig[i], false);
+        } else {
+            esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ZERO_INPUT, ARCaptureDataSig[i], false);
+        }
+    }
+    if(inMask != 0){
+        IOConfigAsInput(inMask, GPIO_PULLUP_DISABLE, GPIO_PULLDOWN_DISABLE);
+    }
+
+    /// CAM_CLK leaves on ClkPin and comes straight back in as PCLK
+    IOConfigAsInputOutput(Mask64(Cfg->ClkPin), GPIO_PULLUP_DISABLE, GPIO_PULLDOWN_DISABLE);
+    esp_rom_gpio_connect_out_signal(Cfg->ClkPin, CAM_CLK_IDX, false, false);
+    esp_rom_gpio_connect_in_signal(Cfg->ClkPin, CAM_PCLK_IDX, false);
+
+    /// No frame/line framing: every PCLK edge is a valid sample
+    esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ONE_INPUT, CAM_V_SYNC_IDX, false);
+    esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ONE_INPUT, CAM_H_SYNC_IDX, false);
+    esp_rom_gpio_connect_in_signal(GPIO_MATRIX_CONST_ONE_INPUT, CAM_H_ENABLE_IDX, false);
+}
+
+/// @brief Write the divider chosen by ARCaptureSetRate() into the camera clock generator
+static void ARCaptureApplyClock(ARCaptureHw_t * Ctx){
+    lcd_cam_dev_t * hw = Ctx->Hw;
+    hw->cam_ctrl.cam_clk_sel      = Ctx->ClkSel;
+    hw->cam_ctrl.cam_clkm_div_num = Ctx->DivNum;
+    hw->cam_ctrl.cam_clkm_div_a   = Ctx->DivA;
+    hw->cam_ctrl.cam_clkm_div_b   = Ctx->DivB;
+    hw->cam_ctrl.cam_update       = 1;
+}
+
+/// @brief Program the camera for free-running 8/16-bit capture, one EOF per ring block
+static void ARCaptureSetupCam(ARCapture_t * Cap){
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) Cap->HwCtx;
+    lcd_cam_dev_t * hw = ctx->Hw;
+
+    /// LCD_CAM is shared with the i80 LCD path: enable the bus clock, never reset the block
+    PERIPH_RCC_ATOMIC() {
+        lcd_ll_enable_bus_clock(0, true);
+    }
+    lcd_ll_enable_clock(hw, true);
+
+    hw->cam_ctrl.cam_stop_en          = 0;
+    hw->cam_ctrl.cam_vsync_filter_thres = 0;
+    hw->cam_ctrl.cam_byte_order       = 0;
+    hw->cam_ctrl.cam_bit_order        = 0;
+    hw->cam_ctrl.cam_line_int_en      = 0;
+    /// EOF comes from the byte counter, not from VSYNC
+    hw->cam_ctrl.cam_vs_eof_en        = 0;
+
+    hw->cam_ctrl1.cam_rec_data_bytelen = Cap->Ring.BlockSamples * sizeof(ARSample_t) - 1;
+    hw->cam_ctrl1.cam_line_int_num    = 0;
+    hw->cam_ctrl1.cam_clk_inv         = 0;
+    hw->cam_ctrl1.cam_vsync_filter_en = 0;
+    /// Always 2 bytes per sample; an 8-bit group reads 0 on the upper inputs
+    hw->cam_ctrl1.cam_2byte_en        = 1;
+    hw->cam_ctrl1.cam_de_inv          = 0;
+    hw->cam_ctrl1.cam_hsync_inv       = 0;
+    hw->cam_ctrl1.cam_vsync_inv       = 0;
+    hw->cam_ctrl1.cam_vh_de_mode_en   = 0;
+    hw->cam_ctrl1.cam_start           = 0;
+
+    ARCaptureApplyClock(ctx);
+}
+
+/// @brief Fill a configuration with the board defaults (DevicePinout.h) and module defaults
+void ARCaptureDefaultConfig(ARCaptureConfig_t * Cfg){
+    if(IsNull(Cfg)){
+        return;
+    }
+#ifdef AR_SCLK
+    const Pin_t pins[AR_CHANNEL_NUM] = {
+        AR_CH0,  AR_CH1,  AR_CH2,  AR_CH3,  AR_CH4,  AR_CH5,  AR_CH6,  AR_CH7,
+        AR_CH8,  AR_CH9,  AR_CH10, AR_CH11, AR_CH12, AR_CH13, AR_CH14, AR_CH15,
+    };
+    REPN(i, AR_CHANNEL_NUM){
+        Cfg->DatPins[i] = pins[i];
+    }
+    Cfg->ClkPin = AR_SCLK;
+#else
+    /// Not a reader board: no pads assigned
+    REPN(i, AR_CHANNEL_NUM){
+        Cfg->DatPins[i] = PIN_UNUSED;
+    }
+    Cfg->ClkPin = PIN_UNUSED;
+#endif
+    Cfg->Width        = AR_CHANNEL_NUM;
+    Cfg->RateHz       = AR_CAPTURE_DEFAULT_RATE_HZ;
+    Cfg->Blocks       = AR_CAPTURE_BLOCKS;
+    Cfg->BlockSamples = AR_CAPTURE_BLOCK_SAMPLES;
+}
+
+/// @brief Allocate the ring (PSRAM) and descriptors, route the pins and set up LCD_CAM + GDMA
+ARCapture_t * ARCaptureNew(const ARCaptureConfig_t * Cfg){
+    AREntry("ARCaptureNew(%p)", Cfg);
+
+    if(IsNull(Cfg)){
+        ARReturnWithLog(NULL, "ARCaptureNew() : STAT_ERR_NULL");
+    }
+    uint32_t blockBytes = Cfg->BlockSamples * sizeof(ARSample_t);
+    if((Cfg->Width != 8) && (Cfg->Width != 16)){
+        ARErr("[ARCaptureNew] Width %d not supported (8 or 16)", Cfg->Width);
+        ARReturnWithLog(NULL, "ARCaptureNew() : STAT_ERR_INVALID_ARG");
+    }
+    if((Cfg->Blocks < 2) || (Cfg->BlockSamples == 0) || (Cfg->BlockSamples % AR_CAPTURE_BLOCK_ALIGN) || (blockBytes > AR_CAPTURE_BLOCK_BYTES_MAX)){
+        ARErr("[ARCaptureNew] Bad ring geometry: %d blocks x %d samples", Cfg->Blocks, Cfg->BlockSamples);
+        ARReturnWithLog(NULL, "ARCaptureNew() : STAT_ERR_INVALID_SIZE");
+    }
+    if( !IsValidPin(Cfg->ClkPin) ){
+        ARErr("[ARCaptureNew] No sample clock pad");
+        ARReturnWithLog(NULL, "ARCaptureNew() : STAT_ERR_INVALID_ARG");
+    }
+
+    ARCapture_t * cap = (ARCapture_t *) heap_caps_calloc(1, sizeof(ARCapture_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) heap_caps_calloc(1, sizeof(ARCaptureHw_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if(IsNull(cap) || IsNull(ctx)){
+        ARErr("[ARCaptureNew] Malloc failed for context");
+        if(IsNotNull(cap)) heap_caps_free(cap);
+        if(IsNotNull(ctx)) heap_caps_free(ctx);
+        ARReturnWithLog(NULL, "ARCaptureNew() : STAT_ERR_MALLOC_FAILED");
+    }
+    cap->Cfg   = *Cfg;
+    cap->HwCtx = ctx;
+    cap->State = AR_CAPTURE_IDLE;
+    ctx->Hw    = &LCD_CAM;
+
+    uint32_t ringBytes = ARRingBytes(Cfg->Blocks, Cfg->BlockSamples);
+    ARSample_t * buf = (ARSample_t *) heap_caps_aligned_alloc(64, ringBytes, MALLOC_CAP_SPIRAM);
+    ctx->DescNum = Cfg->Blocks * ((blockBytes + AR_CAPTURE_DESC_CHUNK - 1) / AR_CAPTURE_DESC_CHUNK);
+    ctx->Descs = (dma_descriptor_t *) heap_caps_calloc(ctx->DescNum, sizeof(dma_descriptor_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if(IsNull(buf) || IsNull(ctx->Descs)){
+        ARErr("[ARCaptureNew] Malloc failed for ring (%d bytes) / %d descriptors", ringBytes, ctx->DescNum);
+        if(IsNotNull(buf)) heap_caps_free(buf);
+        goto fail;
+    }
+    ARRingInit(&(cap->Ring), buf, Cfg->Blocks, Cfg->BlockSamples);
+    cap->Ring.Sync = ARCaptureSyncBlock;
+
+    /// GDMA RX channel wired to the camera
+    gdma_channel_alloc_config_t dmaCfg = {
+        .direction = GDMA_CHANNEL_DIRECTION_RX,
+    };
+    esp_err_t err = gdma_new_ahb_channel(&dmaCfg, &ctx->Chan);
+    if(err == ESP_OK) err = gdma_connect(ctx->Chan, GDMA_MAKE_TRIGGER(GDMA_TRIG_PERIPH_CAM, 0));
+    if(err == ESP_OK){
+        /// The chain is circular and never handed back to the CPU
+        gdma_strategy_config_t strategy = {
+            .auto_update_desc = false,
+            .owner_check = false,
+        };
+        err = gdma_apply_strategy(ctx->Chan, &strategy);
+    }
+    if(err == ESP_OK){
+        gdma_transfer_config_t xfer = {
+            .max_data_burst_size = 64,
+            .access_ext_mem = true,
+        };
+        err = gdma_config_transfer(ctx->Chan, &xfer);
+    }
+    if(err == ESP_OK){
+        gdma_rx_event_callbacks_t cbs = {
+            .on_recv_eof  = ARCaptureOnEof,
+            .on_descr_err = ARCaptureOnDescErr,
+        };
+        err = gdma_register_rx_event_callbacks(ctx->Chan, &cbs, cap);
+    }
+    if(err != ESP_OK){
+        ARErr("[ARCaptureNew] GDMA setup failed (%s)", esp_err_to_name(err));
+        heap_caps_free(buf);
+        goto fail;
+    }
+
+    if(ARCaptureSetRate(cap, Cfg->RateHz) != STAT_OKE){
+        ARErr("[ARCaptureNew] Rate %d Hz out of range, using %d Hz", Cfg->RateHz, AR_CAPTURE_DEFAULT_RATE_HZ);
+        ARCaptureSetRate(cap, AR_CAPTURE_DEFAULT_RATE_HZ);
+    }
+    ARCaptureSetupPins(Cfg);
+    ARCaptureSetupCam(cap);
+
+    ARLog("[ARCaptureNew] %d ch, %d Hz, %d blocks x %d samples (%d KB), %d descriptors",
+          Cfg->Width, cap->RateHz, Cfg->Blocks, Cfg->BlockSamples, ringBytes / 1024, ctx->DescNum);
+    ARReturnWithLog(cap, "ARCaptureNew() : STAT_OKE");
+
+fail:
+    if(IsNotNull(ctx->Chan)){
+        gdma_disconnect(ctx->Chan);
+        gdma_del_channel(ctx->Chan);
+    }
+    if(IsNotNull(ctx->Descs)) heap_caps_free(ctx->Descs);
+    heap_caps_free(ctx);
+    heap_caps_free(cap);
+    ARReturnWithLog(NULL, "ARCaptureNew() : STAT_ERR_INIT_FAILED");
+}
+
+/// @brief Stop the engine and release everything
+void ARCaptureDelete(ARCapture_t * Cap){
+    if(IsNull(Cap) || IsNull(Cap->HwCtx)){
+        return;
+    }
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) Cap->HwCtx;
+
+    ARCaptureStop(Cap);
+    gdma_disconnect(ctx->Chan);
+    gdma_del_channel(ctx->Chan);
+    heap_caps_free(ctx->Descs);
+    heap_caps_free(Cap->Ring.Buf);
+    heap_caps_free(ctx);
+    heap_caps_free(Cap);
+}
+
+/// @brief Select the sample rate (engine must be idle)
+DefaultRet_t ARCaptureSetRate(ARCapture_t * Cap, uint32_t RateHz){
+    if(IsNull(Cap) || IsNull(Cap->HwCtx)){
+        return STAT_ERR_NULL;
+    }
+    if(Cap->State == AR_CAPTURE_RUNNING){
+        return STAT_ERR_BUSY;
+    }
+
+    /// PLL_F160M while the integer part fits, XTAL below that
+    uint32_t srcHz  = AR_CAPTURE_PLL160M_HZ;
+    uint32_t clkSel = AR_CAPTURE_CLK_SEL_PLL160M;
+    if((RateHz > 0) && (RateHz < AR_CAPTURE_PLL160M_HZ / AR_CAPTURE_DIV_NUM_MAX)){
+        srcHz  = AR_CAPTURE_XTAL_HZ;
+        clkSel = AR_CAPTURE_CLK_SEL_XTAL;
+    }
+    if((RateHz == 0) || (RateHz > AR_CAPTURE_RATE_MAX_HZ) || (RateHz > srcHz / AR_CAPTURE_DIV_NUM_MIN)){
+        return STAT_ERR_INVALID_ARG;
+    }
+    uint32_t num = srcHz / RateHz;
+    if(num > AR_CAPTURE_DIV_NUM_MAX){
+        return STAT_ERR_INVALID_ARG;
+    }
+
+    /// Divider is num + b / a: pick the a <= 63 that lands closest to the request
+    uint32_t bestA = 0, bestB = 0;
+    uint64_t bestErr = UINT64_MAX;
+    uint32_t rem = srcHz - num * RateHz;
+    if(rem != 0){
+        for(uint32_t a = 1; a <= AR_CAPTURE_DIV_A_MAX; a++){
+            uint32_t b = (uint32_t) (((uint64_t) rem * a + RateHz / 2) / RateHz);
+            if(b >= a){
+                continue;
+            }
+            uint64_t actual = (uint64_t) srcHz * a / ((uint64_t) num * a + b);
+            uint64_t err = (actual > RateHz) ? (actual - RateHz) : (RateHz - actual);
+            if(err < bestErr){
+                bestErr = err;
+                bestA = a;
+                bestB = b;
+            }
+        }
+    }
+    if(bestB == 0){
+        bestA = 0;
+    }
+
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) Cap->HwCtx;
+    ctx->ClkSel = clkSel;
+    ctx->DivNum = num;
+    ctx->DivA   = bestA;
+    ctx->DivB   = bestB;
+    Cap->RateHz = (bestA == 0) ? (srcHz / num) : (uint32_t) ((uint64_t) srcHz * bestA / ((uint64_t) num * bestA + bestB));
+    ARCaptureApplyClock(ctx);
+
+    ARLog1("[ARCaptureSetRate] %d Hz requested, %d Hz set (src %d / (%d + %d/%d))", RateHz, Cap->RateHz, srcHz, num, bestB, bestA);
+    return STAT_OKE;
+}
+
+/// @brief Empty the ring and start the DMA chain with the sample clock still stopped
+DefaultRet_t ARCaptureArm(ARCapture_t * Cap){
+    if(IsNull(Cap) || IsNull(Cap->HwCtx)){
+        return STAT_ERR_NULL;
+    }
+    if(Cap->State == AR_CAPTURE_RUNNING){
+        return STAT_ERR_BUSY;
+    }
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) Cap->HwCtx;
+    lcd_cam_dev_t * hw = ctx->Hw;
+
+    gdma_stop(ctx->Chan);
+    gdma_reset(ctx->Chan);
+    ARCaptureBuildChain(Cap);
+    ARRingReset(&(Cap->Ring));
+    Cap->DmaErrors = 0;
+
+    hw->cam_ctrl1.cam_start = 0;
+    hw->cam_ctrl1.cam_reset = 1;
+    hw->cam_ctrl1.cam_reset = 0;
+    hw->cam_ctrl1.cam_afifo_reset = 1;
+    hw->cam_ctrl1.cam_afifo_reset = 0;
+
+    gdma_start(ctx->Chan, (intptr_t) ctx->Descs);
+    Cap->State = AR_CAPTURE_ARMED;
+    return STAT_OKE;
+}
+
+/// @brief Start sampling (arms first if needed)
+DefaultRet_t ARCaptureStart(ARCapture_t * Cap){
+    if(IsNull(Cap) || IsNull(Cap->HwCtx)){
+        return STAT_ERR_NULL;
+    }
+    if(Cap->State == AR_CAPTURE_RUNNING){
+        return STAT_OKE;
+    }
+    if(Cap->State != AR_CAPTURE_ARMED){
+        DefaultRet_t ret = ARCaptureArm(Cap);
+        if(ret != STAT_OKE){
+            return ret;
+        }
+    }
+
+    ((ARCaptureHw_t *) Cap->HwCtx)->Hw->cam_ctrl1.cam_start = 1;
+    Cap->State = AR_CAPTURE_RUNNING;
+    return STAT_OKE;
+}
+
+/// @brief Stop sampling; committed blocks stay readable in the ring
+void ARCaptureStop(ARCapture_t * Cap){
+    if(IsNull(Cap) || IsNull(Cap->HwCtx)){
+        return;
+    }
+    ARCaptureHw_t * ctx = (ARCaptureHw_t *) Cap->HwCtx;
+
+    /// The partial block in flight is never committed
+    ctx->Hw->cam_ctrl1.cam_start = 0;
+    gdma_stop(ctx->Chan);
+    Cap->State = AR_CAPTURE_IDLE;
+}
+
+/// @brief Blocks lost since the last arm: overwritten before being read, or dropped by GDMA
+uint32_t ARCaptureOverruns(ARCapture_t * Cap){
+    if(IsNull(Cap)){
+        return 0;
+    }
+    return ARRingOverruns(&(Cap->Ring)) + Cap->DmaErrors;
+}
+
+#endif /// (AR_CAPTURE_EN == 1)
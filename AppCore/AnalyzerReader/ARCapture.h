@@ -0,0 +1,103 @@
+/**
+ * @file ARCapture.h
+ * @brief Logic-analyzer capture engine: LCD_CAM camera interface + GDMA into a PSRAM ring
+ * @details The camera interface is clocked by its own CAM_CLK output, looped back into
+ *          CAM_PCLK through a spare pad, with VSYNC/HSYNC/DE tied high: every clock edge
+ *          stores one 16-bit word of the data inputs. GDMA runs a circular descriptor chain
+ *          over the ring memory and the camera raises EOF every ring block, so the CPU only
+ *          runs one callback per block (ARRingCommit()) and never touches single samples.
+ *          With an 8-channel group, inputs 8..15 read constant 0 (samples stay 16-bit).
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_CAPTURE_H__
+#define __AR_CAPTURE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARCapture.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "AnalyzerReader.h"
+
+#if (AR_CAPTURE_EN == 1)
+
+/// @brief Engine states
+enum ARCaptureState_e {
+    AR_CAPTURE_IDLE         = 0,    ///< Clock stopped, DMA stopped
+    AR_CAPTURE_ARMED        = 1,    ///< DMA running on an empty ring, clock stopped
+    AR_CAPTURE_RUNNING      = 2,    ///< Sampling
+};
+
+/// @brief Capture configuration
+typedef struct ARCaptureConfig_s {
+    Pin_t       DatPins[AR_CHANNEL_NUM];    ///< Channel n input pad (-1: channel reads 0)
+    Pin_t       ClkPin;                     ///< Spare pad carrying the sample clock (output, looped back)
+    uint32_t    Width;                      ///< 8 or 16 channels
+    uint32_t    RateHz;                     ///< Requested sample rate
+    uint32_t    Blocks;                     ///< Ring blocks
+    uint32_t    BlockSamples;               ///< Samples per block (block bytes <= 65536)
+} ARCaptureConfig_t;
+
+/// @brief Capture engine
+typedef struct ARCapture_s {
+    ARRing_t            Ring;       ///< Captured blocks (consumer side is public)
+    ARCaptureConfig_t   Cfg;        ///< Configuration given to ARCaptureNew()
+    uint32_t            RateHz;     ///< Actual sample rate after divider rounding
+    volatile uint32_t   State;      ///< ARCaptureState_e
+    volatile uint32_t   DmaErrors;  ///< Descriptor errors reported by GDMA
+    void *              HwCtx;      ///< LCD_CAM / GDMA private state
+} ARCapture_t;
+
+/// @brief Fill a configuration with the board defaults (DevicePinout.h) and module defaults
+/// @param Cfg Pointer to the configuration
+void                ARCaptureDefaultConfig(ARCaptureConfig_t * Cfg);
+
+/// @brief Allocate the ring (PSRAM) and descriptors, route the pins and set up LCD_CAM + GDMA
+/// @param Cfg Pointer to the configuration (copied)
+/// @return Engine in AR_CAPTURE_IDLE, or NULL on failure
+ARCapture_t *       ARCaptureNew(const ARCaptureConfig_t * Cfg);
+
+/// @brief Stop the engine and release everything
+/// @param Cap Pointer to the engine
+void                ARCaptureDelete(ARCapture_t * Cap);
+
+/// @brief Select the sample rate (engine must be idle)
+/// @details Divides PLL_F160M (>= 625 kHz) or XTAL (down to ~157 kHz) with the fractional
+///          divider; the rate actually used is stored in `Cap->RateHz`.
+/// @param Cap Pointer to the engine
+/// @param RateHz Requested rate
+/// @return STAT_OKE, STAT_ERR_BUSY or STAT_ERR_INVALID_ARG (out of range)
+DefaultRet_t        ARCaptureSetRate(ARCapture_t * Cap, uint32_t RateHz);
+
+/// @brief Empty the ring and start the DMA chain with the sample clock still stopped
+/// @details ARCaptureStart() is then a single register write, so the first sample follows
+///          the start request with a fixed, minimal delay.
+/// @param Cap Pointer to the engine
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARCaptureArm(ARCapture_t * Cap);
+
+/// @brief Start sampling (arms first if needed)
+/// @param Cap Pointer to the engine
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARCaptureStart(ARCapture_t * Cap);
+
+/// @brief Stop sampling; committed blocks stay readable in the ring
+/// @param Cap Pointer to the engine
+void                ARCaptureStop(ARCapture_t * Cap);
+
+/// @brief Blocks lost since the last arm: overwritten before being read, or dropped by GDMA
+/// @param Cap Pointer to the engine
+/// @return Overrun count
+uint32_t            ARCaptureOverruns(ARCapture_t * Cap);
+
+#endif /// (AR_CAPTURE_EN == 1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_CAPTURE_H__
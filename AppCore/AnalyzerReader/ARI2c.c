@@ -0,0 +1,375 @@
+/**
+ * @file ARI2c.c
+ * @brief Streaming I2C decoder with glitch filter, ACK/NACK, repeated START and clock stretching
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARI2c.h"
+
+/// @brief Deglitcher line indices
+#define AR_I2C_SCL                  0
+#define AR_I2C_SDA                  1
+
+/// @brief Hand an event to the sink
+static void ARI2cEmit(ARI2c_t * Dec, const ARI2cEvent_t * Ev){
+    Dec->Events++;
+    if(Ev->Kind == AR_I2C_EV_ERROR){
+        Dec->Errors++;
+    }
+    if(Dec->OnEvent != NULL){
+        Dec->OnEvent(Dec->Arg, Ev);
+    }
+}
+
+/// @brief Emit an event that only carries a kind, a time and possibly an error
+static void ARI2cEmitSimple(ARI2c_t * Dec, uint32_t Kind, uint32_t Error, uint64_t Sample){
+    ARI2cEvent_t ev = {
+        .Kind   = Kind,
+        .Error  = Error,
+        .Sample = Sample,
+    };
+    ARI2cEmit(Dec, &ev);
+}
+
+/// @brief Protocol state machine, fed with filtered edges in time order
+/// @details A bit is latched on SCL rising and only committed on SCL falling: the clock
+///          high phase that carries a repeated START or a STOP is not a data bit.
+static void ARI2cEdge(ARI2c_t * Dec, uint32_t Line, uint32_t Level, uint64_t T){
+    if(Line == AR_I2C_SDA){
+        /// SDA only moves with SCL high for START (falling) and STOP (rising)
+        if( !Dec->Level[AR_I2C_SCL] ){
+            return;
+        }
+        Dec->Latched = 0;
+        if(Dec->InFrame && (Dec->BitCnt != 0)){
+            ARI2cEmitSimple(Dec, AR_I2C_EV_ERROR, AR_I2C_ERR_PARTIAL_BYTE, T);
+        }
+        if(Level == 0){
+            ARI2cEmitSimple(Dec, Dec->InFrame ? AR_I2C_EV_RESTART : AR_I2C_EV_START, AR_I2C_ERR_NONE, T);
+            Dec->InFrame = 1;
+            Dec->First   = 1;
+        } else {
+            if(Dec->InFrame){
+                ARI2cEmitSimple(Dec, AR_I2C_EV_STOP, AR_I2C_ERR_NONE, T);
+            }
+            Dec->InFrame = 0;
+        }
+        Dec->NoStartFlagged = 0;
+        Dec->BitCnt = 0;
+        Dec->Byte   = 0;
+        return;
+    }
+
+    if(Level == 1){
+        /// Clock stretching is measured on every low phase inside a transfer
+        if(Dec->InFrame && (Dec->Cfg.StretchSamples > 0) && (T - Dec->SclFallAt > Dec->Cfg.StretchSamples)){
+            ARI2cEvent_t ev = {
+                .Kind     = AR_I2C_EV_STRETCH,
+                .Sample   = Dec->SclFallAt,
+                .Duration = T - Dec->SclFallAt,
+            };
+            ARI2cEmit(Dec, &ev);
+        }
+        Dec->Latched  = 1;
+        Dec->LatchSda = Dec->Level[AR_I2C_SDA];
+        Dec->LatchAt  = T;
+        return;
+    }
+
+    Dec->SclFallAt = T;
+    if( !Dec->Latched ){
+        return;
+    }
+    Dec->Latched = 0;
+    if( !Dec->InFrame ){
+        if( !Dec->NoStartFlagged ){
+            ARI2cEmitSimple(Dec, AR_I2C_EV_ERROR, AR_I2C_ERR_NO_START, Dec->LatchAt);
+            Dec->NoStartFlagged = 1;
+        }
+        return;
+    }
+
+    if(Dec->BitCnt < 8){
+        if(Dec->BitCnt == 0){
+            Dec->ByteStart = Dec->LatchAt;
+        }
+        Dec->Byte = (Dec->Byte << 1) | Dec->LatchSda;
+        Dec->BitCnt++;
+        return;
+    }
+
+    /// Ninth clock: receiver pulls SDA low to acknowledge
+    ARI2cEvent_t ev = {
+        .Kind   = Dec->First ? AR_I2C_EV_ADDRESS : AR_I2C_EV_DATA,
+        .Value  = Dec->First ? (Dec->Byte >> 1) : Dec->Byte,
+        .Ack    = Dec->LatchSda ? 0 : 1,
+        .Rw     = Dec->First ? (Dec->Byte & 1U) : 0,
+        .Sample = Dec->ByteStart,
+    };
+    ARI2cEmit(Dec, &ev);
+    Dec->Bytes++;
+    Dec->First  = 0;
+    Dec->BitCnt = 0;
+    Dec->Byte   = 0;
+}
+
+/// @brief Turn every pending level that has lasted MinPulse samples by time `T` into an edge
+static void ARI2cAdvance(ARI2c_t * Dec, uint64_t T){
+    uint64_t width = (Dec->Cfg.MinPulse > 1) ? Dec->Cfg.MinPulse : 1;
+    while(1){
+        int32_t line = -1;
+        for(uint32_t l = 0; l < 2; l++){
+            if(Dec->Pending[l] && (Dec->PendAt[l] + width <= T)){
+                if((line < 0) || (Dec->PendAt[l] < Dec->PendAt[line])){
+                    line = (int32_t) l;
+                }
+            }
+        }
+        if(line < 0){
+            return;
+        }
+        Dec->Pending[line] = 0;
+        Dec->Level[line] ^= 1U;
+        ARI2cEdge(Dec, (uint32_t) line, Dec->Level[line], Dec->PendAt[line]);
+    }
+}
+
+/// @brief Raw sample where SCL and/or SDA moved
+static void ARI2cRaw(ARI2c_t * Dec, ARSample_t Raw, uint64_t T){
+    ARI2cAdvance(Dec, T);
+
+    uint32_t raw[2] = {
+        ((uint32_t) Raw >> Dec->Cfg.ChScl) & 1U,
+        ((uint32_t) Raw >> Dec->Cfg.ChSda) & 1U,
+    };
+    for(uint32_t l = 0; l < 2; l++){
+        if(raw[l] == Dec->Level[l]){
+            /// Back to the filtered level before MinPulse: the pulse was a glitch
+            if(Dec->Pending[l]){
+                Dec->Pending[l] = 0;
+                Dec->Glitches++;
+            }
+        } else if( !Dec->Pending[l] ){
+            Dec->Pending[l] = 1;
+            Dec->PendAt[l]  = T;
+        }
+    }
+
+    ARI2cAdvance(Dec, T + 1);
+}
+
+/// @brief SCL on channel 0, SDA on channel 1, 2-sample glitch filter, no stretch report
+void ARI2cDefaultConfig(ARI2cConfig_t * Cfg){
+    if(Cfg == NULL){
+        return;
+    }
+    Cfg->ChScl          = 0;
+    Cfg->ChSda          = 1;
+    Cfg->MinPulse       = 2;
+    Cfg->StretchSamples = 0;
+}
+
+/// @brief Set up a decoder
+DefaultRet_t ARI2cInit(ARI2c_t * Dec, const ARI2cConfig_t * Cfg, ARI2cEventCb_t OnEvent, void * Arg){
+    if((Dec == NULL) || (Cfg == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if((Cfg->ChScl < 0) || (Cfg->ChScl >= AR_CHANNEL_NUM) || (Cfg->ChSda < 0) || (Cfg->ChSda >= AR_CHANNEL_NUM) ||
+       (Cfg->ChScl == Cfg->ChSda)){
+        return STAT_ERR_INVALID_ARG;
+    }
+
+    memset(Dec, 0, sizeof(ARI2c_t));
+    Dec->Cfg       = *Cfg;
+    Dec->OnEvent   = OnEvent;
+    Dec->Arg       = Arg;
+    Dec->WatchMask = (ARSample_t) ((1U << Cfg->ChScl) | (1U << Cfg->ChSda));
+    ARI2cReset(Dec);
+    return STAT_OKE;
+}
+
+/// @brief Forget the bus state and restart the sample clock at 0
+void ARI2cReset(ARI2c_t * Dec){
+    if(Dec == NULL){
+        return;
+    }
+    Dec->HasPrev        = 0;
+    Dec->Pending[0]     = 0;
+    Dec->Pending[1]     = 0;
+    Dec->InFrame        = 0;
+    Dec->First          = 0;
+    Dec->BitCnt         = 0;
+    Dec->Byte           = 0;
+    Dec->SclFallAt      = 0;
+    Dec->Latched        = 0;
+    Dec->NoStartFlagged = 0;
+    Dec->Now            = 0;
+    Dec->Bytes          = 0;
+    Dec->Glitches       = 0;
+    Dec->Errors         = 0;
+    Dec->Events         = 0;
+}
+
+/// @brief Decode the next `Count` samples of the capture
+uint32_t ARI2cDecode(ARI2c_t * Dec, const ARSample_t * Samples, uint32_t Count){
+    if((Dec == NULL) || (Samples == NULL) || (Count == 0)){
+        return 0;
+    }
+    /// The first sample only sets the levels: a capture starting mid-transfer waits for a START
+    if( !Dec->HasPrev ){
+        Dec->Prev = Samples[0];
+        Dec->Level[AR_I2C_SCL] = ((uint32_t) Samples[0] >> Dec->Cfg.ChScl) & 1U;
+        Dec->Level[AR_I2C_SDA] = ((uint32_t) Samples[0] >> Dec->Cfg.ChSda) & 1U;
+        Dec->NoStartFlagged = 1;
+        Dec->HasPrev = 1;
+    }
+
+    uint32_t before = Dec->Events;
+    uint32_t watch = ARLanePair(Dec->WatchMask);
+    uint32_t prev = Dec->Prev;
+    uint32_t i = 0;
+
+    while(i < Count){
+        /// Skip pairs where neither line moves
+        if(i + 1 < Count){
+            uint32_t a = Samples[i];
+            uint32_t x = a | ((uint32_t) Samples[i + 1] << 16);
+            if( !ARLaneNonZero((x ^ (prev | (a << 16))) & watch) ){
+                prev = Samples[i + 1];
+                i += 2;
+                continue;
+            }
+        }
+        if((Samples[i] ^ prev) & Dec->WatchMask){
+            ARI2cRaw(Dec, Samples[i], Dec->Now + i);
+        }
+        prev = Samples[i];
+        i++;
+    }
+
+    Dec->Prev = (ARSample_t) prev;
+    Dec->Now += Count;
+    /// Lines unchanged up to the end of the block: confirm what has lasted long enough
+    ARI2cAdvance(Dec, Dec->Now);
+    return Dec->Events - before;
+}
+
+/// @brief Decode a transition-encoded trace from the reader position up to sample `End`
+uint32_t ARI2cDecodeRle(ARI2c_t * Dec, ARRleReader_t * Rd, uint64_t End){
+    if((Dec == NULL) || (Rd == NULL)){
+        return 0;
+    }
+    if(End > Rd->End){
+        End = Rd->End;
+    }
+    if( !Dec->HasPrev ){
+        Dec->Prev = Rd->State;
+        Dec->Level[AR_I2C_SCL] = ((uint32_t) Rd->State >> Dec->Cfg.ChScl) & 1U;
+        Dec->Level[AR_I2C_SDA] = ((uint32_t) Rd->State >> Dec->Cfg.ChSda) & 1U;
+        Dec->NoStartFlagged = 1;
+        Dec->HasPrev = 1;
+    }
+
+    uint32_t before = Dec->Events;
+    while(Rd->HasNext && (Rd->NextAt < End)){
+        ARRleReaderNext(Rd);
+        if((Rd->State ^ Dec->Prev) & Dec->WatchMask){
+            ARI2cRaw(Dec, Rd->State, Rd->At);
+        }
+        Dec->Prev = Rd->State;
+    }
+
+    if(End > Dec->Now){
+        Dec->Now = End;
+    }
+    ARI2cAdvance(Dec, Dec->Now);
+    return Dec->Events - before;
+}
+
+/// @brief Append `Samples` samples with the current levels
+static void ARI2cSynthPut(ARI2cSynth_t * Syn, uint32_t Samples){
+    ARSample_t s = (ARSample_t) ((Syn->Scl ? Syn->SclMask : 0) | (Syn->Sda ? Syn->SdaMask : 0));
+    for(uint32_t k = 0; k < Samples; k++){
+        if(Syn->Len >= Syn->Cap){
+            Syn->Overflow = 1;
+            return;
+        }
+        Syn->Out[Syn->Len++] = s;
+    }
+}
+
+/// @brief Start a capture in `Out` with both lines high
+void ARI2cSynthInit(ARI2cSynth_t * Syn, const ARI2cConfig_t * Cfg, ARSample_t * Out, uint32_t Cap, uint32_t HalfPeriod){
+    if((Syn == NULL) || (Cfg == NULL)){
+        return;
+    }
+    memset(Syn, 0, sizeof(ARI2cSynth_t));
+    Syn->Out        = Out;
+    Syn->Cap        = (Out != NULL) ? Cap : 0;
+    Syn->SclMask    = (ARSample_t) (1U << Cfg->ChScl);
+    Syn->SdaMask    = (ARSample_t) (1U << Cfg->ChSda);
+    Syn->Scl        = 1;
+    Syn->Sda        = 1;
+    Syn->HalfPeriod = (HalfPeriod > 0) ? HalfPeriod : 1;
+    ARI2cSynthPut(Syn, 2 * Syn->HalfPeriod);
+}
+
+/// @brief Keep the current levels for `Samples` samples (SCL low: clock stretching)
+void ARI2cSynthHold(ARI2cSynth_t * Syn, uint32_t Samples){
+    if(Syn == NULL){
+        return;
+    }
+    ARI2cSynthPut(Syn, Samples);
+}
+
+/// @brief START, or repeated START when SCL is low
+void ARI2cSynthStart(ARI2cSynth_t * Syn){
+    if(Syn == NULL){
+        return;
+    }
+    if( !Syn->Scl ){
+        /// Repeated START: release SDA, then SCL
+        Syn->Sda = 1;
+        ARI2cSynthPut(Syn, Syn->HalfPeriod);
+        Syn->Scl = 1;
+        ARI2cSynthPut(Syn, Syn->HalfPeriod);
+    }
+    Syn->Sda = 0;
+    ARI2cSynthPut(Syn, Syn->HalfPeriod);
+    Syn->Scl = 0;
+}
+
+/// @brief Clock out the `Bits` low bits of `Value`, MSB first
+void ARI2cSynthBits(ARI2cSynth_t * Syn, uint32_t Value, uint32_t Bits){
+    if(Syn == NULL){
+        return;
+    }
+    for(uint32_t b = Bits; b > 0; b--){
+        Syn->Sda = (Value >> (b - 1)) & 1U;
+        ARI2cSynthPut(Syn, Syn->HalfPeriod);
+        Syn->Scl = 1;
+        ARI2cSynthPut(Syn, Syn->HalfPeriod);
+        Syn->Scl = 0;
+    }
+}
+
+/// @brief One byte followed by its ACK (1) or NACK (0) bit
+void ARI2cSynthByte(ARI2cSynth_t * Syn, uint32_t Value, uint32_t Ack){
+    ARI2cSynthBits(Syn, Value, 8);
+    ARI2cSynthBits(Syn, Ack ? 0 : 1, 1);
+}
+
+/// @brief STOP, then idle for a full clock period
+void ARI2cSynthStop(ARI2cSynth_t * Syn){
+    if(Syn == NULL){
+        return;
+    }
+    Syn->Sda = 0;
+    ARI2cSynthPut(Syn, Syn->HalfPeriod);
+    Syn->Scl = 1;
+    ARI2cSynthPut(Syn, Syn->HalfPeriod);
+    Syn->Sda = 1;
+    ARI2cSynthPut(Syn, 2 * Syn->HalfPeriod);
+}
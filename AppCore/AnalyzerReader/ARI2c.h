@@ -0,0 +1,153 @@
+/**
+ * @file ARI2c.h
+ * @brief Streaming I2C decoder with glitch filter, ACK/NACK, repeated START and clock stretching
+ * @details Works on packed samples block by block. Pairs of samples are checked for SCL/SDA
+ *          movement in one 32-bit word, so idle stretches cost a compare per pair and only
+ *          raw edges reach the decoder. Each line has a deglitcher: a new level becomes an
+ *          edge (stamped with the sample it started at) once it has lasted MinPulse samples.
+ *          Filtered edges of both lines are replayed in time order into the protocol state
+ *          machine, which emits events through a callback.
+ *          Hardware independent: ARI2cSynth*() build captures, bus errors included, on a host.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_I2C_H__
+#define __AR_I2C_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARI2c.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+#include "ARRle.h"
+
+/// @brief Decoded event kinds
+enum ARI2cEventKind_e {
+    AR_I2C_EV_START         = 0,    ///< START on an idle bus
+    AR_I2C_EV_RESTART       = 1,    ///< Repeated START inside a transfer
+    AR_I2C_EV_ADDRESS       = 2,    ///< First byte after a (repeated) START: Value = 7-bit address, Rw
+    AR_I2C_EV_DATA          = 3,    ///< Data byte
+    AR_I2C_EV_STOP          = 4,    ///< STOP
+    AR_I2C_EV_STRETCH       = 5,    ///< SCL held low longer than StretchSamples
+    AR_I2C_EV_ERROR         = 6,    ///< Bus error, see Error
+};
+
+/// @brief Bus errors
+enum ARI2cError_e {
+    AR_I2C_ERR_NONE         = 0,
+    AR_I2C_ERR_PARTIAL_BYTE = 1,    ///< START/STOP arrived with a byte (or its ACK) incomplete
+    AR_I2C_ERR_NO_START     = 2,    ///< Clock pulses on a bus that saw no START
+};
+
+/// @brief Decoder configuration
+typedef struct ARI2cConfig_s {
+    int32_t     ChScl;          ///< SCL channel
+    int32_t     ChSda;          ///< SDA channel
+    uint32_t    MinPulse;       ///< Levels shorter than this (samples) are glitches (<= 1: no filter)
+    uint32_t    StretchSamples; ///< SCL low longer than this is reported as stretching (0: off)
+} ARI2cConfig_t;
+
+/// @brief One decoded event
+typedef struct ARI2cEvent_s {
+    uint32_t    Kind;       ///< ARI2cEventKind_e
+    uint32_t    Value;      ///< Address (7 bits) or data byte
+    uint32_t    Ack;        ///< 1: ACK, 0: NACK (ADDRESS/DATA)
+    uint32_t    Rw;         ///< 1: read (ADDRESS)
+    uint32_t    Error;      ///< ARI2cError_e (ERROR)
+    uint64_t    Sample;     ///< Edge of the event (first bit for ADDRESS/DATA, SCL fall for STRETCH)
+    uint64_t    Duration;   ///< SCL low time in samples (STRETCH)
+} ARI2cEvent_t;
+
+/// @brief Event sink, called from ARI2cDecode()
+typedef void (*ARI2cEventCb_t)(void * Arg, const ARI2cEvent_t * Ev);
+
+/// @brief Decoder state
+typedef struct ARI2c_s {
+    ARI2cConfig_t   Cfg;
+    ARI2cEventCb_t  OnEvent;
+    void *          Arg;
+    ARSample_t      WatchMask;      ///< SCL | SDA
+    ARSample_t      Prev;           ///< Last raw sample
+    uint32_t        HasPrev;
+    /* Deglitcher, index 0 = SCL, 1 = SDA */
+    uint32_t        Level[2];       ///< Filtered levels
+    uint32_t        Pending[2];     ///< A new raw level is waiting for MinPulse
+    uint64_t        PendAt[2];      ///< Sample the pending level started at
+    /* Protocol */
+    uint32_t        InFrame;        ///< Between START and STOP
+    uint32_t        First;          ///< Next byte is the address
+    uint32_t        BitCnt;         ///< Bits of the current byte (8: waiting for ACK)
+    uint32_t        Byte;
+    uint64_t        ByteStart;      ///< Sample of the first bit
+    uint64_t        SclFallAt;      ///< Last filtered SCL falling edge
+    uint32_t        Latched;        ///< SDA latched on SCL rising, not committed yet
+    uint32_t        LatchSda;       ///< Latched SDA level
+    uint64_t        LatchAt;        ///< SCL rising edge of the latched bit
+    uint32_t        NoStartFlagged; ///< NO_START already reported since the last START/STOP
+    /* Statistics */
+    uint64_t        Now;            ///< Samples consumed since ARI2cReset()
+    uint32_t        Bytes;          ///< Bytes decoded (address included)
+    uint32_t        Glitches;       ///< Pulses rejected by the filter
+    uint32_t        Errors;         ///< ERROR events
+    uint32_t        Events;         ///< Events emitted
+} ARI2c_t;
+
+/// @brief SCL on channel 0, SDA on channel 1, 2-sample glitch filter, no stretch report
+void                ARI2cDefaultConfig(ARI2cConfig_t * Cfg);
+
+/// @brief Set up a decoder
+/// @return STAT_OKE or STAT_ERR_INVALID_ARG
+DefaultRet_t        ARI2cInit(ARI2c_t * Dec, const ARI2cConfig_t * Cfg, ARI2cEventCb_t OnEvent, void * Arg);
+
+/// @brief Forget the bus state and restart the sample clock at 0
+void                ARI2cReset(ARI2c_t * Dec);
+
+/// @brief Decode the next `Count` samples of the capture
+/// @return Number of events emitted
+uint32_t            ARI2cDecode(ARI2c_t * Dec, const ARSample_t * Samples, uint32_t Count);
+
+/// @brief Decode a transition-encoded trace from the reader position up to sample `End`
+/// @details Only transitions are visited; SCL and SDA must be recorded by the trace.
+/// @return Number of events emitted
+uint32_t            ARI2cDecodeRle(ARI2c_t * Dec, ARRleReader_t * Rd, uint64_t End);
+
+/// @brief Capture builder for host-side checks (bus idles high)
+typedef struct ARI2cSynth_s {
+    ARSample_t *    Out;
+    uint32_t        Cap;
+    uint32_t        Len;            ///< Samples written
+    uint32_t        Overflow;       ///< 1 if something did not fit
+    ARSample_t      SclMask;
+    ARSample_t      SdaMask;
+    uint32_t        Scl;
+    uint32_t        Sda;
+    uint32_t        HalfPeriod;     ///< Samples per clock half period
+} ARI2cSynth_t;
+
+/// @brief Start a capture in `Out` with both lines high
+void                ARI2cSynthInit(ARI2cSynth_t * Syn, const ARI2cConfig_t * Cfg, ARSample_t * Out, uint32_t Cap, uint32_t HalfPeriod);
+
+/// @brief Keep the current levels for `Samples` samples (SCL low: clock stretching)
+void                ARI2cSynthHold(ARI2cSynth_t * Syn, uint32_t Samples);
+
+/// @brief START, or repeated START when SCL is low
+void                ARI2cSynthStart(ARI2cSynth_t * Syn);
+
+/// @brief Clock out the `Bits` low bits of `Value`, MSB first
+void                ARI2cSynthBits(ARI2cSynth_t * Syn, uint32_t Value, uint32_t Bits);
+
+/// @brief One byte followed by its ACK (1) or NACK (0) bit
+void                ARI2cSynthByte(ARI2cSynth_t * Syn, uint32_t Value, uint32_t Ack);
+
+/// @brief STOP, then idle for a full clock period
+void                ARI2cSynthStop(ARI2cSynth_t * Syn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_I2C_H__
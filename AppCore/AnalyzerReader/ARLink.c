@@ -0,0 +1,67 @@
+/**
+ * @file ARLink.c
+ * @brief Decoded protocol events handed from the reader task to the drawing task
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARLink.h"
+
+ARLink_t ARDecodeLink;
+
+/// @brief Lay out an empty link, all blocks free
+DefaultRet_t ARLinkInit(ARLink_t * Link){
+    if(Link == NULL){
+        return STAT_ERR_NULL;
+    }
+    DefaultRet_t ret = SpscRingInit(&(Link->Ring), Link->RingSlots, AR_LINK_BLOCKS);
+    if(ret == STAT_OKE){
+        ret = SpscPoolInit(&(Link->Pool), Link->Mem, AR_LINK_BLOCK_BYTES, AR_LINK_BLOCKS, Link->FreeSlots, AR_LINK_BLOCKS);
+    }
+    Link->Cur     = NULL;
+    Link->Len     = 0;
+    Link->Tag     = AR_LINK_NONE;
+    Link->Sent    = 0;
+    Link->Dropped = 0;
+    return ret;
+}
+
+/// @brief Push the partly filled block
+void ARLinkFlush(ARLink_t * Link){
+    if((Link->Cur == NULL) || (Link->Len == 0)){
+        return;
+    }
+    /// Cannot be full: the ring has a slot for every pool block
+    SpscRingPush(&(Link->Ring), Link->Cur, Link->Len, (uint16_t) Link->Tag, 0);
+    Link->Sent += Link->Len / ((Link->Tag == AR_LINK_SPI) ? sizeof(ARSpiEvent_t) : sizeof(ARI2cEvent_t));
+    Link->Cur = NULL;
+    Link->Len = 0;
+}
+
+/// @brief Append one event of kind `Tag`, starting a block when needed
+static void ARLinkAppend(ARLink_t * Link, uint32_t Tag, const void * Ev, uint32_t Size){
+    if((Link->Cur != NULL) && ((Link->Tag != Tag) || (Link->Len + Size > AR_LINK_BLOCK_BYTES))){
+        ARLinkFlush(Link);
+    }
+    if(Link->Cur == NULL){
+        Link->Cur = (uint8_t *) SpscPoolGet(&(Link->Pool));
+        if(Link->Cur == NULL){
+            Link->Dropped++;
+            return;
+        }
+        Link->Tag = Tag;
+    }
+    memcpy(Link->Cur + Link->Len, Ev, Size);
+    Link->Len += Size;
+}
+
+/// @brief SPI event sink
+void ARLinkOnSpi(void * Arg, const ARSpiEvent_t * Ev){
+    ARLinkAppend((ARLink_t *) Arg, AR_LINK_SPI, Ev, sizeof(ARSpiEvent_t));
+}
+
+/// @brief I2C event sink
+void ARLinkOnI2c(void * Arg, const ARI2cEvent_t * Ev){
+    ARLinkAppend((ARLink_t *) Arg, AR_LINK_I2C, Ev, sizeof(ARI2cEvent_t));
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ARLink.h
+ * @brief Decoded protocol events handed from the reader task to the drawing task
+ * @details The decoders' event callbacks copy events into a block taken from an SpscPool;
+ *          a full block (or the last one of a window, on ARLinkFlush()) is pushed on an
+ *          SpscRing and the drawing task pops it, reads the events and puts the block back.
+ *          A block holds events of one decoder only (Tag), Len / event size of them.
+ *          The ring has a slot per pool block, so a push never fails: when the drawing task
+ *          falls behind, the pool runs dry and the newest events are dropped and counted,
+ *          the reader never waits. Sample blocks keep going through ARRing_t, whose
+ *          overwrite-when-full semantics suit a capture; this link carries the results.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_LINK_H__
+#define __AR_LINK_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARLink.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "../../AppUtils/SpscRing.h"
+#include "ARSpi.h"
+#include "ARI2c.h"
+
+/// @brief Event blocks (power of 2)
+#define AR_LINK_BLOCKS              8
+/// @brief Bytes per event block (multiple of both event sizes: 24 SPI / 40 I2C events)
+#define AR_LINK_BLOCK_BYTES         960
+
+/// @brief Block payload kind (SpscBlock_t::Tag)
+enum ARLinkTag_e {
+    AR_LINK_NONE            = 0,
+    AR_LINK_SPI             = 1,    ///< ARSpiEvent_t array
+    AR_LINK_I2C             = 2,    ///< ARI2cEvent_t array
+};
+
+/// @brief Reader -> drawing task event link
+typedef struct ARLink_s {
+    SpscRing_t  Ring;                           ///< Filled blocks
+    SpscPool_t  Pool;                           ///< Free blocks
+    SpscBlock_t RingSlots[AR_LINK_BLOCKS];
+    SpscBlock_t FreeSlots[AR_LINK_BLOCKS];
+    uint8_t     Mem[AR_LINK_BLOCKS * AR_LINK_BLOCK_BYTES] __attribute__((aligned(8)));
+    /* Producer side */
+    uint8_t *   Cur;                            ///< Block being filled, NULL: none
+    uint32_t    Len;                            ///< Bytes used in Cur
+    uint32_t    Tag;                            ///< Kind of the events in Cur
+    uint32_t    Sent;                           ///< Events pushed
+    uint32_t    Dropped;                        ///< Events lost for want of a free block
+} ARLink_t;
+
+/// @brief Link between TaskReader and the drawing task
+extern ARLink_t ARDecodeLink;
+
+/// @brief Lay out an empty link, all blocks free (before either side uses it)
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARLinkInit(ARLink_t * Link);
+
+/// @brief SPI event sink (ARSpiEventCb_t), `Arg` is the link (producer side)
+void                ARLinkOnSpi(void * Arg, const ARSpiEvent_t * Ev);
+
+/// @brief I2C event sink (ARI2cEventCb_t), `Arg` is the link (producer side)
+void                ARLinkOnI2c(void * Arg, const ARI2cEvent_t * Ev);
+
+/// @brief Push the partly filled block, e.g. at the end of a window (producer side)
+void                ARLinkFlush(ARLink_t * Link);
+
+/// @brief Take the oldest filled block (consumer side)
+/// @param Out Descriptor: Data, Len bytes, Tag (ARLinkTag_e), Seq
+/// @return STAT_OKE, or STAT_ERR_UNDERFLOW when nothing is waiting
+static inline DefaultRet_t ARLinkPop(ARLink_t * Link, SpscBlock_t * Out){
+    return SpscRingPop(&(Link->Ring), Out);
+}
+
+/// @brief Give a block from ARLinkPop() back (consumer side)
+static inline DefaultRet_t ARLinkRelease(ARLink_t * Link, void * Data){
+    return SpscPoolPut(&(Link->Pool), Data);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_LINK_H__
@@ -0,0 +1,355 @@
+/**
+ * @file ARMeasure.c
+ * @brief Waveform measurements: frequency, period, duty, rise/fall, Vpp, Vmean, Vrms
+ * @author Nguyen Thanh Phu
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ARMeasure.h"
+
+/// @brief Latest published results, one sequence counter per channel (odd: being written)
+static struct {
+    volatile uint32_t   Seq;
+    ARMeasResult_t      Res;
+} ARMeasBoard[AR_SCOPE_CH_MAX];
+
+/// @brief Q16 frame where the segment (n - 1, Prev) -> (n, Cur) reaches `T`
+static inline uint64_t ARMeasCross(uint64_t n, int32_t Prev, int32_t Cur, int32_t T){
+    /// A flat step sitting on the level: the crossing is the current frame
+    if(Cur == Prev){
+        return n << AR_SCOPE_TRIG_FRAC_BITS;
+    }
+    uint32_t frac = (uint32_t) ((((int64_t) T - Prev) << AR_SCOPE_TRIG_FRAC_BITS) / (Cur - Prev));
+    return ((n - 1) << AR_SCOPE_TRIG_FRAC_BITS) + frac;
+}
+
+/// @brief Q16 frames to ns
+static inline uint64_t ARMeasNs(const ARMeasure_t * Meas, uint64_t Q16){
+    return (Q16 * 1000000000ULL / Meas->FrameHz) >> AR_SCOPE_TRIG_FRAC_BITS;
+}
+
+/// @brief Codes x 16 to mV
+static inline int32_t ARMeasMv(const ARMeasure_t * Meas, uint64_t Code16){
+    return (int32_t) ((Code16 * Meas->FullScaleMv + 8 * AR_SCOPE_CODE_MAX) / (16 * AR_SCOPE_CODE_MAX));
+}
+
+/// @brief Integer square root
+static uint32_t ARMeasSqrt(uint64_t v){
+    uint64_t r = 0;
+    for(uint64_t bit = 1ULL << 62; bit != 0; bit >>= 2){
+        if(v >= r + bit){
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+    }
+    return (uint32_t) r;
+}
+
+/// @brief Clear the window accumulators (edge state and carried stamps stay)
+static void ARMeasureClear(ARMeasure_t * Meas){
+    Meas->Min     = AR_SCOPE_CODE_MAX;
+    Meas->Max     = 0;
+    Meas->Sum     = 0;
+    Meas->SumSq   = 0;
+    Meas->Count   = 0;
+    Meas->RiseSum = 0;
+    Meas->RiseNum = 0;
+    Meas->FallSum = 0;
+    Meas->FallNum = 0;
+    Meas->HighSum = 0;
+    Meas->HighNum = 0;
+    /// The latest stamps open the next window
+    Meas->FirstRise = Meas->LastRise;
+    Meas->Rises     = (Meas->Rises > 0) ? 1 : 0;
+    Meas->FirstFall = Meas->LastFall;
+    Meas->Falls     = (Meas->Falls > 0) ? 1 : 0;
+    Meas->FirstShot = Meas->LastShot;
+    Meas->Shots     = (Meas->Shots > 0) ? 1 : 0;
+}
+
+/// @brief Reset a channel's measurements, time 0
+void ARMeasureInit(ARMeasure_t * Meas, uint32_t FrameHz, uint32_t FullScaleMv){
+    if(Meas == NULL){
+        return;
+    }
+    memset(Meas, 0, sizeof(ARMeasure_t));
+    Meas->FrameHz     = (FrameHz > 0) ? FrameHz : 1;
+    Meas->FullScaleMv = FullScaleMv;
+    Meas->State       = AR_MEAS_UNKNOWN;
+    ARMeasureClear(Meas);
+}
+
+/// @brief Measure consecutive codes of the channel
+void ARMeasureFeed(ARMeasure_t * Meas, const uint16_t * Codes, uint32_t Count){
+    if((Meas == NULL) || (Codes == NULL) || (Count == 0)){
+        return;
+    }
+    uint32_t lo = Meas->Min, hi = Meas->Max;
+    uint64_t sum = 0, sumSq = 0;
+    int32_t prev = (int32_t) Meas->Prev;
+    uint32_t state = Meas->HasLevels ? Meas->State : AR_MEAS_UNKNOWN;
+    int32_t l10 = Meas->Lo, l50 = Meas->Mid, l90 = Meas->Hi;
+
+    for(uint32_t i = 0; i < Count; i++){
+        int32_t x = Codes[i];
+        lo = ((uint32_t) x < lo) ? (uint32_t) x : lo;
+        hi = ((uint32_t) x > hi) ? (uint32_t) x : hi;
+        sum += (uint32_t) x;
+        sumSq += (uint32_t) (x * x);
+
+        if( !Meas->HasLevels ){
+            continue;
+        }
+        uint64_t n = Meas->Now + i;
+
+        switch(state){
+            case AR_MEAS_UNKNOWN:
+                state = (x < l10) ? AR_MEAS_LOW : ((x > l90) ? AR_MEAS_HIGH : AR_MEAS_UNKNOWN);
+                break;
+
+            case AR_MEAS_LOW:
+                /// Entered at or below 10 %: leave only strictly above it
+                if(x <= l10){
+                    break;
+                }
+                Meas->TEdge = ARMeasCross(n, prev, x, l10);
+                state = AR_MEAS_RISING;
+                /// 50 % and 90 % may be crossed by the same step
+                __attribute__((fallthrough));
+            case AR_MEAS_RISING:
+                if(x < l10){
+                    state = AR_MEAS_LOW;
+                    break;
+                }
+                if((prev < l50) && (x >= l50)){
+                    Meas->TMid = ARMeasCross(n, prev, x, l50);
+                }
+                if(x >= l90){
+                    Meas->RiseSum += ARMeasCross(n, prev, x, l90) - Meas->TEdge;
+                    Meas->RiseNum++;
+                    Meas->FirstRise = (Meas->Rises == 0) ? Meas->TMid : Meas->FirstRise;
+                    Meas->LastRise  = Meas->TMid;
+                    Meas->Rises++;
+                    state = AR_MEAS_HIGH;
+                }
+                break;
+
+            case AR_MEAS_HIGH:
+                if(x >= l90){
+                    break;
+                }
+                Meas->TEdge = ARMeasCross(n, prev, x, l90);
+                state = AR_MEAS_FALLING;
+                __attribute__((fallthrough));
+            default:
+                if(x > l90){
+                    state = AR_MEAS_HIGH;
+                    break;
+                }
+                if((prev > l50) && (x <= l50)){
+                    Meas->TMid = ARMeasCross(n, prev, x, l50);
+                }
+                if(x <= l10){
+                    Meas->FallSum += ARMeasCross(n, prev, x, l10) - Meas->TEdge;
+                    Meas->FallNum++;
+                    if(Meas->Rises > 0){
+                        Meas->HighSum += Meas->TMid - Meas->LastRise;
+                        Meas->HighNum++;
+                    }
+                    Meas->FirstFall = (Meas->Falls == 0) ? Meas->TMid : Meas->FirstFall;
+                    Meas->LastFall  = Meas->TMid;
+                    Meas->Falls++;
+                    state = AR_MEAS_LOW;
+                }
+                break;
+        }
+        prev = x;
+    }
+
+    Meas->Min    = lo;
+    Meas->Max    = hi;
+    Meas->Sum   += sum;
+    Meas->SumSq += sumSq;
+    Meas->Count += Count;
+    Meas->State  = state;
+    Meas->Prev   = Codes[Count - 1];
+    Meas->Now   += Count;
+}
+
+/// @brief Hand over a trigger crossing of this channel
+void ARMeasureShot(ARMeasure_t * Meas, uint64_t TrigPos){
+    if(Meas == NULL){
+        return;
+    }
+    Meas->FirstShot = (Meas->Shots == 0) ? TrigPos : Meas->FirstShot;
+    Meas->LastShot  = TrigPos;
+    Meas->Shots++;
+}
+
+/// @brief Close the window: compute the results and take its levels for the next window
+void ARMeasureFinish(ARMeasure_t * Meas, ARMeasResult_t * Out){
+    if((Meas == NULL) || (Out == NULL)){
+        return;
+    }
+    memset(Out, 0, sizeof(ARMeasResult_t));
+    Out->Frames = Meas->Count;
+    if(Meas->Count == 0){
+        return;
+    }
+
+    /// Levels, codes x 16 for the fractions of mean and RMS
+    Out->Valid   = AR_MEAS_HAS_LEVELS;
+    Out->VminMv  = ARMeasMv(Meas, (uint64_t) Meas->Min * 16);
+    Out->VmaxMv  = ARMeasMv(Meas, (uint64_t) Meas->Max * 16);
+    Out->VppMv   = Out->VmaxMv - Out->VminMv;
+    Out->VmeanMv = ARMeasMv(Meas, (Meas->Sum * 16) / Meas->Count);
+    Out->VrmsMv  = ARMeasMv(Meas, ARMeasSqrt((Meas->SumSq * 256) / Meas->Count));
+
+    /// Period: trigger shots first, then rising stamps, then falling stamps
+    uint64_t period = 0;
+    if(Meas->Shots >= 2){
+        period = (Meas->LastShot - Meas->FirstShot) / (Meas->Shots - 1);
+    } else if(Meas->Rises >= 2){
+        period = (Meas->LastRise - Meas->FirstRise) / (Meas->Rises - 1);
+    } else if(Meas->Falls >= 2){
+        period = (Meas->LastFall - Meas->FirstFall) / (Meas->Falls - 1);
+    }
+    if(period > 0){
+        Out->Valid      |= AR_MEAS_HAS_PERIOD;
+        Out->PeriodNs    = ARMeasNs(Meas, period);
+        Out->FreqMilliHz = ((uint64_t) Meas->FrameHz * 1000ULL << AR_SCOPE_TRIG_FRAC_BITS) / period;
+        if(Meas->HighNum > 0){
+            uint64_t high = Meas->HighSum / Meas->HighNum;
+            Out->Valid       |= AR_MEAS_HAS_DUTY;
+            Out->DutyPermille = (uint32_t) ((high * 1000 + period / 2) / period);
+        }
+    }
+    if(Meas->RiseNum > 0){
+        Out->Valid |= AR_MEAS_HAS_RISE;
+        Out->RiseNs = (uint32_t) ARMeasNs(Meas, Meas->RiseSum / Meas->RiseNum);
+    }
+    if(Meas->FallNum > 0){
+        Out->Valid |= AR_MEAS_HAS_FALL;
+        Out->FallNs = (uint32_t) ARMeasNs(Meas, Meas->FallSum / Meas->FallNum);
+    }
+
+    /// This window's swing sets the levels of the next one
+    int32_t pp = (int32_t) (Meas->Max - Meas->Min);
+    if(pp >= AR_MEAS_MIN_PP){
+        int32_t lo = (int32_t) Meas->Min + pp / 10;
+        int32_t mid = (int32_t) Meas->Min + pp / 2;
+        int32_t hi = (int32_t) Meas->Min + (pp * 9) / 10;
+        /// Levels moved by more than a tenth of the swing: the edge in progress is void
+        if( !Meas->HasLevels || (((mid > Meas->Mid) ? mid - Meas->Mid : Meas->Mid - mid) > pp / 10) ){
+            Meas->State = AR_MEAS_UNKNOWN;
+        }
+        Meas->Lo = lo;
+        Meas->Mid = mid;
+        Meas->Hi = hi;
+        Meas->HasLevels = 1;
+    } else {
+        Meas->HasLevels = 0;
+        Meas->State = AR_MEAS_UNKNOWN;
+        Meas->Rises = 0;
+        Meas->Falls = 0;
+    }
+    ARMeasureClear(Meas);
+}
+
+/// @brief Publish the latest results of channel `Ch`
+void ARMeasurePublish(uint32_t Ch, const ARMeasResult_t * Res){
+    if((Ch >= AR_SCOPE_CH_MAX) || (Res == NULL)){
+        return;
+    }
+    ARMeasBoard[Ch].Seq++;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ARMeasBoard[Ch].Res = *Res;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    ARMeasBoard[Ch].Seq++;
+}
+
+/// @brief Read the latest published results of channel `Ch`
+uint32_t ARMeasureLatest(uint32_t Ch, ARMeasResult_t * Out){
+    if((Ch >= AR_SCOPE_CH_MAX) || (Out == NULL)){
+        return 0;
+    }
+    uint32_t seq;
+    do {
+        /// Retry while a publication is in progress or happened during the copy
+        do {
+            seq = ARMeasBoard[Ch].Seq;
+        } while(seq & 1);
+        if(seq == 0){
+            return 0;
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        *Out = ARMeasBoard[Ch].Res;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while(ARMeasBoard[Ch].Seq != seq);
+    return seq / 2;
+}
+
+/// @brief "Name value unit" with up to four digits, `v` counted in `Units[0]`
+static int32_t ARMeasEng(char * Buf, uint32_t Len, const char * Name, uint64_t v, const char * const * Units, uint32_t UnitNum){
+    uint32_t u = 0;
+    while((v >= 1000000ULL) && (u + 2 < UnitNum)){
+        v /= 1000;
+        u++;
+    }
+    if(v >= 1000){
+        /// One unit up, four digits
+        uint64_t whole = v / 1000;
+        uint64_t frac = v % 1000;
+        if(whole >= 100){
+            return snprintf(Buf, Len, "%s %u.%u%s", Name, (unsigned) whole, (unsigned) (frac / 100), Units[u + 1]);
+        }
+        if(whole >= 10){
+            return snprintf(Buf, Len, "%s %u.%02u%s", Name, (unsigned) whole, (unsigned) (frac / 10), Units[u + 1]);
+        }
+        return snprintf(Buf, Len, "%s %u.%03u%s", Name, (unsigned) whole, (unsigned) frac, Units[u + 1]);
+    }
+    return snprintf(Buf, Len, "%s %u%s", Name, (unsigned) v, Units[u]);
+}
+
+/// @brief Readout text of one item
+int32_t ARMeasureFormat(const ARMeasResult_t * Res, uint32_t Item, char * Buf, uint32_t Len){
+    static const char * const hz[] = { "mHz", "Hz", "kHz", "MHz" };
+    static const char * const ns[] = { "ns", "us", "ms", "s" };
+    static const char * const name[AR_MEAS_ITEM_NUM] = { "F", "T", "Duty", "Rise", "Fall", "Vpp", "Vavg", "Vrms" };
+    static const uint32_t need[AR_MEAS_ITEM_NUM] = {
+        AR_MEAS_HAS_PERIOD, AR_MEAS_HAS_PERIOD, AR_MEAS_HAS_DUTY, AR_MEAS_HAS_RISE,
+        AR_MEAS_HAS_FALL, AR_MEAS_HAS_LEVELS, AR_MEAS_HAS_LEVELS, AR_MEAS_HAS_LEVELS,
+    };
+
+    if((Res == NULL) || (Buf == NULL) || (Len == 0) || (Item >= AR_MEAS_ITEM_NUM)){
+        return 0;
+    }
+    if( !(Res->Valid & need[Item]) ){
+        return snprintf(Buf, Len, "%s --", name[Item]);
+    }
+    switch(Item){
+        case AR_MEAS_FREQ:
+            return ARMeasEng(Buf, Len, name[Item], Res->FreqMilliHz, hz, 4);
+        case AR_MEAS_PERIOD:
+            return ARMeasEng(Buf, Len, name[Item], Res->PeriodNs, ns, 4);
+        case AR_MEAS_DUTY:
+            return snprintf(Buf, Len, "%s %u.%u%%", name[Item], (unsigned) (Res->DutyPermille / 10), (unsigned) (Res->DutyPermille % 10));
+        case AR_MEAS_RISE:
+            return ARMeasEng(Buf, Len, name[Item], Res->RiseNs, ns, 4);
+        case AR_MEAS_FALL:
+            return ARMeasEng(Buf, Len, name[Item], Res->FallNs, ns, 4);
+        default: {
+            int32_t mv = (Item == AR_MEAS_VPP) ? Res->VppMv : ((Item == AR_MEAS_VMEAN) ? Res->VmeanMv : Res->VrmsMv);
+            const char * sign = (mv < 0) ? "-" : "";
+            uint32_t a = (uint32_t) ((mv < 0) ? -mv : mv);
+            if(a >= 1000){
+                return snprintf(Buf, Len, "%s %s%u.%03uV", name[Item], sign, (unsigned) (a / 1000), (unsigned) (a % 1000));
+            }
+            return snprintf(Buf, Len, "%s %s%umV", name[Item], sign, (unsigned) a);
+        }
+    }
+}
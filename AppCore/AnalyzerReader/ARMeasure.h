@@ -0,0 +1,163 @@
+/**
+ * @file ARMeasure.h
+ * @brief Waveform measurements: frequency, period, duty, rise/fall, Vpp, Vmean, Vrms
+ * @details Codes of one channel are fed block by block and every code is visited once:
+ *          the same pass keeps min, max, sum and sum of squares, and walks an edge state
+ *          machine against the 10 / 50 / 90 % levels of the previous measurement window.
+ *          A rising edge starts when the signal leaves the low band (crossing 10 %) and is
+ *          complete at 90 %; falling into the low band again in between cancels it. Every
+ *          crossing is placed between samples by linear interpolation (Q16 frames, like
+ *          ARScopeTrig.h), the 50 % crossing of a complete edge is its time stamp.
+ *          Period comes from the first and last stamps of the window (or from the trigger
+ *          shots handed to ARMeasureShot(), when there are at least two), so its error does
+ *          not grow with the number of periods; the last stamp carries over to the next
+ *          window and no code is scanned twice.
+ *          ARMeasurePublish() / ARMeasureLatest() hand the latest result of each channel
+ *          from the scope task to the drawing task without a lock (sequence counter).
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_MEASURE_H__
+#define __AR_MEASURE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARMeasure.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARScopeTrig.h"
+
+/// @brief Smallest peak-to-peak swing (codes) timed; below it only levels are measured
+#define AR_MEAS_MIN_PP              64
+
+/// @brief Result validity bits
+#define AR_MEAS_HAS_LEVELS          0x0001  ///< Vmin, Vmax, Vpp, Vmean, Vrms
+#define AR_MEAS_HAS_PERIOD          0x0002  ///< Frequency and period
+#define AR_MEAS_HAS_DUTY            0x0004  ///< Duty cycle
+#define AR_MEAS_HAS_RISE            0x0008  ///< Rise time
+#define AR_MEAS_HAS_FALL            0x0010  ///< Fall time
+
+/// @brief Readout items (ARMeasureFormat())
+enum ARMeasItem_e {
+    AR_MEAS_FREQ            = 0,
+    AR_MEAS_PERIOD          = 1,
+    AR_MEAS_DUTY            = 2,
+    AR_MEAS_RISE            = 3,
+    AR_MEAS_FALL            = 4,
+    AR_MEAS_VPP             = 5,
+    AR_MEAS_VMEAN           = 6,
+    AR_MEAS_VRMS            = 7,
+    AR_MEAS_ITEM_NUM        = 8,
+};
+
+/// @brief Edge states
+enum ARMeasState_e {
+    AR_MEAS_UNKNOWN         = 0,    ///< Not yet below 10 % or above 90 %
+    AR_MEAS_LOW             = 1,    ///< Below 10 %
+    AR_MEAS_RISING          = 2,    ///< Crossed 10 % upwards, waiting for 90 %
+    AR_MEAS_HIGH            = 3,    ///< Above 90 %
+    AR_MEAS_FALLING         = 4,    ///< Crossed 90 % downwards, waiting for 10 %
+};
+
+/// @brief Measurements of one window
+typedef struct ARMeasResult_s {
+    uint32_t    Valid;          ///< AR_MEAS_HAS_*
+    uint32_t    Frames;         ///< Codes measured
+    uint64_t    FreqMilliHz;    ///< Frequency (mHz)
+    uint64_t    PeriodNs;       ///< Period (ns)
+    uint32_t    DutyPermille;   ///< High time / period (0.1 %)
+    uint32_t    RiseNs;         ///< Mean 10-90 % rise time (ns)
+    uint32_t    FallNs;         ///< Mean 90-10 % fall time (ns)
+    int32_t     VminMv;         ///< Lowest level (mV)
+    int32_t     VmaxMv;         ///< Highest level (mV)
+    int32_t     VppMv;          ///< Peak to peak (mV)
+    int32_t     VmeanMv;        ///< Mean (mV)
+    int32_t     VrmsMv;         ///< RMS, DC included (mV)
+} ARMeasResult_t;
+
+/// @brief Measurement state of one channel
+typedef struct ARMeasure_s {
+    uint32_t    FrameHz;        ///< Frames per second of the channel
+    uint32_t    FullScaleMv;    ///< Level of code AR_SCOPE_CODE_MAX (mV)
+
+    /* Levels of the previous window (codes) */
+    int32_t     Lo;             ///< 10 %
+    int32_t     Mid;            ///< 50 %
+    int32_t     Hi;             ///< 90 %
+    uint32_t    HasLevels;      ///< 0 until a window swings AR_MEAS_MIN_PP
+
+    /* Window accumulators */
+    uint32_t    Min;
+    uint32_t    Max;
+    uint64_t    Sum;
+    uint64_t    SumSq;
+    uint32_t    Count;
+
+    /* Edges, Q16 frames */
+    uint32_t    State;          ///< ARMeasState_e
+    uint32_t    Prev;           ///< Last code
+    uint64_t    Now;            ///< Frames fed
+    uint64_t    TEdge;          ///< Start of the edge in progress (10 % or 90 % crossing)
+    uint64_t    TMid;           ///< Latest 50 % crossing of the edge in progress
+    uint64_t    FirstRise;      ///< Stamp of the first rising edge of the window
+    uint64_t    LastRise;       ///< Stamp of the latest rising edge
+    uint32_t    Rises;          ///< Rising stamps (the carried one included)
+    uint64_t    FirstFall;
+    uint64_t    LastFall;
+    uint32_t    Falls;
+    uint64_t    RiseSum;        ///< Sum of the rise times of the window
+    uint32_t    RiseNum;
+    uint64_t    FallSum;
+    uint32_t    FallNum;
+    uint64_t    HighSum;        ///< Sum of rising-to-falling stamp spans
+    uint32_t    HighNum;
+    uint64_t    FirstShot;      ///< First trigger shot of the window
+    uint64_t    LastShot;
+    uint32_t    Shots;
+} ARMeasure_t;
+
+/// @brief Reset a channel's measurements, time 0
+/// @param Meas Pointer to the state
+/// @param FrameHz Frames per second of the channel
+/// @param FullScaleMv Level of code AR_SCOPE_CODE_MAX (mV)
+void                ARMeasureInit(ARMeasure_t * Meas, uint32_t FrameHz, uint32_t FullScaleMv);
+
+/// @brief Measure consecutive codes of the channel (one pass, nothing kept)
+/// @param Meas Pointer to the state
+/// @param Codes Codes following the ones of the previous call
+/// @param Count Number of codes
+void                ARMeasureFeed(ARMeasure_t * Meas, const uint16_t * Codes, uint32_t Count);
+
+/// @brief Hand over a trigger crossing of this channel (ARScopeTrig_t TrigPos, no holdoff)
+/// @details Shots and codes share the frame count: start both at time 0 together.
+void                ARMeasureShot(ARMeasure_t * Meas, uint64_t TrigPos);
+
+/// @brief Close the window: compute the results and take its levels for the next window
+/// @param Meas Pointer to the state
+/// @param Out Results (Valid is 0 when nothing was fed)
+void                ARMeasureFinish(ARMeasure_t * Meas, ARMeasResult_t * Out);
+
+/// @brief Publish the latest results of channel `Ch` (one writer per channel)
+void                ARMeasurePublish(uint32_t Ch, const ARMeasResult_t * Res);
+
+/// @brief Read the latest published results of channel `Ch`
+/// @return Publications so far (0: nothing published, `Out` untouched)
+uint32_t            ARMeasureLatest(uint32_t Ch, ARMeasResult_t * Out);
+
+/// @brief Readout text of one item, e.g. "F 1.235kHz" or "Vpp --"
+/// @param Res Results
+/// @param Item ARMeasItem_e
+/// @param Buf Destination
+/// @param Len Size of `Buf`
+/// @return Characters written (snprintf)
+int32_t             ARMeasureFormat(const ARMeasResult_t * Res, uint32_t Item, char * Buf, uint32_t Len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_MEASURE_H__
@@ -0,0 +1,240 @@
+/**
+ * @file ARPyramid.c
+ * @brief Min/max decimation pyramid over captured samples, for zoomable trace rendering
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARPyramid.h"
+
+/// @brief Node covering no sample
+static const ARPyrNode_t ARPyrNone = { .And = 0xFFFF, .Or = 0 };
+
+/// @brief Samples per node of level `l`
+#define ARPyrGroup(l)               ((uint64_t) AR_PYR_BASE << (AR_PYR_FANOUT_SHIFT * (l)))
+
+/// @brief Merge `n` into `acc`
+#define ARPyrMerge(acc, n)          do { (acc).And &= (n).And; (acc).Or |= (n).Or; } while(0)
+
+/// @brief Store level-0 node number `Index` and carry completed merges up the levels
+static void ARPyrPush(ARPyr_t * Pyr, uint64_t Index, ARPyrNode_t Node){
+    for(uint32_t l = 0; l < Pyr->Levels; l++){
+        Pyr->Level[l][Index % Pyr->Nodes[l]] = Node;
+        if(l + 1 >= Pyr->Levels){
+            break;
+        }
+        ARPyrMerge(Pyr->Acc[l + 1], Node);
+        if((Index & (AR_PYR_FANOUT - 1)) != (AR_PYR_FANOUT - 1)){
+            break;
+        }
+        /// Last child of its parent: the parent is complete
+        Node = Pyr->Acc[l + 1];
+        Pyr->Acc[l + 1] = ARPyrNone;
+        Index >>= AR_PYR_FANOUT_SHIFT;
+    }
+}
+
+/// @brief Merge raw samples [From, To) (already clipped) into `Acc`
+static void ARPyrMergeRaw(const ARPyr_t * Pyr, uint64_t From, uint64_t To, ARPyrNode_t * Acc){
+    uint32_t p = (uint32_t) (From % Pyr->RawCap);
+    uint32_t a = Acc->And, o = Acc->Or;
+    for(uint64_t n = To - From; n > 0; n--){
+        a &= Pyr->Raw[p];
+        o |= Pyr->Raw[p];
+        if(++p == Pyr->RawCap){
+            p = 0;
+        }
+    }
+    Acc->And = (ARSample_t) a;
+    Acc->Or  = (ARSample_t) o;
+}
+
+/// @brief Bytes of node memory a pyramid over `RawCap` samples needs
+uint32_t ARPyrBytes(uint32_t RawCap){
+    uint32_t bytes = 0;
+    for(uint32_t l = 0; l < AR_PYR_LEVELS_MAX; l++){
+        uint64_t nodes = RawCap / ARPyrGroup(l);
+        if(nodes == 0){
+            break;
+        }
+        bytes += (uint32_t) nodes * sizeof(ARPyrNode_t);
+    }
+    return bytes;
+}
+
+/// @brief Attach a pyramid to node memory and to the samples it indexes, and reset it
+DefaultRet_t ARPyrInit(ARPyr_t * Pyr, void * Mem, uint32_t Bytes, const ARSample_t * Raw, uint32_t RawCap){
+    if((Pyr == NULL) || (Mem == NULL) || (Raw == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if((RawCap < 2 * AR_PYR_BASE) || (Bytes < ARPyrBytes(RawCap))){
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    memset(Pyr, 0, sizeof(ARPyr_t));
+    Pyr->Raw    = Raw;
+    Pyr->RawCap = RawCap;
+    ARPyrNode_t * node = (ARPyrNode_t *) Mem;
+    for(uint32_t l = 0; l < AR_PYR_LEVELS_MAX; l++){
+        uint64_t nodes = RawCap / ARPyrGroup(l);
+        if(nodes == 0){
+            break;
+        }
+        Pyr->Level[l] = node;
+        Pyr->Nodes[l] = (uint32_t) nodes;
+        node += nodes;
+        Pyr->Levels++;
+    }
+    ARPyrReset(Pyr, 0);
+    return STAT_OKE;
+}
+
+/// @brief Forget every sample; indexing restarts at sample `Start`
+void ARPyrReset(ARPyr_t * Pyr, uint64_t Start){
+    if(Pyr == NULL){
+        return;
+    }
+    for(uint32_t l = 0; l < AR_PYR_LEVELS_MAX; l++){
+        Pyr->Acc[l] = ARPyrNone;
+    }
+    Pyr->Begin = Start;
+    Pyr->Total = Start;
+}
+
+/// @brief Index the next `Count` samples of Raw
+void ARPyrAppend(ARPyr_t * Pyr, uint32_t Count){
+    if(Pyr == NULL){
+        return;
+    }
+    while(Count > 0){
+        /// Contiguous part of Raw
+        uint32_t p = (uint32_t) (Pyr->Total % Pyr->RawCap);
+        uint32_t n = Pyr->RawCap - p;
+        if(n > Count){
+            n = Count;
+        }
+        const ARSample_t * s = &(Pyr->Raw[p]);
+        Count -= n;
+
+        /// Finish the level-0 node in progress
+        while((n > 0) && (Pyr->Total % AR_PYR_BASE)){
+            ARPyrMerge(Pyr->Acc[0], ((ARPyrNode_t) { .And = *s, .Or = *s }));
+            s++;
+            n--;
+            if((++Pyr->Total % AR_PYR_BASE) == 0){
+                ARPyrPush(Pyr, Pyr->Total / AR_PYR_BASE - 1, Pyr->Acc[0]);
+                Pyr->Acc[0] = ARPyrNone;
+            }
+        }
+        /// Whole nodes
+        while(n >= AR_PYR_BASE){
+            uint32_t a = 0xFFFF, o = 0;
+            for(uint32_t k = 0; k < AR_PYR_BASE; k++){
+                a &= s[k];
+                o |= s[k];
+            }
+            Pyr->Total += AR_PYR_BASE;
+            ARPyrPush(Pyr, Pyr->Total / AR_PYR_BASE - 1, ((ARPyrNode_t) { .And = (ARSample_t) a, .Or = (ARSample_t) o }));
+            s += AR_PYR_BASE;
+            n -= AR_PYR_BASE;
+        }
+        /// Start the next one
+        while(n > 0){
+            ARPyrMerge(Pyr->Acc[0], ((ARPyrNode_t) { .And = *s, .Or = *s }));
+            s++;
+            n--;
+            Pyr->Total++;
+        }
+    }
+}
+
+/// @brief Index every block the producer committed since the last call
+uint32_t ARPyrFeed(ARPyr_t * Pyr, ARRing_t * Ring){
+    if((Pyr == NULL) || (Ring == NULL)){
+        return 0;
+    }
+    uint32_t bs = Ring->BlockSamples;
+    uint32_t head = Ring->Head;
+    uint32_t seq = (uint32_t) (Pyr->Total / bs);
+    Pyr->Guard = bs;
+
+    /// Lapped: what was not indexed is gone
+    if(head - seq > Ring->Blocks - 1){
+        seq = head - (Ring->Blocks - 1);
+        ARPyrReset(Pyr, ARRingSeqToSample(Ring, seq));
+    }
+
+    uint32_t blocks = 0;
+    while(seq != head){
+        if(ARRingPeek(Ring, seq) == NULL){
+            break;
+        }
+        ARPyrAppend(Pyr, bs);
+        seq++;
+        blocks++;
+    }
+    return blocks;
+}
+
+/// @brief Oldest sample a query can cover
+uint64_t ARPyrOldest(const ARPyr_t * Pyr){
+    if(Pyr == NULL){
+        return 0;
+    }
+    uint64_t keep = Pyr->RawCap - Pyr->Guard;
+    uint64_t oldest = (Pyr->Total > keep) ? (Pyr->Total - keep) : 0;
+    return (oldest > Pyr->Begin) ? oldest : Pyr->Begin;
+}
+
+/// @brief Summary of samples [From, To), clipped to [ARPyrOldest(), Total)
+ARPyrNode_t ARPyrRange(const ARPyr_t * Pyr, uint64_t From, uint64_t To){
+    ARPyrNode_t acc = ARPyrNone;
+    if(Pyr == NULL){
+        return acc;
+    }
+    uint64_t oldest = ARPyrOldest(Pyr);
+    if(From < oldest){
+        From = oldest;
+    }
+    if(To > Pyr->Total){
+        To = Pyr->Total;
+    }
+    if(From >= To){
+        return acc;
+    }
+
+    /// Raw samples up to the first node boundary
+    uint64_t aligned = (From + AR_PYR_BASE - 1) / AR_PYR_BASE * AR_PYR_BASE;
+    if(aligned >= To){
+        ARPyrMergeRaw(Pyr, From, To, &acc);
+        return acc;
+    }
+    ARPyrMergeRaw(Pyr, From, aligned, &acc);
+    From = aligned;
+
+    /// Largest node that starts here and ends before `To`: climbs, then descends
+    while(To - From >= AR_PYR_BASE){
+        uint32_t l = 0;
+        while((l + 1 < Pyr->Levels) && ((From % ARPyrGroup(l + 1)) == 0) && (From + ARPyrGroup(l + 1) <= To)){
+            l++;
+        }
+        uint64_t g = ARPyrGroup(l);
+        ARPyrMerge(acc, Pyr->Level[l][(From / g) % Pyr->Nodes[l]]);
+        From += g;
+    }
+
+    ARPyrMergeRaw(Pyr, From, To, &acc);
+    return acc;
+}
+
+/// @brief Summaries of [From, To) cut into `Cols` equal columns
+void ARPyrColumns(const ARPyr_t * Pyr, uint64_t From, uint64_t To, ARPyrNode_t * Out, uint32_t Cols){
+    if((Pyr == NULL) || (Out == NULL)){
+        return;
+    }
+    uint64_t span = (To > From) ? (To - From) : 0;
+    for(uint32_t c = 0; c < Cols; c++){
+        Out[c] = ARPyrRange(Pyr, From + span * c / Cols, From + span * (c + 1) / Cols);
+    }
+}
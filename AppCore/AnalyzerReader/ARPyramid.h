@@ -0,0 +1,107 @@
+/**
+ * @file ARPyramid.h
+ * @brief Min/max decimation pyramid over captured samples, for zoomable trace rendering
+ * @details For digital channels the minimum of a span is the AND of its samples and the
+ *          maximum is the OR, so one node is 4 bytes whatever the channel count. A channel
+ *          that is 0 in And and 1 in Or had both levels, i.e. toggled, inside the span.
+ *          Level 0 summarizes groups of AR_PYR_BASE samples and every level above merges
+ *          AR_PYR_FANOUT nodes of the one below. Nodes are written as samples are indexed,
+ *          so the pyramid grows with the capture; any span is then covered by at most a few
+ *          nodes per level plus raw samples at its unaligned ends, and a screen of W columns
+ *          costs O(W log N) whatever the zoom.
+ *          The pyramid indexes a sample buffer it does not own (`Raw`): a linear capture, or
+ *          the ring itself (ARPyrFeed()), with sample n stored at Raw[n % RawCap]. Every level
+ *          is circular too, so it always covers the last RawCap samples.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_PYRAMID_H__
+#define __AR_PYRAMID_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARPyramid.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+
+/// @brief Samples per level-0 node
+#define AR_PYR_BASE                 16
+/// @brief Nodes of level L merged into one node of level L + 1 (log2)
+#define AR_PYR_FANOUT_SHIFT         2
+/// @brief Nodes of level L merged into one node of level L + 1
+#define AR_PYR_FANOUT               (1U << AR_PYR_FANOUT_SHIFT)
+/// @brief Deepest pyramid (16 * 4^11 samples per top node)
+#define AR_PYR_LEVELS_MAX           12
+
+/// @brief Summary of a span of samples
+typedef struct ARPyrNode_s {
+    ARSample_t      And;            ///< Channels high on every sample (minimum)
+    ARSample_t      Or;             ///< Channels high on some sample (maximum)
+} ARPyrNode_t;
+
+/// @brief Channels that toggled inside the span of `node`
+#define ARPyrToggled(node)          ((ARSample_t) ((node).Or & ~(node).And))
+/// @brief Channels without a sample in the span (empty node: And all ones, Or zero)
+#define ARPyrEmpty(node)            ((ARSample_t) ((node).And & ~(node).Or))
+
+/// @brief Pyramid state
+typedef struct ARPyr_s {
+    ARPyrNode_t *       Level[AR_PYR_LEVELS_MAX];   ///< Circular node arrays
+    uint32_t            Nodes[AR_PYR_LEVELS_MAX];   ///< Slots per level
+    uint32_t            Levels;
+    ARPyrNode_t         Acc[AR_PYR_LEVELS_MAX];     ///< Node being merged on each level
+    const ARSample_t *  Raw;
+    uint32_t            RawCap;         ///< Samples in Raw
+    uint32_t            Guard;          ///< Oldest samples that may be under rewrite (ring block)
+    uint64_t            Begin;          ///< First sample indexed without a gap
+    uint64_t            Total;          ///< Samples indexed (= index of the next one)
+} ARPyr_t;
+
+/// @brief Bytes of node memory a pyramid over `RawCap` samples needs (about RawCap / 3)
+uint32_t            ARPyrBytes(uint32_t RawCap);
+
+/// @brief Attach a pyramid to node memory and to the samples it indexes, and reset it
+/// @param Pyr Pointer to the pyramid
+/// @param Mem Node memory, ARPyrBytes(RawCap) bytes, 4-byte aligned
+/// @param Bytes Size of `Mem`
+/// @param Raw Indexed samples (sample n at Raw[n % RawCap])
+/// @param RawCap Samples in `Raw` (>= 2 * AR_PYR_BASE)
+/// @return STAT_OKE or an argument error
+DefaultRet_t        ARPyrInit(ARPyr_t * Pyr, void * Mem, uint32_t Bytes, const ARSample_t * Raw, uint32_t RawCap);
+
+/// @brief Forget every sample; indexing restarts at sample `Start`
+void                ARPyrReset(ARPyr_t * Pyr, uint64_t Start);
+
+/// @brief Index the next `Count` samples of Raw (samples Total .. Total + Count - 1)
+void                ARPyrAppend(ARPyr_t * Pyr, uint32_t Count);
+
+/// @brief Index every block the producer committed since the last call
+/// @details `Pyr` must have been set up on the ring memory (Raw = Ring->Buf,
+///          RawCap = Blocks * BlockSamples). Only reads blocks, so it runs next to the
+///          ring's consumer. Blocks overwritten before they were indexed restart the
+///          pyramid at the oldest intact one.
+/// @return Blocks indexed
+uint32_t            ARPyrFeed(ARPyr_t * Pyr, ARRing_t * Ring);
+
+/// @brief Oldest sample a query can cover
+uint64_t            ARPyrOldest(const ARPyr_t * Pyr);
+
+/// @brief Summary of samples [From, To), clipped to [ARPyrOldest(), Total)
+/// @return Empty node (see ARPyrEmpty()) if nothing is left after clipping
+ARPyrNode_t         ARPyrRange(const ARPyr_t * Pyr, uint64_t From, uint64_t To);
+
+/// @brief Summaries of [From, To) cut into `Cols` equal columns (one per screen column)
+/// @details Column c covers [From + c * Span / Cols, From + (c + 1) * Span / Cols).
+///          Columns outside the indexed samples come back empty.
+void                ARPyrColumns(const ARPyr_t * Pyr, uint64_t From, uint64_t To, ARPyrNode_t * Out, uint32_t Cols);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_PYRAMID_H__
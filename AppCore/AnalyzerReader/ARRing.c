@@ -0,0 +1,138 @@
+/**
+ * @file ARRing.c
+ * @brief Block ring buffer holding captured samples
+ * @author Nguyen Thanh Phu
+ */
+
+#include "ARRing.h"
+
+/// @brief Attach the ring to caller-provided memory and reset it
+DefaultRet_t ARRingInit(ARRing_t * Ring, ARSample_t * Buf, uint32_t Blocks, uint32_t BlockSamples){
+    if((Ring == NULL) || (Buf == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if((Blocks < 2) || (BlockSamples == 0)){
+        return STAT_ERR_INVALID_SIZE;
+    }
+    Ring->Buf          = Buf;
+    Ring->Blocks       = Blocks;
+    Ring->BlockSamples = BlockSamples;
+    Ring->Sync         = NULL;
+    ARRingReset(Ring);
+    return STAT_OKE;
+}
+
+/// @brief Forget every block and the overrun count (producer must be stopped)
+void ARRingReset(ARRing_t * Ring){
+    if(Ring == NULL){
+        return;
+    }
+    Ring->Head     = 0;
+    Ring->Tail     = 0;
+    Ring->Overruns = 0;
+}
+
+/// @brief Consumer: number of committed blocks still intact and not yet released
+uint32_t ARRingPending(ARRing_t * Ring){
+    if(Ring == NULL){
+        return 0;
+    }
+    uint32_t lag = Ring->Head - Ring->Tail;
+    return (lag > Ring->Blocks - 1) ? (Ring->Blocks - 1) : lag;
+}
+
+/// @brief Consumer: oldest committed block, skipping the ones already overwritten
+const ARSample_t * ARRingAcquire(ARRing_t * Ring, uint32_t * Seq){
+    if(Ring == NULL){
+        return NULL;
+    }
+
+    uint32_t head = Ring->Head;
+    uint32_t lag  = head - Ring->Tail;
+    if(lag == 0){
+        return NULL;
+    }
+
+    /// The producer is writing block `head`: everything older than Blocks - 1 is gone
+    if(lag > Ring->Blocks - 1){
+        Ring->Overruns += lag - (Ring->Blocks - 1);
+        Ring->Tail = head - (Ring->Blocks - 1);
+    }
+
+    const ARSample_t * block = &(Ring->Buf[(Ring->Tail % Ring->Blocks) * Ring->BlockSamples]);
+    if(Ring->Sync != NULL){
+        Ring->Sync(block, Ring->BlockSamples * sizeof(ARSample_t));
+    }
+    if(Seq != NULL){
+        *Seq = Ring->Tail;
+    }
+    return block;
+}
+
+/// @brief Consumer: hand the acquired block back to the producer
+DefaultRet_t ARRingRelease(ARRing_t * Ring){
+    if(Ring == NULL){
+        return STAT_ERR_NULL;
+    }
+    if(Ring->Head == Ring->Tail){
+        return STAT_ERR_INVALID_STATE;
+    }
+
+    /// Reached by the producer while it was being read: contents are not trustworthy
+    DefaultRet_t ret = STAT_OKE;
+    if(Ring->Head - Ring->Tail > Ring->Blocks - 1){
+        ret = STAT_ERR_OVERFLOW;
+    }
+    Ring->Tail = Ring->Tail + 1;
+    return ret;
+}
+
+/// @brief Consumer: look at any intact committed block without releasing anything
+const ARSample_t * ARRingPeek(ARRing_t * Ring, uint32_t Seq){
+    if(Ring == NULL){
+        return NULL;
+    }
+    /// Committed, and not yet reached again by the block the producer is writing
+    uint32_t lag = Ring->Head - Seq;
+    if((lag == 0) || (lag > Ring->Blocks - 1)){
+        return NULL;
+    }
+
+    const ARSample_t * block = &(Ring->Buf[(Seq % Ring->Blocks) * Ring->BlockSamples]);
+    if(Ring->Sync != NULL){
+        Ring->Sync(block, Ring->BlockSamples * sizeof(ARSample_t));
+    }
+    return block;
+}
+
+/// @brief Consumer: release every block older than `Seq` at once
+void ARRingDiscard(ARRing_t * Ring, uint32_t Seq){
+    if(Ring == NULL){
+        return;
+    }
+    uint32_t head = Ring->Head;
+    if((int32_t) (Seq - head) > 0){
+        Seq = head;
+    }
+    if((int32_t) (Seq - Ring->Tail) > 0){
+        /// Blocks the producer already took back count as overruns, like in ARRingAcquire()
+        if(head - Ring->Tail > Ring->Blocks - 1){
+            uint32_t oldest = head - (Ring->Blocks - 1);
+            if((int32_t) (Seq - oldest) > 0){
+                Ring->Overruns += oldest - Ring->Tail;
+            } else {
+                Ring->Overruns += Seq - Ring->Tail;
+            }
+        }
+        Ring->Tail = Seq;
+    }
+}
+
+/// @brief Blocks lost to the producer since the last reset
+uint32_t ARRingOverruns(ARRing_t * Ring){
+    if(Ring == NULL){
+        return 0;
+    }
+    uint32_t lag = Ring->Head - Ring->Tail;
+    return Ring->Overruns + ((lag > Ring->Blocks - 1) ? (lag - (Ring->Blocks - 1)) : 0);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file ARRing.h
+ * @brief Block ring buffer holding captured samples
+ * @details The capture memory is cut into equal blocks. A producer (the GDMA EOF callback
+ *          of the capture engine, or the synthetic source) fills the block at the head and
+ *          commits it; the consumer acquires the oldest committed block, processes it in
+ *          place and releases it. Head and tail are free-running block counters, each with
+ *          a single writer, so one producer and one consumer may run on different cores
+ *          without a lock. The producer never waits: when it laps the consumer, the blocks
+ *          it overwrote are counted as overruns and skipped on the next acquire.
+ *          Hardware independent, so the whole pipeline behind the ring builds on a host.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_RING_H__
+#define __AR_RING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARRing.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../../AppUtils/ReturnType.h"
+
+/// @brief One sample: bit n = level of channel n
+typedef uint16_t                    ARSample_t;
+
+/// @brief Number of channels carried by a sample
+#define AR_CHANNEL_NUM              16
+
+/// @brief Two samples per 32-bit word: high bit of each 16-bit lane
+#define AR_LANE_HI                  0x80008000UL
+/// @brief Two samples per 32-bit word: low 15 bits of each lane
+#define AR_LANE_LO                  0x7FFF7FFFUL
+/// @brief Two samples per 32-bit word: lane 0 only
+#define AR_LANE0                    0x00008000UL
+
+/// @brief Same 16-bit value in both lanes
+#define ARLanePair(x)               ((uint32_t) (x) | ((uint32_t) (x) << 16))
+/// @brief Lane high bit set for every lane of `v` that is not zero (no carry between lanes)
+#define ARLaneNonZero(v)            (((((v) & AR_LANE_LO) + AR_LANE_LO) | (v)) & AR_LANE_HI)
+
+/// @brief Sample block ring
+typedef struct ARRing_s {
+    ARSample_t *        Buf;            ///< Blocks * BlockSamples samples
+    uint32_t            Blocks;         ///< Number of blocks (>= 2)
+    uint32_t            BlockSamples;   ///< Samples per block
+    volatile uint32_t   Head;           ///< Blocks committed since the last reset (producer only)
+    volatile uint32_t   Tail;           ///< Blocks released since the last reset (consumer only)
+    uint32_t            Overruns;       ///< Blocks lost to the producer (consumer only)
+    /// @brief Called on every acquired block before the consumer reads it (may be NULL)
+    /// @details The capture engine invalidates the cache lines the DMA wrote behind the CPU.
+    void              (*Sync)(const void * Addr, uint32_t Bytes);
+} ARRing_t;
+
+/// @brief Block the producer fills next
+#define ARRingProducerBlock(ring)           (&((ring)->Buf[((ring)->Head % (ring)->Blocks) * (ring)->BlockSamples]))
+
+/// @brief Producer: publish the block returned by ARRingProducerBlock()
+/// @note  A macro so the GDMA callback does not call into flash; Head has a single writer.
+#define ARRingCommit(ring)                  ((ring)->Head = (ring)->Head + 1)
+
+/// @brief Index of the first sample of block number `seq` (sample timestamp)
+#define ARRingSeqToSample(ring, seq)        ((uint64_t)(seq) * (ring)->BlockSamples)
+
+/// @brief Bytes of capture memory needed for `blocks` blocks of `samples` samples
+#define ARRingBytes(blocks, samples)        ((uint32_t)(blocks) * (uint32_t)(samples) * sizeof(ARSample_t))
+
+/// @brief Attach the ring to caller-provided memory and reset it
+/// @param Ring Pointer to the ring
+/// @param Buf Capture memory (Blocks * BlockSamples samples)
+/// @param Blocks Number of blocks (>= 2)
+/// @param BlockSamples Samples per block
+/// @return STAT_OKE or an argument error
+DefaultRet_t        ARRingInit(ARRing_t * Ring, ARSample_t * Buf, uint32_t Blocks, uint32_t BlockSamples);
+
+/// @brief Forget every block and the overrun count (producer must be stopped)
+/// @param Ring Pointer to the ring
+void                ARRingReset(ARRing_t * Ring);
+
+/// @brief Consumer: number of committed blocks still intact and not yet released
+/// @details One block less than the ring size at most: the producer is writing the next one.
+/// @param Ring Pointer to the ring
+/// @return Blocks ready to acquire
+uint32_t            ARRingPending(ARRing_t * Ring);
+
+/// @brief Consumer: oldest committed block, skipping the ones already overwritten
+/// @param Ring Pointer to the ring
+/// @param Seq Receives the block sequence number (first sample = Seq * BlockSamples), may be NULL
+/// @return Pointer to BlockSamples samples, or NULL if no block is ready
+const ARSample_t *  ARRingAcquire(ARRing_t * Ring, uint32_t * Seq);
+
+/// @brief Consumer: hand the acquired block back to the producer
+/// @param Ring Pointer to the ring
+/// @return STAT_OKE, or STAT_ERR_OVERFLOW if the producer overwrote the block while it was held
+DefaultRet_t        ARRingRelease(ARRing_t * Ring);
+
+/// @brief Consumer: look at any intact committed block without releasing anything
+/// @details Lets a consumer scan ahead of its tail while keeping older blocks (history).
+/// @param Ring Pointer to the ring
+/// @param Seq Block sequence number
+/// @return Pointer to BlockSamples samples, or NULL if the block is not committed yet or overwritten
+const ARSample_t *  ARRingPeek(ARRing_t * Ring, uint32_t Seq);
+
+/// @brief Consumer: release every block older than `Seq` at once
+/// @param Ring Pointer to the ring
+/// @param Seq First block to keep (clamped to the head)
+void                ARRingDiscard(ARRing_t * Ring, uint32_t Seq);
+
+/// @brief Blocks lost to the producer since the last reset
+/// @param Ring Pointer to the ring
+/// @return Overrun count
+uint32_t            ARRingOverruns(ARRing_t * Ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_RING_H__
@@ -0,0 +1,247 @@
+/**
+ * @file ARRle.c
+ * @brief Transition-encoded capture storage: one record per change of the sampled channels
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARRle.h"
+
+/// @brief Append `v` as an unsigned LEB128 varint (room checked by the caller)
+static inline uint32_t ARRlePutVarint(uint8_t * p, uint64_t v){
+    uint32_t n = 0;
+    while(v >= 0x80){
+        p[n++] = (uint8_t) (v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t) v;
+    return n;
+}
+
+/// @brief Read an unsigned LEB128 varint at `*Pos`
+/// @return 1 on success, 0 if it runs past `Len` or overflows 64 bits
+static inline uint32_t ARRleGetVarint(const uint8_t * Buf, uint32_t Len, uint32_t * Pos, uint64_t * Out){
+    uint64_t v = 0;
+    uint32_t shift = 0;
+    uint32_t p = *Pos;
+    while(p < Len){
+        uint8_t b = Buf[p++];
+        v |= (uint64_t) (b & 0x7F) << shift;
+        if( !(b & 0x80) ){
+            *Pos = p;
+            *Out = v;
+            return 1;
+        }
+        shift += 7;
+        if(shift >= 64){
+            return 0;
+        }
+    }
+    return 0;
+}
+
+/// @brief Write one record for a change to `State` at sample `T`
+/// @return 0 if it does not fit
+static inline uint32_t ARRlePut(ARRle_t * Rle, ARSample_t State, uint64_t T){
+    if(Rle->Cap - Rle->Len < AR_RLE_RECORD_MAX){
+        return 0;
+    }
+    Rle->Len += ARRlePutVarint(&Rle->Buf[Rle->Len], T - Rle->LastAt);
+    Rle->Len += ARRlePutVarint(&Rle->Buf[Rle->Len], (uint32_t) (State ^ Rle->State));
+    Rle->State  = State;
+    Rle->LastAt = T;
+    Rle->Records++;
+    return 1;
+}
+
+/// @brief Decode the record at Pos into the lookahead
+static void ARRleReaderFetch(ARRleReader_t * Rd){
+    uint64_t delta, toggle;
+    if(ARRleGetVarint(Rd->Buf, Rd->Len, &Rd->Pos, &delta) && ARRleGetVarint(Rd->Buf, Rd->Len, &Rd->Pos, &toggle)){
+        Rd->NextAt    = Rd->At + delta;
+        Rd->NextState = (ARSample_t) (Rd->State ^ toggle);
+        Rd->HasNext   = 1;
+    } else {
+        Rd->HasNext   = 0;
+    }
+}
+
+/// @brief Attach a trace to caller-provided memory and reset it
+DefaultRet_t ARRleInit(ARRle_t * Rle, uint8_t * Buf, uint32_t Cap, ARSample_t Mask){
+    if((Rle == NULL) || (Buf == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if(Cap < AR_RLE_RECORD_MAX){
+        return STAT_ERR_INVALID_SIZE;
+    }
+    if(Mask == 0){
+        return STAT_ERR_INVALID_ARG;
+    }
+    memset(Rle, 0, sizeof(ARRle_t));
+    Rle->Buf  = Buf;
+    Rle->Cap  = Cap;
+    Rle->Mask = Mask;
+    ARRleReset(Rle);
+    return STAT_OKE;
+}
+
+/// @brief Empty the trace
+void ARRleReset(ARRle_t * Rle){
+    if(Rle == NULL){
+        return;
+    }
+    Rle->Len      = 0;
+    Rle->State    = 0;
+    Rle->HasState = 0;
+    Rle->Full     = 0;
+    Rle->Records  = 0;
+    Rle->LastAt   = 0;
+    Rle->Now      = 0;
+    Rle->Origin   = 0;
+    Rle->Skipped  = 0;
+}
+
+/// @brief Append the next `Count` samples
+uint32_t ARRleEncode(ARRle_t * Rle, const ARSample_t * Samples, uint32_t Count){
+    if((Rle == NULL) || (Samples == NULL) || (Count == 0) || Rle->Full){
+        return 0;
+    }
+    /// The first record carries the initial state
+    if( !Rle->HasState ){
+        if( !ARRlePut(Rle, (ARSample_t) (Samples[0] & Rle->Mask), Rle->Now) ){
+            Rle->Full = 1;
+            return 0;
+        }
+        Rle->HasState = 1;
+    }
+
+    uint32_t watch = ARLanePair(Rle->Mask);
+    uint32_t prev = Rle->State;
+    uint32_t i = 0;
+
+    while(i < Count){
+        /// Skip pairs where no recorded channel moves
+        if(i + 1 < Count){
+            uint32_t a = Samples[i];
+            uint32_t x = a | ((uint32_t) Samples[i + 1] << 16);
+            if( !ARLaneNonZero((x ^ (prev | (a << 16))) & watch) ){
+                i += 2;
+                continue;
+            }
+        }
+        ARSample_t s = (ARSample_t) (Samples[i] & Rle->Mask);
+        if(s != prev){
+            if( !ARRlePut(Rle, s, Rle->Now + i) ){
+                /// Out of room: the trace ends right before this change
+                Rle->Full = 1;
+                Rle->Now += i;
+                return i;
+            }
+            prev = s;
+        }
+        i++;
+    }
+
+    Rle->Now += Count;
+    return Count;
+}
+
+/// @brief Encode and release every block the producer committed since the last call
+uint32_t ARRleDrain(ARRle_t * Rle, ARRing_t * Ring){
+    if((Rle == NULL) || (Ring == NULL)){
+        return 0;
+    }
+    uint32_t blocks = 0;
+    uint32_t seq;
+    const ARSample_t * block;
+
+    while( !Rle->Full && ((block = ARRingAcquire(Ring, &seq)) != NULL) ){
+        uint64_t at = ARRingSeqToSample(Ring, seq);
+        if( !Rle->HasState ){
+            Rle->Origin = at - Rle->Now;
+        } else if(at > Rle->Origin + Rle->Now){
+            /// Blocks overwritten before they were encoded
+            Rle->Skipped += at - (Rle->Origin + Rle->Now);
+            Rle->Now      = at - Rle->Origin;
+        }
+        ARRleEncode(Rle, block, Ring->BlockSamples);
+        ARRingRelease(Ring);
+        blocks++;
+    }
+    return blocks;
+}
+
+/// @brief Bytes of raw samples the trace stands for, per byte stored (x100)
+uint32_t ARRleRatio100(const ARRle_t * Rle){
+    if((Rle == NULL) || (Rle->Len == 0)){
+        return 0;
+    }
+    uint64_t ratio = Rle->Now * sizeof(ARSample_t) * 100 / Rle->Len;
+    return (ratio > UINT32_MAX) ? UINT32_MAX : (uint32_t) ratio;
+}
+
+/// @brief Start reading `Rle` at sample 0
+void ARRleReaderInit(ARRleReader_t * Rd, const ARRle_t * Rle){
+    if((Rd == NULL) || (Rle == NULL)){
+        return;
+    }
+    memset(Rd, 0, sizeof(ARRleReader_t));
+    Rd->Buf = Rle->Buf;
+    Rd->Len = Rle->Len;
+    Rd->End = Rle->Now;
+    /// The first record (delta 0) becomes the current state, the second the lookahead
+    ARRleReaderFetch(Rd);
+    if(Rd->HasNext){
+        ARRleReaderNext(Rd);
+    }
+}
+
+/// @brief Move to the next transition (At/State become NextAt/NextState)
+uint32_t ARRleReaderNext(ARRleReader_t * Rd){
+    if((Rd == NULL) || !Rd->HasNext){
+        return 0;
+    }
+    Rd->At    = Rd->NextAt;
+    Rd->State = Rd->NextState;
+    ARRleReaderFetch(Rd);
+    return 1;
+}
+
+/// @brief Move forward to the transition in effect at sample `T` (never backwards)
+void ARRleReaderSeek(ARRleReader_t * Rd, uint64_t T){
+    if(Rd == NULL){
+        return;
+    }
+    while(Rd->HasNext && (Rd->NextAt <= T)){
+        ARRleReaderNext(Rd);
+    }
+}
+
+/// @brief Render samples [From, From + Count) of the trace as raw samples
+uint32_t ARRleExpand(ARRleReader_t * Rd, uint64_t From, ARSample_t * Out, uint32_t Count){
+    if((Rd == NULL) || (Out == NULL) || (From >= Rd->End)){
+        return 0;
+    }
+    if(Count > Rd->End - From){
+        Count = (uint32_t) (Rd->End - From);
+    }
+    ARRleReaderSeek(Rd, From);
+
+    uint32_t n = 0;
+    while(n < Count){
+        /// Current state runs up to the next transition or the end of the slice
+        uint32_t run = Count - n;
+        if(Rd->HasNext && (Rd->NextAt - (From + n) < run)){
+            run = (uint32_t) (Rd->NextAt - (From + n));
+        }
+        for(uint32_t k = 0; k < run; k++){
+            Out[n + k] = Rd->State;
+        }
+        n += run;
+        if(n < Count){
+            ARRleReaderNext(Rd);
+        }
+    }
+    return n;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file ARRle.h
+ * @brief Transition-encoded capture storage: one record per change of the sampled channels
+ * @details A trace only stores the samples where a recorded channel changes. A record is
+ *          two unsigned LEB128 varints: the samples elapsed since the previous record, then
+ *          the channels that toggled (new state XOR old state). The first record of a trace
+ *          has a delta of 0 and carries the initial state. A one-channel edge within 127
+ *          samples of the previous one costs 2 bytes instead of 2 bytes per sample, so a
+ *          sparse bus fits orders of magnitude more time in the same PSRAM.
+ *          The encoder consumes raw blocks as they come out of the ring (pairs of samples
+ *          are compared in one 32-bit word, like the decoders), and the reader walks
+ *          transitions in time order, so decoders and renderers work on the trace without
+ *          expanding it. ARRleExpand() turns any slice back into raw samples.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_RLE_H__
+#define __AR_RLE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARRle.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+
+/// @brief Longest record: 64-bit delta (10 bytes) + 16-bit toggle mask (3 bytes)
+#define AR_RLE_RECORD_MAX           13
+
+/// @brief Trace being written
+typedef struct ARRle_s {
+    uint8_t *       Buf;
+    uint32_t        Cap;            ///< Bytes available in Buf
+    uint32_t        Len;            ///< Bytes written
+    ARSample_t      Mask;           ///< Recorded channels, the others read as 0
+    ARSample_t      State;          ///< Masked level after the last record
+    uint32_t        HasState;       ///< 0 until the first record
+    uint32_t        Full;           ///< 1 once a record did not fit: the trace ends at Now
+    uint32_t        Records;        ///< Records written
+    uint64_t        LastAt;         ///< Sample of the last record
+    uint64_t        Now;            ///< Samples covered by the trace (= its length)
+    uint64_t        Origin;         ///< Ring sample of trace sample 0 (ARRleDrain())
+    uint64_t        Skipped;        ///< Samples lost to ring overruns, State held across them
+} ARRle_t;
+
+/// @brief Sequential reader with one record of lookahead
+typedef struct ARRleReader_s {
+    const uint8_t * Buf;
+    uint32_t        Len;
+    uint32_t        Pos;            ///< Byte after the lookahead record
+    uint64_t        End;            ///< Trace length in samples
+    uint64_t        At;             ///< Sample of the current transition
+    ARSample_t      State;          ///< Level from At up to NextAt
+    ARSample_t      NextState;
+    uint32_t        HasNext;        ///< 0: State holds until End
+    uint64_t        NextAt;
+} ARRleReader_t;
+
+/// @brief Attach a trace to caller-provided memory and reset it
+/// @param Rle Pointer to the trace
+/// @param Buf Storage
+/// @param Cap Size of `Buf` in bytes (>= AR_RLE_RECORD_MAX)
+/// @param Mask Channels to record
+/// @return STAT_OKE or an argument error
+DefaultRet_t        ARRleInit(ARRle_t * Rle, uint8_t * Buf, uint32_t Cap, ARSample_t Mask);
+
+/// @brief Empty the trace
+void                ARRleReset(ARRle_t * Rle);
+
+/// @brief Append the next `Count` samples
+/// @return Samples consumed: less than `Count` only when the storage filled up
+uint32_t            ARRleEncode(ARRle_t * Rle, const ARSample_t * Samples, uint32_t Count);
+
+/// @brief Encode and release every block the producer committed since the last call
+/// @details Blocks lost to an overrun are bridged by holding the last state; their samples are
+///          added to Skipped so the trace keeps the ring's time base.
+/// @return Blocks encoded
+uint32_t            ARRleDrain(ARRle_t * Rle, ARRing_t * Ring);
+
+/// @brief Bytes of raw samples the trace stands for, per byte stored (x100)
+uint32_t            ARRleRatio100(const ARRle_t * Rle);
+
+/// @brief Start reading `Rle` at sample 0
+void                ARRleReaderInit(ARRleReader_t * Rd, const ARRle_t * Rle);
+
+/// @brief Move to the next transition (At/State become NextAt/NextState)
+/// @return 1 on success, 0 at the end of the trace
+uint32_t            ARRleReaderNext(ARRleReader_t * Rd);
+
+/// @brief Move forward to the transition in effect at sample `T` (never backwards)
+void                ARRleReaderSeek(ARRleReader_t * Rd, uint64_t T);
+
+/// @brief Render samples [From, From + Count) of the trace as raw samples
+/// @details Moves the reader forward; consecutive slices need no new seek.
+/// @return Samples written (clipped to the trace length)
+uint32_t            ARRleExpand(ARRleReader_t * Rd, uint64_t From, ARSample_t * Out, uint32_t Count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_RLE_H__
@@ -0,0 +1,205 @@
+/**
+ * @file ARScope.c
+ * @brief Oscilloscope engine: ADC continuous (DMA) conversions into a block ring
+ * @author Nguyen Thanh Phu
+ */
+
+#include "ARScope.h"
+
+#if (AR_SCOPE_ADC_EN == 1)
+
+#include "esp_adc/adc_continuous.h"
+
+/// @brief Results per DMA frame (one ISR per frame, 4 bytes per result)
+#define AR_SCOPE_FRAME_RESULTS      256
+/// @brief Frames the driver pool holds (flushed when full: blocks are built in the ISR)
+#define AR_SCOPE_POOL_FRAMES        4
+
+/// @brief Frame done (ISR): pack the results into ring blocks, commit the full ones
+static bool IRAM_ATTR ARScopeOnFrame(adc_continuous_handle_t Handle, const adc_continuous_evt_data_t * Ev, void * Arg){
+    ARScope_t * scope = (ARScope_t *) Arg;
+    ARRing_t * ring = &(scope->Ring);
+    const adc_digi_output_data_t * res = (const adc_digi_output_data_t *) Ev->conv_frame_buffer;
+    uint32_t n = Ev->size / SOC_ADC_DIGI_RESULT_BYTES;
+    ARSample_t * block = ARRingProducerBlock(ring);
+    uint32_t fill = scope->Fill;
+    BaseType_t woken = pdFALSE;
+
+    for(uint32_t i = 0; i < n; i++){
+        uint32_t ch = res[i].type2.channel;
+        if(ch >= AR_SCOPE_CH_MAX){
+            continue;
+        }
+        block[fill++] = AR_SCOPE_SAMPLE(ch, res[i].type2.data);
+        if(fill == ring->BlockSamples){
+            ARRingCommit(ring);
+            block = ARRingProducerBlock(ring);
+            fill = 0;
+            if(scope->Waiter != NULL){
+                vTaskNotifyGiveFromISR((TaskHandle_t) scope->Waiter, &woken);
+            }
+        }
+    }
+    scope->Fill = fill;
+    return (woken == pdTRUE);
+}
+
+/// @brief Driver pool full (ISR): a frame went missing from the pool, not from the ring
+static bool IRAM_ATTR ARScopeOnPoolOverflow(adc_continuous_handle_t Handle, const adc_continuous_evt_data_t * Ev, void * Arg){
+    ARScope_t * scope = (ARScope_t *) Arg;
+    scope->PoolOverflows = scope->PoolOverflows + 1;
+    return false;
+}
+
+/// @brief Fill a configuration with the module defaults
+void ARScopeDefaultConfig(ARScopeConfig_t * Cfg){
+    if(IsNull(Cfg)){
+        return;
+    }
+    Cfg->ChannelMask  = AR_SCOPE_CHANNELS;
+    Cfg->Atten        = ADC_ATTEN_DB_12;
+    Cfg->RateHz       = AR_SCOPE_DEFAULT_RATE_HZ;
+    Cfg->Blocks       = AR_SCOPE_BLOCKS;
+    Cfg->BlockSamples = AR_SCOPE_BLOCK_SAMPLES;
+}
+
+/// @brief Allocate the ring (internal RAM) and set up the ADC continuous driver
+ARScope_t * ARScopeNew(const ARScopeConfig_t * Cfg){
+    AREntry("ARScopeNew(%p)", Cfg);
+
+    if(IsNull(Cfg)){
+        ARReturnWithLog(NULL, "ARScopeNew() : STAT_ERR_NULL");
+    }
+    uint32_t mask = Cfg->ChannelMask & ((1U << AR_SCOPE_CH_MAX) - 1);
+    uint32_t channels = __builtin_popcount(mask);
+    if((channels == 0) || (channels > SOC_ADC_PATT_LEN_MAX) ||
+       (Cfg->RateHz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) || (Cfg->RateHz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH)){
+        ARErr("[ARScopeNew] Channels 0x%x at %d Hz not supported", Cfg->ChannelMask, Cfg->RateHz);
+        ARReturnWithLog(NULL, "ARScopeNew() : STAT_ERR_INVALID_ARG");
+    }
+    if((Cfg->Blocks < 2) || (Cfg->BlockSamples == 0)){
+        ARErr("[ARScopeNew] Bad ring geometry: %d blocks x %d samples", Cfg->Blocks, Cfg->BlockSamples);
+        ARReturnWithLog(NULL, "ARScopeNew() : STAT_ERR_INVALID_SIZE");
+    }
+
+    /// Blocks are written from the ISR: internal RAM
+    ARScope_t * scope = (ARScope_t *) heap_caps_calloc(1, sizeof(ARScope_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ARSample_t * buf = (ARSample_t *) heap_caps_malloc(ARRingBytes(Cfg->Blocks, Cfg->BlockSamples), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if(IsNull(scope) || IsNull(buf)){
+        ARErr("[ARScopeNew] Malloc failed for ring (%d bytes)", ARRingBytes(Cfg->Blocks, Cfg->BlockSamples));
+        if(IsNotNull(scope)) heap_caps_free(scope);
+        if(IsNotNull(buf)) heap_caps_free(buf);
+        ARReturnWithLog(NULL, "ARScopeNew() : STAT_ERR_MALLOC_FAILED");
+    }
+    scope->Cfg         = *Cfg;
+    scope->Cfg.ChannelMask = mask;
+    scope->Channels    = channels;
+    scope->State       = AR_SCOPE_IDLE;
+    ARRingInit(&(scope->Ring), buf, Cfg->Blocks, Cfg->BlockSamples);
+
+    adc_continuous_handle_t handle = NULL;
+    adc_continuous_handle_cfg_t handleCfg = {
+        .max_store_buf_size = AR_SCOPE_POOL_FRAMES * AR_SCOPE_FRAME_RESULTS * SOC_ADC_DIGI_RESULT_BYTES,
+        .conv_frame_size    = AR_SCOPE_FRAME_RESULTS * SOC_ADC_DIGI_RESULT_BYTES,
+        .flags.flush_pool   = 1,
+    };
+    esp_err_t err = adc_continuous_new_handle(&handleCfg, &handle);
+
+    if(err == ESP_OK){
+        /// Round robin over the enabled channels, ascending
+        adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX] = { 0 };
+        uint32_t n = 0;
+        for(uint32_t ch = 0; ch < AR_SCOPE_CH_MAX; ch++){
+            if( !(mask & (1U << ch)) ){
+                continue;
+            }
+            pattern[n].atten     = (uint8_t) Cfg->Atten;
+            pattern[n].channel   = (uint8_t) ch;
+            pattern[n].unit      = ADC_UNIT_1;
+            pattern[n].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+            n++;
+        }
+        adc_continuous_config_t digiCfg = {
+            .pattern_num    = n,
+            .adc_pattern    = pattern,
+            .sample_freq_hz = Cfg->RateHz,
+            .conv_mode      = ADC_CONV_SINGLE_UNIT_1,
+            .format         = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+        };
+        err = adc_continuous_config(handle, &digiCfg);
+    }
+    if(err == ESP_OK){
+        adc_continuous_evt_cbs_t cbs = {
+            .on_conv_done = ARScopeOnFrame,
+            .on_pool_ovf  = ARScopeOnPoolOverflow,
+        };
+        err = adc_continuous_register_event_callbacks(handle, &cbs, scope);
+    }
+    if(err != ESP_OK){
+        ARErr("[ARScopeNew] ADC continuous setup failed (%s)", esp_err_to_name(err));
+        if(IsNotNull(handle)) adc_continuous_deinit(handle);
+        heap_caps_free(buf);
+        heap_caps_free(scope);
+        ARReturnWithLog(NULL, "ARScopeNew() : STAT_ERR_INIT_FAILED");
+    }
+    scope->HwCtx = handle;
+
+    ARLog("[ARScopeNew] %d ch (0x%x), %d Hz, %d blocks x %d samples",
+          channels, mask, Cfg->RateHz, Cfg->Blocks, Cfg->BlockSamples);
+    ARReturnWithLog(scope, "ARScopeNew() : STAT_OKE");
+}
+
+/// @brief Stop the engine and release everything
+void ARScopeDelete(ARScope_t * Scope){
+    if(IsNull(Scope) || IsNull(Scope->HwCtx)){
+        return;
+    }
+    ARScopeStop(Scope);
+    adc_continuous_deinit((adc_continuous_handle_t) Scope->HwCtx);
+    heap_caps_free(Scope->Ring.Buf);
+    heap_caps_free(Scope);
+}
+
+/// @brief Empty the ring and start converting
+DefaultRet_t ARScopeStart(ARScope_t * Scope){
+    if(IsNull(Scope) || IsNull(Scope->HwCtx)){
+        return STAT_ERR_NULL;
+    }
+    if(Scope->State == AR_SCOPE_RUNNING){
+        return STAT_OKE;
+    }
+    ARRingReset(&(Scope->Ring));
+    Scope->Fill          = 0;
+    Scope->PoolOverflows = 0;
+
+    esp_err_t err = adc_continuous_start((adc_continuous_handle_t) Scope->HwCtx);
+    if(err != ESP_OK){
+        ARErr("[ARScopeStart] adc_continuous_start failed (%s)", esp_err_to_name(err));
+        return STAT_ERR_INIT_FAILED;
+    }
+    Scope->State = AR_SCOPE_RUNNING;
+    return STAT_OKE;
+}
+
+/// @brief Stop converting; committed blocks stay readable in the ring
+void ARScopeStop(ARScope_t * Scope){
+    if(IsNull(Scope) || IsNull(Scope->HwCtx) || (Scope->State != AR_SCOPE_RUNNING)){
+        return;
+    }
+    adc_continuous_stop((adc_continuous_handle_t) Scope->HwCtx);
+    Scope->State = AR_SCOPE_IDLE;
+}
+
+/// @brief Block the calling task until a block is committed
+uint32_t ARScopeWait(ARScope_t * Scope, uint32_t TimeoutMs){
+    if(IsNull(Scope)){
+        return 0;
+    }
+    Scope->Waiter = xTaskGetCurrentTaskHandle();
+    if(ARRingPending(&(Scope->Ring)) == 0){
+        ulTaskNotifyTake(pdTRUE, MsToTicks(TimeoutMs));
+    }
+    return ARRingPending(&(Scope->Ring));
+}
+
+#endif /// (AR_SCOPE_ADC_EN == 1)
@@ -0,0 +1,91 @@
+/**
+ * @file ARScope.h
+ * @brief Oscilloscope engine: ADC continuous (DMA) conversions into a block ring
+ * @details The ADC digital controller converts the enabled ADC1 channels round robin and
+ *          DMAs the results frame by frame. The frame-done callback (ISR) packs each result
+ *          into a tagged 16-bit sample (ARScopeSynth.h) in the producer block of the ring and
+ *          commits the block once it is full, then wakes the processing task waiting in
+ *          ARScopeWait(). With two blocks this is plain double buffering: the task works on
+ *          one block while the ISR fills the other, with no lock between them.
+ *          ESP32-S3: ADC1 channel n is GPIO n + 1; those pads are also logic inputs, so the
+ *          scope and the logic capture do not share channels.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_SCOPE_H__
+#define __AR_SCOPE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARScope.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "AnalyzerReader.h"
+
+#if (AR_SCOPE_ADC_EN == 1)
+
+/// @brief Engine states
+enum ARScopeState_e {
+    AR_SCOPE_IDLE           = 0,    ///< Converter stopped
+    AR_SCOPE_RUNNING        = 1,    ///< Converting
+};
+
+/// @brief Scope configuration
+typedef struct ARScopeConfig_s {
+    uint32_t    ChannelMask;    ///< ADC1 channels (bit n: channel n, n < AR_SCOPE_CH_MAX)
+    uint32_t    Atten;          ///< adc_atten_t applied to every channel
+    uint32_t    RateHz;         ///< Conversions per second, all channels together
+    uint32_t    Blocks;         ///< Ring blocks (2: double buffer)
+    uint32_t    BlockSamples;   ///< Conversions per block
+} ARScopeConfig_t;
+
+/// @brief Scope engine
+typedef struct ARScope_s {
+    ARRing_t            Ring;           ///< Converted blocks (consumer side is public)
+    ARScopeConfig_t     Cfg;            ///< Configuration given to ARScopeNew()
+    uint32_t            Channels;       ///< Enabled channel count
+    volatile uint32_t   State;          ///< ARScopeState_e
+    volatile uint32_t   Fill;           ///< Samples already in the producer block
+    volatile uint32_t   PoolOverflows;  ///< Frames the driver reported as dropped
+    void *              Waiter;         ///< Task woken on every committed block
+    void *              HwCtx;          ///< ADC driver handle
+} ARScope_t;
+
+/// @brief Fill a configuration with the module defaults (AnalyzerReader.h)
+/// @param Cfg Pointer to the configuration
+void                ARScopeDefaultConfig(ARScopeConfig_t * Cfg);
+
+/// @brief Allocate the ring (internal RAM) and set up the ADC continuous driver
+/// @param Cfg Pointer to the configuration (copied)
+/// @return Engine in AR_SCOPE_IDLE, or NULL on failure
+ARScope_t *         ARScopeNew(const ARScopeConfig_t * Cfg);
+
+/// @brief Stop the engine and release everything
+/// @param Scope Pointer to the engine
+void                ARScopeDelete(ARScope_t * Scope);
+
+/// @brief Empty the ring and start converting
+/// @param Scope Pointer to the engine
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARScopeStart(ARScope_t * Scope);
+
+/// @brief Stop converting; committed blocks stay readable in the ring
+/// @param Scope Pointer to the engine
+void                ARScopeStop(ARScope_t * Scope);
+
+/// @brief Block the calling task until a block is committed (the caller becomes the waiter)
+/// @param Scope Pointer to the engine
+/// @param TimeoutMs Longest wait
+/// @return Blocks ready in the ring
+uint32_t            ARScopeWait(ARScope_t * Scope, uint32_t TimeoutMs);
+
+#endif /// (AR_SCOPE_ADC_EN == 1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_SCOPE_H__
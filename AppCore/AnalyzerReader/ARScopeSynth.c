@@ -0,0 +1,139 @@
+/**
+ * @file ARScopeSynth.c
+ * @brief Oscilloscope sample format and the synthetic waveform source standing in for the ADC
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARScopeSynth.h"
+
+/// @brief Quarter sine wave, Q15, 64 steps + end point
+static const int16_t ARScopeSinQ[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767,
+};
+
+/// @brief sin(2 pi Phase / 2^32) in Q15 (256 steps per period)
+static int32_t ARScopeSin(uint32_t Phase){
+    uint32_t i = (Phase >> 24) & 0x3F;
+    switch(Phase >> 30){
+        case 0:  return  ARScopeSinQ[i];
+        case 1:  return  ARScopeSinQ[64 - i];
+        case 2:  return -ARScopeSinQ[i];
+        default: return -ARScopeSinQ[64 - i];
+    }
+}
+
+/// @brief Next xorshift32 value
+static uint32_t ARScopeSynthRand(ARScopeSynth_t * Synth){
+    uint32_t x = Synth->Seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    Synth->Seed = x;
+    return x;
+}
+
+/// @brief Uniform value in [-Peak, Peak]
+static int32_t ARScopeSynthNoise(ARScopeSynth_t * Synth, uint32_t Peak){
+    if(Peak == 0){
+        return 0;
+    }
+    return (int32_t) (ARScopeSynthRand(Synth) % (2 * Peak + 1)) - (int32_t) Peak;
+}
+
+/// @brief First enabled channel after `Ch` (wrapping)
+static uint32_t ARScopeSynthNextCh(const ARScopeSynth_t * Synth, uint32_t Ch){
+    for(uint32_t k = 1; k <= AR_SCOPE_CH_MAX; k++){
+        uint32_t c = (Ch + k) % AR_SCOPE_CH_MAX;
+        if(Synth->ChannelMask & (1U << c)){
+            return c;
+        }
+    }
+    return Ch;
+}
+
+/// @brief Reset the generator: channels in `ChannelMask` at mid scale, time 0
+void ARScopeSynthInit(ARScopeSynth_t * Synth, uint32_t ChannelMask, uint32_t Seed){
+    if(Synth == NULL){
+        return;
+    }
+    memset(Synth, 0, sizeof(ARScopeSynth_t));
+    Synth->ChannelMask = ChannelMask & ((1U << AR_SCOPE_CH_MAX) - 1);
+    if(Synth->ChannelMask == 0){
+        Synth->ChannelMask = 1;
+    }
+    Synth->Seed = (Seed != 0) ? Seed : 0x2545F491UL;
+    for(uint32_t ch = 0; ch < AR_SCOPE_CH_MAX; ch++){
+        Synth->Wave[ch].Offset = (AR_SCOPE_CODE_MAX + 1) / 2;
+    }
+    Synth->NextCh = ARScopeSynthNextCh(Synth, AR_SCOPE_CH_MAX - 1);
+}
+
+/// @brief Set the waveform of one channel
+void ARScopeSynthSetWave(ARScopeSynth_t * Synth, uint32_t Ch, uint32_t Kind, uint32_t PeriodFrames,
+                         uint32_t Offset, uint32_t Amplitude, uint32_t Noise){
+    if((Synth == NULL) || (Ch >= AR_SCOPE_CH_MAX)){
+        return;
+    }
+    ARScopeWave_t * w = &(Synth->Wave[Ch]);
+    w->Kind      = (uint8_t) Kind;
+    w->Offset    = (uint16_t) ((Offset > AR_SCOPE_CODE_MAX) ? AR_SCOPE_CODE_MAX : Offset);
+    w->Amplitude = (uint16_t) ((Amplitude > AR_SCOPE_CODE_MAX) ? AR_SCOPE_CODE_MAX : Amplitude);
+    w->Noise     = (uint16_t) ((Noise > AR_SCOPE_CODE_MAX) ? AR_SCOPE_CODE_MAX : Noise);
+    w->Step      = (PeriodFrames >= 2) ? (uint32_t) ((1ULL << 32) / PeriodFrames) : 0;
+    w->Phase     = 0;
+}
+
+/// @brief Generate the next `Count` tagged samples
+void ARScopeSynthFill(ARScopeSynth_t * Synth, ARSample_t * Out, uint32_t Count){
+    if((Synth == NULL) || (Out == NULL)){
+        return;
+    }
+
+    for(uint32_t i = 0; i < Count; i++){
+        uint32_t ch = Synth->NextCh;
+        ARScopeWave_t * w = &(Synth->Wave[ch]);
+        int32_t v = w->Offset;
+
+        switch(w->Kind){
+            case AR_WAVE_SINE:
+                v += (ARScopeSin(w->Phase) * (int32_t) w->Amplitude) / 32767;
+                break;
+            case AR_WAVE_SQUARE:
+                v += (w->Phase < 0x80000000UL) ? (int32_t) w->Amplitude : -(int32_t) w->Amplitude;
+                break;
+            case AR_WAVE_NOISE:
+                v += ARScopeSynthNoise(Synth, w->Amplitude);
+                break;
+            default:
+                break;
+        }
+        v += ARScopeSynthNoise(Synth, w->Noise);
+        v = (v < 0) ? 0 : ((v > AR_SCOPE_CODE_MAX) ? AR_SCOPE_CODE_MAX : v);
+
+        Out[i] = AR_SCOPE_SAMPLE(ch, v);
+        w->Phase += w->Step;
+        Synth->NextCh = ARScopeSynthNextCh(Synth, ch);
+    }
+    Synth->Now += Count;
+}
+
+/// @brief Produce whole blocks into a ring, like the ADC engine would
+void ARScopeSynthFeed(ARScopeSynth_t * Synth, ARRing_t * Ring, uint32_t Blocks){
+    if((Synth == NULL) || (Ring == NULL)){
+        return;
+    }
+    for(uint32_t b = 0; b < Blocks; b++){
+        ARScopeSynthFill(Synth, ARRingProducerBlock(Ring), Ring->BlockSamples);
+        ARRingCommit(Ring);
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file ARScopeSynth.h
+ * @brief Oscilloscope sample format and the synthetic waveform source standing in for the ADC
+ * @details Scope blocks travel through an ARRing_t like logic blocks, but each 16-bit sample
+ *          is one ADC conversion: a 12-bit code tagged with its channel in the top 4 bits.
+ *          Enabled channels are converted in ascending order, one "frame" after another, and
+ *          the tag keeps every sample attributable even when the ADC drops a conversion.
+ *          The generator (sine, square, noise, DC, plus additive noise) writes the same
+ *          format and commits the same blocks as ARScope.h, so measurements, triggers and
+ *          renderers run on a host or on a board without an analog front end.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_SCOPE_SYNTH_H__
+#define __AR_SCOPE_SYNTH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARScopeSynth.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+
+/// @brief Analog channels a sample tag can name
+#define AR_SCOPE_CH_MAX             10
+/// @brief Largest ADC code (12 bits)
+#define AR_SCOPE_CODE_MAX           4095
+
+/// @brief Tagged sample: channel `ch`, code `code`
+#define AR_SCOPE_SAMPLE(ch, code)   ((ARSample_t) (((uint32_t) (ch) << 12) | ((uint32_t) (code) & AR_SCOPE_CODE_MAX)))
+/// @brief Channel of a tagged sample
+#define ARScopeCh(s)                ((uint32_t) (s) >> 12)
+/// @brief ADC code of a tagged sample
+#define ARScopeCode(s)              ((uint32_t) (s) & AR_SCOPE_CODE_MAX)
+
+/// @brief Waveform kinds
+enum ARScopeWaveKind_e {
+    AR_WAVE_DC          = 0,    ///< Offset only
+    AR_WAVE_SINE        = 1,    ///< Offset + Amplitude * sin
+    AR_WAVE_SQUARE      = 2,    ///< Offset +/- Amplitude, 50 % duty
+    AR_WAVE_NOISE       = 3,    ///< Offset + uniform noise within +/- Amplitude
+};
+
+/// @brief Waveform of one channel, in ADC codes and frames (one frame = one sample per channel)
+typedef struct ARScopeWave_s {
+    uint8_t     Kind;           ///< ARScopeWaveKind_e
+    uint16_t    Offset;         ///< Center code
+    uint16_t    Amplitude;      ///< Peak deviation from Offset
+    uint16_t    Noise;          ///< Peak uniform noise added on top of the wave
+    uint32_t    Step;           ///< Phase increment per frame (2^32 = one period)
+    uint32_t    Phase;          ///< Current phase
+} ARScopeWave_t;
+
+/// @brief Generator state
+typedef struct ARScopeSynth_s {
+    ARScopeWave_t   Wave[AR_SCOPE_CH_MAX];
+    uint32_t        ChannelMask;    ///< Channels converted, ascending order
+    uint32_t        NextCh;         ///< Channel of the next sample
+    uint64_t        Now;            ///< Samples produced
+    uint32_t        Seed;           ///< Random state (xorshift32, never 0)
+} ARScopeSynth_t;
+
+/// @brief Reset the generator: channels in `ChannelMask` at mid scale, time 0
+/// @param Synth Pointer to the generator
+/// @param ChannelMask Channels to produce (bit n: channel n < AR_SCOPE_CH_MAX)
+/// @param Seed Random seed (0 is replaced by a fixed constant)
+void                ARScopeSynthInit(ARScopeSynth_t * Synth, uint32_t ChannelMask, uint32_t Seed);
+
+/// @brief Set the waveform of one channel
+/// @param Synth Pointer to the generator
+/// @param Ch Channel
+/// @param Kind ARScopeWaveKind_e
+/// @param PeriodFrames Period in frames for sine/square (>= 2)
+/// @param Offset Center code
+/// @param Amplitude Peak deviation (clipped to the 12-bit range on output)
+/// @param Noise Peak uniform noise added to the wave
+void                ARScopeSynthSetWave(ARScopeSynth_t * Synth, uint32_t Ch, uint32_t Kind, uint32_t PeriodFrames,
+                                        uint32_t Offset, uint32_t Amplitude, uint32_t Noise);
+
+/// @brief Generate the next `Count` tagged samples
+void                ARScopeSynthFill(ARScopeSynth_t * Synth, ARSample_t * Out, uint32_t Count);
+
+/// @brief Produce whole blocks into a ring, like the ADC engine would
+void                ARScopeSynthFeed(ARScopeSynth_t * Synth, ARRing_t * Ring, uint32_t Blocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_SCOPE_SYNTH_H__
@@ -0,0 +1,139 @@
+/**
+ * @file ARScopeTrig.c
+ * @brief Analog trigger: edge crossing with hysteresis, holdoff and sub-sample position
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARScopeTrig.h"
+
+/// @brief Threshold that no 12-bit code reaches (disables the `>=` test of ARScopeFind())
+#define AR_STRIG_NEVER              0x7FFF
+
+/// @brief Lane high bit set where the code is below `lt` or at least `ge` (thresholds paired)
+/// @details A code has 12 bits: with the lane high bit forced on, subtracting a threshold
+///          <= 0x7FFF never borrows across lanes and leaves the high bit set iff code >= it.
+static inline uint32_t ARScopeLanes(uint32_t w, uint32_t lt, uint32_t ge){
+    w |= AR_LANE_HI;
+    return (~(w - lt) | (w - ge)) & AR_LANE_HI;
+}
+
+/// @brief Index of the first code below `LtT` or at least `GeT`, or `Count`
+static uint32_t ARScopeFind(const uint16_t * Codes, uint32_t Count, uint32_t LtT, uint32_t GeT){
+    uint32_t lt = ARLanePair(LtT);
+    uint32_t ge = ARLanePair(GeT);
+    uint32_t i = 0;
+
+    /// Eight codes per step; the step holding the hit is rescanned one code at a time
+    for(; i + 8 <= Count; i += 8){
+        uint32_t hit = ARScopeLanes(Codes[i]     | ((uint32_t) Codes[i + 1] << 16), lt, ge) |
+                       ARScopeLanes(Codes[i + 2] | ((uint32_t) Codes[i + 3] << 16), lt, ge) |
+                       ARScopeLanes(Codes[i + 4] | ((uint32_t) Codes[i + 5] << 16), lt, ge) |
+                       ARScopeLanes(Codes[i + 6] | ((uint32_t) Codes[i + 7] << 16), lt, ge);
+        if(hit){
+            break;
+        }
+    }
+    for(; i < Count; i++){
+        if((Codes[i] < LtT) || (Codes[i] >= GeT)){
+            return i;
+        }
+    }
+    return Count;
+}
+
+/// @brief Copy the codes of channel `Ch` out of tagged scope samples, in order
+uint32_t ARScopeExtract(const ARSample_t * Samples, uint32_t Count, uint32_t Ch, uint16_t * Out){
+    if((Samples == NULL) || (Out == NULL)){
+        return 0;
+    }
+    uint32_t n = 0;
+    for(uint32_t i = 0; i < Count; i++){
+        /// Unconditional store, conditional advance: no branch on the channel pattern
+        Out[n] = (uint16_t) ARScopeCode(Samples[i]);
+        n += (ARScopeCh(Samples[i]) == Ch);
+    }
+    return n;
+}
+
+/// @brief Reset the trigger, time 0
+void ARScopeTrigInit(ARScopeTrig_t * Trig, uint32_t Edge, uint32_t Level, uint32_t Hyst, uint32_t Holdoff){
+    if(Trig == NULL){
+        return;
+    }
+    memset(Trig, 0, sizeof(ARScopeTrig_t));
+    Trig->Edge    = Edge & AR_TRIG_EDGE_ANY;
+    Trig->Level   = (Level > AR_SCOPE_CODE_MAX) ? AR_SCOPE_CODE_MAX : Level;
+    Trig->Hyst    = (Hyst > AR_SCOPE_CODE_MAX) ? AR_SCOPE_CODE_MAX : Hyst;
+    Trig->Holdoff = Holdoff;
+    Trig->State   = AR_STRIG_WAIT;
+}
+
+/// @brief Scan consecutive codes of the trigger channel
+int32_t ARScopeTrigScan(ARScopeTrig_t * Trig, const uint16_t * Codes, uint32_t Count){
+    if((Trig == NULL) || (Codes == NULL) || (Count == 0) || (Trig->Edge == 0)){
+        return -1;
+    }
+
+    uint64_t base = Trig->Now;
+    int32_t level = (int32_t) Trig->Level;
+    /// Arming thresholds: below `armLo` arms a rising shot, at least `armHi` a falling one
+    uint32_t armLo = ((Trig->Edge & AR_TRIG_EDGE_RISING) && (level > (int32_t) Trig->Hyst)) ? (uint32_t) (level - Trig->Hyst) : 0;
+    uint32_t armHi = (Trig->Edge & AR_TRIG_EDGE_FALLING) ? (uint32_t) (level + Trig->Hyst + 1) : AR_STRIG_NEVER;
+    uint32_t i = 0;
+
+    while(i < Count){
+        uint32_t k;
+
+        switch(Trig->State){
+            case AR_STRIG_HOLDOFF:
+                if(base + Count <= Trig->HoldUntil){
+                    i = Count;
+                    continue;
+                }
+                if(Trig->HoldUntil > base + i){
+                    i = (uint32_t) (Trig->HoldUntil - base);
+                }
+                Trig->State = AR_STRIG_WAIT;
+                continue;
+
+            case AR_STRIG_WAIT:
+                k = i + ARScopeFind(&Codes[i], Count - i, armLo, armHi);
+                if(k < Count){
+                    Trig->State = (Codes[k] < armLo) ? AR_STRIG_ARMED_LOW : AR_STRIG_ARMED_HIGH;
+                }
+                i = k + 1;
+                continue;
+
+            case AR_STRIG_ARMED_LOW:
+                k = i + ARScopeFind(&Codes[i], Count - i, 0, (uint32_t) level);
+                break;
+
+            default:
+                k = i + ARScopeFind(&Codes[i], Count - i, (uint32_t) level + 1, AR_STRIG_NEVER);
+                break;
+        }
+        if(k >= Count){
+            break;
+        }
+
+        /// Shot: `prev` is on the armed side of Level, Codes[k] on the other side or at it
+        int32_t prev = (k > 0) ? Codes[k - 1] : (int32_t) Trig->Prev;
+        int32_t cur = Codes[k];
+        uint32_t frac = (Trig->State == AR_STRIG_ARMED_LOW) ?
+                        (uint32_t) (((level - prev) << AR_SCOPE_TRIG_FRAC_BITS) / (cur - prev)) :
+                        (uint32_t) (((prev - level) << AR_SCOPE_TRIG_FRAC_BITS) / (prev - cur));
+        Trig->TrigPos   = ((base + k - 1) << AR_SCOPE_TRIG_FRAC_BITS) + frac;
+        Trig->HoldUntil = base + k + 1 + Trig->Holdoff;
+        Trig->State     = AR_STRIG_HOLDOFF;
+        Trig->Shots++;
+        Trig->Prev      = (uint32_t) cur;
+        Trig->Now       = base + k + 1;
+        return (int32_t) k;
+    }
+
+    Trig->Prev = Codes[Count - 1];
+    Trig->Now  = base + Count;
+    return -1;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file ARScopeTrig.h
+ * @brief Analog trigger: edge crossing with hysteresis, holdoff and sub-sample position
+ * @details Runs on the codes of one channel (ARScopeExtract() pulls them out of tagged scope
+ *          blocks). A rising trigger arms once the signal drops below Level - Hyst and fires
+ *          on the first sample at or above Level; falling is the mirror image, any edge arms
+ *          on whichever side it reaches first. Noise smaller than the band cannot re-arm the
+ *          trigger, and after each shot no arming happens for Holdoff frames.
+ *          Every state waits for one threshold test, so the scan skips quiet spans with the
+ *          two-lane arithmetic of ARRing.h: two codes per 32-bit word, eight codes per loop,
+ *          no branch until a word holds the sample the state is waiting for.
+ *          The crossing is placed between the two samples around Level by linear
+ *          interpolation, in Q16 frames: sweeps started at that fractional position (see
+ *          ARTraceDrawWave()) keep the same phase from one refresh to the next.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_SCOPE_TRIG_H__
+#define __AR_SCOPE_TRIG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARScopeTrig.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARScopeSynth.h"
+#include "ARTrigger.h"
+
+/// @brief Fraction bits of a trigger position
+#define AR_SCOPE_TRIG_FRAC_BITS     16
+
+/// @brief Engine states
+enum ARScopeTrigState_e {
+    AR_STRIG_WAIT           = 0,    ///< Waiting for the signal to leave the hysteresis band
+    AR_STRIG_ARMED_LOW      = 1,    ///< Armed below the band, fires at or above Level
+    AR_STRIG_ARMED_HIGH     = 2,    ///< Armed above the band, fires at or below Level
+    AR_STRIG_HOLDOFF        = 3,    ///< Fired, ignoring the signal until HoldUntil
+};
+
+/// @brief Analog trigger
+typedef struct ARScopeTrig_s {
+    uint32_t    Edge;           ///< ARTrigEdge_e
+    uint32_t    Level;          ///< Crossing code
+    uint32_t    Hyst;           ///< Half width of the arming band, in codes
+    uint32_t    Holdoff;        ///< Frames after a shot during which the trigger cannot re-arm
+
+    /* Runtime */
+    uint32_t    State;          ///< ARScopeTrigState_e
+    uint32_t    Prev;           ///< Last code scanned (interpolation reference)
+    uint64_t    Now;            ///< Frames scanned
+    uint64_t    HoldUntil;      ///< First frame the trigger may arm again
+    uint64_t    TrigPos;        ///< Crossing of the last shot, Q16 frames
+    uint32_t    Shots;          ///< Shots fired since ARScopeTrigInit()
+} ARScopeTrig_t;
+
+/// @brief Whole frame of a Q16 position
+#define ARScopeTrigFrame(pos)       ((uint64_t) (pos) >> AR_SCOPE_TRIG_FRAC_BITS)
+
+/// @brief Copy the codes of channel `Ch` out of tagged scope samples, in order
+/// @param Samples Tagged samples (ARScopeSynth.h)
+/// @param Count Number of samples
+/// @param Ch Channel to keep
+/// @param Out Destination, room for `Count` codes
+/// @return Codes written
+uint32_t            ARScopeExtract(const ARSample_t * Samples, uint32_t Count, uint32_t Ch, uint16_t * Out);
+
+/// @brief Reset the trigger, time 0
+/// @param Trig Pointer to the trigger
+/// @param Edge ARTrigEdge_e
+/// @param Level Crossing code
+/// @param Hyst Half width of the arming band (0: arm on any sample on the other side of Level)
+/// @param Holdoff Frames without arming after each shot
+void                ARScopeTrigInit(ARScopeTrig_t * Trig, uint32_t Edge, uint32_t Level, uint32_t Hyst, uint32_t Holdoff);
+
+/// @brief Scan consecutive codes of the trigger channel
+/// @details Keeps its state across calls. Stops at the first shot: TrigPos is set and the
+///          caller scans the codes after the returned index with the next call.
+/// @param Trig Pointer to the trigger
+/// @param Codes Codes following the ones of the previous call
+/// @param Count Number of codes
+/// @return Index of the first code at or past the crossing, or -1
+int32_t             ARScopeTrigScan(ARScopeTrig_t * Trig, const uint16_t * Codes, uint32_t Count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_SCOPE_TRIG_H__
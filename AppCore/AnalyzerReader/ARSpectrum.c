@@ -0,0 +1,252 @@
+/**
+ * @file ARSpectrum.c
+ * @brief Spectrum analyzer: windowed fixed-point FFT of scope codes, averaging and peak hold
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+#include <math.h>
+
+#include "ARSpectrum.h"
+
+/// @brief log2(1 + i / 32), Q16
+static const uint16_t ARSpecLog2Q[33] = {
+        0,  2909,  5732,  8473, 11136, 13727, 16248, 18704,
+    21098, 23433, 25711, 27936, 30109, 32234, 34312, 36346,
+    38336, 40286, 42196, 44068, 45904, 47705, 49472, 51207,
+    52911, 54584, 56229, 57845, 59434, 60997, 62534, 64047,
+    65535,
+};
+
+/// @brief Window coefficients: w(n) = a0 - a1 cos(x) + a2 cos(2x) - a3 cos(3x) + a4 cos(4x)
+static const double ARSpecWinCoef[4][5] = {
+    [AR_WIN_RECT]     = { 1.0,        0.0,        0.0,         0.0,         0.0         },
+    [AR_WIN_HANN]     = { 0.5,        0.5,        0.0,         0.0,         0.0         },
+    [AR_WIN_BLACKMAN] = { 0.42,       0.5,        0.08,        0.0,         0.0         },
+    [AR_WIN_FLATTOP]  = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 },
+};
+
+/// @brief Twiddle W^k = cos(2 pi k / Points) - i sin(2 pi k / Points), Q30, k < 3 Points / 4
+static inline void ARSpecTwiddle(const int32_t * Sin, uint32_t Quarter, uint32_t k, int32_t * C, int32_t * S){
+    uint32_t r = k % Quarter;
+    switch(k / Quarter){
+        case 0:  *S =  Sin[r];           *C =  Sin[Quarter - r]; break;
+        case 1:  *S =  Sin[Quarter - r]; *C = -Sin[r];           break;
+        default: *S = -Sin[r];           *C = -Sin[Quarter - r]; break;
+    }
+}
+
+/// @brief (Re + i Im) * (C - i S), Q30 twiddle
+#define ARSpecMul(x, c, s, re, im)  do { \
+    int64_t _r = (int64_t) (x).Re * (c) + (int64_t) (x).Im * (s); \
+    int64_t _i = (int64_t) (x).Im * (c) - (int64_t) (x).Re * (s); \
+    (re) = (int32_t) ((_r + (1 << 29)) >> 30); \
+    (im) = (int32_t) ((_i + (1 << 29)) >> 30); \
+} while(0)
+
+/// @brief In-place complex FFT
+void ARFft(ARCplx_t * X, uint32_t Num, const int32_t * Sin, uint32_t Points){
+    if((X == NULL) || (Sin == NULL) || (Num < 2)){
+        return;
+    }
+    uint32_t quarter = Points / 4;
+    uint32_t log2n = 31 - __builtin_clz(Num);
+
+    /// Bit-reversed order
+    for(uint32_t i = 1, j = 0; i < Num; i++){
+        uint32_t bit = Num >> 1;
+        for(; j & bit; bit >>= 1){
+            j ^= bit;
+        }
+        j |= bit;
+        if(i < j){
+            ARCplx_t t = X[i];
+            X[i] = X[j];
+            X[j] = t;
+        }
+    }
+
+    uint32_t h = 1;
+    if(log2n & 1){
+        /// Odd stage count: one radix-2 pass with unit twiddles
+        for(uint32_t g = 0; g < Num; g += 2){
+            ARCplx_t a = X[g];
+            ARCplx_t b = X[g + 1];
+            X[g].Re     = a.Re + b.Re;
+            X[g].Im     = a.Im + b.Im;
+            X[g + 1].Re = a.Re - b.Re;
+            X[g + 1].Im = a.Im - b.Im;
+        }
+        h = 2;
+    }
+
+    /// Fused stages h and 2h: b turns by w^2, c by w, d by w^3 (w = W^j of the 4h transform)
+    for(; h < Num; h <<= 2){
+        uint32_t step = Points / (4 * h);
+        for(uint32_t j = 0; j < h; j++){
+            int32_t c1, s1, c2, s2, c3, s3;
+            ARSpecTwiddle(Sin, quarter, j * step, &c1, &s1);
+            ARSpecTwiddle(Sin, quarter, 2 * j * step, &c2, &s2);
+            ARSpecTwiddle(Sin, quarter, 3 * j * step, &c3, &s3);
+
+            for(uint32_t g = j; g < Num; g += 4 * h){
+                ARCplx_t a = X[g];
+                ARCplx_t b, c, d;
+                if(j == 0){
+                    b = X[g + h];
+                    c = X[g + 2 * h];
+                    d = X[g + 3 * h];
+                } else {
+                    ARSpecMul(X[g + h],     c2, s2, b.Re, b.Im);
+                    ARSpecMul(X[g + 2 * h], c1, s1, c.Re, c.Im);
+                    ARSpecMul(X[g + 3 * h], c3, s3, d.Re, d.Im);
+                }
+                int32_t aRe = a.Re + b.Re, aIm = a.Im + b.Im;
+                int32_t bRe = a.Re - b.Re, bIm = a.Im - b.Im;
+                int32_t cRe = c.Re + d.Re, cIm = c.Im + d.Im;
+                int32_t dRe = c.Re - d.Re, dIm = c.Im - d.Im;
+                X[g].Re         = aRe + cRe;
+                X[g].Im         = aIm + cIm;
+                X[g + 2 * h].Re = aRe - cRe;
+                X[g + 2 * h].Im = aIm - cIm;
+                X[g + h].Re     = bRe + dIm;
+                X[g + h].Im     = bIm - dRe;
+                X[g + 3 * h].Re = bRe - dIm;
+                X[g + 3 * h].Im = bIm + dRe;
+            }
+        }
+    }
+}
+
+/// @brief 10 log10(Power) in 1/256 dB
+int32_t ARSpectrumDb256(uint64_t Power){
+    if(Power == 0){
+        return AR_SPEC_DB_FLOOR * 256 / 10;
+    }
+    uint32_t e = 63 - __builtin_clzll(Power);
+    /// Mantissa in [1, 2) with 16 fraction bits
+    uint32_t m = (e >= 16) ? (uint32_t) (Power >> (e - 16)) : (uint32_t) (Power << (16 - e));
+    uint32_t i = (m >> 11) & 0x1F;
+    uint32_t f = m & 0x7FF;
+    int64_t log2q16 = ((int64_t) e << 16) + ARSpecLog2Q[i] + (((int32_t) (ARSpecLog2Q[i + 1] - ARSpecLog2Q[i]) * (int32_t) f) >> 11);
+    /// 10 log10(2) = 3.0103 dB per octave, 256 steps per dB: 770.637 per octave
+    return (int32_t) ((log2q16 * 50504453 + (1LL << 31)) >> 32);
+}
+
+/// @brief Memory ARSpectrumInit() needs for `Points` codes per spectrum
+uint32_t ARSpectrumBytes(uint32_t Points){
+    return (Points / 4 + 1) * sizeof(int32_t) +
+           (Points / 2) * sizeof(ARCplx_t) +
+           (Points / 2 + 1) * sizeof(int32_t) +
+           Points * sizeof(int16_t) +
+           (Points / 2 + 1) * sizeof(int16_t);
+}
+
+/// @brief Lay the analyzer out in `Mem` and build its tables
+DefaultRet_t ARSpectrumInit(ARSpectrum_t * Spec, void * Mem, uint32_t Bytes, uint32_t Points, uint32_t Window, uint32_t AvgShift){
+    if((Spec == NULL) || (Mem == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if((Points < AR_SPEC_POINTS_MIN) || (Points > AR_SPEC_POINTS_MAX) || (Points & (Points - 1))){
+        return STAT_ERR_INVALID_ARG;
+    }
+    if(Bytes < ARSpectrumBytes(Points)){
+        return STAT_ERR_INVALID_SIZE;
+    }
+    memset(Spec, 0, sizeof(ARSpectrum_t));
+    Spec->Points   = Points;
+    Spec->AvgShift = (AvgShift > 15) ? 15 : AvgShift;
+
+    /// Words first, halfwords after
+    uint8_t * p = (uint8_t *) Mem;
+    Spec->Sin  = (int32_t *) p;     p += (Points / 4 + 1) * sizeof(int32_t);
+    Spec->Work = (ARCplx_t *) p;    p += (Points / 2) * sizeof(ARCplx_t);
+    Spec->Avg  = (int32_t *) p;     p += (Points / 2 + 1) * sizeof(int32_t);
+    Spec->Win  = (int16_t *) p;     p += Points * sizeof(int16_t);
+    Spec->Peak = (int16_t *) p;
+
+    for(uint32_t k = 0; k <= Points / 4; k++){
+        Spec->Sin[k] = (int32_t) lround(sin(2.0 * M_PI * k / Points) * (double) (1 << 30));
+    }
+    ARSpectrumSetWindow(Spec, Window);
+    return STAT_OKE;
+}
+
+/// @brief Switch window (averages and peaks restart)
+void ARSpectrumSetWindow(ARSpectrum_t * Spec, uint32_t Window){
+    if((Spec == NULL) || (Spec->Win == NULL)){
+        return;
+    }
+    Spec->Window = (Window <= AR_WIN_FLATTOP) ? Window : AR_WIN_HANN;
+    const double * a = ARSpecWinCoef[Spec->Window];
+    uint32_t n = Spec->Points;
+
+    /// Periodic window; its mean is the coherent gain taken out of the dBFS reference
+    int64_t sum = 0;
+    for(uint32_t i = 0; i < n; i++){
+        double x = 2.0 * M_PI * i / n;
+        double w = a[0] - a[1] * cos(x) + a[2] * cos(2 * x) - a[3] * cos(3 * x) + a[4] * cos(4 * x);
+        int32_t q = (int32_t) lround(w * 32767.0);     /// Flat top dips slightly below 0
+        Spec->Win[i] = (int16_t) q;
+        sum += Spec->Win[i];
+    }
+    /// Full-scale sine: amplitude 2^15 (codes << 4), bin |X| = 2^15 * n/2 * gain, doubled by the split
+    double amp = 32768.0 * (double) sum / 32767.0;
+    Spec->RefDb = ARSpectrumDb256((uint64_t) (amp * amp));
+    ARSpectrumReset(Spec);
+}
+
+/// @brief Restart averaging and peak hold
+void ARSpectrumReset(ARSpectrum_t * Spec){
+    if(Spec == NULL){
+        return;
+    }
+    Spec->Frames = 0;
+}
+
+/// @brief Compute one spectrum and fold it into the averages and peaks
+DefaultRet_t ARSpectrumRun(ARSpectrum_t * Spec, const uint16_t * Codes){
+    if((Spec == NULL) || (Codes == NULL) || (Spec->Work == NULL)){
+        return STAT_ERR_NULL;
+    }
+    uint32_t half = Spec->Points / 2;
+    ARCplx_t * z = Spec->Work;
+    const int16_t * win = Spec->Win;
+
+    /// Centered, 16-bit, windowed; even codes real, odd codes imaginary
+    for(uint32_t n = 0; n < half; n++){
+        int32_t e = ((int32_t) Codes[2 * n]     - (AR_SCOPE_CODE_MAX + 1) / 2) << 4;
+        int32_t o = ((int32_t) Codes[2 * n + 1] - (AR_SCOPE_CODE_MAX + 1) / 2) << 4;
+        z[n].Re = (e * win[2 * n]     + (1 << 14)) >> 15;
+        z[n].Im = (o * win[2 * n + 1] + (1 << 14)) >> 15;
+    }
+    ARFft(z, half, Spec->Sin, Spec->Points);
+
+    /// Split: 2 X[k] = (Z[k] + Z*[M-k]) - i W^k (Z[k] - Z*[M-k]), M = Points / 2
+    uint32_t quarter = Spec->Points / 4;
+    uint32_t first = (Spec->Frames == 0);
+    for(uint32_t k = 0; k <= half; k++){
+        const ARCplx_t * zk = &z[(k == half) ? 0 : k];
+        const ARCplx_t * zm = &z[(k == 0) ? 0 : half - k];
+        int64_t feRe = (int64_t) zk->Re + zm->Re;
+        int64_t feIm = (int64_t) zk->Im - zm->Im;
+        ARCplx_t fo = { .Re = zk->Im + zm->Im, .Im = zm->Re - zk->Re };
+        int32_t c, s, tRe, tIm;
+        ARSpecTwiddle(Spec->Sin, quarter, k, &c, &s);
+        ARSpecMul(fo, c, s, tRe, tIm);
+        int64_t xRe = feRe + tRe;
+        int64_t xIm = feIm + tIm;
+
+        int32_t db = (ARSpectrumDb256((uint64_t) (xRe * xRe) + (uint64_t) (xIm * xIm)) - Spec->RefDb) * 10 / 256;
+        db = (db < AR_SPEC_DB_FLOOR) ? AR_SPEC_DB_FLOOR : db;
+        if(first){
+            Spec->Avg[k]  = db << AR_SPEC_AVG_FRAC;
+            Spec->Peak[k] = (int16_t) db;
+        } else {
+            Spec->Avg[k] += ((db << AR_SPEC_AVG_FRAC) - Spec->Avg[k]) / (1 << Spec->AvgShift);
+            Spec->Peak[k] = (db > Spec->Peak[k]) ? (int16_t) db : Spec->Peak[k];
+        }
+    }
+    Spec->Frames++;
+    return STAT_OKE;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file ARSpectrum.h
+ * @brief Spectrum analyzer: windowed fixed-point FFT of scope codes, averaging and peak hold
+ * @details One spectrum takes `Points` codes of one channel (ARScopeExtract()). They are
+ *          centered on mid scale, windowed (Q15) and packed two by two as N/2 complex
+ *          points: the even code is the real part, the odd one the imaginary part. A complex
+ *          FFT of N/2 points (int32 data, Q30 twiddles, decimation in time: one radix-2 pass
+ *          when needed, then fused radix-4 passes with three complex multiplies per four
+ *          points) and a split pass give the N/2 + 1 bins of the real input. No pass scales:
+ *          with codes scaled to 16 bits the data grows to at most 2^28.
+ *          Bin power is turned into 0.1 dB steps relative to a full-scale sine (dBFS, the
+ *          window gain removed) with an integer log2, then averaged exponentially in dB (video
+ *          averaging, 1/2^AvgShift per spectrum) and held at its maximum.
+ *          Hardware independent; the sine and window tables are computed once by
+ *          ARSpectrumInit() with <math.h>.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_SPECTRUM_H__
+#define __AR_SPECTRUM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARSpectrum.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARScopeSynth.h"
+
+/// @brief Fewest points per spectrum
+#define AR_SPEC_POINTS_MIN          16
+/// @brief Most points per spectrum
+#define AR_SPEC_POINTS_MAX          4096
+/// @brief Level reported for an empty bin (0.1 dBFS)
+#define AR_SPEC_DB_FLOOR            (-2000)
+/// @brief Fraction bits kept by the averages
+#define AR_SPEC_AVG_FRAC            8
+
+/// @brief Windows
+enum ARSpecWindow_e {
+    AR_WIN_RECT             = 0,    ///< No window (narrowest peak, worst leakage)
+    AR_WIN_HANN             = 1,    ///< Hann: general purpose
+    AR_WIN_BLACKMAN         = 2,    ///< Blackman: lower leakage, wider peak
+    AR_WIN_FLATTOP          = 3,    ///< Flat top: amplitude exact within 0.01 dB between bins
+};
+
+/// @brief Complex point
+typedef struct ARCplx_s {
+    int32_t     Re;
+    int32_t     Im;
+} ARCplx_t;
+
+/// @brief Spectrum analyzer (tables and results live in the memory given to ARSpectrumInit())
+typedef struct ARSpectrum_s {
+    uint32_t    Points;         ///< Codes per spectrum (power of 2)
+    uint32_t    Window;         ///< ARSpecWindow_e
+    uint32_t    AvgShift;       ///< Averaging weight 1/2^AvgShift (0: no averaging)
+    int32_t *   Sin;            ///< sin(2 pi k / Points), Q30, k = 0 .. Points / 4
+    ARCplx_t *  Work;           ///< FFT buffer, Points / 2 points
+    int32_t *   Avg;            ///< Averaged level per bin (0.1 dBFS << AR_SPEC_AVG_FRAC), Points / 2 + 1 bins
+    int16_t *   Win;            ///< Window, Q15, Points entries
+    int16_t *   Peak;           ///< Held maximum per bin (0.1 dBFS)
+    int32_t     RefDb;          ///< Level of a full-scale sine before the dBFS offset (1/256 dB)
+    uint32_t    Frames;         ///< Spectra since the last ARSpectrumReset()
+} ARSpectrum_t;
+
+/// @brief Bins of a spectrum (0 .. Points / 2)
+#define ARSpectrumBins(spec)        ((spec)->Points / 2 + 1)
+/// @brief Averaged level of bin `k` (0.1 dBFS)
+#define ARSpectrumAvg(spec, k)      ((spec)->Avg[k] >> AR_SPEC_AVG_FRAC)
+/// @brief Center frequency of bin `k` for a channel sampled at `rate` frames per second
+#define ARSpectrumBinHz(spec, k, rate)  ((uint32_t) (((uint64_t) (k) * (rate)) / (spec)->Points))
+
+/// @brief Memory ARSpectrumInit() needs for `Points` codes per spectrum
+/// @param Points Codes per spectrum (power of 2)
+/// @return Bytes
+uint32_t            ARSpectrumBytes(uint32_t Points);
+
+/// @brief Lay the analyzer out in `Mem` and build its tables
+/// @param Spec Pointer to the analyzer
+/// @param Mem Memory of ARSpectrumBytes(Points) bytes, 4-byte aligned
+/// @param Bytes Size of `Mem`
+/// @param Points Codes per spectrum (power of 2, AR_SPEC_POINTS_MIN .. AR_SPEC_POINTS_MAX)
+/// @param Window ARSpecWindow_e
+/// @param AvgShift Averaging weight 1/2^AvgShift (0: no averaging)
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARSpectrumInit(ARSpectrum_t * Spec, void * Mem, uint32_t Bytes, uint32_t Points, uint32_t Window, uint32_t AvgShift);
+
+/// @brief Switch window (averages and peaks restart)
+void                ARSpectrumSetWindow(ARSpectrum_t * Spec, uint32_t Window);
+
+/// @brief Restart averaging and peak hold
+void                ARSpectrumReset(ARSpectrum_t * Spec);
+
+/// @brief Compute one spectrum and fold it into the averages and peaks
+/// @param Spec Pointer to the analyzer
+/// @param Codes `Points` codes of one channel
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARSpectrumRun(ARSpectrum_t * Spec, const uint16_t * Codes);
+
+/// @brief In-place complex FFT (bit-reversed input order is produced internally)
+/// @details Unscaled: outputs grow by up to `Num` times the largest input.
+/// @param X Points, natural order in and out
+/// @param Num Number of points (power of 2, at most Points / 2 of the table owner)
+/// @param Sin Quarter sine table of an analyzer with `Points` codes
+/// @param Points Table size the quarter wave belongs to (Num divides Points / 2)
+void                ARFft(ARCplx_t * X, uint32_t Num, const int32_t * Sin, uint32_t Points);
+
+/// @brief 10 log10(Power) in 1/256 dB (AR_SPEC_DB_FLOOR scaled for 0)
+int32_t             ARSpectrumDb256(uint64_t Power);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_SPECTRUM_H__
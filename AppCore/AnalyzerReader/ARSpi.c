@@ -0,0 +1,267 @@
+/**
+ * @file ARSpi.c
+ * @brief Streaming SPI decoder working on packed capture samples
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARSpi.h"
+
+/// @brief Level of channel `ch` in sample `s` (0 for AR_SPI_CH_NONE)
+#define ARSpiBit(s, ch)             (((ch) < 0) ? 0U : (((uint32_t) (s) >> (ch)) & 1U))
+/// @brief Sample mask of channel `ch` (0 for AR_SPI_CH_NONE)
+#define ARSpiMask(ch)               (((ch) < 0) ? 0U : (1U << (ch)))
+
+/// @brief Hand an event to the sink
+static void ARSpiEmit(ARSpi_t * Dec, uint32_t Kind, uint32_t Bits, uint64_t Sample){
+    if(Dec->OnEvent == NULL){
+        return;
+    }
+    ARSpiEvent_t ev = {
+        .Kind   = Kind,
+        .Bits   = Bits,
+        .Mosi   = Dec->Mosi,
+        .Miso   = Dec->Miso,
+        .Sample = Sample,
+    };
+    Dec->OnEvent(Dec->Arg, &ev);
+}
+
+/// @brief CS level of sample `s` means "selected"
+static inline uint32_t ARSpiSelected(const ARSpi_t * Dec, ARSample_t s){
+    if(Dec->Cfg.ChCs < 0){
+        return 1;
+    }
+    return ARSpiBit(s, Dec->Cfg.ChCs) ^ (Dec->Cfg.CsActiveLow ? 1U : 0U);
+}
+
+/// @brief Bus state machine for one sample where SCLK and/or CS changed
+/// @return Number of events emitted
+static uint32_t ARSpiStep(ARSpi_t * Dec, ARSample_t Prev, ARSample_t Cur, uint64_t Now){
+    const ARSpiConfig_t * cfg = &(Dec->Cfg);
+    uint32_t events = 0;
+
+    uint32_t sel = ARSpiSelected(Dec, Cur);
+    if(sel != Dec->Active){
+        if( !sel ){
+            /// Word cut short by CS: hand out what was assembled
+            if(Dec->BitCnt > 0){
+                ARSpiEmit(Dec, AR_SPI_EV_WORD, Dec->BitCnt, Dec->WordStart);
+                events++;
+            }
+            ARSpiEmit(Dec, AR_SPI_EV_DESELECT, 0, Now);
+            events++;
+        } else {
+            Dec->Frames++;
+            ARSpiEmit(Dec, AR_SPI_EV_SELECT, 0, Now);
+            events++;
+        }
+        Dec->Active = sel;
+        Dec->BitCnt = 0;
+        Dec->Mosi   = 0;
+        Dec->Miso   = 0;
+    }
+
+    if( !Dec->Active || !((Prev ^ Cur) & ARSpiMask(cfg->ChSclk)) ){
+        return events;
+    }
+    /// Sampling edge: rising for modes 0 and 3, falling for modes 1 and 2
+    uint32_t rising = ARSpiBit(Cur, cfg->ChSclk);
+    if(rising != ((cfg->Cpol == cfg->Cpha) ? 1U : 0U)){
+        return events;
+    }
+
+    uint32_t mosi = ARSpiBit(Cur, cfg->ChMosi);
+    uint32_t miso = ARSpiBit(Cur, cfg->ChMiso);
+    if(Dec->BitCnt == 0){
+        Dec->WordStart = Now;
+    }
+    if(cfg->MsbFirst){
+        Dec->Mosi = (Dec->Mosi << 1) | mosi;
+        Dec->Miso = (Dec->Miso << 1) | miso;
+    } else {
+        Dec->Mosi |= mosi << Dec->BitCnt;
+        Dec->Miso |= miso << Dec->BitCnt;
+    }
+    Dec->BitCnt++;
+
+    if(Dec->BitCnt >= cfg->WordBits){
+        Dec->Words++;
+        ARSpiEmit(Dec, AR_SPI_EV_WORD, Dec->BitCnt, Dec->WordStart);
+        events++;
+        Dec->BitCnt = 0;
+        Dec->Mosi   = 0;
+        Dec->Miso   = 0;
+    }
+    return events;
+}
+
+/// @brief Mode 0, MSB first, 8-bit words on channels 0 (SCLK), 1 (MOSI), 2 (MISO), 3 (CS, low)
+void ARSpiDefaultConfig(ARSpiConfig_t * Cfg){
+    if(Cfg == NULL){
+        return;
+    }
+    Cfg->ChSclk      = 0;
+    Cfg->ChMosi      = 1;
+    Cfg->ChMiso      = 2;
+    Cfg->ChCs        = 3;
+    Cfg->CsActiveLow = 1;
+    Cfg->Cpol        = 0;
+    Cfg->Cpha        = 0;
+    Cfg->MsbFirst    = 1;
+    Cfg->WordBits    = 8;
+}
+
+/// @brief Set up a decoder
+DefaultRet_t ARSpiInit(ARSpi_t * Dec, const ARSpiConfig_t * Cfg, ARSpiEventCb_t OnEvent, void * Arg){
+    if((Dec == NULL) || (Cfg == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if((Cfg->ChSclk < 0) || (Cfg->ChSclk >= AR_CHANNEL_NUM) ||
+       (Cfg->ChMosi >= AR_CHANNEL_NUM) || (Cfg->ChMiso >= AR_CHANNEL_NUM) || (Cfg->ChCs >= AR_CHANNEL_NUM) ||
+       (Cfg->WordBits == 0) || (Cfg->WordBits > AR_SPI_WORD_BITS_MAX)){
+        return STAT_ERR_INVALID_ARG;
+    }
+
+    memset(Dec, 0, sizeof(ARSpi_t));
+    Dec->Cfg       = *Cfg;
+    Dec->OnEvent   = OnEvent;
+    Dec->Arg       = Arg;
+    Dec->WatchMask = (ARSample_t) (ARSpiMask(Cfg->ChSclk) | ARSpiMask(Cfg->ChCs));
+    ARSpiReset(Dec);
+    return STAT_OKE;
+}
+
+/// @brief Forget the bus state and restart the sample clock at 0
+void ARSpiReset(ARSpi_t * Dec){
+    if(Dec == NULL){
+        return;
+    }
+    Dec->HasPrev = 0;
+    Dec->Active  = 0;
+    Dec->BitCnt  = 0;
+    Dec->Mosi    = 0;
+    Dec->Miso    = 0;
+    Dec->Now     = 0;
+    Dec->Words   = 0;
+    Dec->Frames  = 0;
+}
+
+/// @brief Decode the next `Count` samples of the capture
+uint32_t ARSpiDecode(ARSpi_t * Dec, const ARSample_t * Samples, uint32_t Count){
+    if((Dec == NULL) || (Samples == NULL) || (Count == 0)){
+        return 0;
+    }
+    /// A capture starting mid-frame is decoded from its first clock edge on
+    if( !Dec->HasPrev ){
+        Dec->Prev    = Samples[0];
+        Dec->Active  = ARSpiSelected(Dec, Samples[0]);
+        Dec->HasPrev = 1;
+    }
+
+    uint32_t watch = ARLanePair(Dec->WatchMask);
+    uint32_t prev = Dec->Prev;
+    uint32_t events = 0;
+    uint32_t i = 0;
+
+    while(i < Count){
+        /// Skip pairs where neither SCLK nor CS moves
+        if(i + 1 < Count){
+            uint32_t a = Samples[i];
+            uint32_t x = a | ((uint32_t) Samples[i + 1] << 16);
+            if( !ARLaneNonZero((x ^ (prev | (a << 16))) & watch) ){
+                prev = Samples[i + 1];
+                i += 2;
+                continue;
+            }
+        }
+        if((Samples[i] ^ prev) & Dec->WatchMask){
+            events += ARSpiStep(Dec, (ARSample_t) prev, Samples[i], Dec->Now + i);
+        }
+        prev = Samples[i];
+        i++;
+    }
+
+    Dec->Prev = (ARSample_t) prev;
+    Dec->Now += Count;
+    return events;
+}
+
+/// @brief Decode a transition-encoded trace from the reader position up to sample `End`
+uint32_t ARSpiDecodeRle(ARSpi_t * Dec, ARRleReader_t * Rd, uint64_t End){
+    if((Dec == NULL) || (Rd == NULL)){
+        return 0;
+    }
+    if(End > Rd->End){
+        End = Rd->End;
+    }
+    if( !Dec->HasPrev ){
+        Dec->Prev    = Rd->State;
+        Dec->Active  = ARSpiSelected(Dec, Rd->State);
+        Dec->HasPrev = 1;
+    }
+
+    uint32_t events = 0;
+    while(Rd->HasNext && (Rd->NextAt < End)){
+        ARRleReaderNext(Rd);
+        if((Rd->State ^ Dec->Prev) & Dec->WatchMask){
+            events += ARSpiStep(Dec, Dec->Prev, Rd->State, Rd->At);
+        }
+        Dec->Prev = Rd->State;
+    }
+
+    if(End > Dec->Now){
+        Dec->Now = End;
+    }
+    return events;
+}
+
+/// @brief Render SPI frames as a capture, the way ARSpiDecode() expects them
+int32_t ARSpiSynth(const ARSpiConfig_t * Cfg, ARSample_t * Out, uint32_t Cap, const uint32_t * Words, uint32_t Num, uint32_t HalfPeriod){
+    if((Cfg == NULL) || (Out == NULL) || ((Words == NULL) && (Num > 0))){
+        return STAT_ERR_NULL;
+    }
+    if((HalfPeriod == 0) || (Cfg->WordBits == 0) || (Cfg->WordBits > AR_SPI_WORD_BITS_MAX) || (Cfg->ChSclk < 0)){
+        return STAT_ERR_INVALID_ARG;
+    }
+    /// Idle, select, bits, trailing half period, deselect, idle
+    uint64_t need = (uint64_t) HalfPeriod * (2 + 2ULL * Cfg->WordBits * Num + 1 + 2);
+    if(need > Cap){
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    uint32_t sclk = ARSpiMask(Cfg->ChSclk);
+    uint32_t cs   = ARSpiMask(Cfg->ChCs);
+    uint32_t idle = Cfg->Cpol ? sclk : 0;
+    uint32_t csOff = Cfg->CsActiveLow ? cs : 0;
+    uint32_t csOn  = Cfg->CsActiveLow ? 0 : cs;
+    uint32_t n = 0;
+
+    for(uint32_t k = 0; k < 2 * HalfPeriod; k++){
+        Out[n++] = (ARSample_t) (idle | csOff);
+    }
+    for(uint32_t w = 0; w < Num; w++){
+        for(uint32_t b = 0; b < Cfg->WordBits; b++){
+            uint32_t bit  = Cfg->MsbFirst ? (Cfg->WordBits - 1 - b) : b;
+            uint32_t mosi = (Words[w] >> bit) & 1U;
+            uint32_t data = (mosi ? ARSpiMask(Cfg->ChMosi) : 0) | (mosi ? 0 : ARSpiMask(Cfg->ChMiso));
+            /// CPHA 0: data settles while the clock idles; CPHA 1: it changes on the leading edge
+            uint32_t first  = Cfg->Cpha ? (idle ^ sclk) : idle;
+            uint32_t second = first ^ sclk;
+            for(uint32_t k = 0; k < HalfPeriod; k++){
+                Out[n++] = (ARSample_t) (first | data | csOn);
+            }
+            for(uint32_t k = 0; k < HalfPeriod; k++){
+                Out[n++] = (ARSample_t) (second | data | csOn);
+            }
+        }
+    }
+    for(uint32_t k = 0; k < HalfPeriod; k++){
+        Out[n++] = (ARSample_t) (idle | csOn);
+    }
+    for(uint32_t k = 0; k < 2 * HalfPeriod; k++){
+        Out[n++] = (ARSample_t) (idle | csOff);
+    }
+    return (int32_t) n;
+}
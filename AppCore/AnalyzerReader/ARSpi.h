@@ -0,0 +1,129 @@
+/**
+ * @file ARSpi.h
+ * @brief Streaming SPI decoder working on packed capture samples
+ * @details Samples are consumed as they come out of the ring, never unpacked per channel.
+ *          Two samples are compared per 32-bit word against the SCLK/CS mask, so stretches
+ *          without a clock or select edge are skipped a pair at a time; only edges go
+ *          through the bit-level state machine. State survives across calls, so a capture
+ *          of any size is decoded in one pass with a fixed-size decoder and events are
+ *          delivered through a callback as soon as they complete.
+ *          Hardware independent: ARSpiSynth() produces captures to decode on a host.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_SPI_H__
+#define __AR_SPI_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARSpi.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+#include "ARRle.h"
+
+/// @brief Channel index meaning "not connected"
+#define AR_SPI_CH_NONE              (-1)
+/// @brief Longest word the decoder assembles
+#define AR_SPI_WORD_BITS_MAX        32
+
+/// @brief Decoded event kinds
+enum ARSpiEventKind_e {
+    AR_SPI_EV_SELECT        = 0,    ///< CS went active
+    AR_SPI_EV_WORD          = 1,    ///< A word completed (or was cut short by CS, see Bits)
+    AR_SPI_EV_DESELECT      = 2,    ///< CS went inactive
+};
+
+/// @brief Decoder configuration
+typedef struct ARSpiConfig_s {
+    int32_t     ChSclk;     ///< Clock channel
+    int32_t     ChMosi;     ///< Master-out channel (AR_SPI_CH_NONE: not decoded)
+    int32_t     ChMiso;     ///< Master-in channel (AR_SPI_CH_NONE: not decoded)
+    int32_t     ChCs;       ///< Select channel (AR_SPI_CH_NONE: always selected)
+    uint32_t    CsActiveLow;///< 1: CS is active low
+    uint32_t    Cpol;       ///< Clock idle level
+    uint32_t    Cpha;       ///< 0: sample on the first clock edge, 1: on the second
+    uint32_t    MsbFirst;   ///< 1: MSB first
+    uint32_t    WordBits;   ///< Bits per word (1..32)
+} ARSpiConfig_t;
+
+/// @brief One decoded event
+typedef struct ARSpiEvent_s {
+    uint32_t    Kind;       ///< ARSpiEventKind_e
+    uint32_t    Bits;       ///< Bits in the word (< WordBits when CS cut it short)
+    uint32_t    Mosi;       ///< MOSI word
+    uint32_t    Miso;       ///< MISO word
+    uint64_t    Sample;     ///< Sample of the event (first bit for a word)
+} ARSpiEvent_t;
+
+/// @brief Event sink, called from ARSpiDecode()
+typedef void (*ARSpiEventCb_t)(void * Arg, const ARSpiEvent_t * Ev);
+
+/// @brief Decoder state
+typedef struct ARSpi_s {
+    ARSpiConfig_t   Cfg;
+    ARSpiEventCb_t  OnEvent;
+    void *          Arg;
+    ARSample_t      WatchMask;  ///< SCLK | CS
+    ARSample_t      Prev;       ///< Last sample seen
+    uint32_t        HasPrev;    ///< 0 until the first sample
+    uint32_t        Active;     ///< Slave selected
+    uint32_t        BitCnt;     ///< Bits assembled in the current word
+    uint32_t        Mosi;
+    uint32_t        Miso;
+    uint64_t        WordStart;  ///< Sample of the first bit of the current word
+    uint64_t        Now;        ///< Samples consumed since ARSpiReset() (= time of the next one)
+    uint32_t        Words;      ///< Complete words decoded
+    uint32_t        Frames;     ///< Selects seen
+} ARSpi_t;
+
+/// @brief Mode 0, MSB first, 8-bit words on channels 0 (SCLK), 1 (MOSI), 2 (MISO), 3 (CS, low)
+void                ARSpiDefaultConfig(ARSpiConfig_t * Cfg);
+
+/// @brief Set up a decoder
+/// @param Dec Pointer to the decoder
+/// @param Cfg Configuration (copied)
+/// @param OnEvent Event sink (may be NULL to only count)
+/// @param Arg Passed to `OnEvent`
+/// @return STAT_OKE or STAT_ERR_INVALID_ARG
+DefaultRet_t        ARSpiInit(ARSpi_t * Dec, const ARSpiConfig_t * Cfg, ARSpiEventCb_t OnEvent, void * Arg);
+
+/// @brief Forget the bus state and restart the sample clock at 0
+void                ARSpiReset(ARSpi_t * Dec);
+
+/// @brief Decode the next `Count` samples of the capture
+/// @param Dec Pointer to the decoder
+/// @param Samples Samples following the ones of the previous call
+/// @param Count Number of samples
+/// @return Number of events emitted
+uint32_t            ARSpiDecode(ARSpi_t * Dec, const ARSample_t * Samples, uint32_t Count);
+
+/// @brief Decode a transition-encoded trace from the reader position up to sample `End`
+/// @details Only transitions are visited, so idle time costs nothing. Channels of the bus
+///          must be among the ones the trace records. Sample numbers are trace samples.
+/// @param Dec Pointer to the decoder
+/// @param Rd Reader, left on the last transition before `End`
+/// @param End First sample not decoded (clipped to the trace length)
+/// @return Number of events emitted
+uint32_t            ARSpiDecodeRle(ARSpi_t * Dec, ARRleReader_t * Rd, uint64_t End);
+
+/// @brief Render SPI frames as a capture, the way ARSpiDecode() expects them
+/// @details One frame (CS active) carrying `Num` words; MISO carries the MOSI word inverted.
+///          Channels outside the bus stay low.
+/// @param Cfg Bus configuration
+/// @param Out Destination samples
+/// @param Cap Capacity of `Out`
+/// @param Words Words to send
+/// @param Num Number of words
+/// @param HalfPeriod Samples per clock half period (>= 1)
+/// @return Samples written, or a negative DefaultRet_e if `Cap` is too small
+int32_t             ARSpiSynth(const ARSpiConfig_t * Cfg, ARSample_t * Out, uint32_t Cap, const uint32_t * Words, uint32_t Num, uint32_t HalfPeriod);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_SPI_H__
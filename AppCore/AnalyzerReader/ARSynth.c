@@ -0,0 +1,108 @@
+/**
+ * @file ARSynth.c
+ * @brief Synthetic sample source standing in for the capture engine
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARSynth.h"
+
+/// @brief Next xorshift32 value
+static uint32_t ARSynthRand(ARSynth_t * Synth){
+    uint32_t x = Synth->Seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    Synth->Seed = x;
+    return x;
+}
+
+/// @brief Reset the generator: every channel low, time 0
+void ARSynthInit(ARSynth_t * Synth, uint32_t Seed){
+    if(Synth == NULL){
+        return;
+    }
+    memset(Synth, 0, sizeof(ARSynth_t));
+    Synth->Seed = (Seed != 0) ? Seed : 0x2545F491UL;
+}
+
+/// @brief Hold a channel at a fixed level
+void ARSynthSetLevel(ARSynth_t * Synth, uint32_t Ch, uint32_t Level){
+    if((Synth == NULL) || (Ch >= AR_CHANNEL_NUM)){
+        return;
+    }
+    Synth->Chan[Ch].Kind = Level ? AR_SYNTH_HIGH : AR_SYNTH_LOW;
+}
+
+/// @brief Drive a channel with a square wave
+void ARSynthSetClock(ARSynth_t * Synth, uint32_t Ch, uint32_t Period, uint32_t High, uint32_t Phase){
+    if((Synth == NULL) || (Ch >= AR_CHANNEL_NUM) || (Period < 2)){
+        return;
+    }
+    Synth->Chan[Ch].Kind   = AR_SYNTH_CLOCK;
+    Synth->Chan[Ch].Period = Period;
+    Synth->Chan[Ch].High   = High;
+    Synth->Chan[Ch].Phase  = Phase % Period;
+}
+
+/// @brief Let a channel toggle at random
+void ARSynthSetRandom(ARSynth_t * Synth, uint32_t Ch, uint32_t MeanRun){
+    if((Synth == NULL) || (Ch >= AR_CHANNEL_NUM)){
+        return;
+    }
+    Synth->Chan[Ch].Kind   = AR_SYNTH_RANDOM;
+    Synth->Chan[Ch].Period = (MeanRun > 0) ? MeanRun : 1;
+}
+
+/// @brief Generate the next `Count` samples
+void ARSynthFill(ARSynth_t * Synth, ARSample_t * Out, uint32_t Count){
+    if((Synth == NULL) || (Out == NULL)){
+        return;
+    }
+
+    for(uint32_t i = 0; i < Count; i++){
+        uint64_t t = Synth->Now + i;
+        ARSample_t level = Synth->Level;
+
+        for(uint32_t ch = 0; ch < AR_CHANNEL_NUM; ch++){
+            const ARSynthChan_t * c = &(Synth->Chan[ch]);
+            ARSample_t bit = (ARSample_t)(1U << ch);
+            switch(c->Kind){
+                case AR_SYNTH_HIGH:
+                    level |= bit;
+                    break;
+                case AR_SYNTH_CLOCK:
+                    if(((t + c->Period - c->Phase) % c->Period) < c->High){
+                        level |= bit;
+                    } else {
+                        level &= (ARSample_t) ~bit;
+                    }
+                    break;
+                case AR_SYNTH_RANDOM:
+                    if((ARSynthRand(Synth) % c->Period) == 0){
+                        level ^= bit;
+                    }
+                    break;
+                default:
+                    level &= (ARSample_t) ~bit;
+                    break;
+            }
+        }
+
+        Out[i] = level;
+        Synth->Level = level;
+    }
+    Synth->Now += Count;
+}
+
+/// @brief Produce whole blocks into a ring, like the capture engine would
+void ARSynthFeed(ARSynth_t * Synth, ARRing_t * Ring, uint32_t Blocks){
+    if((Synth == NULL) || (Ring == NULL)){
+        return;
+    }
+    for(uint32_t b = 0; b < Blocks; b++){
+        ARSynthFill(Synth, ARRingProducerBlock(Ring), Ring->BlockSamples);
+        ARRingCommit(Ring);
+    }
+}
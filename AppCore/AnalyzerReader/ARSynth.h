@@ -0,0 +1,89 @@
+/**
+ * @file ARSynth.h
+ * @brief Synthetic sample source standing in for the capture engine
+ * @details Generates per-channel waveforms (fixed level, clock, random toggling) and
+ *          commits them to an ARRing_t exactly like the GDMA callback does, so triggers,
+ *          decoders and renderers can be exercised on a Linux host or without wiring.
+ *          Hardware independent.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_SYNTH_H__
+#define __AR_SYNTH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARSynth.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+
+/// @brief Waveform kinds
+enum ARSynthKind_e {
+    AR_SYNTH_LOW        = 0,    ///< Constant 0
+    AR_SYNTH_HIGH       = 1,    ///< Constant 1
+    AR_SYNTH_CLOCK      = 2,    ///< Square wave: `High` samples high out of every `Period`
+    AR_SYNTH_RANDOM     = 3,    ///< Toggles at random, on average every `Period` samples
+};
+
+/// @brief Waveform of one channel
+typedef struct ARSynthChan_s {
+    uint8_t     Kind;       ///< ARSynthKind_e
+    uint32_t    Period;     ///< Clock period / mean run length (samples)
+    uint32_t    High;       ///< Clock: samples spent high per period
+    uint32_t    Phase;      ///< Clock: samples by which the wave is delayed
+} ARSynthChan_t;
+
+/// @brief Generator state
+typedef struct ARSynth_s {
+    ARSynthChan_t   Chan[AR_CHANNEL_NUM];   ///< Per-channel waveform
+    uint64_t        Now;                    ///< Index of the next sample
+    uint32_t        Seed;                   ///< Random state (xorshift32, never 0)
+    ARSample_t      Level;                  ///< Last sample produced
+} ARSynth_t;
+
+/// @brief Reset the generator: every channel low, time 0
+/// @param Synth Pointer to the generator
+/// @param Seed Random seed (0 is replaced by a fixed constant)
+void                ARSynthInit(ARSynth_t * Synth, uint32_t Seed);
+
+/// @brief Hold a channel at a fixed level
+/// @param Synth Pointer to the generator
+/// @param Ch Channel (0..15)
+/// @param Level 0 or 1
+void                ARSynthSetLevel(ARSynth_t * Synth, uint32_t Ch, uint32_t Level);
+
+/// @brief Drive a channel with a square wave
+/// @param Synth Pointer to the generator
+/// @param Ch Channel (0..15)
+/// @param Period Period in samples (>= 2)
+/// @param High Samples spent high per period
+/// @param Phase Delay of the wave in samples
+void                ARSynthSetClock(ARSynth_t * Synth, uint32_t Ch, uint32_t Period, uint32_t High, uint32_t Phase);
+
+/// @brief Let a channel toggle at random
+/// @param Synth Pointer to the generator
+/// @param Ch Channel (0..15)
+/// @param MeanRun Average number of samples between toggles (>= 1)
+void                ARSynthSetRandom(ARSynth_t * Synth, uint32_t Ch, uint32_t MeanRun);
+
+/// @brief Generate the next `Count` samples
+/// @param Synth Pointer to the generator
+/// @param Out Destination
+/// @param Count Number of samples
+void                ARSynthFill(ARSynth_t * Synth, ARSample_t * Out, uint32_t Count);
+
+/// @brief Produce whole blocks into a ring, like the capture engine would
+/// @param Synth Pointer to the generator
+/// @param Ring Pointer to the ring (overruns are accounted as usual)
+/// @param Blocks Number of blocks to commit
+void                ARSynthFeed(ARSynth_t * Synth, ARRing_t * Ring, uint32_t Blocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_SYNTH_H__
@@ -0,0 +1,187 @@
+/**
+ * @file ARTraceView.c
+ * @brief Logic trace renderer: draws channels from an ARPyr_t summary with LCD32DrawLine()
+ * @author Nguyen Thanh Phu
+ */
+
+#include "ARTraceView.h"
+
+/// @brief Column summaries of the view being drawn
+static ARPyrNode_t ARTraceCols[AR_TRACE_COLS_MAX];
+
+/// @brief Draw one channel lane from the column summaries
+static void ARTraceLane(LCD32Dev_t * Dev, const ARTraceView_t * View, uint32_t Ch, Dim_t Top){
+    Dim_t yHi = Top;
+    Dim_t yLo = Top + View->LaneHeight - 2;
+    ARSample_t bit = (ARSample_t) (1U << Ch);
+
+    int32_t runStart = -1;  ///< First column of the open run (-1: none)
+    int32_t level = -1;     ///< Level at the end of the previous column (-1: unknown)
+
+    for(int32_t c = 0; c <= View->Width; c++){
+        int32_t now = -1;
+        uint32_t busy = 0;
+        if(c < View->Width){
+            const ARPyrNode_t * node = &(ARTraceCols[c]);
+            if(ARPyrEmpty(*node) & bit){
+                now = -2;
+            } else if(ARPyrToggled(*node) & bit){
+                busy = 1;
+            } else {
+                now = (node->Or & bit) ? 1 : 0;
+            }
+        } else {
+            now = -2;
+        }
+
+        /// The open run ends where the level stops being constant
+        if((runStart >= 0) && (now != level)){
+            Dim_t y = level ? yHi : yLo;
+            LCD32DrawLine(Dev, y, View->Left + runStart, y, View->Left + c - 1, View->Color);
+            runStart = -1;
+        }
+
+        if(busy){
+            LCD32DrawLine(Dev, yHi, View->Left + c, yLo, View->Left + c, View->Busy);
+            level = -1;
+        } else if(now >= 0){
+            if(runStart < 0){
+                /// Constant on both sides of the column boundary: an edge
+                if((level >= 0) && (level != now)){
+                    LCD32DrawLine(Dev, yHi, View->Left + c, yLo, View->Left + c, View->Color);
+                }
+                runStart = c;
+            }
+            level = now;
+        } else {
+            level = -1;
+        }
+    }
+}
+
+/// @brief Draw samples [From, To) of `Pyr` on the canvas
+DefaultRet_t ARTraceDraw(LCD32Dev_t * Dev, const ARTraceView_t * View, const ARPyr_t * Pyr, uint64_t From, uint64_t To){
+    if(IsNull(Dev) || IsNull(View) || IsNull(Pyr)){
+        return STAT_ERR_NULL;
+    }
+    if((View->Width <= 0) || (View->Width > AR_TRACE_COLS_MAX) || (View->LaneHeight < 3) || (To <= From)){
+        return STAT_ERR_INVALID_ARG;
+    }
+
+    ARPyrColumns(Pyr, From, To, ARTraceCols, (uint32_t) View->Width);
+
+    Dim_t top = View->Top;
+    for(uint32_t ch = 0; ch < AR_CHANNEL_NUM; ch++){
+        if( !(View->Channels & (1U << ch)) ){
+            continue;
+        }
+        ARTraceLane(Dev, View, ch, top);
+        top += View->LaneHeight;
+    }
+    return STAT_OKE;
+}
+
+/// @brief Code at Q16 frame `Pos` (0 <= Pos <= (Count - 1) << 16), linearly interpolated
+static inline int32_t ARTraceWaveAt(const uint16_t * Codes, uint32_t Count, int64_t Pos){
+    uint32_t k = (uint32_t) (Pos >> AR_SCOPE_TRIG_FRAC_BITS);
+    int32_t f = (int32_t) (Pos & ((1 << AR_SCOPE_TRIG_FRAC_BITS) - 1));
+    if((k + 1 >= Count) || (f == 0)){
+        return Codes[k];
+    }
+    return Codes[k] + (int32_t) ((((int64_t) Codes[k + 1] - Codes[k]) * f) >> AR_SCOPE_TRIG_FRAC_BITS);
+}
+
+/// @brief Draw the codes of one analog channel from a Q16 start frame
+DefaultRet_t ARTraceDrawWave(LCD32Dev_t * Dev, const ARWaveView_t * View, const uint16_t * Codes, uint32_t Count, int64_t Start, uint32_t Step){
+    if(IsNull(Dev) || IsNull(View) || IsNull(Codes)){
+        return STAT_ERR_NULL;
+    }
+    if((View->Width <= 0) || (View->Height < 2) || (Step == 0) || (Count == 0)){
+        return STAT_ERR_INVALID_ARG;
+    }
+
+    int64_t last = (int64_t) (Count - 1) << AR_SCOPE_TRIG_FRAC_BITS;
+    Dim_t bottom = View->Top + View->Height - 1;
+
+    for(Dim_t c = 0; c < View->Width; c++){
+        int64_t t0 = Start + (int64_t) c * Step;
+        int64_t t1 = t0 + Step;
+        if((t0 < 0) || (t1 > last)){
+            continue;
+        }
+        int32_t a = ARTraceWaveAt(Codes, Count, t0);
+        int32_t b = ARTraceWaveAt(Codes, Count, t1);
+        int32_t lo = (a < b) ? a : b;
+        int32_t hi = (a < b) ? b : a;
+        /// Samples strictly inside the column (zoomed out: many per column)
+        uint32_t k1 = (uint32_t) ((t1 - 1) >> AR_SCOPE_TRIG_FRAC_BITS);
+        for(uint32_t k = (uint32_t) (t0 >> AR_SCOPE_TRIG_FRAC_BITS) + 1; k <= k1; k++){
+            lo = (Codes[k] < lo) ? Codes[k] : lo;
+            hi = (Codes[k] > hi) ? Codes[k] : hi;
+        }
+        Dim_t yLo = bottom - (Dim_t) ((lo * (View->Height - 1)) / AR_SCOPE_CODE_MAX);
+        Dim_t yHi = bottom - (Dim_t) ((hi * (View->Height - 1)) / AR_SCOPE_CODE_MAX);
+        LCD32DrawLine(Dev, yHi, View->Left + c, yLo, View->Left + c, View->Color);
+    }
+    return STAT_OKE;
+}
+
+/// @brief Row of a level (0.1 dBFS), clipped to the view
+static inline Dim_t ARTraceSpecRow(const ARSpecView_t * View, int32_t Db){
+    int32_t r = ((View->DbTop - Db) * (View->Height - 1)) / View->DbSpan;
+    r = (r < 0) ? 0 : ((r > View->Height - 1) ? View->Height - 1 : r);
+    return View->Top + (Dim_t) r;
+}
+
+/// @brief Draw bins [From, To) of a spectrum
+DefaultRet_t ARTraceDrawSpectrum(LCD32Dev_t * Dev, const ARSpecView_t * View, const ARSpectrum_t * Spec, uint32_t From, uint32_t To){
+    if(IsNull(Dev) || IsNull(View) || IsNull(Spec) || IsNull(Spec->Avg)){
+        return STAT_ERR_NULL;
+    }
+    if((View->Width <= 0) || (View->Height < 2) || (View->DbSpan <= 0) || (To <= From) ||
+       (To > ARSpectrumBins(Spec)) || (Spec->Frames == 0)){
+        return STAT_ERR_INVALID_ARG;
+    }
+
+    uint32_t bins = To - From;
+    Dim_t prev = -1;
+    for(Dim_t c = 0; c < View->Width; c++){
+        uint32_t b0 = From + (uint32_t) (((uint64_t) bins * c) / View->Width);
+        uint32_t b1 = From + (uint32_t) (((uint64_t) bins * (c + 1)) / View->Width);
+        b1 = (b1 > b0) ? b1 : b0 + 1;
+
+        int32_t avg = AR_SPEC_DB_FLOOR;
+        int32_t peak = AR_SPEC_DB_FLOOR;
+        for(uint32_t k = b0; k < b1; k++){
+            avg = (ARSpectrumAvg(Spec, k) > avg) ? ARSpectrumAvg(Spec, k) : avg;
+            peak = (Spec->Peak[k] > peak) ? Spec->Peak[k] : peak;
+        }
+
+        Dim_t y = ARTraceSpecRow(View, avg);
+        Dim_t yPrev = (prev < 0) ? y : prev;
+        LCD32DrawLine(Dev, (yPrev < y) ? yPrev : y, View->Left + c, (yPrev < y) ? y : yPrev, View->Left + c, View->Color);
+        Dim_t yPeak = ARTraceSpecRow(View, peak);
+        if(yPeak < y){
+            LCD32DrawLine(Dev, yPeak, View->Left + c, yPeak, View->Left + c, View->PeakColor);
+        }
+        prev = y;
+    }
+    return STAT_OKE;
+}
+
+/// @brief Draw measurement readouts, one line per item
+DefaultRet_t ARTraceDrawReadout(LCD32Dev_t * Dev, Dim_t Row, Dim_t Col, const GFXfont * Font, const ARMeasResult_t * Res, uint32_t Items, Color_t Color){
+    if(IsNull(Dev) || IsNull(Font) || IsNull(Res)){
+        return STAT_ERR_NULL;
+    }
+    char text[24];
+    for(uint32_t item = 0; item < AR_MEAS_ITEM_NUM; item++){
+        if( !(Items & (1U << item)) ){
+            continue;
+        }
+        ARMeasureFormat(Res, item, text, sizeof(text));
+        LCD32DrawText(Dev, Row, Col, text, Font, Color);
+        Row += Font->yAdvance;
+    }
+    return STAT_OKE;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file ARTraceView.h
+ * @brief Logic trace renderer: draws channels from an ARPyr_t summary with LCD32DrawLine()
+ * @details The visible span is cut into one pyramid summary per screen column, so the cost
+ *          depends on the view width and not on the zoom. Each channel gets a lane; runs of
+ *          columns at a constant level become one horizontal line, a level change between
+ *          two columns one vertical edge, and a column where the channel toggled is filled
+ *          top to bottom in the busy color. Zoomed out over a sparse bus this is a handful of
+ *          lines per lane, which also keeps the strip renderer's display list short.
+ *          Analog channels are drawn from their codes (ARScopeTrig.h) starting at a Q16 frame
+ *          position, so a sweep can begin between two samples at the trigger crossing.
+ *          Spectra (ARSpectrum.h) are drawn one column per bin range with a positive peak
+ *          detector, as a connected trace plus one held-peak dot per column.
+ *          Measurement readouts (ARMeasure.h) are overlaid as text lines with LCD32DrawText().
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_TRACE_VIEW_H__
+#define __AR_TRACE_VIEW_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARTraceView.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "../../AppComponents/LCD32/LCD32.h"
+
+#include "ARPyramid.h"
+#include "ARScopeTrig.h"
+#include "ARSpectrum.h"
+#include "ARMeasure.h"
+
+/// @brief Widest view (columns)
+#define AR_TRACE_COLS_MAX           320
+
+/// @brief View layout and colors
+typedef struct ARTraceView_s {
+    Dim_t       Top;            ///< Row of the first lane
+    Dim_t       Left;           ///< First column
+    Dim_t       Width;          ///< Columns (<= AR_TRACE_COLS_MAX)
+    Dim_t       LaneHeight;     ///< Rows per lane, a 1-row gap included (>= 3)
+    ARSample_t  Channels;       ///< Channels drawn, lowest first, one lane each
+    Color_t     Color;          ///< Levels and edges
+    Color_t     Busy;           ///< Columns where the channel toggled
+} ARTraceView_t;
+
+/// @brief Analog view layout
+typedef struct ARWaveView_s {
+    Dim_t       Top;            ///< Row of code AR_SCOPE_CODE_MAX
+    Dim_t       Left;           ///< First column
+    Dim_t       Width;          ///< Columns
+    Dim_t       Height;         ///< Rows from code AR_SCOPE_CODE_MAX down to code 0 (>= 2)
+    Color_t     Color;          ///< Trace
+} ARWaveView_t;
+
+/// @brief Spectrum view layout
+typedef struct ARSpecView_s {
+    Dim_t       Top;            ///< Row of level DbTop
+    Dim_t       Left;           ///< First column
+    Dim_t       Width;          ///< Columns
+    Dim_t       Height;         ///< Rows from DbTop down to DbTop - DbSpan (>= 2)
+    int32_t     DbTop;          ///< Level at the top row (0.1 dBFS)
+    int32_t     DbSpan;         ///< Levels shown below DbTop (0.1 dB, > 0)
+    Color_t     Color;          ///< Averaged trace
+    Color_t     PeakColor;      ///< Held peaks
+} ARSpecView_t;
+
+/// @brief Draw samples [From, To) of `Pyr` on the canvas (the background is left alone)
+/// @details Columns outside the indexed samples are left blank. Not reentrant: one drawing
+///          task, like every LCD32 call.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param View (const ARTraceView_t *) Layout and colors
+/// @param Pyr (const ARPyr_t *) Pyramid over the capture
+/// @param From (uint64_t) First sample of the view
+/// @param To (uint64_t) Sample after the last one of the view
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARTraceDraw(LCD32Dev_t * Dev, const ARTraceView_t * View, const ARPyr_t * Pyr, uint64_t From, uint64_t To);
+
+/// @brief Draw the codes of one analog channel, column `c` covering frames [Start + c Step, Start + (c + 1) Step]
+/// @details Each column is one vertical line spanning the codes of its interval, with
+///          linear interpolation at both ends: adjacent columns share their boundary value,
+///          so the trace is continuous at any zoom and moves smoothly with `Start`. Columns
+///          outside [0, Count - 1] are left blank.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param View (const ARWaveView_t *) Layout and color
+/// @param Codes (const uint16_t *) Codes of the channel, frame 0 first
+/// @param Count (uint32_t) Number of codes
+/// @param Start (int64_t) Frame at the left edge, Q16 (e.g. trigger position minus pre-trigger)
+/// @param Step (uint32_t) Frames per column, Q16 (> 0)
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARTraceDrawWave(LCD32Dev_t * Dev, const ARWaveView_t * View, const uint16_t * Codes, uint32_t Count, int64_t Start, uint32_t Step);
+
+/// @brief Draw bins [From, To) of a spectrum, levels outside the view clipped to its edges
+/// @details Each column shows the highest averaged level of its bins, joined to the previous
+///          column by a vertical line, and the highest held peak as one dot.
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param View (const ARSpecView_t *) Layout, scale and colors
+/// @param Spec (const ARSpectrum_t *) Analyzer with at least one spectrum
+/// @param From (uint32_t) First bin
+/// @param To (uint32_t) Bin after the last one (<= ARSpectrumBins())
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARTraceDrawSpectrum(LCD32Dev_t * Dev, const ARSpecView_t * View, const ARSpectrum_t * Spec, uint32_t From, uint32_t To);
+
+/// @brief Draw measurement readouts, one line per item, e.g. "F 1.235kHz"
+/// @param Dev (LCD32Dev_t *) Pointer to the device object
+/// @param Row (Dim_t) Baseline row of the first line
+/// @param Col (Dim_t) First column
+/// @param Font (const GFXfont *) Font (lines are Font->yAdvance apart)
+/// @param Res (const ARMeasResult_t *) Results
+/// @param Items (uint32_t) Items drawn (bit n: ARMeasItem_e n)
+/// @param Color (Color_t) Text color
+/// @return STAT_OKE or Error Code
+DefaultRet_t        ARTraceDrawReadout(LCD32Dev_t * Dev, Dim_t Row, Dim_t Col, const GFXfont * Font, const ARMeasResult_t * Res, uint32_t Items, Color_t Color);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_TRACE_VIEW_H__
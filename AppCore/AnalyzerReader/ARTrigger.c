@@ -0,0 +1,289 @@
+/**
+ * @file ARTrigger.c
+ * @brief Trigger engine: edge, level, pattern and sequential triggers with pre-trigger history
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "ARTrigger.h"
+
+/// @brief Stage conditions replicated in both lanes, rebuilt on every stage change
+typedef struct ARTrigPacked_s {
+    uint32_t    Mask;
+    uint32_t    Value;
+    uint32_t    Rise;
+    uint32_t    Fall;
+    uint32_t    Enter;
+    uint32_t    Edge;
+} ARTrigPacked_t;
+
+/// @brief Replicate a stage in both lanes
+static void ARTriggerPack(ARTrigPacked_t * Pk, const ARTrigStage_t * Stage){
+    Pk->Mask  = ARLanePair(Stage->Mask);
+    Pk->Value = ARLanePair(Stage->Value);
+    Pk->Rise  = ARLanePair(Stage->Rise);
+    Pk->Fall  = ARLanePair(Stage->Fall);
+    Pk->Enter = (Stage->Flags & AR_TRIG_FLAG_ENTER) ? 1 : 0;
+    Pk->Edge  = (Stage->Rise | Stage->Fall) ? 1 : 0;
+}
+
+/// @brief Lanes (high bit) where `Cur` hits the stage, `Prev` holding the sample before each lane
+static inline uint32_t ARTriggerLanes(const ARTrigPacked_t * Pk, uint32_t Prev, uint32_t Cur){
+    uint32_t hit = AR_LANE_HI & ~ARLaneNonZero((Cur & Pk->Mask) ^ Pk->Value);
+    if(Pk->Enter){
+        hit &= ARLaneNonZero((Prev & Pk->Mask) ^ Pk->Value);
+    }
+    if(Pk->Edge){
+        hit &= ARLaneNonZero((~Prev & Cur & Pk->Rise) | (Prev & ~Cur & Pk->Fall));
+    }
+    return hit;
+}
+
+/// @brief Samples of the window placed before the trigger
+#define ARTriggerPreSamples(trig)   ((uint32_t) (((uint64_t) (trig)->WindowSamples * (trig)->PrePercent) / 100))
+
+/// @brief Stage condition: rising/falling/any edge on one channel
+void ARTriggerStageEdge(ARTrigStage_t * Stage, uint32_t Ch, uint32_t Edge){
+    if((Stage == NULL) || (Ch >= AR_CHANNEL_NUM)){
+        return;
+    }
+    memset(Stage, 0, sizeof(ARTrigStage_t));
+    Stage->Rise  = (Edge & AR_TRIG_EDGE_RISING)  ? (ARSample_t) (1U << Ch) : 0;
+    Stage->Fall  = (Edge & AR_TRIG_EDGE_FALLING) ? (ARSample_t) (1U << Ch) : 0;
+    Stage->Count = 1;
+}
+
+/// @brief Stage condition: one channel at a level
+void ARTriggerStageLevel(ARTrigStage_t * Stage, uint32_t Ch, uint32_t Level){
+    if((Stage == NULL) || (Ch >= AR_CHANNEL_NUM)){
+        return;
+    }
+    ARTriggerStagePattern(Stage, (ARSample_t) (1U << Ch), Level ? (ARSample_t) (1U << Ch) : 0, 0);
+}
+
+/// @brief Stage condition: masked channels equal `Value` (`Enter`: only when it becomes true)
+void ARTriggerStagePattern(ARTrigStage_t * Stage, ARSample_t Mask, ARSample_t Value, uint32_t Enter){
+    if(Stage == NULL){
+        return;
+    }
+    memset(Stage, 0, sizeof(ARTrigStage_t));
+    Stage->Mask  = Mask;
+    Stage->Value = Value & Mask;
+    Stage->Flags = Enter ? AR_TRIG_FLAG_ENTER : 0;
+    Stage->Count = 1;
+}
+
+/// @brief Reset the engine: no stages, window of `WindowSamples` with `PrePercent` % history
+void ARTriggerInit(ARTrigger_t * Trig, uint32_t WindowSamples, uint32_t PrePercent){
+    if(Trig == NULL){
+        return;
+    }
+    memset(Trig, 0, sizeof(ARTrigger_t));
+    Trig->WindowSamples = WindowSamples;
+    Trig->PrePercent    = (PrePercent > 100) ? 100 : PrePercent;
+    Trig->State         = AR_TRIG_IDLE;
+}
+
+/// @brief Append a stage to the sequence
+DefaultRet_t ARTriggerAddStage(ARTrigger_t * Trig, const ARTrigStage_t * Stage){
+    if((Trig == NULL) || (Stage == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if(Trig->StageNum >= AR_TRIG_STAGE_MAX){
+        return STAT_ERR_OVERFLOW;
+    }
+    ARTrigStage_t * st = &(Trig->Stage[Trig->StageNum]);
+    *st = *Stage;
+    st->Value &= st->Mask;
+    if(st->Count == 0){
+        st->Count = 1;
+    }
+    Trig->StageNum++;
+    return STAT_OKE;
+}
+
+/// @brief Restart the sequence and scan the ring from its oldest unreleased block
+DefaultRet_t ARTriggerArm(ARTrigger_t * Trig, ARRing_t * Ring){
+    if((Trig == NULL) || (Ring == NULL)){
+        return STAT_ERR_NULL;
+    }
+    /// The block holding the window start is partly before it, and one block is always in flight
+    if((Trig->WindowSamples == 0) || (Ring->Blocks < 3) ||
+       ((uint64_t) Trig->WindowSamples > (uint64_t) (Ring->Blocks - 2) * Ring->BlockSamples)){
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    Trig->Cur         = 0;
+    Trig->Hits        = 0;
+    Trig->HasPrev     = 0;
+    Trig->Lost        = 0;
+    Trig->ScanSeq     = Ring->Tail;
+    Trig->TrigSample  = 0;
+    Trig->StartSample = 0;
+    Trig->EndSample   = 0;
+    Trig->State       = AR_TRIG_ARMED;
+    return STAT_OKE;
+}
+
+/// @brief Run the stages over consecutive samples
+int32_t ARTriggerScan(ARTrigger_t * Trig, const ARSample_t * Samples, uint32_t Count){
+    if((Trig == NULL) || (Samples == NULL) || (Count == 0)){
+        return -1;
+    }
+    if(Trig->StageNum == 0){
+        return 0;
+    }
+    if(Trig->Cur >= Trig->StageNum){
+        return -1;
+    }
+    /// No edge can complete on the very first sample
+    if( !Trig->HasPrev ){
+        Trig->Prev    = Samples[0];
+        Trig->HasPrev = 1;
+    }
+
+    ARTrigPacked_t pk;
+    ARTriggerPack(&pk, &(Trig->Stage[Trig->Cur]));
+    uint32_t prev = Trig->Prev;
+    uint32_t i = 0;
+
+    while(i < Count){
+        if(i + 1 < Count){
+            /// Lane 0 = Samples[i], lane 1 = Samples[i + 1], each against the sample before it
+            uint32_t a = Samples[i];
+            uint32_t lanes = ARTriggerLanes(&pk, prev | (a << 16), a | ((uint32_t) Samples[i + 1] << 16));
+            if(lanes == 0){
+                prev = Samples[i + 1];
+                i += 2;
+                continue;
+            }
+            if( !(lanes & AR_LANE0) ){
+                i++;
+            }
+        } else {
+            if( !(ARTriggerLanes(&pk, prev, Samples[i]) & AR_LANE0) ){
+                prev = Samples[i];
+                i++;
+                continue;
+            }
+        }
+
+        /// Samples[i] hits the current stage; the next stage starts with the following sample
+        prev = Samples[i];
+        Trig->Hits++;
+        if(Trig->Hits >= Trig->Stage[Trig->Cur].Count){
+            Trig->Hits = 0;
+            Trig->Cur++;
+            if(Trig->Cur >= Trig->StageNum){
+                Trig->Prev = (ARSample_t) prev;
+                return (int32_t) i;
+            }
+            ARTriggerPack(&pk, &(Trig->Stage[Trig->Cur]));
+        }
+        i++;
+    }
+
+    Trig->Prev = (ARSample_t) prev;
+    return -1;
+}
+
+/// @brief Scan the blocks that landed since the last call and track the window
+uint32_t ARTriggerPoll(ARTrigger_t * Trig, ARRing_t * Ring){
+    if((Trig == NULL) || (Ring == NULL)){
+        return AR_TRIG_IDLE;
+    }
+
+    uint32_t bs  = Ring->BlockSamples;
+    uint32_t pre = ARTriggerPreSamples(Trig);
+
+    while(Trig->State == AR_TRIG_ARMED){
+        uint32_t head = Ring->Head;
+        if(Trig->ScanSeq == head){
+            break;
+        }
+        /// Lapped by the producer: resume at the oldest intact block, edge reference is gone
+        if(head - Trig->ScanSeq > Ring->Blocks - 1){
+            uint32_t oldest = head - (Ring->Blocks - 1);
+            Trig->Lost   += oldest - Trig->ScanSeq;
+            Trig->ScanSeq = oldest;
+            Trig->HasPrev = 0;
+        }
+        const ARSample_t * block = ARRingPeek(Ring, Trig->ScanSeq);
+        if(block == NULL){
+            continue;
+        }
+
+        int32_t idx = ARTriggerScan(Trig, block, bs);
+        if(idx >= 0){
+            /// History is whatever is still intact, at most `pre` samples
+            uint32_t oldest = Ring->Head - (Ring->Blocks - 1);
+            if((int32_t) (Ring->Tail - oldest) > 0){
+                oldest = Ring->Tail;
+            }
+            uint64_t first = ARRingSeqToSample(Ring, oldest);
+            Trig->TrigSample  = ARRingSeqToSample(Ring, Trig->ScanSeq) + (uint32_t) idx;
+            Trig->StartSample = (Trig->TrigSample - first > pre) ? (Trig->TrigSample - pre) : first;
+            Trig->EndSample   = Trig->TrigSample + (Trig->WindowSamples - pre);
+            Trig->State       = AR_TRIG_TRIGGERED;
+            ARRingDiscard(Ring, (uint32_t) (Trig->StartSample / bs));
+        }
+        Trig->ScanSeq++;
+
+        /// Before the trigger only the last `pre` samples can end up in the window
+        if(Trig->State == AR_TRIG_ARMED){
+            uint64_t scanned = ARRingSeqToSample(Ring, Trig->ScanSeq);
+            if(scanned > pre){
+                ARRingDiscard(Ring, (uint32_t) ((scanned - pre) / bs));
+            }
+        }
+    }
+
+    if((Trig->State == AR_TRIG_TRIGGERED) && (ARRingSeqToSample(Ring, Ring->Head) >= Trig->EndSample)){
+        Trig->State = AR_TRIG_DONE;
+    }
+    return Trig->State;
+}
+
+/// @brief Copy the window [StartSample, EndSample) out of the ring
+int32_t ARTriggerCopyWindow(ARTrigger_t * Trig, ARRing_t * Ring, ARSample_t * Out, uint32_t Cap){
+    if((Trig == NULL) || (Ring == NULL) || (Out == NULL)){
+        return STAT_ERR_NULL;
+    }
+    if(Trig->State != AR_TRIG_DONE){
+        return STAT_ERR_INVALID_STATE;
+    }
+    uint64_t count = Trig->EndSample - Trig->StartSample;
+    if(count > Cap){
+        return STAT_ERR_INVALID_SIZE;
+    }
+
+    uint32_t bs = Ring->BlockSamples;
+    uint32_t startSeq = (uint32_t) (Trig->StartSample / bs);
+    uint32_t endSeq = (uint32_t) ((Trig->EndSample + bs - 1) / bs);
+    uint64_t pos = Trig->StartSample;
+    uint32_t copied = 0;
+    while(pos < Trig->EndSample){
+        const ARSample_t * block = ARRingPeek(Ring, (uint32_t) (pos / bs));
+        if(block == NULL){
+            /// What is left of the window is not scanned again by the next arm
+            ARRingDiscard(Ring, endSeq);
+            return STAT_ERR_OVERFLOW;
+        }
+        uint32_t off = (uint32_t) (pos % bs);
+        uint32_t n = bs - off;
+        if(n > Trig->EndSample - pos){
+            n = (uint32_t) (Trig->EndSample - pos);
+        }
+        memcpy(&Out[copied], &block[off], n * sizeof(ARSample_t));
+        pos    += n;
+        copied += n;
+    }
+    /// The producer may have reached the first block while it was being copied
+    /// The next arm resumes after the window, copied or not
+    ARRingDiscard(Ring, endSeq);
+    if(Ring->Head - startSeq > Ring->Blocks - 1){
+        return STAT_ERR_OVERFLOW;
+    }
+    return (int32_t) copied;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file ARTrigger.h
+ * @brief Trigger engine: edge, level, pattern and sequential triggers with pre-trigger history
+ * @details Blocks are scanned as they land in the ring. Two samples are packed in one 32-bit
+ *          word and every stage condition (pattern, pattern entry, rising/falling edges) is
+ *          evaluated on both lanes at once with mask arithmetic, so a quiet bus costs a few
+ *          ALU operations per sample pair and no per-channel loop. The result is a window
+ *          position in sample time; blocks older than the pre-trigger history are released
+ *          while scanning and ARTriggerCopyWindow() hands out only that slice.
+ *          Hardware independent: feed it ARSynth blocks to run it on a host.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __AR_TRIGGER_H__
+#define __AR_TRIGGER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/ARTrigger.h")
+#endif /// PRINT_HEADER_COMPILE_MESSAGE
+
+#include "ARRing.h"
+
+/// @brief Maximum number of sequential stages
+#define AR_TRIG_STAGE_MAX           4
+
+/// @brief Stage flag: the pattern must become true (it did not match on the previous sample)
+#define AR_TRIG_FLAG_ENTER          0x0001
+
+/// @brief Edge selection for ARTriggerStageEdge()
+enum ARTrigEdge_e {
+    AR_TRIG_EDGE_RISING     = 1,
+    AR_TRIG_EDGE_FALLING    = 2,
+    AR_TRIG_EDGE_ANY        = 3,
+};
+
+/// @brief Engine states
+enum ARTrigState_e {
+    AR_TRIG_IDLE            = 0,    ///< Not armed
+    AR_TRIG_ARMED           = 1,    ///< Scanning for the last stage
+    AR_TRIG_TRIGGERED       = 2,    ///< Fired, waiting for the post-trigger samples
+    AR_TRIG_DONE            = 3,    ///< Window complete, ready for ARTriggerCopyWindow()
+};
+
+/// @brief One trigger stage; a sample hits when every configured condition holds
+typedef struct ARTrigStage_s {
+    ARSample_t  Mask;       ///< Channels taking part in the pattern (0: no pattern condition)
+    ARSample_t  Value;      ///< Required levels of the masked channels
+    ARSample_t  Rise;       ///< Any of these channels going 0 -> 1 ...
+    ARSample_t  Fall;       ///< ... or any of these going 1 -> 0 (both 0: no edge condition)
+    uint32_t    Flags;      ///< AR_TRIG_FLAG_*
+    uint32_t    Count;      ///< Hits needed before moving to the next stage (>= 1)
+} ARTrigStage_t;
+
+/// @brief Trigger engine
+typedef struct ARTrigger_s {
+    ARTrigStage_t   Stage[AR_TRIG_STAGE_MAX];
+    uint32_t        StageNum;       ///< Stages in use (0: fires on the first sample)
+    uint32_t        WindowSamples;  ///< Samples handed out per trigger
+    uint32_t        PrePercent;     ///< Part of the window placed before the trigger (0..100)
+
+    /* Runtime */
+    uint32_t        State;          ///< ARTrigState_e
+    uint32_t        Cur;            ///< Stage being waited for
+    uint32_t        Hits;           ///< Hits counted on the current stage
+    ARSample_t      Prev;           ///< Last sample scanned (edge reference)
+    uint32_t        HasPrev;        ///< 0 until the first sample is scanned
+    uint32_t        ScanSeq;        ///< Next ring block to scan
+    uint32_t        Lost;           ///< Blocks overwritten before they could be scanned
+    uint64_t        TrigSample;     ///< Sample that completed the last stage
+    uint64_t        StartSample;    ///< First sample of the window
+    uint64_t        EndSample;      ///< One past the last sample of the window
+} ARTrigger_t;
+
+/// @brief Stage condition: rising/falling/any edge on one channel
+void                ARTriggerStageEdge(ARTrigStage_t * Stage, uint32_t Ch, uint32_t Edge);
+
+/// @brief Stage condition: one channel at a level
+void                ARTriggerStageLevel(ARTrigStage_t * Stage, uint32_t Ch, uint32_t Level);
+
+/// @brief Stage condition: masked channels equal `Value` (`Enter`: only when it becomes true)
+void                ARTriggerStagePattern(ARTrigStage_t * Stage, ARSample_t Mask, ARSample_t Value, uint32_t Enter);
+
+/// @brief Reset the engine: no stages, window of `WindowSamples` with `PrePercent` % history
+/// @param Trig Pointer to the engine
+/// @param WindowSamples Samples handed out per trigger
+/// @param PrePercent Part of the window placed before the trigger (clamped to 100)
+void                ARTriggerInit(ARTrigger_t * Trig, uint32_t WindowSamples, uint32_t PrePercent);
+
+/// @brief Append a stage to the sequence
+/// @param Trig Pointer to the engine
+/// @param Stage Stage to copy (Count 0 is taken as 1)
+/// @return STAT_OKE or STAT_ERR_OVERFLOW when AR_TRIG_STAGE_MAX stages are in use
+DefaultRet_t        ARTriggerAddStage(ARTrigger_t * Trig, const ARTrigStage_t * Stage);
+
+/// @brief Restart the sequence and scan the ring from its oldest unreleased block
+/// @param Trig Pointer to the engine
+/// @param Ring Ring to scan
+/// @return STAT_OKE, or STAT_ERR_INVALID_SIZE if the window cannot fit in the ring
+DefaultRet_t        ARTriggerArm(ARTrigger_t * Trig, ARRing_t * Ring);
+
+/// @brief Run the stages over consecutive samples
+/// @details Keeps stage, hit count and edge reference across calls, so blocks can be fed
+///          one after the other. Stops at the sample completing the last stage.
+/// @param Trig Pointer to the engine
+/// @param Samples Samples following the ones of the previous call
+/// @param Count Number of samples
+/// @return Index of the sample that completed the last stage, or -1
+int32_t             ARTriggerScan(ARTrigger_t * Trig, const ARSample_t * Samples, uint32_t Count);
+
+/// @brief Scan the blocks that landed since the last call and track the window
+/// @details Releases blocks the pre-trigger history no longer needs. Call it from the ring
+///          consumer instead of ARRingAcquire()/ARRingRelease().
+/// @param Trig Pointer to the engine
+/// @param Ring Ring given to ARTriggerArm()
+/// @return ARTrigState_e
+uint32_t            ARTriggerPoll(ARTrigger_t * Trig, ARRing_t * Ring);
+
+/// @brief Copy the window [StartSample, EndSample) out of the ring
+/// @details The window's blocks are released even when the copy fails, so the next
+///          ARTriggerArm() scans on from its end instead of firing in it again.
+/// @param Trig Pointer to the engine (AR_TRIG_DONE)
+/// @param Ring Ring given to ARTriggerArm()
+/// @param Out Destination
+/// @param Cap Capacity of `Out` in samples
+/// @return Samples copied, or a negative DefaultRet_e (STAT_ERR_OVERFLOW: overwritten meanwhile)
+int32_t             ARTriggerCopyWindow(ARTrigger_t * Trig, ARRing_t * Ring, ARSample_t * Out, uint32_t Cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __AR_TRIGGER_H__
@@ -0,0 +1,21 @@
+#ifndef __ANALYZER_READER_ALL_H__
+#define __ANALYZER_READER_ALL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppCore/AnalyzerReader/All.h")
+#endif
+
+#include "AnalyzerReader.h"
+#include "ARCapture.h"
+#include "ARScope.h"
+#include "ARTraceView.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __ANALYZER_READER_ALL_H__
@@ -1 +1,351 @@
-#include "AnalyzerReader.h"
+#include "All.h"
+
+/// @brief Interval between two throughput reports (ms)
+#define AR_REPORT_PERIOD_MS         1000
+
+void TaskReader(void * pv){
+    AREntry("TaskReader(%p)", pv);
+
+#if (AR_CAPTURE_EN == 1)
+    ARCaptureConfig_t cfg;
+    ARCaptureDefaultConfig(&cfg);
+
+    ARCapture_t * cap = ARCaptureNew(&cfg);
+    if(IsNull(cap) || (ARCaptureStart(cap) != STAT_OKE)){
+        ARErr("[TaskReader] Capture engine failed to start.");
+        ARCaptureDelete(cap);
+        vTaskDelete(NULL);
+        return;
+    }
+    ARRing_t * ring = &(cap->Ring);
+    uint32_t rateHz = cap->RateHz;
+#else
+    /// No capture hardware: a synthetic source stands in for the DMA
+    static ARRing_t synthRing;
+    static ARSynth_t synth;
+    ARSample_t * buf = (ARSample_t *) heap_caps_malloc(ARRingBytes(AR_CAPTURE_BLOCKS, AR_CAPTURE_BLOCK_SAMPLES), MALLOC_CAP_SPIRAM);
+    if(IsNull(buf) || (ARRingInit(&synthRing, buf, AR_CAPTURE_BLOCKS, AR_CAPTURE_BLOCK_SAMPLES) != STAT_OKE)){
+        ARErr("[TaskReader] Malloc failed for synthetic ring.");
+        vTaskDelete(NULL);
+        return;
+    }
+    ARSynthInit(&synth, 1);
+    ARSynthSetClock(&synth, 0, 10, 5, 0);
+    ARSynthSetClock(&synth, 1, 160, 80, 40);
+    ARSynthSetRandom(&synth, 2, 64);
+    ARRing_t * ring = &synthRing;
+    uint32_t rateHz = AR_CAPTURE_DEFAULT_RATE_HZ;
+#endif
+
+#if (AR_RLE_CAPTURE_EN == 1)
+    /// Deep capture: every block is transition-encoded as it lands, decoded once the storage is full
+    static ARRle_t rle;
+    uint8_t * rleBuf = (uint8_t *) heap_caps_malloc(AR_RLE_BYTES, MALLOC_CAP_SPIRAM);
+    if(IsNull(rleBuf) || (ARRleInit(&rle, rleBuf, AR_RLE_BYTES, 0xFFFF) != STAT_OKE)){
+        ARErr("[TaskReader] Malloc failed for transition-encoded capture.");
+        vTaskDelete(NULL);
+        return;
+    }
+#else
+    /// Default trigger: falling edge on channel 0; the window is the slice handed on
+    static ARTrigger_t trig;
+    ARTrigStage_t stage;
+    ARTriggerInit(&trig, AR_TRIGGER_WINDOW_SAMPLES, AR_TRIGGER_PRE_PERCENT);
+    ARTriggerStageEdge(&stage, 0, AR_TRIG_EDGE_FALLING);
+    ARTriggerAddStage(&trig, &stage);
+    ARSample_t * window = (ARSample_t *) heap_caps_malloc(AR_TRIGGER_WINDOW_SAMPLES * sizeof(ARSample_t), MALLOC_CAP_SPIRAM);
+    if(IsNull(window) || (ARTriggerArm(&trig, ring) != STAT_OKE)){
+        ARErr("[TaskReader] Trigger setup failed.");
+        vTaskDelete(NULL);
+        return;
+    }
+#endif
+
+    /// Decoded events go to the drawing task through ARDecodeLink
+    ARLinkInit(&ARDecodeLink);
+#if (AR_SPI_DECODE_EN == 1)
+    static ARSpi_t spi;
+    ARSpiConfig_t spiCfg;
+    ARSpiDefaultConfig(&spiCfg);
+    ARSpiInit(&spi, &spiCfg, ARLinkOnSpi, &ARDecodeLink);
+#endif
+#if (AR_I2C_DECODE_EN == 1)
+    static ARI2c_t i2c;
+    ARI2cConfig_t i2cCfg;
+    ARI2cDefaultConfig(&i2cCfg);
+    ARI2cInit(&i2c, &i2cCfg, ARLinkOnI2c, &ARDecodeLink);
+#endif
+
+    uint32_t lastHead = ring->Head;
+    uint32_t windows = 0;
+#if (AR_RLE_CAPTURE_EN != 1)
+    uint32_t lost = 0;
+#endif
+    int64_t lastReport = esp_timer_get_time();
+
+    while(1){
+    #if (AR_CAPTURE_EN != 1)
+        ARSynthFeed(&synth, ring, 1);
+    #endif
+    #if (AR_RLE_CAPTURE_EN == 1)
+        ARRleDrain(&rle, ring);
+        if(rle.Full){
+            ARLog1("[TaskReader] Trace: %lld samples (%lld ms) in %d bytes, %d records, ratio x%d.%02d, %lld samples skipped",
+                   (int64_t) rle.Now, (int64_t) (rle.Now * 1000 / rateHz), rle.Len, rle.Records,
+                   ARRleRatio100(&rle) / 100, ARRleRatio100(&rle) % 100, (int64_t) rle.Skipped);
+            windows++;
+            ARRleReader_t rd;
+        #if (AR_SPI_DECODE_EN == 1)
+            int64_t t0 = esp_timer_get_time();
+            ARSpiReset(&spi);
+            ARRleReaderInit(&rd, &rle);
+            ARSpiDecodeRle(&spi, &rd, rle.Now);
+            ARLog1("[TaskReader] SPI: %d frames, %d words in %lld us", spi.Frames, spi.Words, esp_timer_get_time() - t0);
+        #endif
+        #if (AR_I2C_DECODE_EN == 1)
+            int64_t t1 = esp_timer_get_time();
+            ARI2cReset(&i2c);
+            ARRleReaderInit(&rd, &rle);
+            ARI2cDecodeRle(&i2c, &rd, rle.Now);
+            ARLog1("[TaskReader] I2C: %d bytes, %d errors, %d glitches in %lld us", i2c.Bytes, i2c.Errors, i2c.Glitches, esp_timer_get_time() - t1);
+        #endif
+            ARLinkFlush(&ARDecodeLink);
+            ARRleReset(&rle);
+        }
+    #else
+        if(ARTriggerPoll(&trig, ring) == AR_TRIG_DONE){
+            int32_t n = ARTriggerCopyWindow(&trig, ring, window, AR_TRIGGER_WINDOW_SAMPLES);
+            if(n < 0){
+                /// The window is released anyway: the next arm scans on from its end
+                ARErr("[TaskReader] Window at sample %lld overwritten before copy, skipped to %lld", (int64_t) trig.StartSample, (int64_t) trig.EndSample);
+            } else {
+                ARLog1("[TaskReader] Trigger at sample %lld, window %d samples from %lld", (int64_t) trig.TrigSample, n, (int64_t) trig.StartSample);
+                windows++;
+            #if (AR_SPI_DECODE_EN == 1)
+                int64_t t0 = esp_timer_get_time();
+                ARSpiReset(&spi);
+                ARSpiDecode(&spi, window, n);
+                int64_t us = esp_timer_get_time() - t0;
+                ARLog1("[TaskReader] SPI: %d frames, %d words in %lld us (%d MB/s of samples)",
+                       spi.Frames, spi.Words, us, (us > 0) ? (int32_t) ((int64_t) n * sizeof(ARSample_t) / us) : 0);
+            #endif
+            #if (AR_I2C_DECODE_EN == 1)
+                int64_t t1 = esp_timer_get_time();
+                ARI2cReset(&i2c);
+                ARI2cDecode(&i2c, window, n);
+                int64_t us1 = esp_timer_get_time() - t1;
+                ARLog1("[TaskReader] I2C: %d bytes, %d errors, %d glitches in %lld us (%d MB/s of samples)",
+                       i2c.Bytes, i2c.Errors, i2c.Glitches, us1, (us1 > 0) ? (int32_t) ((int64_t) n * sizeof(ARSample_t) / us1) : 0);
+            #endif
+                ARLinkFlush(&ARDecodeLink);
+            }
+            /// ARTriggerArm() clears the count of blocks the trigger could not scan
+            lost += trig.Lost;
+            ARTriggerArm(&trig, ring);
+        }
+    #endif
+
+        int64_t now = esp_timer_get_time();
+        if(now - lastReport >= AR_REPORT_PERIOD_MS * 1000LL){
+            uint32_t expected = (uint32_t) ((uint64_t) rateHz * (now - lastReport) / 1000000ULL / ring->BlockSamples);
+        #if (AR_CAPTURE_EN == 1)
+            uint32_t overruns = ARCaptureOverruns(cap);
+        #else
+            uint32_t overruns = ARRingOverruns(ring);
+        #endif
+            uint32_t head = ring->Head;
+            ARLog("[TaskReader] %d blocks/s (expected %d), %d windows, %d overruns total", head - lastHead, expected, windows, overruns);
+        #if (AR_RLE_CAPTURE_EN != 1)
+            ARLog("[TaskReader] Trigger: %d blocks not scanned total", lost + trig.Lost);
+        #endif
+            ARLog("[TaskReader] Decoded events: %d sent, %d dropped total", ARDecodeLink.Sent, ARDecodeLink.Dropped);
+            lastHead = head;
+            windows = 0;
+            lastReport = now;
+        }
+
+        DelayMs(1);
+    }
+}
+
+#if (AR_SCOPE_EN == 1)
+
+void TaskScope(void * pv){
+    AREntry("TaskScope(%p)", pv);
+
+#if (AR_SCOPE_ADC_EN == 1)
+    ARScopeConfig_t cfg;
+    ARScopeDefaultConfig(&cfg);
+
+    ARScope_t * scope = ARScopeNew(&cfg);
+    if(IsNull(scope) || (ARScopeStart(scope) != STAT_OKE)){
+        ARErr("[TaskScope] ADC engine failed to start.");
+        ARScopeDelete(scope);
+        vTaskDelete(NULL);
+        return;
+    }
+    ARRing_t * ring = &(scope->Ring);
+#else
+    /// No analog front end: waveforms stand in for the ADC, paced at the configured rate
+    static ARRing_t synthRing;
+    static ARScopeSynth_t synth;
+    static ARSample_t synthBuf[AR_SCOPE_BLOCKS * AR_SCOPE_BLOCK_SAMPLES];
+    ARRingInit(&synthRing, synthBuf, AR_SCOPE_BLOCKS, AR_SCOPE_BLOCK_SAMPLES);
+    ARScopeSynthInit(&synth, AR_SCOPE_CHANNELS, 1);
+    uint32_t frameHz = AR_SCOPE_DEFAULT_RATE_HZ / __builtin_popcount(synth.ChannelMask);
+    ARScopeSynthSetWave(&synth, 0, AR_WAVE_SINE,   frameHz / 1000, 2048, 1500, 8);
+    ARScopeSynthSetWave(&synth, 1, AR_WAVE_SQUARE, frameHz / 250,  2048, 1000, 8);
+    ARScopeSynthSetWave(&synth, 2, AR_WAVE_NOISE,  0,              1024,  200, 0);
+    ARRing_t * ring = &synthRing;
+    int64_t synthStart = esp_timer_get_time();
+    uint64_t synthBlocks = 0;
+#endif
+
+    /// Per-channel measurements over one report period
+    uint32_t chMask = AR_SCOPE_CHANNELS & ((1U << AR_SCOPE_CH_MAX) - 1);
+    uint32_t chHz = AR_SCOPE_DEFAULT_RATE_HZ / __builtin_popcount(chMask);
+    static ARMeasure_t meas[AR_SCOPE_CH_MAX];
+    for(uint32_t ch = 0; ch < AR_SCOPE_CH_MAX; ch++){
+        ARMeasureInit(&meas[ch], chHz, AR_SCOPE_FULL_SCALE_MV);
+    }
+    static uint16_t measCodes[AR_SCOPE_BLOCK_SAMPLES];
+    uint32_t blocks = 0;
+    int64_t lastReport = esp_timer_get_time();
+
+    /// Trigger channel codes of one block, and the spacing of consecutive shots (Q16 frames)
+    static uint16_t trigCodes[AR_SCOPE_BLOCK_SAMPLES];
+    ARScopeTrig_t trig;
+    ARScopeTrigInit(&trig, AR_SCOPE_TRIG_EDGE, AR_SCOPE_TRIG_LEVEL, AR_SCOPE_TRIG_HYST, AR_SCOPE_TRIG_HOLDOFF);
+    uint64_t lastShot = 0;
+    uint64_t periodSum = 0, periodMin = UINT64_MAX, periodMax = 0;
+    uint32_t periods = 0, shots = 0;
+
+#if (AR_SCOPE_FFT_EN == 1)
+    /// Trigger channel codes gathered until a spectrum is due
+    static uint16_t fftCodes[AR_SCOPE_FFT_POINTS];
+    uint32_t fftFill = 0, spectra = 0;
+    int64_t fftUs = 0;
+    ARSpectrum_t spec;
+    void * specMem = heap_caps_malloc(ARSpectrumBytes(AR_SCOPE_FFT_POINTS), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if(IsNull(specMem) ||
+       (ARSpectrumInit(&spec, specMem, ARSpectrumBytes(AR_SCOPE_FFT_POINTS), AR_SCOPE_FFT_POINTS, AR_SCOPE_FFT_WINDOW, AR_SCOPE_FFT_AVG_SHIFT) != STAT_OKE)){
+        ARErr("[TaskScope] Spectrum setup failed (%d bytes)", ARSpectrumBytes(AR_SCOPE_FFT_POINTS));
+        vTaskDelete(NULL);
+        return;
+    }
+#endif
+
+    while(1){
+    #if (AR_SCOPE_ADC_EN == 1)
+        ARScopeWait(scope, AR_REPORT_PERIOD_MS);
+    #else
+        uint64_t due = (uint64_t) (esp_timer_get_time() - synthStart) * AR_SCOPE_DEFAULT_RATE_HZ / 1000000ULL / AR_SCOPE_BLOCK_SAMPLES;
+        if(due > synthBlocks){
+            /// Behind by more than the ring holds: those blocks would have been overruns anyway
+            uint32_t n = (due - synthBlocks > AR_SCOPE_BLOCKS) ? AR_SCOPE_BLOCKS : (uint32_t) (due - synthBlocks);
+            ARScopeSynthFeed(&synth, ring, n);
+            synthBlocks = due;
+        } else {
+            DelayMs(1);
+        }
+    #endif
+
+        const ARSample_t * block;
+        while((block = ARRingAcquire(ring, NULL)) != NULL){
+            for(uint32_t ch = 0; ch < AR_SCOPE_CH_MAX; ch++){
+                if((ch != AR_SCOPE_TRIG_CH) && (chMask & (1U << ch))){
+                    ARMeasureFeed(&meas[ch], measCodes, ARScopeExtract(block, ring->BlockSamples, ch, measCodes));
+                }
+            }
+
+            uint32_t n = ARScopeExtract(block, ring->BlockSamples, AR_SCOPE_TRIG_CH, trigCodes);
+            ARMeasureFeed(&meas[AR_SCOPE_TRIG_CH], trigCodes, n);
+            uint32_t off = 0;
+            int32_t k;
+            while((off < n) && ((k = ARScopeTrigScan(&trig, &trigCodes[off], n - off)) >= 0)){
+                if(trig.Shots > 1){
+                    uint64_t period = trig.TrigPos - lastShot;
+                    periodSum += period;
+                    periodMin = (period < periodMin) ? period : periodMin;
+                    periodMax = (period > periodMax) ? period : periodMax;
+                    periods++;
+                }
+                lastShot = trig.TrigPos;
+                shots++;
+                if(AR_SCOPE_TRIG_HOLDOFF == 0){
+                    ARMeasureShot(&meas[AR_SCOPE_TRIG_CH], trig.TrigPos);
+                }
+                off += (uint32_t) k + 1;
+            }
+
+        #if (AR_SCOPE_FFT_EN == 1)
+            for(uint32_t i = 0; i < n; i++){
+                fftCodes[fftFill++] = trigCodes[i];
+                if(fftFill == AR_SCOPE_FFT_POINTS){
+                    int64_t t0 = esp_timer_get_time();
+                    ARSpectrumRun(&spec, fftCodes);
+                    fftUs += esp_timer_get_time() - t0;
+                    spectra++;
+                    fftFill = 0;
+                }
+            }
+        #endif
+            ARRingRelease(ring);
+            blocks++;
+        }
+
+        int64_t now = esp_timer_get_time();
+        if(now - lastReport >= AR_REPORT_PERIOD_MS * 1000LL){
+            uint32_t expected = (uint32_t) ((uint64_t) AR_SCOPE_DEFAULT_RATE_HZ * (now - lastReport) / 1000000ULL / ring->BlockSamples);
+            ARLog("[TaskScope] %d blocks/s (expected %d), %d overruns total", blocks, expected, ARRingOverruns(ring));
+            for(uint32_t ch = 0; ch < AR_SCOPE_CH_MAX; ch++){
+                if( !(chMask & (1U << ch)) ){
+                    continue;
+                }
+                /// Published for the display side, logged as the readout it would draw
+                ARMeasResult_t res;
+                char text[AR_MEAS_ITEM_NUM][20];
+                ARMeasureFinish(&meas[ch], &res);
+                ARMeasurePublish(ch, &res);
+                for(uint32_t item = 0; item < AR_MEAS_ITEM_NUM; item++){
+                    ARMeasureFormat(&res, item, text[item], sizeof(text[item]));
+                }
+                /// Two lines: a log call carries at most CORE_LOG_ARG_MAX arguments
+                ARLog1("[TaskScope] ch%d: %s, %s, %s, %s", ch, text[0], text[1], text[2], text[3]);
+                ARLog1("[TaskScope] ch%d: %s, %s, %s, %s", ch, text[4], text[5], text[6], text[7]);
+            }
+            if(periods > 0){
+                /// Shot spacing in 1/1000 frame: the spread is the trigger jitter
+                ARLog("[TaskScope] ch%d trigger: %d shots, period %d/1000 frames (spread %d/1000)",
+                      AR_SCOPE_TRIG_CH, shots,
+                      (int32_t) (((periodSum / periods) * 1000) >> AR_SCOPE_TRIG_FRAC_BITS),
+                      (int32_t) (((periodMax - periodMin) * 1000) >> AR_SCOPE_TRIG_FRAC_BITS));
+            } else {
+                ARLog("[TaskScope] ch%d trigger: %d shots", AR_SCOPE_TRIG_CH, shots);
+            }
+        #if (AR_SCOPE_FFT_EN == 1)
+            if((spectra > 0) && (spec.Frames > 0)){
+                /// Strongest bin above DC
+                uint32_t best = 1;
+                for(uint32_t k = 2; k < ARSpectrumBins(&spec); k++){
+                    best = (ARSpectrumAvg(&spec, k) > ARSpectrumAvg(&spec, best)) ? k : best;
+                }
+                ARLog("[TaskScope] ch%d spectrum: %d x %d points, %d us each, peak %d Hz at %d/10 dBFS",
+                      AR_SCOPE_TRIG_CH, spectra, AR_SCOPE_FFT_POINTS, (int32_t) (fftUs / spectra),
+                      ARSpectrumBinHz(&spec, best, chHz), ARSpectrumAvg(&spec, best));
+            }
+            spectra = 0;
+            fftUs = 0;
+        #endif
+            blocks = 0;
+            shots = 0;
+            periods = 0;
+            periodSum = 0;
+            periodMin = UINT64_MAX;
+            periodMax = 0;
+            lastReport = now;
+        }
+    }
+}
+
+#endif /// (AR_SCOPE_EN == 1)
@@ -1,3 +1,12 @@
+/**
+ * @file AnalyzerReader.h
+ * @brief Reader firmware: bus capture and signal processing
+ * @details Samples flow through an ARRing_t. The producer is either the LCD_CAM capture
+ *          engine (ARCapture.h, ESP32-S3 only) or the synthetic source (ARSynth.h), and
+ *          everything downstream only sees the ring API.
+ * @author Nguyen Thanh Phu
+ */
+
 #ifndef __ANALYZER_READER_H__
 #define __ANALYZER_READER_H__
 
@@ -9,10 +18,173 @@ extern "C" {
 #pragma message ("AppCore/AnalyzerReader/AnalyzerReader.h")
 #endif
 
+#include "../../AppConfig/All.h"
+#include "../../AppUtils/All.h"
+#include "../../AppESPWrap/All.h"
+
+#define AR_LOG_SECTION
+
+/// @brief Enable the LCD_CAM camera + GDMA capture engine (ESP32-S3)
+#define AR_CAPTURE_EN               1
+
+/// @brief Samples per ring block (one GDMA EOF, i.e. one callback, per block)
+#define AR_CAPTURE_BLOCK_SAMPLES    8192
+/// @brief Ring blocks (8192 * 2 B * 256 = 4 MB of PSRAM)
+#define AR_CAPTURE_BLOCKS           256
+/// @brief Sample rate used until ARCaptureSetRate() is called
+#define AR_CAPTURE_DEFAULT_RATE_HZ  10000000
+/// @brief Highest accepted sample rate
+/// @note  16-bit samples at 40 MHz are 80 MB/s into PSRAM; above ~20 MHz expect overruns
+///        whenever something else competes for PSRAM bandwidth.
+#define AR_CAPTURE_RATE_MAX_HZ      40000000
+
+/// @brief Samples handed out per trigger
+#define AR_TRIGGER_WINDOW_SAMPLES   65536
+/// @brief Part of the window placed before the trigger (%)
+#define AR_TRIGGER_PRE_PERCENT      25
+
+/// @brief Record the stream transition-encoded (ARRle.h) instead of waiting for trigger windows
+#define AR_RLE_CAPTURE_EN           0
+/// @brief PSRAM for one transition-encoded capture (2 bytes per single-channel edge)
+#define AR_RLE_BYTES                (2 * 1024 * 1024)
+
+/// @brief Decode every trigger window as SPI (ARSpiDefaultConfig() channels) and log throughput
+#define AR_SPI_DECODE_EN            1
+/// @brief Decode every trigger window as I2C (ARI2cDefaultConfig() channels) and log throughput
+#define AR_I2C_DECODE_EN            1
+
+/// @brief Oscilloscope mode: TaskScope runs instead of TaskReader
+#define AR_SCOPE_EN                 0
+/// @brief Convert with the ADC continuous driver (ARScope.h); 0: synthetic waveforms (ARScopeSynth.h)
+#define AR_SCOPE_ADC_EN             1
+/// @brief ADC1 channels converted (bit n: channel n, GPIO n + 1 on ESP32-S3)
+#define AR_SCOPE_CHANNELS           0x0003
+/// @brief Conversions per second, all channels together (611 Hz .. 83.3 kHz)
+#define AR_SCOPE_DEFAULT_RATE_HZ    80000
+/// @brief Ring blocks (2: double buffer)
+#define AR_SCOPE_BLOCKS             2
+/// @brief Conversions per block
+#define AR_SCOPE_BLOCK_SAMPLES      1024
+/// @brief Input level of code 4095 (mV, ADC_ATTEN_DB_12 uncalibrated)
+#define AR_SCOPE_FULL_SCALE_MV      3100
+/// @brief Trigger channel (ARScopeTrig.h)
+#define AR_SCOPE_TRIG_CH            0
+/// @brief Trigger edge (ARTrigEdge_e)
+#define AR_SCOPE_TRIG_EDGE          AR_TRIG_EDGE_RISING
+/// @brief Trigger level (code)
+#define AR_SCOPE_TRIG_LEVEL         2048
+/// @brief Trigger hysteresis, half band (codes)
+#define AR_SCOPE_TRIG_HYST          64
+/// @brief Trigger holdoff (frames)
+#define AR_SCOPE_TRIG_HOLDOFF       0
+/// @brief Spectrum of the trigger channel every AR_SCOPE_FFT_POINTS frames (ARSpectrum.h)
+#define AR_SCOPE_FFT_EN             1
+/// @brief Codes per spectrum (power of 2, 16 .. 4096)
+#define AR_SCOPE_FFT_POINTS         1024
+/// @brief Spectrum window (ARSpecWindow_e)
+#define AR_SCOPE_FFT_WINDOW         AR_WIN_HANN
+/// @brief Spectrum averaging weight 1/2^AR_SCOPE_FFT_AVG_SHIFT
+#define AR_SCOPE_FFT_AVG_SHIFT      2
+
+/// @brief Capture task priority
+#define AR_TASK_PRIO                3
+/// @brief Capture task stack size (bytes)
+#define AR_TASK_STACK               4096
+
+#ifndef AR_LOG_LEVEL
+    /// @brief Log level of this module (SYS_LOG_LEVEL_*, set in AppConfig/SystemLog.h)
+    #define AR_LOG_LEVEL              SYS_LOG_LEVEL_VERB
+#endif
+
+/// Sample blocks
+#include "ARRing.h"
+/// Synthetic sample source
+#include "ARSynth.h"
+/// Trigger engine
+#include "ARTrigger.h"
+/// Transition-encoded capture storage
+#include "ARRle.h"
+/// Min/max decimation pyramid
+#include "ARPyramid.h"
+/// Oscilloscope sample format and waveform source
+#include "ARScopeSynth.h"
+/// Analog trigger
+#include "ARScopeTrig.h"
+/// Spectrum analyzer
+#include "ARSpectrum.h"
+/// Waveform measurements
+#include "ARMeasure.h"
+/// Protocol decoders
+#include "ARSpi.h"
+#include "ARI2c.h"
+/// Decoded events to the drawing task
+#include "ARLink.h"
+
+/// @brief Reader main task: runs the capture engine and drains the ring
+/// @param pv Unused
+void                TaskReader(void * pv);
+
+/// @brief Oscilloscope task: runs the ADC engine (or the waveform source) and processes its blocks
+/// @param pv Unused
+void                TaskScope(void * pv);
+
+/* --- MACROS & LOGGING --- */
+
+#ifdef AR_LOG_SECTION
+
+    #if SysLogLevelOn(AR_LOG_LEVEL, SYS_LOG_LEVEL_ERR)
+        /// @brief Log error message
+        #define ARErr(...)                      SysErr(__VA_ARGS__)
+    #else
+        #define ARErr(...)
+    #endif
+
+    #if SysLogLevelOn(AR_LOG_LEVEL, SYS_LOG_LEVEL_INFO)
+        /// @brief Log standard info message
+        #define ARLog(...)                      SysLog(__VA_ARGS__)
+
+        /// @brief Log standard info message, at most once per SYSTEM_LOG_HOT_MS from this line
+        #define ARLogHot(...)                   SysRateMs(SYSTEM_LOG_HOT_MS, SysLog, __VA_ARGS__)
+    #else
+        #define ARLog(...)
+        #define ARLogHot(...)
+    #endif
+
+    #if SysLogLevelOn(AR_LOG_LEVEL, SYS_LOG_LEVEL_VERB)
+        /// @brief Log verbose/detailed message
+        #define ARLog1(...)                     SysLogVer(__VA_ARGS__)
+    #else
+        #define ARLog1(...)
+    #endif
+
+    #if SysLogLevelOn(AR_LOG_LEVEL, SYS_LOG_LEVEL_TRACE)
+        /// @brief Log function entry
+        #define AREntry(...)                    SysEntry(__VA_ARGS__)
+
+        /// @brief Log function exit
+        #define ARExit(...)                     SysExit(__VA_ARGS__)
+
+        /// @brief Log function exit and return a value
+        #define ARReturnWithLog(ret, ...)       SysExit(__VA_ARGS__); return ret;
+
+        /// @brief Entry / exit of functions called per frame or per transfer: at most one line
+        ///        per SYSTEM_LOG_HOT_MS from each call site, with the count of calls skipped
+        #define AREntryHot(...)                 SysRateMs(SYSTEM_LOG_HOT_MS, SysEntry, __VA_ARGS__)
+        #define ARExitHot(...)                  SysRateMs(SYSTEM_LOG_HOT_MS, SysExit, __VA_ARGS__)
+        #define ARReturnWithLogHot(ret, ...)    SysRateMs(SYSTEM_LOG_HOT_MS, SysExit, __VA_ARGS__); return ret;
+    #else
+        #define AREntry(...)
+        #define ARExit(...)
+        #define ARReturnWithLog(ret, ...)       return ret;
+        #define AREntryHot(...)
+        #define ARExitHot(...)
+        #define ARReturnWithLogHot(ret, ...)    return ret;
+    #endif
 
+#endif /// AR_LOG_SECTION
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /// __ANALYZER_READER_H__
\ No newline at end of file
+#endif /// __ANALYZER_READER_H__
@@ -77,37 +77,256 @@ void IOConfigAsInputOutputODPullUp(uint64_t pin_bit_mask){
 }
 
 #if (SYSTEM_SAFE_THREAD_LOG_EN == 1)
-    /// @brief Spinlock to protect printing resource (UART)
-    portMUX_TYPE __LogSpinLock = portMUX_INITIALIZER_UNLOCKED;
+    /// @brief Records of each core, their free lists and their queues to CoreLogTask
+    /// @details A record is taken from the pool of the core the call starts on and queued on the
+    ///          ring of the core it ends on (the task may move in between); CoreLogTask gives it
+    ///          back to its own pool. Each ring and free list has one producer, the core it
+    ///          belongs to with its interrupts masked, and one consumer, CoreLogTask.
+    static CoreLogRec_t     __LogRec[CORE_LOG_CORES][SYSTEM_LOG_DEPTH];
+    static SpscBlock_t      __LogFreeSlot[CORE_LOG_CORES][SYSTEM_LOG_DEPTH];
+    static SpscBlock_t      __LogQueueSlot[CORE_LOG_CORES][SYSTEM_LOG_DEPTH * CORE_LOG_CORES];
+    static SpscPool_t       __LogPool[CORE_LOG_CORES];
+    static SpscRing_t       __LogQueue[CORE_LOG_CORES];
+    /// @brief Calls dropped because their core had no free record
+    static volatile uint32_t __LogLost[CORE_LOG_CORES];
+    /// @brief Console owner: CoreLogTask while it prints, or a CoreLogLock() caller
+    static SemaphoreHandle_t __LogConsole = NULL;
+    /// @brief 0: not set up, 1: being set up, 2: ready
+    static atomic_uint_fast32_t __LogState = 0;
 
-    /// @brief Thread-safe logging wrapper function
-    /// @param fmt Format string (printf style)
-    /// @param ... Variable arguments
-    void CoreLog(const char *fmt, ...) {
-        va_list args;
-        static char log_buffer[256]; /// Temporary buffer
+    /// @brief Lay the pools and rings out on the first call, from any core
+    static bool IRAM_ATTR CoreLogSetup(void) {
+        uint_fast32_t expected = 0;
+        if (atomic_compare_exchange_strong(&__LogState, &expected, 1)) {
+            for (uint32_t core = 0; core < CORE_LOG_CORES; core++) {
+                SpscPoolInit(&__LogPool[core], __LogRec[core], sizeof(CoreLogRec_t), SYSTEM_LOG_DEPTH,
+                             __LogFreeSlot[core], SYSTEM_LOG_DEPTH);
+                SpscRingInit(&__LogQueue[core], __LogQueueSlot[core], SYSTEM_LOG_DEPTH * CORE_LOG_CORES);
+            }
+            atomic_store_explicit(&__LogState, 2, memory_order_release);
+            return true;
+        }
+        /// The other core is setting up: this call is lost
+        return (atomic_load_explicit(&__LogState, memory_order_acquire) == 2);
+    }
 
-        /// 1. Start argument processing
-        va_start(args, fmt);
+    CoreLogRec_t * IRAM_ATTR CoreLogBegin(const char *Fmt, uint32_t Num) {
+        if ((atomic_load_explicit(&__LogState, memory_order_acquire) != 2) && !CoreLogSetup()) {
+            return NULL;
+        }
+        UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+        uint32_t core = (uint32_t) xPortGetCoreID();
+        CoreLogRec_t *rec = (CoreLogRec_t *) SpscPoolGet(&__LogPool[core]);
+        if (rec == NULL) {
+            __LogLost[core]++;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+        if (rec == NULL) {
+            return NULL;
+        }
+        rec->Fmt      = Fmt;
+        rec->Time     = esp_timer_get_time();
+        rec->Num      = (uint8_t) Num;
+        rec->Core     = (uint8_t) core;
+        rec->TextUsed = 0;
+        rec->TextMask = 0;
+        return rec;
+    }
 
-        /// 2. Format string into buffer first (Avoid holding lock during calculation)
-        /// vsnprintf is safer than vsprintf due to length limitation
-        vsnprintf(log_buffer, sizeof(log_buffer), fmt, args);
+    void IRAM_ATTR CoreLogCommit(CoreLogRec_t *Rec) {
+        UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+        /// Never full: the ring has a slot for every record of every core
+        SpscRingPush(&__LogQueue[xPortGetCoreID()], Rec, sizeof(CoreLogRec_t), 0, 0);
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    }
+
+    void IRAM_ATTR CoreLogArgS(CoreLogRec_t *Rec, uint32_t Idx, const char *Str) {
+        if ((Str == NULL) || esp_ptr_in_drom(Str)) {
+            Rec->Arg[Idx] = (uintptr_t) Str;
+            return;
+        }
+        /// RAM strings may be gone when the record is printed: keep a copy, cut to the room left
+        uint32_t used = Rec->TextUsed;
+        uint32_t room = CORE_LOG_TEXT_MAX - used;
+        uint32_t len = 0;
+        while ((len + 1 < room) && (Str[len] != '\0')) {
+            len++;
+        }
+        if (room > 0) {
+            memcpy(&Rec->Text[used], Str, len);
+            Rec->Text[used + len] = '\0';
+            Rec->TextUsed = (uint8_t) (used + len + 1);
+        }
+        Rec->Arg[Idx] = (room > 0) ? used : (CORE_LOG_TEXT_MAX - 1);
+        Rec->TextMask |= (uint8_t) (1U << Idx);
+    }
 
-        /// 3. Enter Critical Section - Disable interrupts, lock other Cores
-        portENTER_CRITICAL(&__LogSpinLock);
+    uint32_t CoreLogFormat(const CoreLogRec_t *Rec, char *Buf, uint32_t Len) {
+        if ((Rec == NULL) || (Buf == NULL) || (Len == 0)) {
+            return 0;
+        }
+        uint32_t out = 0;
+        uint32_t arg = 0;
+        const char *p = Rec->Fmt;
 
-        /// 4. Print formatted string using low-level function
-        /// The string is now continuous, preventing interleaving
-        ets_printf("%s", log_buffer);
+        /// Append snprintf output, keeping `out` within the buffer
+        #define CORE_LOG_PUT(...)   do {                                                    \
+            int n = snprintf(&Buf[out], Len - out, __VA_ARGS__);                            \
+            out = (n < 0) ? out : ((out + (uint32_t) n >= Len) ? (Len - 1) : (out + (uint32_t) n)); \
+        } while (0)
 
-        /// 5. Exit Critical Section
-        portEXIT_CRITICAL(&__LogSpinLock);
+        CORE_LOG_PUT("[%lld] ", (long long) Rec->Time);
+        while ((*p != '\0') && (out + 1 < Len)) {
+            if ((p[0] != '%') || (p[1] == '%')) {
+                Buf[out++] = *p;
+                p += (p[0] == '%') ? 2 : 1;
+                continue;
+            }
 
-        /// 6. End argument processing
-        va_end(args);
+            /// One conversion: rebuild it alone, `*` replaced by its argument, then print its slot
+            char spec[24];
+            uint32_t n = 0;
+            spec[n++] = *p++;
+            while ((*p != '\0') && (strchr("-+ #0123456789.*", *p) != NULL) && (n < sizeof(spec) - 8)) {
+                if (*p == '*') {
+                    int star = (arg < Rec->Num) ? (int) Rec->Arg[arg++] : 0;
+                    n += (uint32_t) snprintf(&spec[n], sizeof(spec) - n - 4, "%d", star);
+                    p++;
+                    continue;
+                }
+                spec[n++] = *p++;
+            }
+            uint32_t lenMod = 0;        /// 0: int, 1: h / hh, 2: l, 3: ll / j, 4: z / t
+            while ((*p != '\0') && (strchr("hlLjzt", *p) != NULL)) {
+                lenMod = (*p == 'h') ? 1 : (*p == 'z' || *p == 't') ? 4 : (*p == 'j' || lenMod == 2) ? 3 : 2;
+                spec[n++] = *p++;
+            }
+            char conv = *p;
+            if (conv == '\0') {
+                break;
+            }
+            p++;
+            spec[n++] = conv;
+            spec[n] = '\0';
+            if (arg >= Rec->Num) {
+                CORE_LOG_PUT("<?>");
+                continue;
+            }
+            uint64_t raw = Rec->Arg[arg];
+            bool isText = (Rec->TextMask >> arg) & 1U;
+            arg++;
+
+            switch (conv) {
+                case 'd': case 'i':
+                    if (lenMod == 3)        CORE_LOG_PUT(spec, (long long) raw);
+                    else if (lenMod == 2)   CORE_LOG_PUT(spec, (long) raw);
+                    else if (lenMod == 4)   CORE_LOG_PUT(spec, (size_t) raw);
+                    else                    CORE_LOG_PUT(spec, (int) raw);
+                    break;
+                case 'u': case 'o': case 'x': case 'X':
+                    if (lenMod == 3)        CORE_LOG_PUT(spec, (unsigned long long) raw);
+                    else if (lenMod == 2)   CORE_LOG_PUT(spec, (unsigned long) raw);
+                    else if (lenMod == 4)   CORE_LOG_PUT(spec, (size_t) raw);
+                    else                    CORE_LOG_PUT(spec, (unsigned int) raw);
+                    break;
+                case 'c':
+                    CORE_LOG_PUT(spec, (int) raw);
+                    break;
+                case 'p':
+                    CORE_LOG_PUT(spec, (void *) (uintptr_t) raw);
+                    break;
+                case 's':
+                    if (isText) {
+                        CORE_LOG_PUT(spec, &Rec->Text[raw]);
+                    } else {
+                        CORE_LOG_PUT(spec, (raw != 0) ? (const char *) (uintptr_t) raw : "(null)");
+                    }
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+                    double val;
+                    memcpy(&val, &raw, sizeof(val));
+                    if (lenMod == 2) {
+                        /// %Lf: the slot holds a double, print it as one
+                        spec[n - 2] = conv;
+                        spec[n - 1] = '\0';
+                    }
+                    CORE_LOG_PUT(spec, val);
+                    break;
+                }
+                default:
+                    /// %n and unknown conversions print nothing
+                    break;
+            }
+        }
+        #undef CORE_LOG_PUT
+        Buf[out] = '\0';
+        return out;
     }
 
-#endif /// (SYSTEM_SAFE_THREAD_LOG_EN == 1)
+    uint32_t CoreLogDrain(void) {
+        static uint32_t reported[CORE_LOG_CORES];
+        char line[256];
+        uint32_t printed = 0;
 
+        if (atomic_load_explicit(&__LogState, memory_order_acquire) != 2) {
+            return 0;
+        }
+        for (uint32_t core = 0; core < CORE_LOG_CORES; core++) {
+            uint32_t lost = __LogLost[core];
+            if (lost != reported[core]) {
+                ets_printf("[%lld] [W] [CoreLog] cpu%d: %d records lost\n", esp_timer_get_time(), core, lost - reported[core]);
+                reported[core] = lost;
+            }
+        }
+        while (true) {
+            /// Oldest record at the head of the rings
+            const SpscBlock_t *next = NULL;
+            uint32_t from = 0;
+            for (uint32_t core = 0; core < CORE_LOG_CORES; core++) {
+                const SpscBlock_t *head = SpscRingPeek(&__LogQueue[core]);
+                if ((head != NULL) && ((next == NULL) || (((CoreLogRec_t *) head->Data)->Time < ((CoreLogRec_t *) next->Data)->Time))) {
+                    next = head;
+                    from = core;
+                }
+            }
+            if (next == NULL) {
+                return printed;
+            }
+            CoreLogRec_t *rec = (CoreLogRec_t *) next->Data;
+            CoreLogFormat(rec, line, sizeof(line));
+            SpscRingDrop(&__LogQueue[from]);
+            SpscPoolPut(&__LogPool[rec->Core], rec);
+            CoreLogLock();
+            ets_printf("%s", line);
+            CoreLogUnlock();
+            printed++;
+        }
+    }
 
+    void CoreLogTask(void *Param) {
+        (void) Param;
+        while (true) {
+            if (CoreLogDrain() == 0) {
+                DelayMs(SYSTEM_LOG_DRAIN_MS);
+            }
+        }
+    }
+
+    void CoreLogLock(void) {
+        if (__LogConsole != NULL) {
+            xSemaphoreTake(__LogConsole, portMAX_DELAY);
+        }
+    }
+
+    void CoreLogUnlock(void) {
+        if (__LogConsole != NULL) {
+            xSemaphoreGive(__LogConsole);
+        }
+    }
+
+    void CoreLogInit(void) {
+        __LogConsole = xSemaphoreCreateMutex();
+        CreateTaskCPU0(CoreLogTask, "CoreLog", SYSTEM_LOG_TASK_STACK, NULL, SYSTEM_LOG_TASK_PRIO, NULL);
+    }
+
+#endif /// (SYSTEM_SAFE_THREAD_LOG_EN == 1)
@@ -15,6 +15,7 @@ extern "C" {
 #include "freertos/FreeRTOS.h"   /// Core FreeRTOS definitions
 #include "freertos/task.h"       /// Task management
 #include "freertos/semphr.h"     /// Semaphores and Mutexes
+#include "freertos/queue.h"      /// Queues
 
 #ifndef EnterCriticalSection
     /// Enter critical section (disable interrupts) - Use with care!
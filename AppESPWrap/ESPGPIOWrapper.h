@@ -70,6 +70,24 @@ extern "C" {
                                         IOExtendedClr((uint32_t)((uint64_t)(mask64) >> 32)); \
                                      } while(0)
 
+/// @brief Enable the output driver of GPIO 0-31 (Atomic, Fast)
+/// @details Only the direction changes: pull resistors, input enable and the GPIO matrix
+///          routing set up by IOConfig*() stay as they are.
+/// @param mask Bitmask of pins to drive
+#define IOStandardEnableOut(mask)    (GPIO.enable_w1ts = (uint32_t)(mask))
+
+/// @brief Disable the output driver of GPIO 0-31, pins go High-Z (Atomic, Fast)
+/// @param mask Bitmask of pins to release
+#define IOStandardDisableOut(mask)   (GPIO.enable_w1tc = (uint32_t)(mask))
+
+/// @brief Enable the output driver of GPIO 32-39+ (Atomic, Fast)
+/// @param mask Bitmask relative to the high bank (bit 0 = GPIO 32)
+#define IOExtendedEnableOut(mask)    (GPIO.enable1_w1ts.val = (uint32_t)(mask))
+
+/// @brief Disable the output driver of GPIO 32-39+ (Atomic, Fast)
+/// @param mask Bitmask relative to the high bank
+#define IOExtendedDisableOut(mask)   (GPIO.enable1_w1tc.val = (uint32_t)(mask))
+
 /// @brief Configure a GPIO pin with specific mode, pull-up/down settings, and interrupt type
 /// @param pin_bit_mask Bitmask of the GPIO(s) to configure
 /// @param mode         GPIO mode (e.g., GPIO_MODE_INPUT, GPIO_MODE_OUTPUT)
@@ -14,6 +14,7 @@ extern "C" {
 
 #include <stdio.h>              /// Standard input/output definitions
 #include <stdarg.h>             /// Macros for variable arguments
+#include <string.h>             /// memcpy
 #include "esp_timer.h"          /// ESP32 timer functions (esp_timer_get_time)
 #include "esp_system.h"         /// ESP32 system APIs
 
@@ -53,23 +54,140 @@ extern "C" {
     #ifndef SYSTEM_LOG_ENTRY_L2_EN
         #define SYSTEM_LOG_ENTRY_L2_EN      1
     #endif
+    #ifndef SYSTEM_LOG_DEPTH
+        #define SYSTEM_LOG_DEPTH            64
+    #endif
+    #ifndef SYSTEM_LOG_DRAIN_MS
+        #define SYSTEM_LOG_DRAIN_MS         10
+    #endif
+    #ifndef SYSTEM_LOG_TASK_PRIO
+        #define SYSTEM_LOG_TASK_PRIO        1
+    #endif
+    #ifndef SYSTEM_LOG_TASK_STACK
+        #define SYSTEM_LOG_TASK_STACK       3072
+    #endif
+    #ifndef SYSTEM_LOG_HOT_MS
+        #define SYSTEM_LOG_HOT_MS           1000
+    #endif
 #endif
 
 #if (SYSTEM_SAFE_THREAD_LOG_EN == 1)
     #include "freertos/FreeRTOS.h"   /// Core FreeRTOS definitions
     #include "freertos/task.h"       /// Task management
     #include "freertos/semphr.h"     /// Semaphores and Mutexes
+    #include "esp_memory_utils.h"    /// esp_ptr_in_drom
+    #include "../AppUtils/SpscRing.h"
+
+    /// Deferred binary log: a call records the format pointer, a time stamp and its raw
+    /// arguments into a ring of its core, CoreLogTask formats and prints them later.
+    /// Strings are kept by pointer when they live in flash (literals, name tables) and copied
+    /// into the record otherwise. Arguments are evaluated with interrupts enabled; only taking
+    /// and queuing the record masks them on the current core, for a few instructions.
+
+    /// @brief Most arguments per call (format excluded)
+    #define CORE_LOG_ARG_MAX            8
+    /// @brief Bytes per record for copied strings (longer ones are cut)
+    #define CORE_LOG_TEXT_MAX           64
+    /// @brief Record rings, one per core
+    #define CORE_LOG_CORES              portNUM_PROCESSORS
+
+    /// @brief One deferred log call
+    typedef struct CoreLogRec_s {
+        const char *    Fmt;                        ///< Format string (static)
+        int64_t         Time;                       ///< esp_timer_get_time() at the call
+        uint8_t         Num;                        ///< Arguments recorded
+        uint8_t         Core;                       ///< Core whose pool the record belongs to
+        uint8_t         TextUsed;                   ///< Bytes of Text in use
+        uint8_t         TextMask;                   ///< Bit i: Arg[i] is an offset into Text
+        uint64_t        Arg[CORE_LOG_ARG_MAX];      ///< Raw arguments, one slot each
+        char            Text[CORE_LOG_TEXT_MAX];    ///< Copied strings
+    } CoreLogRec_t;
+
+    /// @brief Take a record for a call of `Num` arguments (any context)
+    /// @return Record to fill and pass to CoreLogCommit(), NULL when the ring is full (counted as lost)
+    CoreLogRec_t *  CoreLogBegin(const char * Fmt, uint32_t Num);
+
+    /// @brief Queue a filled record for CoreLogTask
+    void            CoreLogCommit(CoreLogRec_t * Rec);
+
+    /// @brief Record a string argument: pointer when it is in flash, copy otherwise
+    void            CoreLogArgS(CoreLogRec_t * Rec, uint32_t Idx, const char * Str);
+
+    /// @brief Format one record as its line would have been printed, time stamp first
+    /// @return Characters written (at most Len - 1)
+    uint32_t        CoreLogFormat(const CoreLogRec_t * Rec, char * Buf, uint32_t Len);
+
+    /// @brief Format and print queued records of all cores in time order
+    /// @return Records printed
+    uint32_t        CoreLogDrain(void);
 
-    /// @brief Spinlock to protect printing resource (UART)
-    extern portMUX_TYPE __LogSpinLock;
+    /// @brief Start CoreLogTask (records taken before are kept until it runs)
+    void            CoreLogInit(void);
 
-    /// @brief Thread-safe logging wrapper function
-    /// @param fmt Format string (printf style)
-    /// @param ... Variable arguments
-    void CoreLog(const char *fmt, ...);
+    /// @brief Low-priority task draining the log rings
+    void            CoreLogTask(void * Param);
+
+    /// @brief Hold the console between CoreLogTask lines, to print a block of raw text (tasks only)
+    void            CoreLogLock(void);
+
+    /// @brief Release the console taken by CoreLogLock()
+    void            CoreLogUnlock(void);
+
+    static inline void CoreLogArgI(CoreLogRec_t * Rec, uint32_t Idx, long long Val){
+        Rec->Arg[Idx] = (uint64_t) Val;
+    }
+
+    static inline void CoreLogArgU(CoreLogRec_t * Rec, uint32_t Idx, unsigned long long Val){
+        Rec->Arg[Idx] = Val;
+    }
+
+    static inline void CoreLogArgF(CoreLogRec_t * Rec, uint32_t Idx, double Val){
+        memcpy(&Rec->Arg[Idx], &Val, sizeof(Val));
+    }
+
+    static inline void CoreLogArgP(CoreLogRec_t * Rec, uint32_t Idx, const volatile void * Val){
+        Rec->Arg[Idx] = (uintptr_t) Val;
+    }
+
+    /// @brief Record argument `x` in slot `i`, by its type
+    #define CoreLogArg(r, i, x)     _Generic((x),                                                   \
+        _Bool: CoreLogArgU, char: CoreLogArgI, signed char: CoreLogArgI, unsigned char: CoreLogArgU, \
+        short: CoreLogArgI, unsigned short: CoreLogArgU, int: CoreLogArgI, unsigned int: CoreLogArgU, \
+        long: CoreLogArgI, unsigned long: CoreLogArgU, long long: CoreLogArgI, unsigned long long: CoreLogArgU, \
+        float: CoreLogArgF, double: CoreLogArgF, long double: CoreLogArgF,                          \
+        char *: CoreLogArgS, const char *: CoreLogArgS,                                             \
+        default: CoreLogArgP)((r), (i), (x));
+
+    #define CORE_LOG_CAT_(a, b)     a##b
+    #define CORE_LOG_CAT(a, b)      CORE_LOG_CAT_(a, b)
+    /// @brief Number of arguments (0 .. 8)
+    #define CORE_LOG_NARG(...)      CORE_LOG_NARG_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+    #define CORE_LOG_NARG_(_, _1, _2, _3, _4, _5, _6, _7, _8, n, ...)   n
+
+    #define CORE_LOG_A0(r)
+    #define CORE_LOG_A1(r, a)                       CoreLogArg(r, 0, a)
+    #define CORE_LOG_A2(r, a, b)                    CORE_LOG_A1(r, a) CoreLogArg(r, 1, b)
+    #define CORE_LOG_A3(r, a, b, c)                 CORE_LOG_A2(r, a, b) CoreLogArg(r, 2, c)
+    #define CORE_LOG_A4(r, a, b, c, d)              CORE_LOG_A3(r, a, b, c) CoreLogArg(r, 3, d)
+    #define CORE_LOG_A5(r, a, b, c, d, e)           CORE_LOG_A4(r, a, b, c, d) CoreLogArg(r, 4, e)
+    #define CORE_LOG_A6(r, a, b, c, d, e, f)        CORE_LOG_A5(r, a, b, c, d, e) CoreLogArg(r, 5, f)
+    #define CORE_LOG_A7(r, a, b, c, d, e, f, g)     CORE_LOG_A6(r, a, b, c, d, e, f) CoreLogArg(r, 6, g)
+    #define CORE_LOG_A8(r, a, b, c, d, e, f, g, h)  CORE_LOG_A7(r, a, b, c, d, e, f, g) CoreLogArg(r, 7, h)
+
+    /// @brief Deferred log call (printf style, at most CORE_LOG_ARG_MAX arguments)
+    #define CoreLog(fmt, ...)       do {                                                        \
+        CoreLogRec_t * __logRec = CoreLogBegin(fmt, CORE_LOG_NARG(__VA_ARGS__));                \
+        if(__logRec != NULL){                                                                   \
+            CORE_LOG_CAT(CORE_LOG_A, CORE_LOG_NARG(__VA_ARGS__))(__logRec, ##__VA_ARGS__)       \
+            CoreLogCommit(__logRec);                                                            \
+        }                                                                                       \
+    } while(0)
 
 #elif (SYSTEM_SAFE_THREAD_LOG_EN == 0)
-    #define CoreLog ets_printf
+    #define CoreLog(fmt, ...)       ets_printf("[%lld] " fmt, esp_timer_get_time(), ##__VA_ARGS__)
+    #define CoreLogInit()
+    #define CoreLogLock()
+    #define CoreLogUnlock()
 #else 
     #ifdef SYSTEM_SAFE_THREAD_LOG_EN
         #undef SYSTEM_SAFE_THREAD_LOG_EN
@@ -81,7 +199,7 @@ extern "C" {
 /// ERROR LOGGING
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_ERR_EN) && SYSTEM_ERR_EN == 1)
     /// Log error message with timestamp and [err] tag
-    #define SysErr(fmt, ...)    CoreLog("[%lld] [err] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysErr(fmt, ...)    CoreLog("[err] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysErr(fmt, ...)
 #endif
@@ -89,7 +207,7 @@ extern "C" {
 /// WARNING LOGGING
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_WARN_EN) && SYSTEM_WARN_EN == 1)
     /// Log warning message with timestamp and [W] tag
-    #define SysWarn(fmt, ...)   CoreLog("[%lld] [W] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysWarn(fmt, ...)   CoreLog("[W] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysWarn(fmt, ...)
 #endif
@@ -97,7 +215,7 @@ extern "C" {
 /// INFO LOGGING
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_INFO_EN) && SYSTEM_INFO_EN == 1)
     /// Log info message with timestamp and [Info] tag
-    #define SysInfo(fmt, ...)   CoreLog("[%lld] [Info] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysInfo(fmt, ...)   CoreLog("[Info] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysInfo(fmt, ...)
 #endif
@@ -105,10 +223,10 @@ extern "C" {
 /// LEVEL 1 LOGGING
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_LOG_L1_EN) && SYSTEM_LOG_L1_EN == 1)
     /// Log standard message with timestamp and [log] tag
-    #define SysLog(fmt, ...)            CoreLog("[%lld] [log] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysLog(fmt, ...)            CoreLog("[log] " fmt "\n", ##__VA_ARGS__)
     
     /// Log message with custom tag string (Mapped to L1)
-    #define SysTagLog(tag, fmt, ...)    CoreLog("[%lld] [log] [%s] " fmt "\n", esp_timer_get_time(), tag, ##__VA_ARGS__)
+    #define SysTagLog(tag, fmt, ...)    CoreLog("[log] [%s] " fmt "\n", tag, ##__VA_ARGS__)
 #else
     #define SysLog(fmt, ...)
     #define SysTagLog(tag, fmt, ...)
@@ -117,10 +235,10 @@ extern "C" {
 /// LEVEL 2 LOGGING (VERBOSE)
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_LOG_L2_EN) && SYSTEM_LOG_L2_EN == 1)
     /// Log verbose/detailed message with timestamp and [verb] tag
-    #define SysLogVer(fmt, ...)             CoreLog("[%lld] [verb] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysLogVer(fmt, ...)             CoreLog("[verb] " fmt "\n", ##__VA_ARGS__)
     
     /// Log verbose message with custom tag
-    #define SysTagLogVer(tag, fmt, ...)     CoreLog("[%lld] [%s] " fmt "\n", esp_timer_get_time(), tag, ##__VA_ARGS__)
+    #define SysTagLogVer(tag, fmt, ...)     CoreLog("[%s] " fmt "\n", tag, ##__VA_ARGS__)
 #else
     #define SysLogVer(fmt, ...)
     #define SysTagLogVer(tag, fmt, ...)
@@ -129,32 +247,57 @@ extern "C" {
 /// ENTRY/EXIT TRACES
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_LOG_ENTRY_L1_EN) && SYSTEM_LOG_ENTRY_L1_EN == 1)
     /// Log function entry trace (Level 1) with [>>>] tag
-    #define SysEntry(fmt, ...)      CoreLog("[%lld] [>>>] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysEntry(fmt, ...)      CoreLog("[>>>] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysEntry(fmt, ...)
 #endif
 
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_LOG_ENTRY_L2_EN) && SYSTEM_LOG_ENTRY_L2_EN == 1)
     /// Log function entry trace (Level 2/Verbose) with [>>>] tag
-    #define SysEntryVer(fmt, ...)   CoreLog("[%lld] [>>>] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysEntryVer(fmt, ...)   CoreLog("[>>>] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysEntryVer(fmt, ...)
 #endif
 
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_LOG_EXIT_L1_EN) && SYSTEM_LOG_EXIT_L1_EN == 1)
     /// Log function exit trace (Level 1) with [<<<] tag
-    #define SysExit(fmt, ...)       CoreLog("[%lld] [<<<] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysExit(fmt, ...)       CoreLog("[<<<] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysExit(fmt, ...)
 #endif
 
 #if (defined(SYSTEM_LOG_EN) && SYSTEM_LOG_EN == 1) && (defined(SYSTEM_LOG_EXIT_L2_EN) && SYSTEM_LOG_EXIT_L2_EN == 1)
     /// Log function exit trace (Level 2/Verbose) with [<<<] tag
-    #define SysExitVer(fmt, ...)    CoreLog("[%lld] [<<<] " fmt "\n", esp_timer_get_time(), ##__VA_ARGS__)
+    #define SysExitVer(fmt, ...)    CoreLog("[<<<] " fmt "\n", ##__VA_ARGS__)
 #else
     #define SysExitVer(fmt, ...)
 #endif
 
+/// RATE-LIMITED / SAMPLED LOGGING (hot functions)
+/// Log through `log` (any Sys* macro) at most once per `ms` from this call site; the line
+/// ends with the number of calls skipped since the previous one. One time read per call.
+#define SysRateMs(ms, log, fmt, ...)    do {                                                \
+        static int64_t __logNext;                                                           \
+        static uint32_t __logSkipped;                                                       \
+        int64_t __logNow = esp_timer_get_time();                                            \
+        if(__logNow >= __logNext){                                                          \
+            __logNext = __logNow + (int64_t) (ms) * 1000;                                   \
+            log(fmt " (+%u)", ##__VA_ARGS__, (unsigned) __logSkipped);                      \
+            __logSkipped = 0;                                                               \
+        } else {                                                                            \
+            __logSkipped++;                                                                 \
+        }                                                                                   \
+    } while(0)
+
+/// Log through `log` (any Sys* macro) on the first call and then one call out of `n` from
+/// this call site. One counter increment per call.
+#define SysEvery(n, log, ...)           do {                                                \
+        static uint32_t __logCount;                                                         \
+        if((__logCount++ % (n)) == 0){                                                      \
+            log(__VA_ARGS__);                                                               \
+        }                                                                                   \
+    } while(0)
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,45 @@
+#include "./All.h"
+
+DefaultRet_t SpscRingInit(SpscRing_t *Ring, SpscBlock_t *Slots, uint32_t SlotNum) {
+    if ((Ring == NULL) || (Slots == NULL)) {
+        return STAT_ERR_NULL;
+    }
+    if ((SlotNum < 2) || (SlotNum > 0x80000000UL) || ((SlotNum & (SlotNum - 1)) != 0)) {
+        return STAT_ERR_INVALID_SIZE;
+    }
+    memset(Slots, 0, SlotNum * sizeof(SpscBlock_t));
+    Ring->Slots = Slots;
+    Ring->Mask  = SlotNum - 1;
+    SpscRingReset(Ring);
+    return STAT_OKE;
+}
+
+void SpscRingReset(SpscRing_t *Ring) {
+    atomic_store_explicit(&Ring->Head, 0, memory_order_relaxed);
+    atomic_store_explicit(&Ring->Tail, 0, memory_order_relaxed);
+    Ring->TailCache = 0;
+    Ring->HeadCache = 0;
+    Ring->Refused   = 0;
+    /// Both sides start from a published, empty ring
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+DefaultRet_t SpscPoolInit(SpscPool_t *Pool, void *Mem, uint32_t BlockSize, uint32_t BlockNum, SpscBlock_t *Slots, uint32_t SlotNum) {
+    if ((Pool == NULL) || (Mem == NULL)) {
+        return STAT_ERR_NULL;
+    }
+    if ((BlockSize == 0) || ((BlockSize & 3) != 0) || (BlockNum == 0) || (BlockNum > SlotNum)) {
+        return STAT_ERR_INVALID_SIZE;
+    }
+    DefaultRet_t ret = SpscRingInit(&Pool->Free, Slots, SlotNum);
+    if (ret != STAT_OKE) {
+        return ret;
+    }
+    Pool->Mem       = (uint8_t *) Mem;
+    Pool->BlockSize = BlockSize;
+    Pool->BlockNum  = BlockNum;
+    for (uint32_t i = 0; i < BlockNum; i++) {
+        SpscRingPush(&Pool->Free, Pool->Mem + i * BlockSize, BlockSize, 0, 0);
+    }
+    return STAT_OKE;
+}
@@ -0,0 +1,210 @@
+/// @file   SpscRing.h
+/// @brief  Lock-free single-producer / single-consumer ring of block descriptors and a fixed-size block pool.
+/// @details One context pushes, one other context pops; either may be an ISR or a task on
+///          either core. No lock, no malloc: the caller provides all memory.
+///          Head (written by the producer only) and Tail (written by the consumer only) live on
+///          separate cache lines. Each side also keeps a private copy of the other side's index
+///          on its own line and re-reads the shared one only when that copy says full / empty,
+///          so a busy ring costs about one shared cache line transfer per batch, not per block.
+///          Indexes run freely over 32 bits; Head - Tail is the fill level.
+///          The pool hands out fixed-size blocks from a preallocated array. Its free list is an
+///          SpscRing running the other way (the ring's consumer gives blocks back, its producer
+///          takes them), so a pool pairs with exactly one data ring and is lock-free too.
+///          The hot-path functions are static inline: they are compiled into the caller and
+///          run from IRAM when the caller does.
+
+#ifndef __APP_UTILS_SPSC_RING_H__
+#define __APP_UTILS_SPSC_RING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PRINT_HEADER_COMPILE_MESSAGE
+#pragma message ("AppUtils/SpscRing.h")
+#endif
+
+/// Fixed-width integer types (uint8_t, int32_t, etc.)
+#include <stdint.h>
+/// NULL
+#include <stddef.h>
+/// Standard atomic operations for thread safety
+#include <stdatomic.h>
+
+#include "./ReturnType.h"
+
+#ifndef APP_CACHE_LINE
+    /// @brief  Alignment separating producer and consumer data (ESP32-S3 data cache line is 32 bytes, hosts use 64).
+    #define APP_CACHE_LINE          64
+#endif
+
+/// @brief  Block descriptor carried by the ring.
+typedef struct SpscBlock_s {
+    void *      Data;       ///< Block memory (pool block or any buffer owned by the message)
+    uint32_t    Len;        ///< Bytes used in `Data`
+    uint16_t    Tag;        ///< Payload kind, defined by the users of the ring
+    uint16_t    Arg;        ///< Small payload-specific value (channel, command...)
+    uint32_t    Seq;        ///< Push number, set by SpscRingPush() (consecutive: a full ring refuses, never overwrites)
+} SpscBlock_t;
+
+/// @brief  SPSC ring. Place it in internal RAM; statics and stack variables honour its alignment.
+typedef struct SpscRing_s {
+    /* Producer line */
+    atomic_uint_fast32_t    Head __attribute__((aligned(APP_CACHE_LINE)));     ///< Next slot to fill
+    uint32_t                TailCache;      ///< Producer's copy of Tail
+    uint32_t                Refused;        ///< Pushes refused because the ring was full
+    /* Consumer line */
+    atomic_uint_fast32_t    Tail __attribute__((aligned(APP_CACHE_LINE)));     ///< Next slot to read
+    uint32_t                HeadCache;      ///< Consumer's copy of Head
+    /* Read-only after SpscRingInit() */
+    SpscBlock_t *           Slots __attribute__((aligned(APP_CACHE_LINE)));
+    uint32_t                Mask;           ///< Slots - 1
+} SpscRing_t;
+
+/// @brief  Fixed-size block pool, free list in an SpscRing.
+typedef struct SpscPool_s {
+    SpscRing_t  Free;       ///< Free blocks; the data ring's consumer puts, its producer gets
+    uint8_t *   Mem;        ///< BlockNum blocks of BlockSize bytes
+    uint32_t    BlockSize;
+    uint32_t    BlockNum;
+} SpscPool_t;
+
+/// @brief  Prepare an empty ring.
+/// @param  Ring Pointer to the ring.
+/// @param  Slots Descriptor array, `SlotNum` entries.
+/// @param  SlotNum Capacity (power of 2, 2 .. 2^31).
+/// @return STAT_OKE or Error Code.
+DefaultRet_t SpscRingInit(SpscRing_t *Ring, SpscBlock_t *Slots, uint32_t SlotNum);
+
+/// @brief  Empty the ring. Neither side may use it meanwhile.
+void SpscRingReset(SpscRing_t *Ring);
+
+/// @brief  Lay a pool out in `Mem`, all blocks free.
+/// @param  Pool Pointer to the pool.
+/// @param  Mem BlockNum * BlockSize bytes.
+/// @param  BlockSize Bytes per block (multiple of 4).
+/// @param  BlockNum Number of blocks.
+/// @param  Slots Free-list descriptors, `SlotNum` entries.
+/// @param  SlotNum Power of 2, at least `BlockNum`.
+/// @return STAT_OKE or Error Code.
+DefaultRet_t SpscPoolInit(SpscPool_t *Pool, void *Mem, uint32_t BlockSize, uint32_t BlockNum, SpscBlock_t *Slots, uint32_t SlotNum);
+
+/* --- PRODUCER SIDE --- */
+
+/// @brief  Free slots seen by the producer (refreshes its copy of Tail).
+static inline uint32_t SpscRingSpace(SpscRing_t *Ring) {
+    uint32_t head = (uint32_t) atomic_load_explicit(&Ring->Head, memory_order_relaxed);
+    Ring->TailCache = (uint32_t) atomic_load_explicit(&Ring->Tail, memory_order_acquire);
+    return Ring->Mask + 1 - (head - Ring->TailCache);
+}
+
+/// @brief  Append a descriptor (producer only).
+/// @param  Ring Pointer to the ring.
+/// @param  Data Block memory.
+/// @param  Len Bytes used.
+/// @param  Tag Payload kind.
+/// @param  Arg Payload-specific value.
+/// @return STAT_OKE, or STAT_ERR_OVERFLOW when the ring is full (counted in Refused).
+static inline DefaultRet_t SpscRingPush(SpscRing_t *Ring, void *Data, uint32_t Len, uint16_t Tag, uint16_t Arg) {
+    uint32_t head = (uint32_t) atomic_load_explicit(&Ring->Head, memory_order_relaxed);
+    if ((head - Ring->TailCache) > Ring->Mask) {
+        /// Looks full: the consumer may have moved since the last look
+        Ring->TailCache = (uint32_t) atomic_load_explicit(&Ring->Tail, memory_order_acquire);
+        if ((head - Ring->TailCache) > Ring->Mask) {
+            Ring->Refused++;
+            return STAT_ERR_OVERFLOW;
+        }
+    }
+    SpscBlock_t *slot = &Ring->Slots[head & Ring->Mask];
+    slot->Data = Data;
+    slot->Len  = Len;
+    slot->Tag  = Tag;
+    slot->Arg  = Arg;
+    slot->Seq  = head;
+    /// Release: the slot is written before the consumer can see the new Head
+    atomic_store_explicit(&Ring->Head, head + 1, memory_order_release);
+    return STAT_OKE;
+}
+
+/* --- CONSUMER SIDE --- */
+
+/// @brief  Descriptors waiting, seen by the consumer (refreshes its copy of Head).
+static inline uint32_t SpscRingCount(SpscRing_t *Ring) {
+    uint32_t tail = (uint32_t) atomic_load_explicit(&Ring->Tail, memory_order_relaxed);
+    Ring->HeadCache = (uint32_t) atomic_load_explicit(&Ring->Head, memory_order_acquire);
+    return Ring->HeadCache - tail;
+}
+
+/// @brief  Oldest descriptor, left in the ring (consumer only).
+/// @return Pointer to it, valid until SpscRingDrop(); NULL when empty.
+static inline const SpscBlock_t *SpscRingPeek(SpscRing_t *Ring) {
+    uint32_t tail = (uint32_t) atomic_load_explicit(&Ring->Tail, memory_order_relaxed);
+    if (tail == Ring->HeadCache) {
+        /// Looks empty: the producer may have moved since the last look
+        Ring->HeadCache = (uint32_t) atomic_load_explicit(&Ring->Head, memory_order_acquire);
+        if (tail == Ring->HeadCache) {
+            return NULL;
+        }
+    }
+    return &Ring->Slots[tail & Ring->Mask];
+}
+
+/// @brief  Remove the descriptor returned by SpscRingPeek() (consumer only).
+static inline void SpscRingDrop(SpscRing_t *Ring) {
+    uint32_t tail = (uint32_t) atomic_load_explicit(&Ring->Tail, memory_order_relaxed);
+    /// Release: the slot is read out before the producer may reuse it
+    atomic_store_explicit(&Ring->Tail, tail + 1, memory_order_release);
+}
+
+/// @brief  Take the oldest descriptor (consumer only).
+/// @param  Ring Pointer to the ring.
+/// @param  Out Copy of the descriptor.
+/// @return STAT_OKE, or STAT_ERR_UNDERFLOW when the ring is empty.
+static inline DefaultRet_t SpscRingPop(SpscRing_t *Ring, SpscBlock_t *Out) {
+    const SpscBlock_t *slot = SpscRingPeek(Ring);
+    if (slot == NULL) {
+        return STAT_ERR_UNDERFLOW;
+    }
+    *Out = *slot;
+    SpscRingDrop(Ring);
+    return STAT_OKE;
+}
+
+/* --- BLOCK POOL --- */
+
+/// @brief  Take a free block (the data ring's producer only).
+/// @return Block of BlockSize bytes, NULL when all are in use.
+static inline void *SpscPoolGet(SpscPool_t *Pool) {
+    const SpscBlock_t *slot = SpscRingPeek(&Pool->Free);
+    if (slot == NULL) {
+        return NULL;
+    }
+    void *block = slot->Data;
+    SpscRingDrop(&Pool->Free);
+    return block;
+}
+
+/// @brief  Give a block back (the data ring's consumer only).
+/// @return STAT_OKE, or STAT_ERR_INVALID_ARG when `Block` is not a block of this pool.
+static inline DefaultRet_t SpscPoolPut(SpscPool_t *Pool, void *Block) {
+    if ((Block == NULL) || ((uint8_t *) Block < Pool->Mem)) {
+        return STAT_ERR_INVALID_ARG;
+    }
+    uint32_t offset = (uint32_t) ((uint8_t *) Block - Pool->Mem);
+    if ((offset >= Pool->BlockSize * Pool->BlockNum) || ((offset % Pool->BlockSize) != 0)) {
+        return STAT_ERR_INVALID_ARG;
+    }
+    /// Cannot be full: the free ring has a slot for every block
+    return SpscRingPush(&Pool->Free, Block, Pool->BlockSize, 0, 0);
+}
+
+/// @brief  Free blocks, as seen by the getter.
+static inline uint32_t SpscPoolAvail(SpscPool_t *Pool) {
+    return SpscRingCount(&Pool->Free);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /// __APP_UTILS_SPSC_RING_H__
@@ -0,0 +1,42 @@
+/**
+ * @file HostP16.h
+ * @brief P16Com device on the host bus model, shared by the P16Com host tests
+ * @details The control pins are those of the analyzer board (AppConfig/DevicePinout.h);
+ *          the data pins are chosen by each test, so the compact and wide LUTs and every
+ *          read gather mode can be driven. Logs are recorded but never printed.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __HOST_P16_H__
+#define __HOST_P16_H__
+
+#include "HostTest.h"
+#include "HostGpio.h"
+#include "P16Com.h"
+
+#define HOST_P16_RST    0
+#define HOST_P16_WR     2
+#define HOST_P16_RD     14
+#define HOST_P16_RS     21
+#define HOST_P16_CS     13
+
+/// @brief Data pins of the analyzer board: bank 0, spread over three port bytes
+static const Pin_t HostP16BoardPins[16] = { 18, 12, 17, 11, 16, 10, 15, 9, 7, 3, 6, 20, 5, 19, 4, 8 };
+
+/// @brief Configure and initialize `Dev` on `DatPins`, with a fresh bus model
+static inline void HostP16Open(P16Dev_t * Dev, P16Lut_t * Lut, const Pin_t * DatPins){
+    /// P16Dev_t::CtlPinArr order: Read, Write, ChipSel, RegSel, Reset
+    static const Pin_t Ctl[P16COM_CTL_PIN_NUM] = { HOST_P16_RD, HOST_P16_WR, HOST_P16_CS, HOST_P16_RS, HOST_P16_RST };
+    HostQuiet = 1;
+    HostGpioReset(DatPins, HOST_P16_WR, HOST_P16_RD, HOST_P16_RS);
+    *Dev = (P16Dev_t) { 0 };
+    Dev->Backend = P16COM_BACKEND_BITBANG;
+    HostCheck(P16ComConfigCtl(Dev, Ctl) == STAT_OKE, "control pins refused");
+    HostCheck(P16ComConfigDat(Dev, DatPins, Lut) == STAT_OKE, "data pins refused");
+    HostCheck(P16ComInit(Dev) == STAT_OKE, "init failed");
+    /// Outputs on, strobes idle: the edges of the pins going up at init are not bus words
+    HostGpioSync();
+    HostBus.CapNum = 0;
+}
+
+#endif /// __HOST_P16_H__
@@ -0,0 +1,52 @@
+/**
+ * @file HostTest.h
+ * @brief Check and timing helpers shared by the host tests
+ * @details The host tests build the hardware-independent units with the host gcc (no
+ *          ESP-IDF) and run under ctest. Each test is one executable: checks print the
+ *          failing line and the test returns non-zero when any check failed.
+ * @author Nguyen Thanh Phu
+ */
+
+#ifndef __HOST_TEST_H__
+#define __HOST_TEST_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/// @brief Failed checks of the running test
+static uint32_t HostTestFails;
+
+/// @brief Count and print a failed condition
+#define HostCheck(cond, ...)        do { \
+                                        if(!(cond)){ \
+                                            HostTestFails++; \
+                                            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+                                            printf(__VA_ARGS__); \
+                                            printf("\n"); \
+                                        } \
+                                    } while(0)
+
+/// @brief Print the verdict, value to return from main()
+#define HostTestEnd(name)           (printf("%s: %s (%u failed checks)\n", (name), \
+                                            (HostTestFails == 0) ? "passed" : "FAILED", HostTestFails), \
+                                     (HostTestFails == 0) ? 0 : 1)
+
+/// @brief Monotonic time in ns, for the benchmarks
+static inline uint64_t HostNowNs(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/// @brief Small deterministic PRNG (xorshift32), same sequence on every host
+static inline uint32_t HostRand(uint32_t * State){
+    uint32_t x = *State;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *State = x;
+    return x;
+}
+
+#endif /// __HOST_TEST_H__
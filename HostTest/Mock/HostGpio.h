@@ -0,0 +1,45 @@
+/**
+ * @file HostGpio.h
+ * @brief Parallel bus model behind the host GPIO registers (soc/gpio_struct.h)
+ * @details The test names the bus pins. On each WR rising edge the word on the data pins is
+ *          latched into `Cap` (bit 16: RS level), on each RD falling edge the next word of
+ *          `Feed` is put on the data pins of the input registers. Register accesses and
+ *          latched words are counted, so the tests can check what the driver put on the
+ *          pins and how many stores it took. A read strobe while a data pin still has its
+ *          output enabled counts as bus contention.
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdint.h>
+#include "soc/gpio_struct.h"
+
+/// @brief Bit of a captured word carrying the RS level
+#define HOST_BUS_RS                 (1UL << 16)
+
+typedef struct HostBus_s {
+    int8_t          Dat[16];        ///< GPIO of D0..D15
+    int8_t          Wr, Rd, Rs;     ///< Strobe and register-select GPIOs
+    uint32_t *      Cap;            ///< Latched words, NULL: count only
+    uint32_t        CapMax;
+    uint32_t        CapNum;         ///< Words latched (also past CapMax)
+    const uint16_t *Feed;           ///< Words answered to RD strobes, in order
+    uint32_t        FeedNum;
+    uint32_t        FeedPos;        ///< Words answered so far
+    /// @brief Called on each WR rising edge after the capture (e.g. to play an ISR), may be NULL
+    void            (*OnWrite)(uint32_t Word);
+    uint32_t        Accesses;       ///< GPIO register accesses (loads and stores)
+    uint32_t        OeStores;       ///< Stores to the output-enable set / clear registers
+    uint32_t        Contention;     ///< RD strobes with a data pin output still enabled
+} HostBus_t;
+
+extern HostBus_t HostBus;
+
+/// @brief The registers themselves: a test may change them without going through the model
+///        (e.g. an OnWrite hook playing an ISR that drives another pin)
+extern gpio_dev_t HostGpioRegs;
+
+/// @brief Reset the registers (all pins low, outputs off) and the bus model
+void        HostGpioReset(const int8_t * Dat, int8_t Wr, int8_t Rd, int8_t Rs);
+
+/// @brief Commit the last store (the driver's final store is otherwise pending)
+void        HostGpioSync(void);
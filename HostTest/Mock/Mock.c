@@ -0,0 +1,343 @@
+/**
+ * @file Mock.c
+ * @brief Host implementations of the ESP-IDF / FreeRTOS calls the drivers make
+ * @details Single task, single core: semaphores and queues never wait, delays move the
+ *          test clock, allocations are malloc. GPIO registers are modelled in HostGpio.h.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "HostGpio.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_random.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "rom/ets_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+/* GPIO */
+
+HostBus_t HostBus;
+uint32_t HostGpioConfigCalls;
+
+gpio_dev_t HostGpioRegs;
+/// @brief Pin levels seen at the previous access
+static uint32_t PrevOut, PrevOut1;
+
+static inline uint32_t Level(uint32_t Lo, uint32_t Hi, int8_t Pin){
+    return (Pin < 0) ? 0 : (((Pin < 32) ? (Lo >> Pin) : (Hi >> (Pin - 32))) & 1);
+}
+
+/// @brief Apply the pending store, then play the strobe edges it made
+static void Commit(void){
+    HostBus.OeStores += (HostGpioRegs.enable_w1ts | HostGpioRegs.enable_w1tc |
+                         HostGpioRegs.enable1_w1ts.val | HostGpioRegs.enable1_w1tc.val) != 0;
+    HostGpioRegs.out = (HostGpioRegs.out | HostGpioRegs.out_w1ts) & ~HostGpioRegs.out_w1tc;
+    HostGpioRegs.out1.val = (HostGpioRegs.out1.val | HostGpioRegs.out1_w1ts.val) & ~HostGpioRegs.out1_w1tc.val;
+    HostGpioRegs.enable = (HostGpioRegs.enable | HostGpioRegs.enable_w1ts) & ~HostGpioRegs.enable_w1tc;
+    HostGpioRegs.enable1.val = (HostGpioRegs.enable1.val | HostGpioRegs.enable1_w1ts.val) & ~HostGpioRegs.enable1_w1tc.val;
+    HostGpioRegs.out_w1ts = HostGpioRegs.out_w1tc = HostGpioRegs.enable_w1ts = HostGpioRegs.enable_w1tc = 0;
+    HostGpioRegs.out1_w1ts.val = HostGpioRegs.out1_w1tc.val = HostGpioRegs.enable1_w1ts.val = HostGpioRegs.enable1_w1tc.val = 0;
+
+    if(!Level(PrevOut, PrevOut1, HostBus.Wr) && Level(HostGpioRegs.out, HostGpioRegs.out1.val, HostBus.Wr)){
+        uint32_t word = Level(HostGpioRegs.out, HostGpioRegs.out1.val, HostBus.Rs) ? HOST_BUS_RS : 0;
+        for(uint32_t i = 0; i < 16; i++){
+            word |= Level(HostGpioRegs.out, HostGpioRegs.out1.val, HostBus.Dat[i]) << i;
+        }
+        if((HostBus.Cap != NULL) && (HostBus.CapNum < HostBus.CapMax)){
+            HostBus.Cap[HostBus.CapNum] = word;
+        }
+        HostBus.CapNum++;
+        if(HostBus.OnWrite != NULL){
+            HostBus.OnWrite(word);
+        }
+    }
+    if(Level(PrevOut, PrevOut1, HostBus.Rd) && !Level(HostGpioRegs.out, HostGpioRegs.out1.val, HostBus.Rd)){
+        uint16_t word = (HostBus.FeedPos < HostBus.FeedNum) ? HostBus.Feed[HostBus.FeedPos] : 0;
+        HostBus.FeedPos++;
+        for(uint32_t i = 0; i < 16; i++){
+            int8_t pin = HostBus.Dat[i];
+            HostBus.Contention += Level(HostGpioRegs.enable, HostGpioRegs.enable1.val, pin);
+            uint32_t * reg = (pin < 32) ? &HostGpioRegs.in : &HostGpioRegs.in1.val;
+            uint32_t bit = 1UL << (pin & 31);
+            *reg = ((word >> i) & 1) ? (*reg | bit) : (*reg & ~bit);
+        }
+    }
+    PrevOut = HostGpioRegs.out;
+    PrevOut1 = HostGpioRegs.out1.val;
+}
+
+gpio_dev_t * HostGpio(void){
+    Commit();
+    HostBus.Accesses++;
+    return &HostGpioRegs;
+}
+
+void HostGpioReset(const int8_t * Dat, int8_t Wr, int8_t Rd, int8_t Rs){
+    memset(&HostGpioRegs, 0, sizeof(HostGpioRegs));
+    memset(&HostBus, 0, sizeof(HostBus));
+    memcpy(HostBus.Dat, Dat, sizeof(HostBus.Dat));
+    HostBus.Wr = Wr;
+    HostBus.Rd = Rd;
+    HostBus.Rs = Rs;
+    PrevOut = PrevOut1 = 0;
+}
+
+void HostGpioSync(void){
+    Commit();
+}
+
+/// @brief Output modes turn the drivers on, input turns them off
+esp_err_t gpio_config(const gpio_config_t * Cfg){
+    HostGpioConfigCalls++;
+    Commit();
+    uint32_t lo = (uint32_t) Cfg->pin_bit_mask, hi = (uint32_t) (Cfg->pin_bit_mask >> 32);
+    if(Cfg->mode & GPIO_MODE_OUTPUT){
+        HostGpioRegs.enable |= lo;
+        HostGpioRegs.enable1.val |= hi;
+    } else {
+        HostGpioRegs.enable &= ~lo;
+        HostGpioRegs.enable1.val &= ~hi;
+    }
+    return ESP_OK;
+}
+
+/* System */
+
+int64_t HostTimeUs;
+int HostQuiet;
+uint32_t HostPrinted;
+char HostLine[256];
+
+int64_t esp_timer_get_time(void){
+    return HostTimeUs;
+}
+
+void ets_delay_us(uint32_t Us){
+    (void) Us;
+}
+
+int ets_printf(const char * Fmt, ...){
+    HostPrinted++;
+    va_list ap;
+    va_start(ap, Fmt);
+    int n = vsnprintf(HostLine, sizeof(HostLine), Fmt, ap);
+    va_end(ap);
+    if(!HostQuiet){
+        fputs(HostLine, stdout);
+    }
+    return n;
+}
+
+const char * esp_err_to_name(esp_err_t Err){
+    return (Err == ESP_OK) ? "ESP_OK" : "ESP_ERR";
+}
+
+uint32_t esp_random(void){
+    return (uint32_t) rand();
+}
+
+size_t esp_get_free_heap_size(void){
+    return 0;
+}
+
+void * heap_caps_malloc(size_t Size, uint32_t Caps){
+    (void) Caps;
+    return malloc(Size);
+}
+
+void * heap_caps_calloc(size_t Num, size_t Size, uint32_t Caps){
+    (void) Caps;
+    return calloc(Num, Size);
+}
+
+void * heap_caps_aligned_alloc(size_t Align, size_t Size, uint32_t Caps){
+    (void) Caps;
+    return aligned_alloc(Align, (Size + Align - 1) / Align * Align);
+}
+
+size_t heap_caps_get_free_size(uint32_t Caps){
+    (void) Caps;
+    return 0;
+}
+
+void heap_caps_free(void * Ptr){
+    free(Ptr);
+}
+
+bool esp_ptr_in_drom(const void * Ptr){
+    (void) Ptr;
+    return false;
+}
+
+bool esp_ptr_internal(const void * Ptr){
+    (void) Ptr;
+    return true;
+}
+
+bool esp_ptr_external_ram(const void * Ptr){
+    (void) Ptr;
+    return false;
+}
+
+/* FreeRTOS */
+
+BaseType_t xPortGetCoreID(void){
+    return 0;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t Fn, const char * Name, uint32_t Stack, void * Arg, UBaseType_t Prio, TaskHandle_t * Handle, BaseType_t Core){
+    (void) Fn; (void) Name; (void) Stack; (void) Arg; (void) Prio; (void) Core;
+    if(Handle != NULL){
+        *Handle = NULL;
+    }
+    return pdFALSE;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t Fn, const char * Name, uint32_t Stack, void * Arg, UBaseType_t Prio, TaskHandle_t * Handle){
+    return xTaskCreatePinnedToCore(Fn, Name, Stack, Arg, Prio, Handle, 0);
+}
+
+void vTaskDelete(TaskHandle_t Task){
+    (void) Task;
+}
+
+void vTaskDelay(TickType_t Ticks){
+    HostTimeUs += (int64_t) Ticks * (1000000 / configTICK_RATE_HZ);
+}
+
+void taskYIELD(void){
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t Clear, TickType_t Ticks){
+    (void) Clear; (void) Ticks;
+    return 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t Task){
+    (void) Task;
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void){
+    return NULL;
+}
+
+/// @brief Semaphore: a count and its ceiling
+typedef struct HostSem_s {
+    UBaseType_t Count, Max;
+} HostSem_t;
+
+static SemaphoreHandle_t SemNew(UBaseType_t Max, UBaseType_t Init){
+    HostSem_t * sem = (HostSem_t *) malloc(sizeof(HostSem_t));
+    if(sem != NULL){
+        sem->Count = Init;
+        sem->Max = Max;
+    }
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void){
+    return SemNew(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void){
+    return SemNew(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t Max, UBaseType_t Init){
+    return SemNew(Max, Init);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t Sem, TickType_t Ticks){
+    (void) Ticks;
+    HostSem_t * sem = (HostSem_t *) Sem;
+    if(sem->Count == 0){
+        return pdFALSE;
+    }
+    sem->Count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t Sem){
+    HostSem_t * sem = (HostSem_t *) Sem;
+    if(sem->Count >= sem->Max){
+        return pdFALSE;
+    }
+    sem->Count++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t Sem, BaseType_t * Woken){
+    if(Woken != NULL){
+        *Woken = pdFALSE;
+    }
+    return xSemaphoreGive(Sem);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t Sem){
+    free(Sem);
+}
+
+/// @brief Queue: ring of fixed-size items
+typedef struct HostQueue_s {
+    UBaseType_t Len, Size, Head, Num;
+    uint8_t     Items[];
+} HostQueue_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t Len, UBaseType_t ItemSize){
+    HostQueue_t * q = (HostQueue_t *) calloc(1, sizeof(HostQueue_t) + (size_t) Len * ItemSize);
+    if(q != NULL){
+        q->Len = Len;
+        q->Size = ItemSize;
+    }
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t Queue, const void * Item, TickType_t Ticks){
+    (void) Ticks;
+    HostQueue_t * q = (HostQueue_t *) Queue;
+    if(q->Num == q->Len){
+        return pdFALSE;
+    }
+    memcpy(&q->Items[((q->Head + q->Num) % q->Len) * q->Size], Item, q->Size);
+    q->Num++;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t Queue, void * Item, TickType_t Ticks){
+    (void) Ticks;
+    HostQueue_t * q = (HostQueue_t *) Queue;
+    if(q->Num == 0){
+        return pdFALSE;
+    }
+    memcpy(Item, &q->Items[q->Head * q->Size], q->Size);
+    q->Head = (q->Head + 1) % q->Len;
+    q->Num--;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t Queue){
+    HostQueue_t * q = (HostQueue_t *) Queue;
+    q->Head = q->Num = 0;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t Queue){
+    return ((HostQueue_t *) Queue)->Num;
+}
+
+void vQueueDelete(QueueHandle_t Queue){
+    free(Queue);
+}
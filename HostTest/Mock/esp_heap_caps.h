@@ -0,0 +1,17 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Host stand-in: every capability is plain malloc
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#define MALLOC_CAP_DMA              (1 << 3)
+#define MALLOC_CAP_8BIT             (1 << 2)
+#define MALLOC_CAP_SPIRAM           (1 << 10)
+#define MALLOC_CAP_INTERNAL         (1 << 11)
+void *  heap_caps_malloc(size_t Size, uint32_t Caps);
+void *  heap_caps_calloc(size_t Num, size_t Size, uint32_t Caps);
+void *  heap_caps_aligned_alloc(size_t Align, size_t Size, uint32_t Caps);
+size_t  heap_caps_get_free_size(uint32_t Caps);
+void    heap_caps_free(void * Ptr);
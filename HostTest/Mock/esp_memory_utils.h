@@ -0,0 +1,10 @@
+/**
+ * @file esp_memory_utils.h
+ * @brief Host stand-in: nothing is in flash, log strings are always copied
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdbool.h>
+bool esp_ptr_in_drom(const void * Ptr);
+bool esp_ptr_internal(const void * Ptr);
+bool esp_ptr_external_ram(const void * Ptr);
@@ -0,0 +1,8 @@
+/**
+ * @file esp_random.h
+ * @brief Host stand-in for the ESP-IDF header of the same name (host tests only)
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdint.h>
+uint32_t esp_random(void);
@@ -0,0 +1,8 @@
+/**
+ * @file esp_system.h
+ * @brief Host stand-in for the ESP-IDF header of the same name (host tests only)
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stddef.h>
+size_t esp_get_free_heap_size(void);
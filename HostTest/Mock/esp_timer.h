@@ -0,0 +1,10 @@
+/**
+ * @file esp_timer.h
+ * @brief Host stand-in: time in microseconds, driven by the test (HostTimeUs)
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdint.h>
+/// @brief Value returned by esp_timer_get_time(); tests move it to run rate limits
+extern int64_t HostTimeUs;
+int64_t esp_timer_get_time(void);
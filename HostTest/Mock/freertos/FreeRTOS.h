@@ -0,0 +1,34 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host stand-in: one task, one core, no preemption
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+/// The IDF port headers bring the heap API in with FreeRTOS.h, the drivers rely on it
+#include "esp_heap_caps.h"
+typedef int         BaseType_t;
+typedef unsigned    UBaseType_t;
+typedef uint32_t    TickType_t;
+typedef struct { int Unused; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED            { 0 }
+#define portMAX_DELAY                           0xFFFFFFFFU
+#define portNUM_PROCESSORS                      2
+#define configTICK_RATE_HZ                      1000
+#define pdTRUE                                  1
+#define pdFALSE                                 0
+#define pdPASS                                  1
+#define pdMS_TO_TICKS(ms)                       ((TickType_t) (ms))
+#define portENTER_CRITICAL(m)                   (void) (m)
+#define portEXIT_CRITICAL(m)                    (void) (m)
+#define portENTER_CRITICAL_ISR(m)               (void) (m)
+#define portEXIT_CRITICAL_ISR(m)                (void) (m)
+#define taskENTER_CRITICAL(m)                   (void) (m)
+#define taskEXIT_CRITICAL(m)                    (void) (m)
+#define portSET_INTERRUPT_MASK_FROM_ISR()       0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(s)    (void) (s)
+#define portYIELD_FROM_ISR(...)                 do { } while(0)
+#define IRAM_ATTR
+#define DRAM_ATTR
+BaseType_t xPortGetCoreID(void);
@@ -0,0 +1,14 @@
+/**
+ * @file queue.h
+ * @brief Host stand-in: fixed-size item queues without waiting
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include "FreeRTOS.h"
+typedef void * QueueHandle_t;
+QueueHandle_t xQueueCreate(UBaseType_t Len, UBaseType_t ItemSize);
+BaseType_t    xQueueSend(QueueHandle_t Queue, const void * Item, TickType_t Ticks);
+BaseType_t    xQueueReceive(QueueHandle_t Queue, void * Item, TickType_t Ticks);
+BaseType_t    xQueueReset(QueueHandle_t Queue);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t Queue);
+void          vQueueDelete(QueueHandle_t Queue);
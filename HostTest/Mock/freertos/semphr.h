@@ -0,0 +1,16 @@
+/**
+ * @file semphr.h
+ * @brief Host stand-in: counting semaphores without waiting (a take that would block fails)
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include "FreeRTOS.h"
+#include "queue.h"
+typedef void * SemaphoreHandle_t;
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t Max, UBaseType_t Init);
+BaseType_t        xSemaphoreTake(SemaphoreHandle_t Sem, TickType_t Ticks);
+BaseType_t        xSemaphoreGive(SemaphoreHandle_t Sem);
+BaseType_t        xSemaphoreGiveFromISR(SemaphoreHandle_t Sem, BaseType_t * Woken);
+void              vSemaphoreDelete(SemaphoreHandle_t Sem);
@@ -0,0 +1,17 @@
+/**
+ * @file task.h
+ * @brief Host stand-in: vTaskDelay() moves HostTimeUs, tasks are not created
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include "FreeRTOS.h"
+typedef void * TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+BaseType_t   xTaskCreatePinnedToCore(TaskFunction_t Fn, const char * Name, uint32_t Stack, void * Arg, UBaseType_t Prio, TaskHandle_t * Handle, BaseType_t Core);
+BaseType_t   xTaskCreate(TaskFunction_t Fn, const char * Name, uint32_t Stack, void * Arg, UBaseType_t Prio, TaskHandle_t * Handle);
+void         vTaskDelete(TaskHandle_t Task);
+void         vTaskDelay(TickType_t Ticks);
+void         taskYIELD(void);
+uint32_t     ulTaskNotifyTake(BaseType_t Clear, TickType_t Ticks);
+BaseType_t   xTaskNotifyGive(TaskHandle_t Task);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
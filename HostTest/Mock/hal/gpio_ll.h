@@ -0,0 +1,6 @@
+/**
+ * @file gpio_ll.h
+ * @brief Host stand-in for the ESP-IDF header of the same name (nothing used)
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
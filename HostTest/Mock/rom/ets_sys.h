@@ -0,0 +1,14 @@
+/**
+ * @file ets_sys.h
+ * @brief Host stand-in: ets_printf goes to stdout unless HostQuiet, delays cost nothing
+ * @details The text of the last ets_printf() call is kept in HostLine.
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdint.h>
+/// @brief Non-zero: ets_printf() output is counted (HostPrinted) but not printed
+extern int HostQuiet;
+extern uint32_t HostPrinted;
+extern char HostLine[256];
+int  ets_printf(const char * Fmt, ...);
+void ets_delay_us(uint32_t Us);
@@ -0,0 +1,26 @@
+/**
+ * @file gpio_struct.h
+ * @brief Host stand-in for the GPIO register block, backed by the bus model of HostGpio.h
+ * @details `GPIO` is a call: every register access of the driver macros goes through
+ *          HostGpio(), which first commits the previous store (w1ts / w1tc into out and
+ *          enable) and then returns the block. Each access is counted, and the bus model
+ *          sees every pin edge in the order the hardware would.
+ * @author Nguyen Thanh Phu
+ */
+#pragma once
+#include <stdint.h>
+
+typedef struct { uint32_t val; } HostReg_t;
+
+typedef struct {
+    uint32_t    out, out_w1ts, out_w1tc;
+    HostReg_t   out1, out1_w1ts, out1_w1tc;
+    uint32_t    enable, enable_w1ts, enable_w1tc;
+    HostReg_t   enable1, enable1_w1ts, enable1_w1tc;
+    uint32_t    in;
+    HostReg_t   in1;
+} gpio_dev_t;
+
+gpio_dev_t * HostGpio(void);
+
+#define GPIO                        (*HostGpio())
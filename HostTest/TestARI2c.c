@@ -0,0 +1,211 @@
+/**
+ * @file TestARI2c.c
+ * @brief Host test of ARI2c: events of scripted transfers and the glitch filter
+ * @details Transfers (restart, NACK, clock stretching, a byte cut short, clocks without a
+ *          START) are built with the ARI2cSynth helpers and decoded in random-sized chunks.
+ *          Spikes shorter than MinPulse are then injected on stable stretches of both lines:
+ *          the events must not change and every spike must be counted as a glitch.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARI2c.h"
+
+#define CH_SCL          3
+#define CH_SDA          11
+#define HALF            8
+#define MIN_PULSE       3
+#define STRETCH         20
+#define CAP             8192
+#define EV_MAX          64
+
+static ARSample_t Clean[CAP];
+static ARSample_t Noisy[CAP];
+
+/// @brief Decoded events
+typedef struct Log_s {
+    ARI2cEvent_t    Ev[EV_MAX];
+    uint32_t        Num;
+} Log_t;
+
+/// @brief Expected event: kind, value, ACK, R/W or error code
+typedef struct Exp_s {
+    uint32_t    Kind;
+    uint32_t    Value;
+    uint32_t    Ack;
+    uint32_t    Rw;
+    uint32_t    Error;
+} Exp_t;
+
+static const Exp_t Expected[] = {
+    { AR_I2C_EV_START,   0,    0, 0, 0 },
+    { AR_I2C_EV_ADDRESS, 0x50, 1, 0, 0 },
+    { AR_I2C_EV_DATA,    0xA5, 1, 0, 0 },
+    { AR_I2C_EV_DATA,    0x3C, 0, 0, 0 },
+    { AR_I2C_EV_STOP,    0,    0, 0, 0 },
+
+    { AR_I2C_EV_START,   0,    0, 0, 0 },
+    { AR_I2C_EV_ADDRESS, 0x68, 1, 0, 0 },
+    { AR_I2C_EV_DATA,    0x75, 1, 0, 0 },
+    { AR_I2C_EV_STRETCH, 0,    0, 0, 0 },
+    { AR_I2C_EV_RESTART, 0,    0, 0, 0 },
+    { AR_I2C_EV_ADDRESS, 0x68, 1, 1, 0 },
+    { AR_I2C_EV_DATA,    0x71, 1, 0, 0 },
+    { AR_I2C_EV_DATA,    0x00, 0, 0, 0 },
+    { AR_I2C_EV_STOP,    0,    0, 0, 0 },
+
+    { AR_I2C_EV_START,   0,    0, 0, 0 },
+    { AR_I2C_EV_ADDRESS, 0x22, 1, 0, 0 },
+    { AR_I2C_EV_ERROR,   0,    0, 0, AR_I2C_ERR_PARTIAL_BYTE },
+    { AR_I2C_EV_STOP,    0,    0, 0, 0 },
+
+    { AR_I2C_EV_ERROR,   0,    0, 0, AR_I2C_ERR_NO_START },
+};
+#define EXP_NUM         (sizeof(Expected) / sizeof(Expected[0]))
+
+static void OnEvent(void * Arg, const ARI2cEvent_t * Ev){
+    Log_t * log = (Log_t *) Arg;
+    if(log->Num < EV_MAX){
+        log->Ev[log->Num] = *Ev;
+    }
+    log->Num++;
+}
+
+/// @brief The scripted transfers
+static uint32_t BuildCapture(const ARI2cConfig_t * Cfg){
+    ARI2cSynth_t syn;
+    ARI2cSynthInit(&syn, Cfg, Clean, CAP, HALF);
+
+    ARI2cSynthStart(&syn);
+    ARI2cSynthByte(&syn, 0x50 << 1, 1);
+    ARI2cSynthByte(&syn, 0xA5, 1);
+    ARI2cSynthByte(&syn, 0x3C, 0);
+    ARI2cSynthStop(&syn);
+
+    /// Register read: write the index, stretch, repeated START, read two bytes
+    ARI2cSynthStart(&syn);
+    ARI2cSynthByte(&syn, 0x68 << 1, 1);
+    ARI2cSynthByte(&syn, 0x75, 1);
+    ARI2cSynthHold(&syn, 2 * STRETCH);
+    ARI2cSynthStart(&syn);
+    ARI2cSynthByte(&syn, (0x68 << 1) | 1, 1);
+    ARI2cSynthByte(&syn, 0x71, 1);
+    ARI2cSynthByte(&syn, 0x00, 0);
+    ARI2cSynthStop(&syn);
+
+    /// Three bits, then STOP
+    ARI2cSynthStart(&syn);
+    ARI2cSynthByte(&syn, 0x22 << 1, 1);
+    ARI2cSynthBits(&syn, 0x5, 3);
+    ARI2cSynthStop(&syn);
+
+    /// Clock pulses with SDA high and no START
+    syn.Scl = 0;
+    ARI2cSynthHold(&syn, HALF);
+    ARI2cSynthBits(&syn, 0xF, 4);
+    syn.Scl = 1;
+    ARI2cSynthHold(&syn, 4 * HALF);
+
+    HostCheck( !syn.Overflow, "capture does not fit");
+    return syn.Len;
+}
+
+/// @brief Decode in chunks of random size
+static void Decode(ARI2c_t * Dec, const ARSample_t * Cap, uint32_t Len, uint32_t * Seed){
+    uint32_t done = 0;
+    while(done < Len){
+        uint32_t num = 1 + HostRand(Seed) % 61;
+        if(num > Len - done){
+            num = Len - done;
+        }
+        ARI2cDecode(Dec, &Cap[done], num);
+        done += num;
+    }
+}
+
+/// @brief Decoded events against the script
+static void CheckEvents(const char * Name, const Log_t * Log){
+    HostCheck(Log->Num == EXP_NUM, "%s: %u events, expected %u", Name, Log->Num, (uint32_t) EXP_NUM);
+    for(uint32_t i = 0; (i < Log->Num) && (i < EXP_NUM) && (i < EV_MAX); i++){
+        const ARI2cEvent_t * ev = &(Log->Ev[i]);
+        const Exp_t * exp = &Expected[i];
+        uint32_t ok = (ev->Kind == exp->Kind);
+        if(ok && ((ev->Kind == AR_I2C_EV_ADDRESS) || (ev->Kind == AR_I2C_EV_DATA))){
+            ok = (ev->Value == exp->Value) && (ev->Ack == exp->Ack) && (ev->Rw == exp->Rw);
+        }
+        if(ok && (ev->Kind == AR_I2C_EV_ERROR)){
+            ok = (ev->Error == exp->Error);
+        }
+        if(ok && (ev->Kind == AR_I2C_EV_STRETCH)){
+            ok = (ev->Duration >= 2 * STRETCH);
+        }
+        HostCheck(ok, "%s, event %u: kind %u value 0x%02x ack %u rw %u error %u, expected kind %u value 0x%02x",
+                  Name, i, ev->Kind, ev->Value, ev->Ack, ev->Rw, ev->Error, exp->Kind, exp->Value);
+    }
+}
+
+/// @brief Spikes of 1..MinPulse-1 samples where neither line moves for a while
+static uint32_t InjectGlitches(const ARI2cConfig_t * Cfg, uint32_t Len, uint32_t * Seed){
+    memcpy(Noisy, Clean, Len * sizeof(ARSample_t));
+    uint32_t num = 0;
+    uint32_t margin = MIN_PULSE + 2;
+    for(uint32_t i = margin; i + 2 * margin < Len; ){
+        uint32_t stable = 1;
+        for(uint32_t k = i - margin; k < i + 2 * margin; k++){
+            stable &= (Clean[k] == Clean[i]);
+        }
+        if( !stable || (HostRand(Seed) % 4)){
+            i++;
+            continue;
+        }
+        ARSample_t line = (HostRand(Seed) & 1) ? (ARSample_t) (1U << Cfg->ChScl) : (ARSample_t) (1U << Cfg->ChSda);
+        uint32_t width = 1 + HostRand(Seed) % (MIN_PULSE - 1);
+        for(uint32_t k = 0; k < width; k++){
+            Noisy[i + k] ^= line;
+        }
+        num++;
+        i += 2 * margin;
+    }
+    return num;
+}
+
+int main(void){
+    static Log_t log;
+    ARI2cConfig_t cfg;
+    ARI2c_t dec;
+    uint32_t seed = 0x12C;
+
+    ARI2cDefaultConfig(&cfg);
+    cfg.ChScl          = CH_SCL;
+    cfg.ChSda          = CH_SDA;
+    cfg.MinPulse       = MIN_PULSE;
+    cfg.StretchSamples = STRETCH;
+    uint32_t len = BuildCapture(&cfg);
+
+    memset(&log, 0, sizeof(log));
+    HostCheck(ARI2cInit(&dec, &cfg, OnEvent, &log) == STAT_OKE, "init");
+    Decode(&dec, Clean, len, &seed);
+    CheckEvents("clean", &log);
+    HostCheck(dec.Glitches == 0, "clean: %u glitches", dec.Glitches);
+    HostCheck(dec.Bytes == 9, "clean: %u bytes", dec.Bytes);
+
+    /// Same events from the spiky capture, every spike counted
+    for(uint32_t round = 0; round < 20; round++){
+        uint32_t spikes = InjectGlitches(&cfg, len, &seed);
+        memset(&log, 0, sizeof(log));
+        ARI2cInit(&dec, &cfg, OnEvent, &log);
+        Decode(&dec, Noisy, len, &seed);
+        CheckEvents("spiky", &log);
+        HostCheck(dec.Glitches == spikes, "round %u: %u glitches counted, %u injected", round, dec.Glitches, spikes);
+    }
+
+    /// Without the filter the same spikes break the decode
+    cfg.MinPulse = 1;
+    memset(&log, 0, sizeof(log));
+    ARI2cInit(&dec, &cfg, OnEvent, &log);
+    Decode(&dec, Noisy, len, &seed);
+    HostCheck((log.Num != EXP_NUM) || (dec.Errors > 2), "spikes went unnoticed without the filter");
+    return HostTestEnd("TestARI2c");
+}
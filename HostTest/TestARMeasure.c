@@ -0,0 +1,104 @@
+/**
+ * @file TestARMeasure.c
+ * @brief Host test of ARMeasure: signals sitting exactly on the 10 / 90 % levels
+ * @details A constant input on a level and a staircase dwelling on every level used to
+ *          divide 0 by 0 when the edge state machine interpolated a flat step.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARMeasure.h"
+
+#define FRAME_HZ        1000000
+#define FULL_SCALE_MV   3300
+#define DWELL           4
+#define WINDOW          4096
+
+/// @brief Levels of a 0..1000 swing: 10 % = 100, 50 % = 500, 90 % = 900
+static const uint16_t Steps[] = { 0, 100, 500, 900, 1000, 900, 500, 100 };
+#define STEP_NUM        (sizeof(Steps) / sizeof(Steps[0]))
+#define PERIOD          (STEP_NUM * DWELL)
+
+/// @brief Staircase holding every step for DWELL frames, from frame `Start`
+static void Staircase(uint16_t * Out, uint32_t Num, uint32_t Start){
+    for(uint32_t i = 0; i < Num; i++){
+        Out[i] = Steps[((Start + i) % PERIOD) / DWELL];
+    }
+}
+
+/// @brief One window of staircase sets the levels of the next
+static void SetLevels(ARMeasure_t * Meas, uint16_t * Buf){
+    ARMeasResult_t res;
+    ARMeasureInit(Meas, FRAME_HZ, FULL_SCALE_MV);
+    Staircase(Buf, WINDOW, 0);
+    ARMeasureFeed(Meas, Buf, WINDOW);
+    ARMeasureFinish(Meas, &res);
+    HostCheck((Meas->Lo == 100) && (Meas->Mid == 500) && (Meas->Hi == 900),
+              "levels %d %d %d", Meas->Lo, Meas->Mid, Meas->Hi);
+}
+
+/// @brief Land exactly on a level, then stay there
+static void TestConstant(uint16_t Level, uint16_t Other){
+    static uint16_t buf[WINDOW];
+    ARMeasure_t meas;
+    ARMeasResult_t res;
+    SetLevels(&meas, buf);
+
+    /// One full swing ending on the level, then a flat line on it
+    for(uint32_t i = 0; i < WINDOW; i++){
+        buf[i] = (i < 64) ? Other : Level;
+    }
+    buf[0] = 0;
+    buf[1] = 1000;
+    ARMeasureFeed(&meas, buf, WINDOW);
+    ARMeasureFinish(&meas, &res);
+    HostCheck(res.Valid & AR_MEAS_HAS_LEVELS, "constant %u: no levels", Level);
+
+    /// The flat line alone, levels kept from the swing
+    meas.Lo = 100; meas.Mid = 500; meas.Hi = 900; meas.HasLevels = 1;
+    for(uint32_t i = 0; i < WINDOW; i++){
+        buf[i] = Level;
+    }
+    ARMeasureFeed(&meas, buf, WINDOW);
+    ARMeasureFinish(&meas, &res);
+    HostCheck(res.VminMv == res.VmaxMv, "constant %u: Vpp %d", Level, res.VppMv);
+}
+
+/// @brief Staircase dwelling on each level: exact period, duty and edge times
+static void TestStaircase(void){
+    static uint16_t buf[WINDOW];
+    ARMeasure_t meas;
+    ARMeasResult_t res;
+    SetLevels(&meas, buf);
+
+    /// Fed in odd-sized blocks so flat steps straddle block boundaries
+    uint32_t done = 0;
+    while(done < WINDOW){
+        uint32_t num = (WINDOW - done < 37) ? WINDOW - done : 37;
+        Staircase(buf, num, WINDOW + done);
+        ARMeasureFeed(&meas, buf, num);
+        done += num;
+    }
+    ARMeasureFinish(&meas, &res);
+
+    uint64_t periodNs = (uint64_t) PERIOD * 1000000000ULL / FRAME_HZ;
+    HostCheck(res.Valid & AR_MEAS_HAS_PERIOD, "staircase: no period (valid 0x%x)", res.Valid);
+    HostCheck(res.PeriodNs == periodNs, "staircase: period %llu ns, expected %llu",
+              (unsigned long long) res.PeriodNs, (unsigned long long) periodNs);
+    /// 500 -> 500 one half-period later: 50 %
+    HostCheck(res.DutyPermille == 500, "staircase: duty %u", res.DutyPermille);
+    /// 10 % left at the 100 -> 500 step, 90 % reached at the 500 -> 900 step
+    uint32_t edgeNs = (uint32_t) ((2 * DWELL - 1) * 1000000000ULL / FRAME_HZ);
+    HostCheck(res.RiseNs <= edgeNs + 1000 && res.RiseNs > 0, "staircase: rise %u ns", res.RiseNs);
+    HostCheck(res.FallNs <= edgeNs + 1000 && res.FallNs > 0, "staircase: fall %u ns", res.FallNs);
+}
+
+int main(void){
+    TestConstant(100, 1000);    ///< Falls onto 10 %, stays in LOW on the level
+    TestConstant(900, 0);       ///< Rises onto 90 %, stays in HIGH on the level
+    TestConstant(500, 0);
+    TestStaircase();
+    return HostTestEnd("TestARMeasure");
+}
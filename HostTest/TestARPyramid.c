@@ -0,0 +1,193 @@
+/**
+ * @file TestARPyramid.c
+ * @brief Host test of ARPyramid: range min/max against brute force, plus column timings
+ * @details A stream four times the raw buffer is appended in random-sized pieces; random
+ *          ranges (clipped ones included) and screen columns must give the AND / OR of the
+ *          samples they cover. Feeding from a lapped ring must restart at the oldest intact
+ *          block. The time of a 320-column zoom-out over a deep capture is printed against
+ *          the plain scan.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "HostTest.h"
+#include "ARSynth.h"
+#include "ARPyramid.h"
+
+#define RAW_CAP         (1 << 16)
+#define STREAM          (4 * RAW_CAP)
+#define COLS            320
+/// @brief Samples of the capture the zoom-out is timed on
+#define BENCH_CAP       (1 << 23)
+
+static ARSample_t Stream[STREAM];
+static ARSample_t Raw[RAW_CAP];
+
+/// @brief AND / OR of stream samples [From, To)
+static ARPyrNode_t Brute(uint64_t From, uint64_t To){
+    ARPyrNode_t node = { .And = 0xFFFF, .Or = 0 };
+    for(uint64_t t = From; t < To; t++){
+        node.And &= Stream[t];
+        node.Or  |= Stream[t];
+    }
+    return node;
+}
+
+static uint32_t Same(ARPyrNode_t A, ARPyrNode_t B){
+    return (A.And == B.And) && (A.Or == B.Or);
+}
+
+/// @brief Random ranges, clipped to what the pyramid still covers
+static void CheckRanges(const ARPyr_t * Pyr, uint32_t * Seed, uint32_t Num){
+    uint64_t oldest = ARPyrOldest(Pyr);
+    uint64_t total = Pyr->Total;
+    HostCheck(oldest + RAW_CAP >= total, "oldest %llu, total %llu: raw samples overwritten",
+              (unsigned long long) oldest, (unsigned long long) total);
+    for(uint32_t q = 0; q < Num; q++){
+        /// Spans from a few samples to the whole buffer, some sticking out on either side
+        uint64_t span = 1 + HostRand(Seed) % ((HostRand(Seed) & 1) ? 100 : RAW_CAP);
+        uint64_t from = oldest + HostRand(Seed) % (total - oldest + 1);
+        from = (from > 50) ? from - 50 : 0;
+        uint64_t to = from + span;
+        uint64_t cf = (from < oldest) ? oldest : from;
+        uint64_t ct = (to > total) ? total : to;
+        ARPyrNode_t got = ARPyrRange(Pyr, from, to);
+        ARPyrNode_t exp = (cf < ct) ? Brute(cf, ct) : (ARPyrNode_t) { .And = 0xFFFF, .Or = 0 };
+        HostCheck(Same(got, exp), "[%llu, %llu): %04x/%04x, brute force %04x/%04x",
+                  (unsigned long long) from, (unsigned long long) to, got.And, got.Or, exp.And, exp.Or);
+    }
+}
+
+/// @brief Every screen column against brute force
+static void CheckColumns(const ARPyr_t * Pyr, uint64_t From, uint64_t To){
+    static ARPyrNode_t cols[COLS];
+    ARPyrColumns(Pyr, From, To, cols, COLS);
+    uint64_t span = To - From;
+    for(uint32_t c = 0; c < COLS; c++){
+        uint64_t a = From + span * c / COLS;
+        uint64_t b = From + span * (c + 1) / COLS;
+        a = (a < ARPyrOldest(Pyr)) ? ARPyrOldest(Pyr) : a;
+        b = (b > Pyr->Total) ? Pyr->Total : b;
+        ARPyrNode_t exp = (a < b) ? Brute(a, b) : (ARPyrNode_t) { .And = 0xFFFF, .Or = 0 };
+        HostCheck(Same(cols[c], exp), "column %u of [%llu, %llu)", c,
+                  (unsigned long long) From, (unsigned long long) To);
+    }
+}
+
+/// @brief Stream appended in random pieces through the circular raw buffer
+static void TestAppend(void * Mem, uint32_t Bytes){
+    ARPyr_t pyr;
+    uint32_t seed = 0x9A11;
+    HostCheck(ARPyrInit(&pyr, Mem, Bytes, Raw, RAW_CAP) == STAT_OKE, "init");
+
+    uint32_t done = 0;
+    while(done < STREAM){
+        /// At most a quarter of the buffer per piece, so the guard keeps the rest readable
+        uint32_t num = 1 + HostRand(&seed) % (RAW_CAP / 4);
+        if(num > STREAM - done){
+            num = STREAM - done;
+        }
+        for(uint32_t i = 0; i < num; i++){
+            Raw[(done + i) % RAW_CAP] = Stream[done + i];
+        }
+        ARPyrAppend(&pyr, num);
+        done += num;
+        CheckRanges(&pyr, &seed, 200);
+    }
+    HostCheck(pyr.Total == STREAM, "total %llu", (unsigned long long) pyr.Total);
+
+    uint64_t oldest = ARPyrOldest(&pyr);
+    CheckColumns(&pyr, oldest, STREAM);
+    CheckColumns(&pyr, STREAM - 1000, STREAM);
+    CheckColumns(&pyr, STREAM - 100, STREAM);          ///< Fewer samples than columns
+    CheckColumns(&pyr, oldest - 5000, STREAM + 5000);  ///< Both ends outside
+}
+
+/// @brief Zoomed-out view of a deep capture: columns from the pyramid against the plain scan
+static void BenchColumns(void){
+    static ARPyrNode_t cols[COLS];
+    uint32_t cap = BENCH_CAP;
+    ARSample_t * raw = malloc(cap * sizeof(ARSample_t));
+    uint32_t bytes = ARPyrBytes(cap);
+    void * mem = malloc(bytes);
+    ARPyr_t pyr;
+    ARSynth_t synth;
+    ARSynthInit(&synth, 0x5);
+    ARSynthSetRandom(&synth, 0, 300);
+    ARSynthSetRandom(&synth, 1, 20000);
+    ARSynthFill(&synth, raw, cap);
+    ARPyrInit(&pyr, mem, bytes, raw, cap);
+    ARPyrAppend(&pyr, cap);
+
+    uint64_t from = ARPyrOldest(&pyr);
+    uint64_t span = pyr.Total - from;
+    uint64_t t0 = HostNowNs();
+    for(uint32_t r = 0; r < 10; r++){
+        ARPyrColumns(&pyr, from, pyr.Total, cols, COLS);
+    }
+    uint64_t t1 = HostNowNs();
+    uint32_t bad = 0;
+    for(uint32_t c = 0; c < COLS; c++){
+        ARPyrNode_t node = { .And = 0xFFFF, .Or = 0 };
+        for(uint64_t t = from + span * c / COLS; t < from + span * (c + 1) / COLS; t++){
+            node.And &= raw[t];
+            node.Or  |= raw[t];
+        }
+        bad += !Same(node, cols[c]);
+    }
+    uint64_t t2 = HostNowNs();
+    HostCheck(bad == 0, "deep capture: %u columns differ", bad);
+    printf("  %u columns over %llu samples: pyramid %.1f us, plain scan %.1f us\n", COLS,
+           (unsigned long long) span, (t1 - t0) / 10e3, (t2 - t1) / 1e3);
+    free(mem);
+    free(raw);
+}
+
+/// @brief Indexing from a ring, lapped once
+static void TestFeed(void * Mem, uint32_t Bytes){
+    enum { BLOCKS = 8, BS = RAW_CAP / 8 };
+    ARRing_t ring;
+    ARPyr_t pyr;
+    uint32_t seed = 0xFEED;
+    ARRingInit(&ring, Raw, BLOCKS, BS);
+    ARPyrInit(&pyr, Mem, Bytes, Raw, BLOCKS * BS);
+
+    uint32_t seq = 0;
+    for(; seq < 4; seq++){
+        memcpy(ARRingProducerBlock(&ring), &Stream[seq * BS], BS * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+    }
+    HostCheck(ARPyrFeed(&pyr, &ring) == 4, "first feed");
+    CheckRanges(&pyr, &seed, 500);
+
+    for(; seq < 20; seq++){
+        memcpy(ARRingProducerBlock(&ring), &Stream[seq * BS], BS * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+    }
+    HostCheck(ARPyrFeed(&pyr, &ring) == BLOCKS - 1, "feed after the lap");
+    HostCheck(ARPyrOldest(&pyr) == (uint64_t) (20 - (BLOCKS - 1)) * BS, "oldest %llu after the lap",
+              (unsigned long long) ARPyrOldest(&pyr));
+    CheckRanges(&pyr, &seed, 500);
+}
+
+int main(void){
+    ARSynth_t synth;
+    ARSynthInit(&synth, 0x3);
+    ARSynthSetClock(&synth, 0, 2, 1, 0);
+    ARSynthSetClock(&synth, 1, 1000, 1, 0);         ///< One-sample spikes: must never be lost
+    ARSynthSetRandom(&synth, 2, 40);
+    ARSynthSetRandom(&synth, 3, 5000);
+    ARSynthSetRandom(&synth, 9, 100000);
+    ARSynthSetLevel(&synth, 15, 1);
+    ARSynthFill(&synth, Stream, STREAM);
+
+    uint32_t bytes = ARPyrBytes(RAW_CAP);
+    void * mem = malloc(bytes);
+    TestAppend(mem, bytes);
+    TestFeed(mem, bytes);
+    free(mem);
+    BenchColumns();
+    return HostTestEnd("TestARPyramid");
+}
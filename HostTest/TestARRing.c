@@ -0,0 +1,122 @@
+/**
+ * @file TestARRing.c
+ * @brief Host test of ARRing fed by the ARSynth sample source
+ * @details The synthetic source commits whole blocks exactly like the capture engine does.
+ *          Every acquired block must hold the samples of its sequence number, and blocks the
+ *          producer laps must show up as overruns, never as stale data.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARSynth.h"
+
+#define BLOCKS          8
+#define BLOCK_SAMPLES   256
+#define STREAM          (64 * BLOCK_SAMPLES)
+
+static ARSample_t RingMem[BLOCKS * BLOCK_SAMPLES];
+/// @brief The same waveforms generated in one go: sample n of the capture
+static ARSample_t Stream[STREAM];
+
+/// @brief Clocks, a constant and a random channel
+static void SynthSetup(ARSynth_t * Synth){
+    ARSynthInit(Synth, 0xC0FFEE);
+    ARSynthSetClock(Synth, 0, 10, 3, 2);
+    ARSynthSetClock(Synth, 1, 2, 1, 0);
+    ARSynthSetClock(Synth, 5, 777, 300, 100);
+    ARSynthSetLevel(Synth, 7, 1);
+    ARSynthSetRandom(Synth, 12, 20);
+}
+
+/// @brief Acquired block against the reference stream
+static void CheckBlock(const ARSample_t * Block, uint32_t Seq){
+    uint64_t first = (uint64_t) Seq * BLOCK_SAMPLES;
+    HostCheck(first + BLOCK_SAMPLES <= STREAM, "block %u past the reference", Seq);
+    if(first + BLOCK_SAMPLES > STREAM){
+        return;
+    }
+    HostCheck(memcmp(Block, &Stream[first], BLOCK_SAMPLES * sizeof(ARSample_t)) == 0,
+              "block %u does not hold samples %llu..", Seq, (unsigned long long) first);
+}
+
+/// @brief Channel 0 against the clock formula: high for 3 of every 10 samples, 2 late
+static void TestClockShape(void){
+    for(uint32_t t = 0; t < STREAM; t++){
+        uint32_t high = ((t + 10 - 2) % 10) < 3;
+        HostCheck((Stream[t] & 1) == high, "ch0 at %u: %u", t, Stream[t] & 1);
+        HostCheck((Stream[t] >> 7) & 1, "ch7 low at %u", t);
+    }
+}
+
+/// @brief Consumer keeping up: every block in order, no overrun
+static void TestInOrder(void){
+    ARRing_t ring;
+    ARSynth_t synth;
+    HostCheck(ARRingInit(&ring, RingMem, BLOCKS, BLOCK_SAMPLES) == STAT_OKE, "init");
+    SynthSetup(&synth);
+
+    uint32_t expect = 0;
+    while(expect < STREAM / BLOCK_SAMPLES){
+        /// Uneven producer bursts, never more than the ring can hold
+        ARSynthFeed(&synth, &ring, 1 + expect % (BLOCKS - 1));
+        const ARSample_t * block;
+        uint32_t seq;
+        while((block = ARRingAcquire(&ring, &seq)) != NULL){
+            HostCheck(seq == expect, "seq %u, expected %u", seq, expect);
+            CheckBlock(block, seq);
+            HostCheck(ARRingRelease(&ring) == STAT_OKE, "release %u", seq);
+            expect = seq + 1;
+        }
+    }
+    HostCheck(ARRingOverruns(&ring) == 0, "overruns %u", ARRingOverruns(&ring));
+}
+
+/// @brief Producer lapping the consumer: lost blocks counted, the rest intact
+static void TestOverrun(void){
+    ARRing_t ring;
+    ARSynth_t synth;
+    ARRingInit(&ring, RingMem, BLOCKS, BLOCK_SAMPLES);
+    SynthSetup(&synth);
+
+    /// 20 blocks into 8: the producer is on block 20, blocks 13..19 are intact
+    ARSynthFeed(&synth, &ring, 20);
+    HostCheck(ARRingPending(&ring) == BLOCKS - 1, "pending %u", ARRingPending(&ring));
+    HostCheck(ARRingOverruns(&ring) == 20 - (BLOCKS - 1), "overruns %u", ARRingOverruns(&ring));
+
+    uint32_t seq;
+    const ARSample_t * block = ARRingAcquire(&ring, &seq);
+    HostCheck((block != NULL) && (seq == 20 - (BLOCKS - 1)), "first intact block %u", seq);
+    CheckBlock(block, seq);
+
+    /// Lapped again while held: the release reports it
+    ARSynthFeed(&synth, &ring, BLOCKS);
+    HostCheck(ARRingRelease(&ring) == STAT_ERR_OVERFLOW, "release of an overwritten block");
+
+    /// Peek and discard agree with acquire on what is still there
+    uint32_t head = ring.Head;
+    HostCheck(ARRingPeek(&ring, head) == NULL, "peek of the block being written");
+    HostCheck(ARRingPeek(&ring, head - BLOCKS) == NULL, "peek of an overwritten block");
+    block = ARRingPeek(&ring, head - 1);
+    HostCheck(block != NULL, "peek of the newest block");
+    if(block != NULL){
+        CheckBlock(block, head - 1);
+    }
+    ARRingDiscard(&ring, head - 1);
+    block = ARRingAcquire(&ring, &seq);
+    HostCheck((block != NULL) && (seq == head - 1), "acquire after discard: %u", seq);
+    /// Lost: 0..12 before the first acquire, 14..20 while block 13 was held
+    HostCheck(ARRingOverruns(&ring) == 20, "overruns %u after discard", ARRingOverruns(&ring));
+}
+
+int main(void){
+    ARSynth_t synth;
+    SynthSetup(&synth);
+    ARSynthFill(&synth, Stream, STREAM);
+
+    TestClockShape();
+    TestInOrder();
+    TestOverrun();
+    return HostTestEnd("TestARRing");
+}
@@ -0,0 +1,157 @@
+/**
+ * @file TestARScopeSynth.c
+ * @brief Host test of ARScopeSynth through the scope block path: ring, extraction, trigger
+ * @details The generator commits blocks into an ARRing_t as the ADC engine does, and the
+ *          codes of each channel are pulled out with ARScopeExtract(). The acquired stream
+ *          must equal ARScopeSynthFill() of the same seed, the channel tags must cycle
+ *          through the enabled channels in ascending order across block boundaries, every
+ *          wave must stay in its range with the excess clipped to 0 / AR_SCOPE_CODE_MAX, and
+ *          ARScopeTrig must fire once per period of the generated sine.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARScopeSynth.h"
+#include "ARScopeTrig.h"
+
+#define BLOCKS          8
+#define BLOCK_SAMPLES   250
+#define ROUNDS          200
+#define SAMPLES         (ROUNDS * BLOCK_SAMPLES)
+#define CHANNELS        0x20B       ///< 0, 1, 3, 9
+#define CH_NUM          4
+#define SINE_PERIOD     64
+
+static const uint32_t Chs[CH_NUM] = { 0, 1, 3, 9 };
+static ARSample_t RingMem[BLOCKS * BLOCK_SAMPLES];
+static ARSample_t Stream[SAMPLES];
+static ARSample_t Ref[SAMPLES];
+static uint16_t Codes[CH_NUM][SAMPLES];
+static uint32_t CodeNum[CH_NUM];
+
+static void Setup(ARScopeSynth_t * Synth){
+    ARScopeSynthInit(Synth, CHANNELS, 0x5C09E);
+    /// Sine within range, square clipped at the top, noise clipped at the bottom, DC + noise at the top
+    ARScopeSynthSetWave(Synth, 0, AR_WAVE_SINE, SINE_PERIOD, 2048, 1500, 0);
+    ARScopeSynthSetWave(Synth, 1, AR_WAVE_SQUARE, 50, 3500, 1000, 0);
+    ARScopeSynthSetWave(Synth, 3, AR_WAVE_NOISE, 0, 100, 300, 0);
+    ARScopeSynthSetWave(Synth, 9, AR_WAVE_DC, 0, 4000, 0, 200);
+}
+
+/// @brief Blocks through the ring one at a time, channels extracted from each
+static void Acquire(void){
+    ARScopeSynth_t synth;
+    ARRing_t ring;
+    Setup(&synth);
+    HostCheck(ARRingInit(&ring, RingMem, BLOCKS, BLOCK_SAMPLES) == STAT_OKE, "ring init");
+    memset(CodeNum, 0, sizeof(CodeNum));
+    for(uint32_t r = 0; r < ROUNDS; r++){
+        ARScopeSynthFeed(&synth, &ring, 1);
+        uint32_t seq;
+        const ARSample_t * blk = ARRingAcquire(&ring, &seq);
+        HostCheck((blk != NULL) && (seq == r), "round %u: block %u", r, seq);
+        if(blk == NULL){
+            return;
+        }
+        memcpy(&Stream[(uint64_t) seq * BLOCK_SAMPLES], blk, BLOCK_SAMPLES * sizeof(ARSample_t));
+        for(uint32_t c = 0; c < CH_NUM; c++){
+            CodeNum[c] += ARScopeExtract(blk, BLOCK_SAMPLES, Chs[c], &Codes[c][CodeNum[c]]);
+        }
+        HostCheck(ARRingRelease(&ring) == STAT_OKE, "round %u: release", r);
+    }
+    HostCheck(synth.Now == SAMPLES, "%llu samples produced", (unsigned long long) synth.Now);
+
+    ARScopeSynth_t ref;
+    Setup(&ref);
+    ARScopeSynthFill(&ref, Ref, SAMPLES);
+    HostCheck(memcmp(Stream, Ref, sizeof(Ref)) == 0, "ring stream differs from ARScopeSynthFill");
+}
+
+/// @brief Tags cycle 0, 1, 3, 9 across block boundaries
+static void TestInterleave(void){
+    uint32_t bad = 0;
+    for(uint32_t i = 0; i < SAMPLES; i++){
+        bad += (ARScopeCh(Stream[i]) != Chs[i % CH_NUM]);
+    }
+    HostCheck(bad == 0, "%u samples out of the channel order", bad);
+    for(uint32_t c = 0; c < CH_NUM; c++){
+        HostCheck(CodeNum[c] == SAMPLES / CH_NUM, "channel %u: %u codes", Chs[c], CodeNum[c]);
+    }
+}
+
+/// @brief Smallest and largest code of channel slot `c`, count of `Value`
+static void Range(uint32_t c, uint32_t * Min, uint32_t * Max, uint32_t Value, uint32_t * Hits){
+    *Min = AR_SCOPE_CODE_MAX;
+    *Max = 0;
+    *Hits = 0;
+    for(uint32_t n = 0; n < CodeNum[c]; n++){
+        uint32_t v = Codes[c][n];
+        *Min = (v < *Min) ? v : *Min;
+        *Max = (v > *Max) ? v : *Max;
+        *Hits += (v == Value);
+    }
+}
+
+static void TestRanges(void){
+    uint32_t lo, hi, hits, frames = SAMPLES / CH_NUM;
+
+    /// Sine: exact peaks, one period later the same code
+    Range(0, &lo, &hi, 0, &hits);
+    HostCheck((lo == 2048 - 1500) && (hi == 2048 + 1500), "sine range %u..%u", lo, hi);
+    uint32_t bad = 0;
+    for(uint32_t n = SINE_PERIOD; n < frames; n++){
+        bad += (Codes[0][n] != Codes[0][n - SINE_PERIOD]);
+    }
+    HostCheck(bad == 0, "sine: %u codes differ from one period before", bad);
+
+    /// Square: 2500 / 4500 clipped to 4095, half the frames each
+    Range(1, &lo, &hi, AR_SCOPE_CODE_MAX, &hits);
+    HostCheck((lo == 2500) && (hi == AR_SCOPE_CODE_MAX), "square range %u..%u", lo, hi);
+    /// 2^32 / 50 truncates, so the duty drifts by up to one frame over the run
+    HostCheck((hits + 1 >= frames / 2) && (hits <= frames / 2 + 1), "square high for %u of %u frames", hits, frames);
+    for(uint32_t n = 0; n < frames; n++){
+        bad += (Codes[1][n] != 2500) && (Codes[1][n] != AR_SCOPE_CODE_MAX);
+    }
+    HostCheck(bad == 0, "square: %u codes between the levels", bad);
+
+    /// Noise: 100 +/- 300, the lower 200 codes clipped to 0 (1 / 3 of the draws)
+    Range(2, &lo, &hi, 0, &hits);
+    HostCheck((lo == 0) && (hi <= 400) && (hi >= 390), "noise range %u..%u", lo, hi);
+    HostCheck((hits > frames * 30 / 100) && (hits < frames * 37 / 100), "noise clipped to 0 in %u of %u frames", hits, frames);
+
+    /// DC + noise: 4000 +/- 200, clipped to 4095 above
+    Range(3, &lo, &hi, AR_SCOPE_CODE_MAX, &hits);
+    HostCheck((lo >= 3800) && (lo <= 3810) && (hi == AR_SCOPE_CODE_MAX), "DC range %u..%u", lo, hi);
+    HostCheck((hits > frames * 20 / 100) && (hits < frames * 27 / 100), "DC clipped in %u of %u frames", hits, frames);
+}
+
+/// @brief One rising shot per sine period, 64 frames apart
+static void TestTrigger(void){
+    ARScopeTrig_t trig;
+    ARScopeTrigInit(&trig, AR_TRIG_EDGE_RISING, 2048, 40, 0);
+    uint32_t frames = CodeNum[0], off = 0, shots = 0, bad = 0;
+    uint64_t prev = 0;
+    int32_t k;
+    while((off < frames) && ((k = ARScopeTrigScan(&trig, &Codes[0][off], frames - off)) >= 0)){
+        if(shots > 0){
+            int64_t d = (int64_t) (trig.TrigPos - prev) - ((int64_t) SINE_PERIOD << AR_SCOPE_TRIG_FRAC_BITS);
+            bad += (d < -(1 << (AR_SCOPE_TRIG_FRAC_BITS - 4))) || (d > (1 << (AR_SCOPE_TRIG_FRAC_BITS - 4)));
+        }
+        prev = trig.TrigPos;
+        shots++;
+        off += (uint32_t) k + 1;
+    }
+    HostCheck((shots + 1 >= frames / SINE_PERIOD) && (shots <= frames / SINE_PERIOD + 1), "%u shots for %u periods",
+              shots, frames / SINE_PERIOD);
+    HostCheck(bad == 0, "%u shots not one period after the previous one", bad);
+}
+
+int main(void){
+    Acquire();
+    TestInterleave();
+    TestRanges();
+    TestTrigger();
+    return HostTestEnd("TestARScopeSynth");
+}
@@ -0,0 +1,98 @@
+/**
+ * @file TestARScopeTrig.c
+ * @brief Host test of ARScopeTrig: shot count and trigger jitter on noisy sines
+ * @details A sine whose period is not a whole number of frames crosses the level at a
+ *          different fraction of a frame on every cycle. The interpolated crossing must sit
+ *          on the true one to a small part of a frame, while the index of the first code past
+ *          it jitters by up to one frame. With noise on top, the hysteresis must keep one
+ *          shot per period. Jitter figures are printed.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARScopeTrig.h"
+
+#define FRAMES          (1 << 18)
+#define OFFSET          2048
+#define AMPLITUDE       1500
+
+static uint16_t Codes[FRAMES];
+
+/// @brief Sine of `Period` frames, rising through OFFSET at frame 0, uniform noise of +/- `Noise`
+static void Sine(double Period, uint32_t Noise, uint32_t Seed){
+    for(uint32_t n = 0; n < FRAMES; n++){
+        double x = OFFSET + AMPLITUDE * sin(2.0 * M_PI * n / Period);
+        if(Noise > 0){
+            x += (double) (HostRand(&Seed) % (2 * Noise + 1)) - (double) Noise;
+        }
+        Codes[n] = (uint16_t) lround(x);
+    }
+}
+
+/// @brief Shots over the whole buffer in chunks; RMS distance to the true crossings (frames)
+static uint32_t Shots(uint32_t Edge, uint32_t Hyst, double Period, double * RmsInterp, double * RmsIndex){
+    ARScopeTrig_t trig;
+    ARScopeTrigInit(&trig, Edge, OFFSET, Hyst, 0);
+    double sumI = 0, sumX = 0;
+    uint32_t shots = 0;
+    uint32_t seed = 0x7;
+    uint32_t done = 0;
+    /// Falling crossings are half a period after the rising ones
+    double phase = (Edge == AR_TRIG_EDGE_FALLING) ? Period / 2 : 0;
+
+    while(done < FRAMES){
+        uint32_t num = 1 + HostRand(&seed) % 1000;
+        if(num > FRAMES - done){
+            num = FRAMES - done;
+        }
+        uint32_t off = 0;
+        int32_t k;
+        while((off < num) && ((k = ARScopeTrigScan(&trig, &Codes[done + off], num - off)) >= 0)){
+            double pos = (double) trig.TrigPos / (1 << AR_SCOPE_TRIG_FRAC_BITS);
+            double ideal = phase + round((pos - phase) / Period) * Period;
+            double index = (double) (done + off + (uint32_t) k);
+            sumI += (pos - ideal) * (pos - ideal);
+            sumX += (index - ideal) * (index - ideal);
+            shots++;
+            off += (uint32_t) k + 1;
+        }
+        done += num;
+    }
+    *RmsInterp = (shots > 0) ? sqrt(sumI / shots) : 0;
+    *RmsIndex  = (shots > 0) ? sqrt(sumX / shots) : 0;
+    return shots;
+}
+
+/// @brief One signal, both edges
+static void TestJitter(const char * Name, double Period, uint32_t Noise, uint32_t Hyst){
+    Sine(Period, Noise, 0x1234);
+    /// Noise of N codes moves the crossing by N / slope frames at most, slope 2 pi A / P
+    double maxInterp = 0.02 + Noise / (2.0 * M_PI * AMPLITUDE / Period);
+    /// The first crossing of each kind may fall before the trigger is armed
+    uint32_t periods = (uint32_t) (FRAMES / Period);
+    static const uint32_t Edges[] = { AR_TRIG_EDGE_RISING, AR_TRIG_EDGE_FALLING };
+    for(uint32_t e = 0; e < 2; e++){
+        double interp, index;
+        uint32_t shots = Shots(Edges[e], Hyst, Period, &interp, &index);
+        printf("  %-22s %-7s %5u shots, jitter %.3f frames interpolated, %.3f frames by index\n",
+               Name, (e == 0) ? "rising" : "falling", shots, interp, index);
+        HostCheck((shots + 1 >= periods) && (shots <= periods + 1), "%s: %u shots for %u periods", Name, shots, periods);
+        HostCheck(interp <= maxInterp, "%s: interpolated jitter %.3f frames", Name, interp);
+        /// Unless the noise swamps the slope, the fraction beats the whole frame
+        if(maxInterp < 0.5){
+            HostCheck(interp < index / 4, "%s: interpolation does not beat the index", Name);
+        }
+    }
+}
+
+int main(void){
+    TestJitter("clean, P = 97.3", 97.3, 0, 40);
+    TestJitter("clean, P = 20.7", 20.7, 0, 40);
+    TestJitter("noise 20, P = 97.3", 97.3, 20, 60);
+    /// Hysteresis wider than the noise: still one shot per period
+    TestJitter("noise 100, P = 397.1", 397.1, 100, 300);
+    return HostTestEnd("TestARScopeTrig");
+}
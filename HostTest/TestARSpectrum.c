@@ -0,0 +1,179 @@
+/**
+ * @file TestARSpectrum.c
+ * @brief Host test of ARSpectrum: fixed-point FFT and levels against a double reference
+ * @details ARFft is compared with a direct double DFT for every size from 2 to 2048 points,
+ *          ARSpectrumDb256 with 10 log10, and the dBFS bins of ARSpectrumRun with the
+ *          windowed DFT of the same codes for each window. A sine on a bin center must read
+ *          its amplitude in dBFS. Host FFT timings are printed.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARSpectrum.h"
+
+#define POINTS_MAX      AR_SPEC_POINTS_MAX
+
+static ARCplx_t Fx[POINTS_MAX];
+static double   RefRe[POINTS_MAX];
+static double   RefIm[POINTS_MAX];
+static uint16_t Codes[POINTS_MAX];
+
+/// @brief Direct DFT in double precision, forward sign
+static void Dft(const ARCplx_t * X, uint32_t Num){
+    for(uint32_t k = 0; k < Num; k++){
+        double re = 0, im = 0;
+        for(uint32_t n = 0; n < Num; n++){
+            double a = -2.0 * M_PI * (double) ((uint64_t) k * n % Num) / Num;
+            re += X[n].Re * cos(a) - X[n].Im * sin(a);
+            im += X[n].Re * sin(a) + X[n].Im * cos(a);
+        }
+        RefRe[k] = re;
+        RefIm[k] = im;
+    }
+}
+
+/// @brief Every size, tables of every analyzer size it fits in
+static void TestFft(void){
+    static ARCplx_t in[POINTS_MAX];
+    uint32_t seed = 0xF0F0;
+    for(uint32_t points = AR_SPEC_POINTS_MIN; points <= POINTS_MAX; points <<= 1){
+        ARSpectrum_t spec;
+        uint32_t bytes = ARSpectrumBytes(points);
+        void * mem = malloc(bytes);
+        HostCheck(ARSpectrumInit(&spec, mem, bytes, points, AR_WIN_HANN, 0) == STAT_OKE, "init %u", points);
+
+        for(uint32_t num = 2; num <= points / 2; num <<= 1){
+            /// 12-bit inputs: the unscaled output stays within int32 up to 2048 points
+            for(uint32_t n = 0; n < num; n++){
+                in[n].Re = (int32_t) (HostRand(&seed) % 4096) - 2048;
+                in[n].Im = (int32_t) (HostRand(&seed) % 4096) - 2048;
+            }
+            memcpy(Fx, in, num * sizeof(ARCplx_t));
+            ARFft(Fx, num, spec.Sin, points);
+            Dft(in, num);
+
+            double err = 0, peak = 0;
+            for(uint32_t k = 0; k < num; k++){
+                double dr = Fx[k].Re - RefRe[k], di = Fx[k].Im - RefIm[k];
+                err  = fmax(err, sqrt(dr * dr + di * di));
+                peak = fmax(peak, sqrt(RefRe[k] * RefRe[k] + RefIm[k] * RefIm[k]));
+            }
+            /// Q30 twiddles: the rounding of each stage adds up over sqrt(Num) paths at most
+            HostCheck(err <= 0.25 * sqrt(num) * log2(num), "FFT %u of %u: error %.2f, peak %.0f", num, points, err, peak);
+        }
+        free(mem);
+    }
+}
+
+/// @brief 10 log10 in 1/256 dB over the whole 64-bit range
+static void TestDb(void){
+    double worst = 0;
+    uint32_t seed = 0xDB;
+    for(uint32_t i = 0; i < 100000; i++){
+        uint64_t p = ((uint64_t) HostRand(&seed) << 32 | HostRand(&seed)) >> (HostRand(&seed) % 64);
+        if(p == 0){
+            continue;
+        }
+        double exp = 2560.0 * log10((double) p);
+        worst = fmax(worst, fabs(ARSpectrumDb256(p) - exp));
+    }
+    HostCheck(worst <= 2.0, "dB error %.2f / 256 dB", worst);
+    HostCheck(ARSpectrumDb256(0) == AR_SPEC_DB_FLOOR * 256 / 10, "dB of 0");
+}
+
+/// @brief Bins of one run against the windowed double DFT of the same codes
+static void TestRun(uint32_t Points, uint32_t Window){
+    ARSpectrum_t spec;
+    uint32_t bytes = ARSpectrumBytes(Points);
+    void * mem = malloc(bytes);
+    ARSpectrumInit(&spec, mem, bytes, Points, Window, 0);
+
+    /// A tone between bins, one 60 dB down on a bin, a little noise
+    uint32_t seed = 0x51 + Points + Window;
+    for(uint32_t n = 0; n < Points; n++){
+        double x = 2000.0 * sin(2.0 * M_PI * 37.3 * n / Points) +
+                   2.0 * cos(2.0 * M_PI * (Points / 4) * n / Points + 1.0) +
+                   (double) (HostRand(&seed) % 5) - 2.0;
+        Codes[n] = (uint16_t) lround(2048.0 + x);
+    }
+    ARSpectrumRun(&spec, Codes);
+
+    uint32_t bad = 0;
+    for(uint32_t k = 0; k < ARSpectrumBins(&spec); k++){
+        double re = 0, im = 0;
+        for(uint32_t n = 0; n < Points; n++){
+            double v = (double) (((int32_t) Codes[n] - 2048) * 16) * spec.Win[n] / 32768.0;
+            double a = -2.0 * M_PI * (double) ((uint64_t) k * n % Points) / Points;
+            re += v * cos(a);
+            im += v * sin(a);
+        }
+        /// Split output is 2 X[k]
+        double p = 4.0 * (re * re + im * im);
+        double exp = (p > 0) ? (2560.0 * log10(p) - spec.RefDb) * 10.0 / 256.0 : AR_SPEC_DB_FLOOR;
+        int32_t got = ARSpectrumAvg(&spec, k);
+        /// Amplitudes relative to full scale: the 0.1 dB step, plus the fixed-point noise
+        /// floor near -100 dBFS that decides the weakest bins
+        double aGot = pow(10.0, got / 200.0), aExp = pow(10.0, exp / 200.0);
+        if((exp > AR_SPEC_DB_FLOOR) && (fabs(aGot - aExp) > 0.015 * aExp + 1e-5)){
+            if(bad++ < 5){
+                HostCheck(0, "%u points, window %u, bin %u: %d, reference %.1f (0.1 dBFS)", Points, Window, k, got, exp);
+            }
+        }
+    }
+    HostCheck(bad == 0, "%u points, window %u: %u bins off", Points, Window, bad);
+    free(mem);
+}
+
+/// @brief A sine on a bin center reads its amplitude
+static void TestLevel(uint32_t Window){
+    enum { POINTS = 1024, BIN = 100 };
+    ARSpectrum_t spec;
+    uint32_t bytes = ARSpectrumBytes(POINTS);
+    void * mem = malloc(bytes);
+    ARSpectrumInit(&spec, mem, bytes, POINTS, Window, 0);
+    static const double Amp[] = { 2047.0, 1024.0, 100.0 };
+    for(uint32_t a = 0; a < sizeof(Amp) / sizeof(Amp[0]); a++){
+        for(uint32_t n = 0; n < POINTS; n++){
+            Codes[n] = (uint16_t) lround(2048.0 + Amp[a] * sin(2.0 * M_PI * BIN * n / POINTS));
+        }
+        ARSpectrumReset(&spec);
+        ARSpectrumRun(&spec, Codes);
+        double exp = 200.0 * log10(Amp[a] / 2048.0);
+        int32_t got = ARSpectrumAvg(&spec, BIN);
+        HostCheck(fabs(got - exp) <= 1.0, "window %u, amplitude %.0f: %d, expected %.1f (0.1 dBFS)",
+                  Window, Amp[a], got, exp);
+    }
+    free(mem);
+}
+
+/// @brief Host time of one spectrum per size
+static void BenchRun(void){
+    for(uint32_t points = 256; points <= POINTS_MAX; points <<= 2){
+        ARSpectrum_t spec;
+        uint32_t bytes = ARSpectrumBytes(points);
+        void * mem = malloc(bytes);
+        ARSpectrumInit(&spec, mem, bytes, points, AR_WIN_HANN, 3);
+        uint64_t t0 = HostNowNs();
+        for(uint32_t r = 0; r < 1000; r++){
+            ARSpectrumRun(&spec, Codes);
+        }
+        printf("  %4u points: %.1f us per spectrum\n", points, (HostNowNs() - t0) / 1000e3);
+        free(mem);
+    }
+}
+
+int main(void){
+    TestFft();
+    TestDb();
+    for(uint32_t w = AR_WIN_RECT; w <= AR_WIN_FLATTOP; w++){
+        TestRun(256, w);
+        TestRun(4096, w);
+        TestLevel(w);
+    }
+    BenchRun();
+    return HostTestEnd("TestARSpectrum");
+}
@@ -0,0 +1,183 @@
+/**
+ * @file TestARSpi.c
+ * @brief Host test of ARSpi: the four SPI modes from an independent bus generator
+ * @details Frames are drawn from the mode definitions (idle clock level, data set up before
+ *          or on the leading edge), with MOSI and MISO carrying unrelated words, noise on
+ *          the channels outside the bus and a word cut short by CS. The capture is fed to the
+ *          decoder in random-sized chunks; every event, value and sample number must match.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARSpi.h"
+
+#define CH_SCLK         5
+#define CH_MOSI         9
+#define CH_MISO         0
+#define CH_CS           14
+/// @brief Channels toggling at random outside the bus
+#define NOISE_MASK      0x0488
+
+#define CAP             (1 << 17)
+#define EV_MAX          512
+
+static ARSample_t Cap[CAP];
+
+/// @brief Bus generator: current levels plus the expected events
+typedef struct Bus_s {
+    ARSample_t      Level;
+    uint32_t        Num;
+    uint32_t        Seed;
+    ARSpiEvent_t    Ev[EV_MAX];
+    uint32_t        EvNum;
+} Bus_t;
+
+/// @brief Decoded events
+typedef struct Log_s {
+    ARSpiEvent_t    Ev[EV_MAX];
+    uint32_t        Num;
+} Log_t;
+
+static void OnEvent(void * Arg, const ARSpiEvent_t * Ev){
+    Log_t * log = (Log_t *) Arg;
+    if(log->Num < EV_MAX){
+        log->Ev[log->Num] = *Ev;
+    }
+    log->Num++;
+}
+
+/// @brief Set one channel of the current level
+static void BusSet(Bus_t * Bus, uint32_t Ch, uint32_t Level){
+    Bus->Level = (ARSample_t) ((Bus->Level & ~(1U << Ch)) | ((Level & 1U) << Ch));
+}
+
+/// @brief Hold the current level for `Num` samples, with noise on the other channels
+static void BusHold(Bus_t * Bus, uint32_t Num){
+    for(uint32_t i = 0; (i < Num) && (Bus->Num < CAP); i++){
+        if((HostRand(&(Bus->Seed)) & 7) == 0){
+            Bus->Level ^= (ARSample_t) (HostRand(&(Bus->Seed)) & NOISE_MASK);
+        }
+        Cap[Bus->Num++] = Bus->Level;
+    }
+}
+
+static void BusExpect(Bus_t * Bus, uint32_t Kind, uint32_t Bits, uint32_t Mosi, uint32_t Miso, uint64_t Sample){
+    if(Bus->EvNum < EV_MAX){
+        Bus->Ev[Bus->EvNum++] = (ARSpiEvent_t){ .Kind = Kind, .Bits = Bits, .Mosi = Mosi, .Miso = Miso, .Sample = Sample };
+    }
+}
+
+/// @brief One frame of `Num` words; the last one stops after `LastBits` bits
+static void BusFrame(Bus_t * Bus, const ARSpiConfig_t * Cfg, uint32_t Num, uint32_t LastBits, uint32_t Half){
+    BusSet(Bus, CH_SCLK, Cfg->Cpol);
+    BusHold(Bus, 3 * Half);
+    BusSet(Bus, CH_CS, 0);
+    BusExpect(Bus, AR_SPI_EV_SELECT, 0, 0, 0, Bus->Num);
+    BusHold(Bus, Half);
+
+    for(uint32_t w = 0; w < Num; w++){
+        uint32_t bits = (w + 1 == Num) ? LastBits : Cfg->WordBits;
+        uint32_t mosi = HostRand(&(Bus->Seed));
+        uint32_t miso = HostRand(&(Bus->Seed));
+        if(bits < 32){
+            mosi &= (1U << bits) - 1;
+            miso &= (1U << bits) - 1;
+        }
+        uint64_t first = 0;
+        for(uint32_t b = 0; b < bits; b++){
+            uint32_t shift = Cfg->MsbFirst ? (bits - 1 - b) : b;
+            if(Cfg->Cpha == 0){
+                /// Data set up while the clock idles, sampled on the leading edge
+                BusSet(Bus, CH_MOSI, mosi >> shift);
+                BusSet(Bus, CH_MISO, miso >> shift);
+                BusHold(Bus, Half);
+                BusSet(Bus, CH_SCLK, !Cfg->Cpol);
+                if(b == 0){
+                    first = Bus->Num;
+                }
+                BusHold(Bus, Half);
+                BusSet(Bus, CH_SCLK, Cfg->Cpol);
+            } else {
+                /// Data changes on the leading edge, sampled on the trailing one
+                BusSet(Bus, CH_SCLK, !Cfg->Cpol);
+                BusSet(Bus, CH_MOSI, mosi >> shift);
+                BusSet(Bus, CH_MISO, miso >> shift);
+                BusHold(Bus, Half);
+                BusSet(Bus, CH_SCLK, Cfg->Cpol);
+                if(b == 0){
+                    first = Bus->Num;
+                }
+                BusHold(Bus, Half);
+            }
+        }
+        if(bits > 0){
+            BusExpect(Bus, AR_SPI_EV_WORD, bits, mosi, miso, first);
+        }
+    }
+
+    BusHold(Bus, Half);
+    BusSet(Bus, CH_CS, 1);
+    BusExpect(Bus, AR_SPI_EV_DESELECT, 0, 0, 0, Bus->Num);
+    BusHold(Bus, 2 * Half);
+}
+
+/// @brief One configuration: a few frames, one cut short, decoded in chunks
+static void TestMode(uint32_t Cpol, uint32_t Cpha, uint32_t MsbFirst, uint32_t WordBits, uint32_t Seed){
+    static Bus_t bus;
+    static Log_t log;
+    ARSpiConfig_t cfg = {
+        .ChSclk = CH_SCLK, .ChMosi = CH_MOSI, .ChMiso = CH_MISO, .ChCs = CH_CS,
+        .CsActiveLow = 1, .Cpol = Cpol, .Cpha = Cpha, .MsbFirst = MsbFirst, .WordBits = WordBits,
+    };
+    memset(&bus, 0, sizeof(bus));
+    bus.Seed = Seed;
+    BusSet(&bus, CH_CS, 1);
+    for(uint32_t f = 0; f < 6; f++){
+        uint32_t half = 1 + f % 3;
+        uint32_t last = (f == 4) ? (WordBits / 2) : WordBits;
+        BusFrame(&bus, &cfg, 1 + f, last, half);
+    }
+
+    ARSpi_t dec;
+    memset(&log, 0, sizeof(log));
+    HostCheck(ARSpiInit(&dec, &cfg, OnEvent, &log) == STAT_OKE, "init");
+    uint32_t done = 0;
+    while(done < bus.Num){
+        uint32_t num = 1 + HostRand(&Seed) % 97;
+        if(num > bus.Num - done){
+            num = bus.Num - done;
+        }
+        ARSpiDecode(&dec, &Cap[done], num);
+        done += num;
+    }
+
+    uint32_t mode = (Cpol << 1) | Cpha;
+    HostCheck(log.Num == bus.EvNum, "mode %u, %u bits: %u events, expected %u", mode, WordBits, log.Num, bus.EvNum);
+    for(uint32_t i = 0; (i < log.Num) && (i < bus.EvNum); i++){
+        const ARSpiEvent_t * got = &log.Ev[i];
+        const ARSpiEvent_t * exp = &bus.Ev[i];
+        HostCheck((got->Kind == exp->Kind) && (got->Sample == exp->Sample),
+                  "mode %u, %u bits, event %u: kind %u at %llu, expected %u at %llu", mode, WordBits, i,
+                  got->Kind, (unsigned long long) got->Sample, exp->Kind, (unsigned long long) exp->Sample);
+        if((got->Kind == AR_SPI_EV_WORD) && (exp->Kind == AR_SPI_EV_WORD)){
+            HostCheck((got->Bits == exp->Bits) && (got->Mosi == exp->Mosi) && (got->Miso == exp->Miso),
+                      "mode %u, %u bits, event %u: %u bits %08x/%08x, expected %u bits %08x/%08x", mode, WordBits, i,
+                      got->Bits, got->Mosi, got->Miso, exp->Bits, exp->Mosi, exp->Miso);
+        }
+    }
+    HostCheck(dec.Frames == 6, "mode %u: %u frames", mode, dec.Frames);
+}
+
+int main(void){
+    static const uint32_t WordBits[] = { 8, 12, 16, 32 };
+    uint32_t seed = 0x5EED;
+    for(uint32_t mode = 0; mode < 4; mode++){
+        for(uint32_t w = 0; w < sizeof(WordBits) / sizeof(WordBits[0]); w++){
+            TestMode(mode >> 1, mode & 1, 1, WordBits[w], HostRand(&seed));
+            TestMode(mode >> 1, mode & 1, 0, WordBits[w], HostRand(&seed));
+        }
+    }
+    return HostTestEnd("TestARSpi");
+}
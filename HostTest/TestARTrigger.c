@@ -0,0 +1,227 @@
+/**
+ * @file TestARTrigger.c
+ * @brief Host test of ARTrigger: two-lane scan against a sample-by-sample reference
+ * @details Random stage sequences (edges, levels, entered patterns, hit counts) run over a
+ *          random stream fed in odd-sized chunks; the two-lane scan must stop on the same
+ *          sample as the plain loop. The ring path must hand out the window around it,
+ *          history included, count the blocks it could not scan, and move past a window
+ *          overwritten before it was copied.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "ARSynth.h"
+#include "ARTrigger.h"
+
+#define STREAM          (1 << 16)
+#define BLOCKS          16
+#define BLOCK_SAMPLES   256
+#define WINDOW          1024
+#define PRE_PERCENT     25
+
+static ARSample_t Stream[STREAM];
+static ARSample_t RingMem[BLOCKS * BLOCK_SAMPLES];
+static ARSample_t Window[WINDOW];
+
+/// @brief Sample-by-sample reference of the stage sequence
+static int32_t RefScan(const ARTrigger_t * Trig, const ARSample_t * S, uint32_t Num){
+    uint32_t cur = 0, hits = 0;
+    ARSample_t prev = S[0];
+    for(uint32_t i = 0; i < Num; i++){
+        const ARTrigStage_t * st = &(Trig->Stage[cur]);
+        uint32_t hit = ((S[i] & st->Mask) == st->Value);
+        if(st->Flags & AR_TRIG_FLAG_ENTER){
+            hit = hit && ((prev & st->Mask) != st->Value);
+        }
+        if(st->Rise | st->Fall){
+            hit = hit && (((~prev & S[i] & st->Rise) | (prev & ~S[i] & st->Fall)) != 0);
+        }
+        prev = S[i];
+        if(hit && (++hits >= st->Count)){
+            hits = 0;
+            if(++cur >= Trig->StageNum){
+                return (int32_t) i;
+            }
+        }
+    }
+    return -1;
+}
+
+/// @brief One random stage over channels 0..3
+static void RandStage(ARTrigStage_t * Stage, uint32_t * Seed){
+    uint32_t ch = HostRand(Seed) % 4;
+    switch(HostRand(Seed) % 3){
+        case 0:
+            ARTriggerStageEdge(Stage, ch, 1 + HostRand(Seed) % 3);
+            break;
+        case 1:
+            ARTriggerStageLevel(Stage, ch, HostRand(Seed) & 1);
+            break;
+        default:
+            ARTriggerStagePattern(Stage, (ARSample_t) (1 + HostRand(Seed) % 15),
+                                  (ARSample_t) HostRand(Seed), HostRand(Seed) & 1);
+            break;
+    }
+    Stage->Count = 1 + HostRand(Seed) % 3;
+}
+
+/// @brief Random sequences, scanned in chunks, against the reference
+static void TestScan(void){
+    uint32_t seed = 0xACE1;
+    uint32_t fired = 0;
+    for(uint32_t round = 0; round < 500; round++){
+        ARTrigger_t trig;
+        ARTriggerInit(&trig, WINDOW, PRE_PERCENT);
+        uint32_t stages = 1 + HostRand(&seed) % AR_TRIG_STAGE_MAX;
+        for(uint32_t s = 0; s < stages; s++){
+            ARTrigStage_t st;
+            RandStage(&st, &seed);
+            ARTriggerAddStage(&trig, &st);
+        }
+        uint32_t from = HostRand(&seed) % (STREAM / 2);
+        int32_t ref = RefScan(&trig, &Stream[from], STREAM - from);
+
+        int32_t got = -1;
+        uint32_t done = from;
+        while((got < 0) && (done < STREAM)){
+            uint32_t num = 1 + HostRand(&seed) % 300;
+            if(num > STREAM - done){
+                num = STREAM - done;
+            }
+            int32_t idx = ARTriggerScan(&trig, &Stream[done], num);
+            if(idx >= 0){
+                got = (int32_t) (done - from) + idx;
+            }
+            done += num;
+        }
+        HostCheck(got == ref, "round %u: %u stages fire at %d, reference %d", round, stages, got, ref);
+        fired += (ref >= 0);
+    }
+    /// The random sequences must mostly fire, or the comparison says little
+    HostCheck(fired > 400, "only %u of 500 sequences fired", fired);
+}
+
+/// @brief Two stages through the ring: window placement and contents
+static void TestWindow(void){
+    ARRing_t ring;
+    ARTrigger_t trig;
+    ARTrigStage_t st;
+    ARRingInit(&ring, RingMem, BLOCKS, BLOCK_SAMPLES);
+    ARTriggerInit(&trig, WINDOW, PRE_PERCENT);
+    /// Channel 1 going high 40 times puts the trigger past the pre-trigger history
+    ARTriggerStagePattern(&st, 0x0002, 0x0002, 1);
+    st.Count = 40;
+    ARTriggerAddStage(&trig, &st);
+    ARTriggerStageEdge(&st, 0, AR_TRIG_EDGE_RISING);
+    st.Count = 3;
+    ARTriggerAddStage(&trig, &st);
+    HostCheck(ARTriggerArm(&trig, &ring) == STAT_OKE, "arm");
+    int32_t ref = RefScan(&trig, Stream, STREAM);
+    HostCheck(ref > WINDOW, "reference trigger at %d, too early for the test", ref);
+
+    /// Producer one block ahead of every poll, like the capture task
+    uint32_t seq = 0;
+    while((ARTriggerPoll(&trig, &ring) != AR_TRIG_DONE) && (seq < STREAM / BLOCK_SAMPLES)){
+        memcpy(ARRingProducerBlock(&ring), &Stream[seq * BLOCK_SAMPLES], BLOCK_SAMPLES * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+        seq++;
+    }
+    HostCheck(trig.State == AR_TRIG_DONE, "window never completed");
+    HostCheck(trig.TrigSample == (uint64_t) ref, "trigger at %llu, reference %d",
+              (unsigned long long) trig.TrigSample, ref);
+    uint32_t pre = WINDOW * PRE_PERCENT / 100;
+    HostCheck(trig.StartSample == trig.TrigSample - pre, "start %llu", (unsigned long long) trig.StartSample);
+    HostCheck(trig.EndSample == trig.StartSample + WINDOW, "end %llu", (unsigned long long) trig.EndSample);
+
+    int32_t copied = ARTriggerCopyWindow(&trig, &ring, Window, WINDOW);
+    HostCheck(copied == WINDOW, "copied %d", copied);
+    if(copied == WINDOW){
+        HostCheck(memcmp(Window, &Stream[trig.StartSample], sizeof(Window)) == 0, "window contents");
+    }
+    HostCheck(trig.Lost == 0, "lost %u", trig.Lost);
+}
+
+/// @brief Producer far ahead of the poll: skipped blocks counted in Lost
+static void TestLost(void){
+    ARRing_t ring;
+    ARTrigger_t trig;
+    ARTrigStage_t st;
+    ARRingInit(&ring, RingMem, BLOCKS, BLOCK_SAMPLES);
+    ARTriggerInit(&trig, WINDOW, PRE_PERCENT);
+    /// Never true: channel 15 is held low
+    ARTriggerStageLevel(&st, 15, 1);
+    ARTriggerAddStage(&trig, &st);
+    ARTriggerArm(&trig, &ring);
+    for(uint32_t b = 0; b < 40; b++){
+        memcpy(ARRingProducerBlock(&ring), &Stream[b * BLOCK_SAMPLES], BLOCK_SAMPLES * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+    }
+    HostCheck(ARTriggerPoll(&trig, &ring) == AR_TRIG_ARMED, "fired on a low channel");
+    HostCheck(trig.Lost == 40 - (BLOCKS - 1), "lost %u", trig.Lost);
+    HostCheck(trig.ScanSeq == 40, "scan stopped at %u", trig.ScanSeq);
+}
+
+/// @brief Window overwritten before the copy: released anyway, the next arm scans on from its end
+static void TestOverwritten(void){
+    ARRing_t ring;
+    ARTrigger_t trig;
+    ARTrigStage_t st;
+    ARRingInit(&ring, RingMem, BLOCKS, BLOCK_SAMPLES);
+    ARTriggerInit(&trig, WINDOW, PRE_PERCENT);
+    ARTriggerStageEdge(&st, 3, AR_TRIG_EDGE_RISING);
+    ARTriggerAddStage(&trig, &st);
+    ARTriggerArm(&trig, &ring);
+
+    uint32_t seq = 0;
+    while((ARTriggerPoll(&trig, &ring) != AR_TRIG_DONE) && (seq < STREAM / BLOCK_SAMPLES)){
+        memcpy(ARRingProducerBlock(&ring), &Stream[seq * BLOCK_SAMPLES], BLOCK_SAMPLES * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+        seq++;
+    }
+    HostCheck(trig.State == AR_TRIG_DONE, "window never completed");
+    /// The producer reaches the first block of the window before the copy
+    uint32_t startSeq = (uint32_t) (trig.StartSample / BLOCK_SAMPLES);
+    for(; seq - startSeq < BLOCKS; seq++){
+        memcpy(ARRingProducerBlock(&ring), &Stream[seq * BLOCK_SAMPLES], BLOCK_SAMPLES * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+    }
+    uint64_t end = trig.EndSample;
+    HostCheck(ARTriggerCopyWindow(&trig, &ring, Window, WINDOW) == STAT_ERR_OVERFLOW, "copied an overwritten window");
+    ARTriggerArm(&trig, &ring);
+    HostCheck((uint64_t) trig.ScanSeq * BLOCK_SAMPLES >= end, "rearmed at block %u, inside the window ending at %llu",
+              trig.ScanSeq, (unsigned long long) end);
+
+    /// The next trigger is a later edge, not the one of the lost window
+    uint64_t lastTrig = trig.TrigSample;
+    while((ARTriggerPoll(&trig, &ring) != AR_TRIG_DONE) && (seq < STREAM / BLOCK_SAMPLES)){
+        memcpy(ARRingProducerBlock(&ring), &Stream[seq * BLOCK_SAMPLES], BLOCK_SAMPLES * sizeof(ARSample_t));
+        ARRingCommit(&ring);
+        seq++;
+    }
+    HostCheck((trig.State == AR_TRIG_DONE) && (trig.TrigSample >= end) && (trig.TrigSample != lastTrig),
+              "next trigger at %llu, lost window ended at %llu", (unsigned long long) trig.TrigSample, (unsigned long long) end);
+    /// History starts at the first block after the lost window
+    int32_t n = ARTriggerCopyWindow(&trig, &ring, Window, WINDOW);
+    HostCheck((n > 0) && ((uint64_t) n == trig.EndSample - trig.StartSample) && (trig.StartSample >= end), "copy after the skip: %d", n);
+    if(n > 0){
+        HostCheck(memcmp(Window, &Stream[trig.StartSample], n * sizeof(ARSample_t)) == 0, "window contents after the skip");
+    }
+}
+
+int main(void){
+    ARSynth_t synth;
+    ARSynthInit(&synth, 0xBEEF);
+    ARSynthSetRandom(&synth, 0, 3);
+    ARSynthSetRandom(&synth, 1, 17);
+    ARSynthSetRandom(&synth, 2, 50);
+    ARSynthSetClock(&synth, 3, 40, 13, 5);
+    ARSynthFill(&synth, Stream, STREAM);
+
+    TestScan();
+    TestWindow();
+    TestLost();
+    TestOverwritten();
+    return HostTestEnd("TestARTrigger");
+}
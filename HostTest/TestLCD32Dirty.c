@@ -0,0 +1,90 @@
+/**
+ * @file TestLCD32Dirty.c
+ * @brief Host test of LCD32Dirty: region coverage and bus words for typical UI updates
+ * @details Regions must cover exactly the dirty tiles, once. The words a partial flush puts
+ *          on the bus (pixels plus the window command list of each region) are printed
+ *          next to the full-frame cost.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "LCD32Dirty.h"
+
+#define W               320
+#define H               240
+/// @brief Bus words of one address window: CASET + 4, PASET + 4, RAMWR
+#define WINDOW_WORDS    11
+
+/// @brief Words a dirty flush sends, regions counted in `Regions`
+static uint32_t FlushWords(const LCD32DirtyMap_t * Map, uint32_t * Regions){
+    static uint8_t cover[H][W];
+    memset(cover, 0, sizeof(cover));
+    uint32_t cursor = 0, words = 0, px = 0;
+    LCD32DirtyRect_t rect;
+    *Regions = 0;
+    while(LCD32DirtyNextRegion(Map, &cursor, &rect)){
+        HostCheck((rect.x >= 0) && (rect.y >= 0) && (rect.w > 0) && (rect.h > 0) &&
+                  (rect.x + rect.w <= W) && (rect.y + rect.h <= H),
+                  "region (%d, %d, %d, %d) off screen", rect.x, rect.y, rect.w, rect.h);
+        for(int32_t y = rect.y; y < rect.y + rect.h; y++){
+            for(int32_t x = rect.x; x < rect.x + rect.w; x++){
+                HostCheck(cover[y][x] == 0, "pixel (%d, %d) sent twice", x, y);
+                cover[y][x] = 1;
+            }
+        }
+        px += (uint32_t) rect.w * rect.h;
+        words += WINDOW_WORDS + (uint32_t) rect.w * rect.h;
+        (*Regions)++;
+    }
+    /// Every pixel of a dirty tile is sent, nothing else
+    for(int32_t y = 0; y < H; y++){
+        for(int32_t x = 0; x < W; x++){
+            uint32_t dirty = (Map->Rows[y >> LCD32_DIRTY_TILE_SHIFT] >> (x >> LCD32_DIRTY_TILE_SHIFT)) & 1;
+            HostCheck(cover[y][x] == dirty, "pixel (%d, %d): sent %u, dirty %u", x, y, cover[y][x], dirty);
+        }
+    }
+    HostCheck(px == LCD32DirtyPixelCount(Map), "pixel count %u, regions %u", LCD32DirtyPixelCount(Map), px);
+    return words;
+}
+
+/// @brief One UI update: mark, count, print against a full frame
+static void UiUpdate(const char * Name, int16_t r, int16_t c, int16_t h, int16_t w, uint32_t MaxWords){
+    LCD32DirtyMap_t map;
+    uint32_t regions;
+    LCD32DirtyReset(&map, W, H);
+    LCD32DirtyMarkRect(&map, r, c, h, w);
+    uint32_t words = FlushWords(&map, &regions);
+    printf("  %-24s %6u words in %2u regions (%5.1f %% of a full frame)\n", Name, words, regions,
+           100.0 * words / (W * H + WINDOW_WORDS));
+    HostCheck(words <= MaxWords, "%s: %u words, at most %u expected", Name, words, MaxWords);
+}
+
+int main(void){
+    printf("Words per flush, full frame %u:\n", W * H + WINDOW_WORDS);
+    UiUpdate("single pixel", 100, 200, 1, 1, 16 * 16 + WINDOW_WORDS);
+    UiUpdate("cursor readout 80x16", 4, 4, 16, 80, 2 * 16 * 96 + 2 * WINDOW_WORDS);
+    UiUpdate("vertical cursor line", 0, 150, H, 1, 16 * H + WINDOW_WORDS);
+    UiUpdate("status bar 320x12", H - 12, 0, 12, W, 16 * W + WINDOW_WORDS);
+    UiUpdate("full screen", 0, 0, H, W, W * H + WINDOW_WORDS);
+    UiUpdate("clipped rectangle", -20, 300, 50, 60, 4 * 16 * 16 + WINDOW_WORDS);
+
+    /// Random rectangle sets: exact coverage, no pixel twice
+    uint32_t seed = 0x1234567;
+    for(uint32_t round = 0; round < 200; round++){
+        LCD32DirtyMap_t map;
+        uint32_t regions;
+        LCD32DirtyReset(&map, W, H);
+        uint32_t num = 1 + HostRand(&seed) % 8;
+        for(uint32_t i = 0; i < num; i++){
+            int16_t r = (int16_t) (HostRand(&seed) % (H + 40)) - 20;
+            int16_t c = (int16_t) (HostRand(&seed) % (W + 40)) - 20;
+            int16_t h = (int16_t) (1 + HostRand(&seed) % 80);
+            int16_t w = (int16_t) (1 + HostRand(&seed) % 120);
+            LCD32DirtyMarkRect(&map, r, c, h, w);
+        }
+        FlushWords(&map, &regions);
+    }
+    return HostTestEnd("TestLCD32Dirty");
+}
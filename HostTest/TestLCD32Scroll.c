@@ -0,0 +1,225 @@
+/**
+ * @file TestLCD32Scroll.c
+ * @brief Host test of the LCD32 hardware scrolling against a model of the ILI9341 panel
+ * @details A bus hook plays the panel: MADCTL, CASET / PASET and RAMWR fill a frame memory
+ *          in gate / source order (MV exchanges the address counters, MY reverses the gate
+ *          lines, MX the sources), VSCRDEF and VSCRSADD pick the memory line each gate line
+ *          shows. For the four orientations and scroll areas at the start, in the middle and
+ *          at the end of the scroll axis, every pixel of the glass must show the canvas at
+ *          LCD32ScrollMap() after each LCD32ScrollPush(), single lines as well as pushes that
+ *          wrap or exceed the area, and the area must show the last pushed lines in order.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostP16.h"
+#include "LCD32.h"
+
+#define HOST_P16_BL     1
+#define GATES           LCD32_SCROLL_AXIS_LINES
+#define SOURCES         LCD32_SCROLL_LINE_PX
+#define PUSH_MAX        (GATES + 8)
+
+/// @brief Panel state seen through the bus
+typedef struct {
+    uint16_t    Gram[GATES][SOURCES];   ///< Frame memory, gate line by source
+    uint8_t     Madctl;
+    uint16_t    Cmd;                    ///< Last command
+    uint8_t     Param[8];
+    uint32_t    ParamNum;
+    uint32_t    Col0, Col1, Page0, Page1;
+    uint32_t    Col, Page;              ///< RAMWR address counters
+    uint32_t    Tfa, Vsa, Vsp;
+} Panel_t;
+
+static Panel_t Panel;
+static P16Lut_t Lut;
+static LCD32Dev_t * Dev;
+static Color_t Lines[PUSH_MAX * SOURCES];
+static uint32_t Pushed;                 ///< Lines pushed since the area was set
+
+/// @brief Gate line and source of address (column, page) under the current MADCTL
+static void PanelMap(uint32_t Col, uint32_t Page, uint32_t * Gate, uint32_t * Src){
+    uint32_t g = (Panel.Madctl & MADCTL_MV) ? Col : Page;
+    uint32_t s = (Panel.Madctl & MADCTL_MV) ? Page : Col;
+    *Gate = (Panel.Madctl & MADCTL_MY) ? (GATES - 1 - g) : g;
+    *Src = (Panel.Madctl & MADCTL_MX) ? (SOURCES - 1 - s) : s;
+}
+
+static void PanelOnWrite(uint32_t Word){
+    uint16_t v = (uint16_t) Word;
+    if((Word & HOST_BUS_RS) == 0){
+        Panel.Cmd = v & 0xFF;
+        Panel.ParamNum = 0;
+        if(Panel.Cmd == ILI9341_MEMORY_WRITE){
+            Panel.Col = Panel.Col0;
+            Panel.Page = Panel.Page0;
+        }
+        return;
+    }
+    if(Panel.Cmd == ILI9341_MEMORY_WRITE){
+        uint32_t g, s;
+        PanelMap(Panel.Col, Panel.Page, &g, &s);
+        if((g < GATES) && (s < SOURCES)){
+            Panel.Gram[g][s] = v;
+        }
+        if(++Panel.Col > Panel.Col1){
+            Panel.Col = Panel.Col0;
+            Panel.Page++;
+        }
+        return;
+    }
+    if(Panel.ParamNum < sizeof(Panel.Param)){
+        Panel.Param[Panel.ParamNum++] = (uint8_t) v;
+    }
+    const uint8_t * p = Panel.Param;
+    switch(Panel.Cmd){
+        case ILI9341_MEMORY_ACCESS_CONTROL:
+            Panel.Madctl = p[0];
+            break;
+        case ILI9341_COLUMN_ADDRESS_SET:
+            if(Panel.ParamNum == 4){
+                Panel.Col0 = ((uint32_t) p[0] << 8) | p[1];
+                Panel.Col1 = ((uint32_t) p[2] << 8) | p[3];
+            }
+            break;
+        case ILI9341_PAGE_ADDRESS_SET:
+            if(Panel.ParamNum == 4){
+                Panel.Page0 = ((uint32_t) p[0] << 8) | p[1];
+                Panel.Page1 = ((uint32_t) p[2] << 8) | p[3];
+            }
+            break;
+        case ILI9341_VERTICAL_SCROLL_DEFINITION:
+            if(Panel.ParamNum == 6){
+                Panel.Tfa = ((uint32_t) p[0] << 8) | p[1];
+                Panel.Vsa = ((uint32_t) p[2] << 8) | p[3];
+                HostCheck(Panel.Tfa + Panel.Vsa + (((uint32_t) p[4] << 8) | p[5]) == GATES,
+                          "VSCRDEF %u + %u + %u", Panel.Tfa, Panel.Vsa, ((uint32_t) p[4] << 8) | p[5]);
+            }
+            break;
+        case ILI9341_VERTICAL_SCROLL_START:
+            if(Panel.ParamNum == 2){
+                Panel.Vsp = ((uint32_t) p[0] << 8) | p[1];
+                HostCheck((Panel.Vsp >= Panel.Tfa) && (Panel.Vsp < Panel.Tfa + Panel.Vsa),
+                          "VSCRSADD %u outside the area %u + %u", Panel.Vsp, Panel.Tfa, Panel.Vsa);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/// @brief Pixel on the glass at screen (Row, Col): the scroll area shows memory from VSP on
+static uint16_t Glass(Dim_t Row, Dim_t Col){
+    uint32_t g, s;
+    PanelMap((uint32_t) Col, (uint32_t) Row, &g, &s);
+    if((g >= Panel.Tfa) && (g < Panel.Tfa + Panel.Vsa)){
+        g = Panel.Tfa + (g - Panel.Tfa + Panel.Vsp - Panel.Tfa) % Panel.Vsa;
+    }
+    return Panel.Gram[g][s];
+}
+
+/// @brief Pixel `Px` of pushed line `Line`
+static Color_t LineColor(uint32_t Line, uint32_t Px){
+    return (Color_t) ((Line * 0x9E37u) ^ (Px * 0x0101u) ^ 0x5A5A);
+}
+
+/// @brief Glass against the canvas through LCD32ScrollMap(), and the area against the last pushes
+static void CheckGlass(const char * Name){
+    HostGpioSync();
+    bool alongRows = (Dev->Orientation == LCD32_ORIENTATION_PORTRAIT) || (Dev->Orientation == LCD32_ORIENTATION_PORTRAIT_FLIP);
+    uint32_t bad = 0, order = 0;
+    for(Dim_t r = 0; r < Dev->Height; r++){
+        for(Dim_t c = 0; c < Dev->Width; c++){
+            Dim_t line = alongRows ? r : c, px = alongRows ? c : r;
+            Dim_t mapped = LCD32ScrollMap(Dev, line);
+            Color_t want = alongRows ? Dev->Canvas[(int32_t) mapped * Dev->Width + c] : Dev->Canvas[(int32_t) r * Dev->Width + mapped];
+            uint16_t got = Glass(r, c);
+            if((got != want) && (bad++ == 0)){
+                HostCheck(0, "%s: screen (%d, %d) shows 0x%04X, canvas line %d has 0x%04X", Name, r, c, got, mapped, want);
+            }
+            /// Screen line First + k shows push Pushed - Lines + k
+            Dim_t k = line - Dev->ScrollFirst;
+            if((Dev->ScrollLines > 0) && (k >= 0) && (k < Dev->ScrollLines) && (Pushed >= (uint32_t) Dev->ScrollLines)){
+                Color_t push = LineColor(Pushed - (uint32_t) Dev->ScrollLines + (uint32_t) k, (uint32_t) px);
+                if((got != push) && (order++ == 0)){
+                    HostCheck(0, "%s: screen line %d is not push %u", Name, line, Pushed - Dev->ScrollLines + k);
+                }
+            }
+        }
+    }
+    HostCheck(bad == 0, "%s: %u pixels differ from the mapped canvas", Name, bad);
+    HostCheck(order == 0, "%s: %u pixels out of push order", Name, order);
+}
+
+/// @brief Push `Num` new lines and check the glass
+static void Push(const char * Name, Dim_t Num){
+    for(Dim_t j = 0; j < Num; j++){
+        for(uint32_t i = 0; i < SOURCES; i++){
+            Lines[(uint32_t) j * SOURCES + i] = LineColor(Pushed + (uint32_t) j, i);
+        }
+    }
+    HostCheck(LCD32ScrollPush(Dev, Lines, Num) == STAT_OKE, "%s: push of %d refused", Name, Num);
+    Pushed += (uint32_t) Num;
+    CheckGlass(Name);
+}
+
+/// @brief One orientation: flushed canvas, areas at the start, middle and end, pushes that wrap
+static void TestOrientation(uint8_t Orientation){
+    static const Dim_t Areas[][2] = { { 40, 200 }, { 0, 100 }, { GATES - 77, 77 }, { 0, GATES } };
+    char name[64];
+    /// LCD32Init() pulses RST: the panel forgets its scroll area
+    Panel.Tfa = 0;
+    Panel.Vsa = GATES;
+    Panel.Vsp = 0;
+    Dev->Orientation = Orientation;
+    HostCheck(LCD32Init(Dev) == STAT_OKE, "orientation %u: init failed", Orientation);
+    for(int32_t i = 0; i < (int32_t) Dev->Width * Dev->Height; i++){
+        Dev->Canvas[i] = (Color_t) (i * 7 + Orientation);
+    }
+    LCD32FlushCanvas(Dev);
+    snprintf(name, sizeof(name), "orientation %u, no area", Orientation);
+    CheckGlass(name);
+
+    uint32_t seed = 0x5C0 + Orientation;
+    for(uint32_t a = 0; a < sizeof(Areas) / sizeof(Areas[0]); a++){
+        Dim_t first = Areas[a][0], lines = Areas[a][1];
+        snprintf(name, sizeof(name), "orientation %u, area %d + %d", Orientation, first, lines);
+        HostCheck(LCD32SetScrollArea(Dev, first, lines) == STAT_OKE, "%s: refused", name);
+        Pushed = 0;
+        CheckGlass(name);
+        /// Single lines, a push up to the wrap, one across it, one longer than the area
+        Push(name, 1);
+        Push(name, 3);
+        Push(name, lines - 4 - 1);
+        Push(name, 2);
+        Push(name, lines - 1);
+        Push(name, lines + 8);
+        for(uint32_t n = 0; n < 12; n++){
+            Push(name, (Dim_t) (1 + HostRand(&seed) % (uint32_t) lines));
+        }
+    }
+    /// Off again: the glass shows the canvas as is
+    HostCheck(LCD32SetScrollArea(Dev, 0, 0) == STAT_OKE, "orientation %u: area off refused", Orientation);
+    snprintf(name, sizeof(name), "orientation %u, area off", Orientation);
+    CheckGlass(name);
+}
+
+int main(void){
+    static const Pin_t Ctl[6] = { HOST_P16_RD, HOST_P16_WR, HOST_P16_CS, HOST_P16_RS, HOST_P16_RST, HOST_P16_BL };
+    HostQuiet = 1;
+    HostGpioReset(HostP16BoardPins, HOST_P16_WR, HOST_P16_RD, HOST_P16_RS);
+    HostBus.OnWrite = PanelOnWrite;
+    Dev = LCD32New();
+    HostCheck(Dev != NULL, "LCD32New failed");
+    HostCheck(LCD32Config(Dev, Ctl, HostP16BoardPins, &Lut) == STAT_OKE, "config refused");
+
+    TestOrientation(LCD32_ORIENTATION_PORTRAIT);
+    TestOrientation(LCD32_ORIENTATION_LANDSCAPE);
+    TestOrientation(LCD32_ORIENTATION_PORTRAIT_FLIP);
+    TestOrientation(LCD32_ORIENTATION_LANDSCAPE_FLIP);
+
+    LCD32Delete(Dev);
+    return HostTestEnd("TestLCD32Scroll");
+}
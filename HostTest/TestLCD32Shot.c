@@ -0,0 +1,332 @@
+/**
+ * @file TestLCD32Shot.c
+ * @brief Host test of LCD32Shot: QOI round trip and GRAM readback unpacking
+ * @details Images are pushed through LCD32QoiBegin() / Push() / End() in random slice sizes
+ *          and the bytes the sink collects are decoded by a plain QOI decoder written from
+ *          the specification: the pixels must come back as the RGB888 expansion of the
+ *          RGB565 input. Runs of 62 and 63, the staging buffer flush at
+ *          LCD32_SHOT_OUT_BYTES - 5, sink errors and LCD32ShotUnpack() on odd pixel counts
+ *          are checked on their own.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "LCD32Shot.h"
+
+#define IMG_W           97
+#define IMG_H           61
+#define IMG_PX          (IMG_W * IMG_H)
+#define OUT_MAX         (14 + IMG_PX * 5 + 8)
+
+/// @brief Sink collecting the encoded bytes
+typedef struct {
+    uint8_t     Buf[OUT_MAX];
+    uint32_t    Len;
+    uint32_t    Calls;
+    uint32_t    FirstLen;       ///< Bytes of the first call
+    uint32_t    MaxLen;         ///< Largest call
+    uint32_t    FailAt;         ///< Call number returning an error (0: never)
+} Sink_t;
+
+static uint16_t Img[IMG_PX + 16];
+static uint32_t Decoded[IMG_PX];
+static Sink_t Out;
+
+static int32_t SinkWrite(void * Ctx, const uint8_t * Data, uint32_t Len){
+    Sink_t * s = (Sink_t *) Ctx;
+    s->Calls++;
+    if(s->Calls == s->FailAt){
+        return -7;
+    }
+    if(s->Calls == 1){
+        s->FirstLen = Len;
+    }
+    s->MaxLen = (Len > s->MaxLen) ? Len : s->MaxLen;
+    if(s->Len + Len <= OUT_MAX){
+        memcpy(&s->Buf[s->Len], Data, Len);
+    }
+    s->Len += Len;
+    return 0;
+}
+
+/// @brief RGB565 to 0xRRGGBB, bit replication as the encoder documents it
+static uint32_t To888(uint16_t c){
+    uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    return (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+/// @brief QOI decoder after the specification, RGBA kept, 0xRRGGBB out
+/// @return Pixels decoded, or -1 on a malformed stream
+static int32_t QoiDecode(const uint8_t * In, uint32_t Len, uint32_t * W, uint32_t * H, uint32_t * Px, uint32_t PxMax){
+    if((Len < 22) || (memcmp(In, "qoif", 4) != 0) || (In[12] != 3) || (In[13] != 0)){
+        return -1;
+    }
+    *W = ((uint32_t) In[4] << 24) | ((uint32_t) In[5] << 16) | ((uint32_t) In[6] << 8) | In[7];
+    *H = ((uint32_t) In[8] << 24) | ((uint32_t) In[9] << 16) | ((uint32_t) In[10] << 8) | In[11];
+    uint32_t num = *W * *H;
+    if(num > PxMax){
+        return -1;
+    }
+    uint8_t index[64][4], px[4] = { 0, 0, 0, 255 };
+    memset(index, 0, sizeof(index));
+    uint32_t p = 14, run = 0, end = Len - 8;
+    for(uint32_t i = 0; i < num; i++){
+        if(run > 0){
+            run--;
+        } else if(p < end){
+            uint8_t b1 = In[p++];
+            if(b1 == 0xFE){
+                px[0] = In[p]; px[1] = In[p + 1]; px[2] = In[p + 2];
+                p += 3;
+            } else if(b1 == 0xFF){
+                px[0] = In[p]; px[1] = In[p + 1]; px[2] = In[p + 2]; px[3] = In[p + 3];
+                p += 4;
+            } else if((b1 & 0xC0) == 0x00){
+                memcpy(px, index[b1], 4);
+            } else if((b1 & 0xC0) == 0x40){
+                px[0] += ((b1 >> 4) & 3) - 2;
+                px[1] += ((b1 >> 2) & 3) - 2;
+                px[2] += (b1 & 3) - 2;
+            } else if((b1 & 0xC0) == 0x80){
+                uint8_t b2 = In[p++];
+                int32_t dg = (b1 & 0x3F) - 32;
+                px[0] += dg - 8 + ((b2 >> 4) & 0x0F);
+                px[1] += dg;
+                px[2] += dg - 8 + (b2 & 0x0F);
+            } else {
+                run = b1 & 0x3F;
+            }
+            memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63], px, 4);
+        } else {
+            return -1;
+        }
+        Px[i] = ((uint32_t) px[0] << 16) | ((uint32_t) px[1] << 8) | px[2];
+    }
+    static const uint8_t marker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    if((run != 0) || (p != end) || (memcmp(&In[end], marker, 8) != 0)){
+        return -1;
+    }
+    return (int32_t) num;
+}
+
+/// @brief Encode `Num` pixels of Img in slices of 1..MaxSlice, return the encoder's result
+static int32_t Encode(uint32_t W, uint32_t H, uint32_t MaxSlice, uint32_t * Seed){
+    static LCD32Qoi_t qoi;
+    memset(&Out, 0, sizeof(Out));
+    int32_t ret = LCD32QoiBegin(&qoi, W, H, SinkWrite, &Out);
+    for(uint32_t done = 0; (ret == 0) && (done < W * H); ){
+        uint32_t n = 1 + HostRand(Seed) % MaxSlice;
+        n = (n > W * H - done) ? (W * H - done) : n;
+        ret = LCD32QoiPush(&qoi, &Img[done], n);
+        done += n;
+    }
+    return (ret == 0) ? LCD32QoiEnd(&qoi) : ret;
+}
+
+/// @brief Round trip of the first W * H pixels of Img
+static void RoundTrip(const char * Name, uint32_t W, uint32_t H, uint32_t * Seed){
+    int32_t ret = Encode(W, H, 300, Seed);
+    HostCheck(ret == 0, "%s: encoder returned %d", Name, ret);
+    HostCheck(Out.MaxLen <= LCD32_SHOT_OUT_BYTES, "%s: sink handed %u bytes", Name, Out.MaxLen);
+    uint32_t w = 0, h = 0;
+    int32_t num = QoiDecode(Out.Buf, Out.Len, &w, &h, Decoded, IMG_PX);
+    HostCheck((num == (int32_t) (W * H)) && (w == W) && (h == H), "%s: decoded %d pixels, %ux%u", Name, num, w, h);
+    uint32_t bad = 0;
+    for(int32_t i = 0; i < num; i++){
+        bad += (Decoded[i] != To888(Img[i]));
+    }
+    HostCheck(bad == 0, "%s: %u pixels differ", Name, bad);
+    printf("  %-10s %3ux%-3u %6u bytes (%5.2f bytes / pixel), %u sink calls\n", Name, W, H, Out.Len,
+           (double) Out.Len / (W * H), Out.Calls);
+}
+
+static void TestImages(void){
+    uint32_t seed = 0x0A11CE;
+
+    memset(Img, 0, sizeof(Img));
+    RoundTrip("black", IMG_W, IMG_H, &seed);
+
+    for(uint32_t i = 0; i < IMG_PX; i++){
+        Img[i] = (uint16_t) HostRand(&seed);
+    }
+    RoundTrip("noise", IMG_W, IMG_H, &seed);
+
+    uint16_t block[(IMG_H / 8 + 1) * (IMG_W / 8 + 1)];
+    for(uint32_t i = 0; i < sizeof(block) / sizeof(block[0]); i++){
+        block[i] = (uint16_t) HostRand(&seed);
+    }
+    for(uint32_t y = 0; y < IMG_H; y++){
+        for(uint32_t x = 0; x < IMG_W; x++){
+            Img[y * IMG_W + x] = block[(y / 8) * (IMG_W / 8 + 1) + x / 8];
+        }
+    }
+    RoundTrip("blocks", IMG_W, IMG_H, &seed);
+
+    for(uint32_t y = 0; y < IMG_H; y++){
+        for(uint32_t x = 0; x < IMG_W; x++){
+            Img[y * IMG_W + x] = (uint16_t) ((((x * 31) / IMG_W) << 11) | (((y * 63) / IMG_H) << 5) | ((x + y) & 0x1F));
+        }
+    }
+    RoundTrip("gradient", IMG_W, IMG_H, &seed);
+
+    memset(Img, 0, sizeof(Img));
+    for(uint32_t i = 0; i < 40; i++){
+        Img[HostRand(&seed) % IMG_PX] = (uint16_t) HostRand(&seed);
+    }
+    RoundTrip("sparse", IMG_W, IMG_H, &seed);
+
+    for(uint32_t i = 0; i < 21; i++){
+        Img[i] = (uint16_t) HostRand(&seed);
+    }
+    Img[5] = Img[4];
+    Img[13] = 0;
+    RoundTrip("7x3", 7, 3, &seed);
+}
+
+/// @brief A run of 62 fills one chunk, 63 needs a second
+static void TestRuns(void){
+    uint32_t seed = 62;
+    static const uint8_t end[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+    memset(Img, 0, sizeof(Img));
+    HostCheck(Encode(62, 1, 7, &seed) == 0, "run 62: encoder");
+    HostCheck((Out.Len == 14 + 1 + 8) && (Out.Buf[14] == (0xC0 | 61)) && (memcmp(&Out.Buf[15], end, 8) == 0),
+              "run 62: %u bytes, chunk 0x%02X", Out.Len, Out.Buf[14]);
+
+    HostCheck(Encode(63, 1, 7, &seed) == 0, "run 63: encoder");
+    HostCheck((Out.Len == 14 + 2 + 8) && (Out.Buf[14] == (0xC0 | 61)) && (Out.Buf[15] == 0xC0),
+              "run 63: %u bytes, chunks 0x%02X 0x%02X", Out.Len, Out.Buf[14], Out.Buf[15]);
+
+    /// The same after a colour, runs counting from the second pixel
+    for(uint32_t len = 62; len <= 63; len++){
+        for(uint32_t i = 0; i <= len; i++){
+            Img[i] = 0x1234;
+        }
+        Img[len + 1] = 0x4321;
+        HostCheck(Encode(len + 2, 1, 5, &seed) == 0, "colour run %u: encoder", len);
+        uint32_t w, h;
+        int32_t num = QoiDecode(Out.Buf, Out.Len, &w, &h, Decoded, IMG_PX);
+        HostCheck(num == (int32_t) (len + 2), "colour run %u: decoded %d", len, num);
+        HostCheck((Decoded[len] == To888(0x1234)) && (Decoded[len + 1] == To888(Img[len + 1])),
+                  "colour run %u: pixels 0x%06X 0x%06X", len, Decoded[len], Decoded[len + 1]);
+        HostCheck(Out.Buf[18] == (0xC0 | 61), "colour run %u: chunk 0x%02X", len, Out.Buf[18]);
+    }
+}
+
+/// @brief Unique colours with a green step QOI can only write as OP_RGB (4 bytes)
+static uint16_t RgbOnly(uint32_t j){
+    return (uint16_t) ((((j >> 1) + 1) << 11) | ((j & 1) ? (32 << 5) : 0) | (j & 0x1F));
+}
+
+/// @brief `Rgb` OP_RGB pixels (14 + 4 * Rgb bytes staged), then pairs of a repeat and an
+///        OP_RGB pixel (5 bytes each) up to `Num` pixels
+static void BuildStaging(uint32_t Rgb, uint32_t Num){
+    uint32_t i = 0, j = 0;
+    while(j < Rgb){
+        Img[i++] = RgbOnly(j++);
+    }
+    while(i + 1 < Num){
+        Img[i] = Img[i - 1];
+        i++;
+        Img[i++] = RgbOnly(j++);
+    }
+}
+
+/// @brief Flush at LCD32_SHOT_OUT_BYTES - 5: a 5-byte pixel on 251 staged bytes still fits
+static void TestFlushBoundary(void){
+    uint32_t seed = 5;
+    /// 14 + 4 * 58 + 5 = 251 staged, the next pair adds 5: 256 in the first call
+    BuildStaging(58, 58 + 2 * 4);
+    HostCheck(Encode(58 + 2 * 4, 1, 1, &seed) == 0, "251: encoder");
+    HostCheck(Out.FirstLen == LCD32_SHOT_OUT_BYTES, "251 staged: first sink call %u bytes", Out.FirstLen);
+    /// 14 + 4 * 57 + 10 = 252 staged: flushed before the next pixel
+    BuildStaging(57, 57 + 2 * 4);
+    HostCheck(Encode(57 + 2 * 4, 1, 1, &seed) == 0, "252: encoder");
+    HostCheck(Out.FirstLen == LCD32_SHOT_OUT_BYTES - 4, "252 staged: first sink call %u bytes", Out.FirstLen);
+
+    /// Both decode, and so does every length around the end marker flush
+    for(uint32_t num = 50; num < 80; num++){
+        BuildStaging(num / 2, num);
+        HostCheck(Encode(num, 1, 1 + num % 4, &seed) == 0, "%u pixels: encoder", num);
+        uint32_t w, h, bad = 0;
+        int32_t got = QoiDecode(Out.Buf, Out.Len, &w, &h, Decoded, IMG_PX);
+        HostCheck(got == (int32_t) num, "%u pixels: decoded %d", num, got);
+        for(int32_t i = 0; i < got; i++){
+            bad += (Decoded[i] != To888(Img[i]));
+        }
+        HostCheck((bad == 0) && (Out.MaxLen <= LCD32_SHOT_OUT_BYTES), "%u pixels: %u differ, call of %u bytes",
+                  num, bad, Out.MaxLen);
+    }
+}
+
+/// @brief Sink errors stop the encoder and stick, short and long images are handled
+static void TestErrors(void){
+    static LCD32Qoi_t qoi;
+    uint32_t seed = 0xE7;
+    for(uint32_t i = 0; i < IMG_PX; i++){
+        Img[i] = (uint16_t) HostRand(&seed);
+    }
+    memset(&Out, 0, sizeof(Out));
+    Out.FailAt = 2;
+    HostCheck(LCD32QoiBegin(&qoi, IMG_W, IMG_H, SinkWrite, &Out) == 0, "begin");
+    HostCheck(LCD32QoiPush(&qoi, Img, IMG_PX) == -7, "push after a sink error");
+    HostCheck(LCD32QoiEnd(&qoi) == -7, "end after a sink error");
+    HostCheck(Out.Calls == 2, "sink called %u times after failing", Out.Calls);
+
+    memset(&Out, 0, sizeof(Out));
+    HostCheck(LCD32QoiBegin(&qoi, 0, 5, SinkWrite, &Out) == -1, "zero width");
+    HostCheck(LCD32QoiBegin(&qoi, 5, 5, NULL, &Out) == -1, "no sink");
+    HostCheck(LCD32QoiBegin(&qoi, 5, 5, SinkWrite, &Out) == 0, "5x5");
+    HostCheck(LCD32QoiPush(&qoi, Img, 24) == 0, "24 pixels");
+    HostCheck(LCD32QoiEnd(&qoi) == -1, "end one pixel short");
+    /// Pixels past the image are dropped
+    HostCheck(LCD32QoiPush(&qoi, &Img[24], 16) == 0, "16 pixels more");
+    HostCheck(LCD32QoiEnd(&qoi) == 0, "end");
+    uint32_t w, h;
+    HostCheck(QoiDecode(Out.Buf, Out.Len, &w, &h, Decoded, IMG_PX) == 25, "5x5 decode");
+}
+
+/// @brief Readback packing [R0 G0] [B0 R1] [G1 B1], 6 bits used per byte, for 1..9 and 101 pixels
+static void TestUnpack(void){
+    static const uint32_t counts[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 101 };
+    static uint16_t words[LCD32ShotWords(101) + 1], px[102];
+    uint32_t seed = 0x9341;
+    for(uint32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++){
+        uint32_t num = counts[c];
+        uint8_t bytes[2 * (LCD32ShotWords(101) + 1)];
+        for(uint32_t i = 0; i < num; i++){
+            Img[i] = (uint16_t) HostRand(&seed);
+            /// Unused low bits of each byte come back as junk
+            uint32_t junk = HostRand(&seed);
+            bytes[3 * i]     = (uint8_t) (((Img[i] >> 11) << 3) | (junk & 7));
+            bytes[3 * i + 1] = (uint8_t) ((((Img[i] >> 5) & 0x3F) << 2) | ((junk >> 3) & 3));
+            bytes[3 * i + 2] = (uint8_t) (((Img[i] & 0x1F) << 3) | ((junk >> 5) & 7));
+        }
+        if(num & 1){
+            bytes[3 * num] = (uint8_t) HostRand(&seed);
+        }
+        for(uint32_t k = 0; k < LCD32ShotWords(num); k++){
+            words[k] = (uint16_t) ((bytes[2 * k] << 8) | bytes[2 * k + 1]);
+        }
+        px[num] = 0xBEEF;
+        LCD32ShotUnpack(words, px, num);
+        uint32_t bad = 0;
+        for(uint32_t i = 0; i < num; i++){
+            bad += (px[i] != Img[i]);
+        }
+        HostCheck(bad == 0, "unpack %u pixels: %u differ", num, bad);
+        HostCheck(px[num] == 0xBEEF, "unpack %u pixels: wrote past the end", num);
+    }
+}
+
+int main(void){
+    printf("QOI round trip:\n");
+    TestImages();
+    TestRuns();
+    TestFlushBoundary();
+    TestErrors();
+    TestUnpack();
+    return HostTestEnd("TestLCD32Shot");
+}
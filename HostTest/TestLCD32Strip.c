@@ -0,0 +1,151 @@
+/**
+ * @file TestLCD32Strip.c
+ * @brief Host test of the LCD32 strip renderer: bus words against the canvas path
+ * @details The same scenes are drawn once on the full-screen canvas and flushed, once through
+ *          the display list and LCD32FlushStrips(). The words latched on the bus model (window
+ *          commands, their parameters and every pixel) must be equal, word for word. Scenes
+ *          put lines, thick lines, rectangles, polygons, text and pixels on the band edges and
+ *          partly off screen; random scenes follow. Host time of both paths is printed.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "HostP16.h"
+#include "LCD32.h"
+
+#define HOST_P16_BL     1
+#define SCENES          30
+#define PRIMITIVES      60
+
+static P16Lut_t Lut;
+static LCD32Dev_t * Dev;
+static uint32_t * Cap[2];
+static uint32_t CapMax;
+
+/// @brief Fixed scene: every primitive kind across the 16-row band edges and the screen edges
+static void Scene(void){
+    static const LCDPoint_t Star[] = { { 160, 100 }, { 190, 190 }, { 100, 130 }, { 220, 130 }, { 130, 190 } };
+    static const LCDPoint_t Hull[] = { { -20, 300 }, { 60, 250 }, { 120, 330 }, { 40, 500 } };
+    LCD32FillCanvas(Dev, 0x0841);
+    LCD32DrawLine(Dev, 0, 0, Dev->Height - 1, Dev->Width - 1, 0xF800);
+    LCD32DrawLine(Dev, 15, 0, 15, Dev->Width - 1, 0x07E0);
+    LCD32DrawLine(Dev, 16, 0, 16, Dev->Width - 1, 0x001F);
+    LCD32DrawLine(Dev, -40, 10, 60, 11, 0xFFE0);
+    LCD32DrawThickLine(Dev, 30, 20, 200, 300, 0x07FF, 7);
+    LCD32DrawThickLine(Dev, 47, 5, 49, 250, 0xF81F, 4);
+    LCD32DrawEmptyRect(Dev, 10, 10, 70, 150, 3, 0xFFFF);
+    LCD32DrawEmptyRect(Dev, -5, Dev->Width - 40, 33, Dev->Width + 10, 2, 0x7BEF);
+    LCD32DrawPolygon(Dev, Star, 5, 0xFD20);
+    LCD32DrawFilledPolygon(Dev, Star, 5, 0x8010);
+    LCD32DrawFilledPolygon(Dev, Hull, 4, 0x03E0);
+    LCD32DrawText(Dev, 31, 4, "Strip 0123 | band edge", &FreeSerif9pt7b, 0xFFFF);
+    LCD32DrawText(Dev, Dev->Height - 2, 4, "cut at the bottom\nand gone", &FreeSerifBoldItalic12pt7b, 0xFFE0);
+    LCD32DrawChar(Dev, 250, Dev->Width - 8, 'W', &FreeSerifBoldItalic24pt7b, 0x07E0);
+    for(Dim_t c = 0; c < Dev->Width; c += 7){
+        LCD32SetCanvasPixel(Dev, (Dim_t) (c % 48), c, 0xFFFF);
+    }
+    LCD32SetCanvasPixel(Dev, Dev->Height - 1, Dev->Width - 1, 0xF800);
+    LCD32SetCanvasPixel(Dev, Dev->Height, 0, 0xF800);
+    LCD32SetCanvasPixel(Dev, -1, 5, 0xF800);
+}
+
+static Dim_t Coord(uint32_t * Seed, Dim_t Size){
+    return (Dim_t) ((int32_t) (HostRand(Seed) % (uint32_t) (Size + 80)) - 40);
+}
+
+/// @brief Random scene of `PRIMITIVES` primitives from `Seed`
+static uint32_t RandSeed;
+static void RandomScene(void){
+    uint32_t seed = RandSeed;
+    Dim_t h = Dev->Height, w = Dev->Width;
+    LCD32FillCanvas(Dev, (Color_t) HostRand(&seed));
+    for(uint32_t n = 0; n < PRIMITIVES; n++){
+        Color_t color = (Color_t) HostRand(&seed);
+        LCDPoint_t pts[6];
+        uint32_t num = 3 + HostRand(&seed) % 4;
+        for(uint32_t k = 0; k < num; k++){
+            pts[k].row = Coord(&seed, h);
+            pts[k].col = Coord(&seed, w);
+        }
+        Dim_t r0 = Coord(&seed, h), c0 = Coord(&seed, w), r1 = Coord(&seed, h), c1 = Coord(&seed, w);
+        switch(HostRand(&seed) % 7){
+            case 0: LCD32DrawLine(Dev, r0, c0, r1, c1, color); break;
+            case 1: LCD32DrawThickLine(Dev, r0, c0, r1, c1, color, (Dim_t) (1 + HostRand(&seed) % 9)); break;
+            case 2: LCD32DrawEmptyRect(Dev, Min(r0, r1), Min(c0, c1), Max(r0, r1), Max(c0, c1), (Dim_t) (1 + HostRand(&seed) % 5), color); break;
+            case 3: LCD32DrawPolygon(Dev, pts, num, color); break;
+            case 4: LCD32DrawFilledPolygon(Dev, pts, num, color); break;
+            case 5: LCD32DrawText(Dev, r0, c0, "Ag 16 rows", &FreeSerif9pt7b, color); break;
+            default: LCD32SetCanvasPixel(Dev, r0, c0, color); break;
+        }
+    }
+}
+
+/// @brief Draw and flush in `Mode`, bus words into Cap[Mode]; host ns of draw + flush
+static uint64_t Frame(uint32_t Mode, void (*Draw)(void)){
+    HostCheck(LCD32SetRenderMode(Dev, Mode) == STAT_OKE, "render mode %u refused", Mode);
+    HostGpioSync();
+    HostBus.Cap = Cap[Mode];
+    HostBus.CapMax = CapMax;
+    HostBus.CapNum = 0;
+    uint64_t t0 = HostNowNs();
+    Draw();
+    if(Mode == LCD32_RENDER_STRIP){
+        HostCheck(Dev->Strip->List.Dropped == 0, "%u commands dropped", Dev->Strip->List.Dropped);
+        HostCheck(LCD32FlushStrips(Dev) == STAT_OKE, "strip flush failed");
+    } else {
+        LCD32FlushCanvas(Dev);
+    }
+    uint64_t ns = HostNowNs() - t0;
+    HostGpioSync();
+    return ns;
+}
+
+/// @brief Both paths of one scene, word for word
+static void Compare(const char * Name, void (*Draw)(void), uint64_t * CanvasNs, uint64_t * StripNs){
+    *CanvasNs += Frame(LCD32_RENDER_CANVAS, Draw);
+    uint32_t num = HostBus.CapNum;
+    *StripNs += Frame(LCD32_RENDER_STRIP, Draw);
+    uint32_t pixels = (uint32_t) Dev->Width * Dev->Height;
+    HostCheck(num >= pixels, "%s: %u words for %u pixels", Name, num, pixels);
+    HostCheck(HostBus.CapNum == num, "%s: strip sent %u words, canvas %u", Name, HostBus.CapNum, num);
+    for(uint32_t n = 0; (n < num) && (n < HostBus.CapNum); n++){
+        if(Cap[0][n] != Cap[1][n]){
+            uint32_t px = n - (num - pixels);
+            HostCheck(0, "%s: word %u (row %u, col %u): strip 0x%05X, canvas 0x%05X", Name, n,
+                      px / Dev->Width, px % Dev->Width, Cap[1][n], Cap[0][n]);
+            break;
+        }
+    }
+}
+
+int main(void){
+    static const Pin_t Ctl[6] = { HOST_P16_RD, HOST_P16_WR, HOST_P16_CS, HOST_P16_RS, HOST_P16_RST, HOST_P16_BL };
+    HostQuiet = 1;
+    HostGpioReset(HostP16BoardPins, HOST_P16_WR, HOST_P16_RD, HOST_P16_RS);
+    Dev = LCD32New();
+    HostCheck(Dev != NULL, "LCD32New failed");
+    HostCheck(LCD32Config(Dev, Ctl, HostP16BoardPins, &Lut) == STAT_OKE, "config refused");
+    HostCheck(LCD32Init(Dev) == STAT_OKE, "init failed");
+    CapMax = (uint32_t) Dev->Width * Dev->Height + 64;
+    Cap[0] = malloc(CapMax * sizeof(uint32_t));
+    Cap[1] = malloc(CapMax * sizeof(uint32_t));
+
+    uint64_t canvasNs = 0, stripNs = 0;
+    Compare("fixed scene", Scene, &canvasNs, &stripNs);
+    canvasNs = stripNs = 0;
+    for(uint32_t s = 0; s < SCENES; s++){
+        char name[32];
+        snprintf(name, sizeof(name), "random scene %u", s);
+        RandSeed = 0x5C3E + s;
+        Compare(name, RandomScene, &canvasNs, &stripNs);
+    }
+    printf("  %ux%u, %u primitives: canvas %.2f ms, strips %.2f ms per frame on the host (draw + flush)\n",
+           Dev->Width, Dev->Height, PRIMITIVES, canvasNs / (SCENES * 1e6), stripNs / (SCENES * 1e6));
+
+    free(Cap[0]);
+    free(Cap[1]);
+    LCD32Delete(Dev);
+    return HostTestEnd("TestLCD32Strip");
+}
@@ -0,0 +1,114 @@
+/**
+ * @file TestP16ComBusDir.c
+ * @brief Host test of the P16Com read paths: bus turn-around and sampled words
+ * @details Single and burst reads of words fed by the bus model must come back intact, with
+ *          every data driver off at each RD strobe and back on afterwards. The turn-around
+ *          must be made of output-enable register stores only (one per bank holding data
+ *          pins, per direction) and never call gpio_config(). P16ComReadBenchmark() must
+ *          leave the bus as it found it. Stores and host time per word are printed.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostP16.h"
+
+#define WORDS           2048
+
+/// @brief A map with the high byte above GPIO32: two banks to turn around
+static const Pin_t WidePins[16] = { 18, 12, 17, 11, 16, 10, 15, 9, 33, 34, 35, 36, 37, 38, 39, 40 };
+
+static P16Lut_t Lut;
+static P16Dev_t Dev;
+static uint16_t Feed[WORDS];
+static P16Data_t Got[WORDS];
+
+static void Feeder(uint32_t Seed){
+    for(uint32_t n = 0; n < WORDS; n++){
+        Feed[n] = (uint16_t) HostRand(&Seed);
+    }
+    HostGpioSync();
+    HostBus.Feed = Feed;
+    HostBus.FeedNum = WORDS;
+    HostBus.FeedPos = 0;
+    HostBus.Accesses = 0;
+    HostBus.OeStores = 0;
+    HostBus.Contention = 0;
+}
+
+/// @brief Every data driver on, as P16COM_DB_NORMAL_OUTPUT_EN leaves the bus between transfers
+static uint32_t DriversOn(void){
+    HostGpioSync();
+    return ((HostGpioRegs.enable & Dev.DatOeLo) == Dev.DatOeLo) &&
+           ((HostGpioRegs.enable1.val & Dev.DatOeHi) == Dev.DatOeHi);
+}
+
+static void TestReads(const char * Name, const Pin_t * Pins){
+    HostP16Open(&Dev, &Lut, Pins);
+    uint32_t banks = 1 + (Dev.DatOeHi != 0);
+    HostCheck(DriversOn(), "%s: drivers off after init", Name);
+    uint32_t configs = HostGpioConfigCalls;
+
+    /// Single reads: a turn-around pair each
+    Feeder(0xBEEF);
+    uint32_t bad = 0;
+    for(uint32_t n = 0; n < 256; n++){
+        bad += (P16ComRead(&Dev) != Feed[n]);
+    }
+    HostGpioSync();
+    HostCheck(bad == 0, "%s: %u single reads wrong", Name, bad);
+    HostCheck(HostBus.OeStores == 256 * 2 * banks, "%s: %u enable stores for 256 reads", Name, HostBus.OeStores);
+    HostCheck(HostBus.Contention == 0, "%s: %u pins driven during single reads", Name, HostBus.Contention);
+    HostCheck(DriversOn(), "%s: drivers off after single reads", Name);
+    uint32_t singleStores = HostBus.Accesses;
+
+    /// Burst: one pair for the whole array
+    Feeder(0xCAFE);
+    P16ComReadArray(&Dev, Got, WORDS);
+    HostGpioSync();
+    HostCheck(memcmp(Got, Feed, sizeof(Got)) == 0, "%s: burst words wrong", Name);
+    HostCheck(HostBus.OeStores == 2 * banks, "%s: %u enable stores for a burst", Name, HostBus.OeStores);
+    HostCheck(HostBus.Contention == 0, "%s: %u pins driven during the burst", Name, HostBus.Contention);
+    HostCheck(DriversOn(), "%s: drivers off after the burst", Name);
+    HostCheck(HostGpioConfigCalls == configs, "%s: gpio_config() called %u times by reads", Name, HostGpioConfigCalls - configs);
+
+    /// Host time is only a relative figure: every register access is a call into the model
+    Feeder(0x5EED);
+    uint64_t t0 = HostNowNs();
+    for(uint32_t r = 0; r < 50; r++){
+        HostBus.FeedPos = 0;
+        P16ComReadArray(&Dev, Got, WORDS);
+    }
+    double ns = (double) (HostNowNs() - t0) / (50.0 * WORDS);
+    printf("  %-8s single read %.1f register accesses, burst %.2f per word, %.1f ns per burst word on the host\n",
+           Name, singleStores / 256.0, (double) HostBus.Accesses / (50.0 * WORDS), ns);
+
+    /// The benchmark deselects the panel and hands the bus back driven
+    HostCheck(P16ComReadBenchmark(&Dev, Got, 64, 2) == STAT_OKE, "%s: benchmark refused", Name);
+    HostCheck(DriversOn(), "%s: drivers off after the benchmark", Name);
+    HostCheck((HostGpioRegs.out & Mask32(HOST_P16_CS)) != 0, "%s: CS low after the benchmark", Name);
+    HostCheck(P16ComReadBenchmark(&Dev, NULL, 64, 2) == STAT_ERR_NULL, "%s: NULL buffer accepted", Name);
+    HostCheck(P16ComReadBenchmark(&Dev, Got, 64, 0) == STAT_ERR_INVALID_SIZE, "%s: 0 rounds accepted", Name);
+}
+
+/// @brief A write after a read goes out on driven pins
+static void TestWriteAfterRead(void){
+    static uint32_t cap[4];
+    HostP16Open(&Dev, &Lut, HostP16BoardPins);
+    Feeder(0x1);
+    P16ComRead(&Dev);
+    HostBus.Cap = cap;
+    HostBus.CapMax = 4;
+    P16SetHighRegSelPin(&Dev);
+    P16ComWrite(&Dev, 0x5AA5);
+    HostGpioSync();
+    HostCheck((HostBus.CapNum == 1) && (cap[0] == (0x5AA5 | HOST_BUS_RS)), "write after read: %u words, 0x%05X", HostBus.CapNum, cap[0]);
+    HostCheck(DriversOn(), "drivers off after the write");
+}
+
+int main(void){
+    TestReads("compact", HostP16BoardPins);
+    TestReads("wide", WidePins);
+    TestWriteAfterRead();
+    return HostTestEnd("TestP16ComBusDir");
+}
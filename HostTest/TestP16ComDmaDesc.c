@@ -0,0 +1,106 @@
+/**
+ * @file TestP16ComDmaDesc.c
+ * @brief Host test of the P16Com GDMA descriptor chains: chunking, EOF marks and replay
+ * @details Chains are built for sizes around the chunk size and for a full 320x240 RGB565
+ *          frame. Every link must carry at most P16COM_DMA_DESC_CHUNK bytes, all but the
+ *          last exactly that, point into the source in order and be owned by the DMA, with
+ *          suc_eof on the last link only; P16ComDmaDescReplay() must give back the source
+ *          byte for byte. Odd and zero sizes, too few descriptors and malformed chains
+ *          must be refused.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "HostTest.h"
+#include "P16ComDmaDesc.h"
+
+#define FRAME_BYTES     (320 * 240 * 2)
+#define DESC_MAX        (P16ComDmaDescCount(FRAME_BYTES) + 1)
+
+static P16DmaDesc_t Descs[DESC_MAX];
+static uint8_t Src[FRAME_BYTES];
+static uint8_t Out[FRAME_BYTES];
+
+/// @brief Build `Bytes` bytes of Src, check every link and the replay
+static void TestSize(uint32_t Bytes){
+    uint32_t exp = (Bytes + P16COM_DMA_DESC_CHUNK - 1) / P16COM_DMA_DESC_CHUNK;
+    int32_t num = P16ComDmaDescBuild(Descs, DESC_MAX, Src, Bytes);
+    HostCheck(num == (int32_t) exp, "%u bytes: %d links, expected %u", Bytes, num, exp);
+    if(num != (int32_t) exp){
+        return;
+    }
+
+    uint32_t off = 0, eofs = 0;
+    for(uint32_t i = 0; i < exp; i++){
+        const P16DmaDesc_t * d = &Descs[i];
+        uint32_t len = (i < exp - 1) ? P16COM_DMA_DESC_CHUNK : Bytes - off;
+        HostCheck((d->dw0.length == len) && (d->dw0.size == len), "%u bytes, link %u: %u / %u bytes, expected %u",
+                  Bytes, i, d->dw0.length, d->dw0.size, len);
+        HostCheck(d->buffer == &Src[off], "%u bytes, link %u: buffer at offset %ld", Bytes, i,
+                  (long) ((const uint8_t *) d->buffer - Src));
+        HostCheck(d->dw0.owner == P16COM_DMA_DESC_OWNER_DMA, "%u bytes, link %u: CPU owned", Bytes, i);
+        HostCheck(d->next == ((i < exp - 1) ? &Descs[i + 1] : NULL), "%u bytes, link %u: next", Bytes, i);
+        HostCheck(d->dw0.suc_eof == (i == exp - 1), "%u bytes, link %u: suc_eof %u", Bytes, i, d->dw0.suc_eof);
+        eofs += d->dw0.suc_eof;
+        off += d->dw0.length;
+    }
+    HostCheck((off == Bytes) && (eofs == 1), "%u bytes: %u carried, %u EOF marks", Bytes, off, eofs);
+
+    memset(Out, 0xEE, sizeof(Out));
+    HostCheck(P16ComDmaDescReplay(Descs, Out, sizeof(Out)) == (int32_t) Bytes, "%u bytes: replay length", Bytes);
+    HostCheck(memcmp(Out, Src, Bytes) == 0, "%u bytes: replayed payload differs", Bytes);
+    HostCheck(P16ComDmaDescReplay(Descs, NULL, 0) == (int32_t) Bytes, "%u bytes: counting replay", Bytes);
+    if(Bytes > 2){
+        HostCheck(P16ComDmaDescReplay(Descs, Out, Bytes - 2) == STAT_ERR_OVERFLOW, "%u bytes: short output accepted", Bytes);
+    }
+
+    /// One descriptor short of the chain
+    HostCheck(P16ComDmaDescBuild(Descs, exp - 1, Src, Bytes) == STAT_ERR_OVERFLOW, "%u bytes in %u links accepted", Bytes, exp - 1);
+}
+
+/// @brief Sizes the builder refuses and chains the engine would stop on
+static void TestRefused(void){
+    HostCheck(P16ComDmaDescBuild(Descs, DESC_MAX, Src, 0) == STAT_ERR_INVALID_SIZE, "0 bytes accepted");
+    HostCheck(P16ComDmaDescBuild(Descs, DESC_MAX, Src, 1) == STAT_ERR_INVALID_SIZE, "1 byte accepted");
+    HostCheck(P16ComDmaDescBuild(Descs, DESC_MAX, Src, P16COM_DMA_DESC_CHUNK + 1) == STAT_ERR_INVALID_SIZE, "odd size accepted");
+    HostCheck(P16ComDmaDescBuild(NULL, DESC_MAX, Src, 2) == STAT_ERR_NULL, "NULL descriptors accepted");
+    HostCheck(P16ComDmaDescBuild(Descs, DESC_MAX, NULL, 2) == STAT_ERR_NULL, "NULL buffer accepted");
+    HostCheck(P16ComDmaDescBuild(Descs, 0, Src, 2) == STAT_ERR_OVERFLOW, "no descriptors accepted");
+    HostCheck(P16ComDmaDescReplay(NULL, Out, sizeof(Out)) == STAT_ERR_NULL, "NULL chain replayed");
+
+    uint32_t bytes = 3 * P16COM_DMA_DESC_CHUNK;
+    P16ComDmaDescBuild(Descs, DESC_MAX, Src, bytes);
+    Descs[1].dw0.owner = P16COM_DMA_DESC_OWNER_CPU;
+    HostCheck(P16ComDmaDescReplay(Descs, Out, sizeof(Out)) == STAT_ERR_INVALID_STATE, "CPU-owned link replayed");
+    P16ComDmaDescBuild(Descs, DESC_MAX, Src, bytes);
+    Descs[2].dw0.suc_eof = 0;
+    HostCheck(P16ComDmaDescReplay(Descs, Out, sizeof(Out)) == STAT_ERR_INVALID_STATE, "chain without EOF replayed");
+    P16ComDmaDescBuild(Descs, DESC_MAX, Src, bytes);
+    Descs[0].dw0.length = P16COM_DMA_DESC_CHUNK;
+    Descs[0].dw0.size = P16COM_DMA_DESC_CHUNK - 2;
+    HostCheck(P16ComDmaDescReplay(Descs, Out, sizeof(Out)) == STAT_ERR_INVALID_SIZE, "length past size replayed");
+}
+
+int main(void){
+    uint32_t seed = 0xD3A;
+    for(uint32_t i = 0; i < FRAME_BYTES; i++){
+        Src[i] = (uint8_t) HostRand(&seed);
+    }
+    HostCheck(P16COM_DMA_DESC_CHUNK <= P16COM_DMA_DESC_LEN_MAX, "chunk does not fit the length field");
+
+    TestRefused();
+    static const uint32_t Sizes[] = { 2, 64, P16COM_DMA_DESC_CHUNK - 2, P16COM_DMA_DESC_CHUNK, P16COM_DMA_DESC_CHUNK + 2,
+                                      2 * P16COM_DMA_DESC_CHUNK - 2, 2 * P16COM_DMA_DESC_CHUNK, 2 * P16COM_DMA_DESC_CHUNK + 2,
+                                      7 * P16COM_DMA_DESC_CHUNK, 320 * 16 * 2, FRAME_BYTES - 2, FRAME_BYTES };
+    for(uint32_t s = 0; s < sizeof(Sizes) / sizeof(Sizes[0]); s++){
+        TestSize(Sizes[s]);
+    }
+    /// Random even sizes
+    for(uint32_t n = 0; n < 200; n++){
+        TestSize(2 + 2 * (HostRand(&seed) % (FRAME_BYTES / 2)));
+    }
+    printf("  full frame: %u bytes in %u links\n", FRAME_BYTES, (uint32_t) P16ComDmaDescCount(FRAME_BYTES));
+    return HostTestEnd("TestP16ComDmaDesc");
+}
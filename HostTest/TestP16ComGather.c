@@ -0,0 +1,182 @@
+/**
+ * @file TestP16ComGather.c
+ * @brief Host test of the P16Com read gather: pin runs, byte-slice tables and bit loop
+ * @details Random pin maps of three shapes (a few runs of consecutive GPIOs, pins scattered
+ *          over at most four port bytes, pins scattered over the whole port) must select the
+ *          run, table and loop gathers respectively, and P16ComGather() must return the same
+ *          word as a pin-by-pin reference for random port snapshots. The board map is read
+ *          end to end through P16ComReadArray(). Host time per gathered word of each mode is
+ *          printed.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostP16.h"
+
+#define MAPS            200
+#define SNAPSHOTS       2000
+#define GPIO_NUM        49
+
+/// @brief Gather of maps over a few port bytes (the bit loop without the read tables)
+#if (P16COM_RD_GATHER_TABLE_EN == 1)
+#define MODE_BYTES      P16COM_RD_LUT
+#else
+#define MODE_BYTES      P16COM_RD_LOOP
+#endif
+
+static P16Lut_t Lut;
+static P16Dev_t Dev;
+
+/// @brief Word on pins `Pins` of the port snapshot, one pin at a time
+static P16Data_t Reference(const Pin_t * Pins, uint32_t Lo, uint32_t Hi){
+    uint32_t val = 0;
+    for(uint32_t i = 0; i < 16; i++){
+        uint32_t bit = (Pins[i] < 32) ? (Lo >> Pins[i]) : (Hi >> (Pins[i] - 32));
+        val |= (bit & 1) << i;
+    }
+    return (P16Data_t) val;
+}
+
+/// @brief 16 distinct GPIOs out of `Pool`, in random order
+static void Pick(Pin_t * Pins, const Pin_t * Pool, uint32_t PoolNum, uint32_t * Seed){
+    Pin_t pool[64];
+    memcpy(pool, Pool, PoolNum * sizeof(Pin_t));
+    for(uint32_t i = 0; i < 16; i++){
+        uint32_t k = i + HostRand(Seed) % (PoolNum - i);
+        Pin_t t = pool[i];
+        pool[i] = pool[k];
+        pool[k] = t;
+        Pins[i] = pool[i];
+    }
+}
+
+/// @brief Shape 0: 1-4 runs of consecutive GPIOs (a run does not cross GPIO32)
+static void MapRuns(Pin_t * Pins, uint32_t * Seed){
+    uint32_t runs = 1 + HostRand(Seed) % P16COM_RD_PART_MAX;
+    uint32_t i = 0;
+    uint64_t used = 0;
+    for(uint32_t r = 0; r < runs; r++){
+        uint32_t len = (r == runs - 1) ? 16 - i : 1 + HostRand(Seed) % (16 - i - (runs - 1 - r));
+        Pin_t base;
+        uint64_t span = ((1ULL << len) - 1);
+        do {
+            base = (Pin_t) (HostRand(Seed) % (GPIO_NUM - len + 1));
+        } while(((base >> 5) != ((base + (Pin_t) len - 1) >> 5)) || (used & (span << base)) ||
+                ((r > 0) && (base == Pins[i - 1] + 1)));
+        used |= span << base;
+        for(uint32_t k = 0; k < len; k++){
+            Pins[i++] = (Pin_t) (base + (Pin_t) k);
+        }
+    }
+}
+
+/// @brief Shape 1: scattered over 2-4 port bytes
+static void MapBytes(Pin_t * Pins, uint32_t * Seed){
+    Pin_t pool[32];
+    uint32_t num = 0;
+    uint32_t bytes = 2 + HostRand(Seed) % 3;
+    uint32_t taken = 0;
+    for(uint32_t b = 0; b < bytes; b++){
+        uint32_t byte;
+        do {
+            byte = HostRand(Seed) % (GPIO_NUM / 8);
+        } while(taken & (1UL << byte));
+        taken |= 1UL << byte;
+        for(uint32_t k = 0; k < 8; k++){
+            pool[num++] = (Pin_t) (byte * 8 + k);
+        }
+    }
+    Pick(Pins, pool, num, Seed);
+}
+
+/// @brief Shape 2: anywhere in the port
+static void MapSpread(Pin_t * Pins, uint32_t * Seed){
+    Pin_t pool[GPIO_NUM];
+    for(uint32_t k = 0; k < GPIO_NUM; k++){
+        pool[k] = (Pin_t) k;
+    }
+    Pick(Pins, pool, GPIO_NUM, Seed);
+}
+
+/// @brief Gather of random snapshots against the reference, `Mode` expected for the shape
+static void TestShape(const char * Name, void (*Map)(Pin_t *, uint32_t *), uint32_t Mode){
+    uint32_t seed = 0xC0DE + Mode;
+    uint32_t wrongMode = 0, wrongWord = 0, spans = 0;
+    for(uint32_t m = 0; m < MAPS; m++){
+        Pin_t pins[16];
+        Map(pins, &seed);
+        Dev = (P16Dev_t) { 0 };
+        HostCheck(P16ComConfigDat(&Dev, pins, &Lut) == STAT_OKE, "%s: map %u refused", Name, m);
+        /// Only maps of one shape can be sure of their mode: a spread map may still fit 4 bytes
+        if((Mode != P16COM_RD_LOOP) && (Dev.RdMode != Mode)){
+            wrongMode++;
+        }
+        spans += (Dev.RdMode == Mode);
+        for(uint32_t s = 0; s < SNAPSHOTS; s++){
+            uint32_t lo = HostRand(&seed), hi = HostRand(&seed);
+            wrongWord += (P16ComGather(&Dev, lo, hi) != Reference(pins, lo, hi));
+        }
+    }
+    HostCheck(wrongMode == 0, "%s: %u maps with another gather", Name, wrongMode);
+    HostCheck(wrongWord == 0, "%s: %u words wrong", Name, wrongWord);
+    HostCheck(spans > MAPS / 2, "%s: only %u maps in mode %u", Name, spans, Mode);
+}
+
+/// @brief Host time per gathered word of one map
+static void Bench(const char * Name, void (*Map)(Pin_t *, uint32_t *), uint32_t Mode){
+    uint32_t seed = 0xB0B + Mode;
+    Pin_t pins[16];
+    do {
+        Map(pins, &seed);
+        Dev = (P16Dev_t) { 0 };
+        P16ComConfigDat(&Dev, pins, &Lut);
+    } while(Dev.RdMode != Mode);
+    static uint32_t port[1024];
+    for(uint32_t k = 0; k < 1024; k++){
+        port[k] = HostRand(&seed);
+    }
+    volatile uint32_t sink = 0;
+    uint64_t t0 = HostNowNs();
+    for(uint32_t r = 0; r < 4000; r++){
+        uint32_t acc = 0;
+        for(uint32_t k = 0; k < 1024; k += 2){
+            acc ^= P16ComGather(&Dev, port[k], port[k + 1]);
+        }
+        sink ^= acc;
+    }
+    double ns = (double) (HostNowNs() - t0) / (4000.0 * 512);
+    printf("  %-7s %u parts, %.2f ns per word on the host\n", Name, Dev.RdPartNum, ns);
+    (void) sink;
+}
+
+/// @brief The board map through the read path: three port bytes
+static void TestBoard(void){
+    static uint16_t feed[512];
+    static P16Data_t got[512];
+    HostP16Open(&Dev, &Lut, HostP16BoardPins);
+    HostCheck(Dev.RdMode == MODE_BYTES, "board map: mode %u", Dev.RdMode);
+    uint32_t seed = 0xB0A4D;
+    for(uint32_t n = 0; n < 512; n++){
+        feed[n] = (uint16_t) HostRand(&seed);
+    }
+    HostGpioSync();
+    HostBus.Feed = feed;
+    HostBus.FeedNum = 512;
+    P16ComReadArray(&Dev, got, 512);
+    HostCheck(memcmp(got, feed, sizeof(got)) == 0, "board map: words read wrong");
+}
+
+int main(void){
+    HostQuiet = 1;
+    TestShape("runs", MapRuns, P16COM_RD_RUNS);
+    TestShape("bytes", MapBytes, MODE_BYTES);
+    TestShape("spread", MapSpread, P16COM_RD_LOOP);
+    TestBoard();
+    Bench("runs", MapRuns, P16COM_RD_RUNS);
+#if (P16COM_RD_GATHER_TABLE_EN == 1)
+    Bench("table", MapBytes, P16COM_RD_LUT);
+#endif
+    Bench("loop", MapSpread, P16COM_RD_LOOP);
+    return HostTestEnd("TestP16ComGather");
+}
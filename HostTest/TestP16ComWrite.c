@@ -0,0 +1,178 @@
+/**
+ * @file TestP16ComWrite.c
+ * @brief Host test of the P16Com write paths on the GPIO register model
+ * @details Words written with the compact LUT (every data pin below GPIO32) and the wide one
+ *          must reach the data pins at each WR rising edge, RS must follow the command list,
+ *          and a bank-0 output driven by someone else in the middle of a burst must keep its
+ *          level. Register stores per word and host time per word are printed; the compact
+ *          path is held to three stores per new word and two (the WR strobe) per repeated one.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <string.h>
+
+#include "HostP16.h"
+
+#define WORDS           4096
+
+/// @brief A map with the high byte above GPIO32: the wide LUT
+static const Pin_t WidePins[16] = { 18, 12, 17, 11, 16, 10, 15, 9, 33, 34, 35, 36, 37, 38, 39, 40 };
+
+static P16Lut_t Lut;
+static P16Dev_t Dev;
+static P16Data_t Data[WORDS];
+static uint32_t Cap[WORDS + 64];
+
+/// @brief Random words with runs, as in a frame
+static void Fill(uint32_t Seed){
+    for(uint32_t n = 0; n < WORDS; ){
+        P16Data_t w = (P16Data_t) HostRand(&Seed);
+        uint32_t run = 1 + ((HostRand(&Seed) % 4 == 0) ? HostRand(&Seed) % 16 : 0);
+        for(uint32_t k = 0; (k < run) && (n < WORDS); k++){
+            Data[n++] = w;
+        }
+    }
+}
+
+static void Capture(void){
+    HostGpioSync();
+    HostBus.Cap = Cap;
+    HostBus.CapMax = sizeof(Cap) / sizeof(Cap[0]);
+    HostBus.CapNum = 0;
+    HostBus.Accesses = 0;
+}
+
+/// @brief Words latched since Capture() against `Exp`
+static void Expect(const char * What, const P16Data_t * Exp, uint32_t Num, uint32_t Rs){
+    HostGpioSync();
+    HostCheck(HostBus.CapNum == Num, "%s: %u words latched, %u written", What, HostBus.CapNum, Num);
+    uint32_t bad = 0;
+    for(uint32_t n = 0; (n < Num) && (n < HostBus.CapNum); n++){
+        uint32_t exp = Exp[n] | (Rs ? HOST_BUS_RS : 0);
+        if((Cap[n] != exp) && (bad++ < 3)){
+            HostCheck(0, "%s: word %u latched 0x%05X, expected 0x%05X", What, n, Cap[n], exp);
+        }
+    }
+    HostCheck(bad == 0, "%s: %u words wrong", What, bad);
+}
+
+/// @brief Single, burst and repeat writes on one pin map
+static void TestPaths(const char * Name, const Pin_t * Pins, uint32_t Mode){
+    HostP16Open(&Dev, &Lut, Pins);
+    HostCheck(Dev.LutMode == Mode, "%s: LUT mode %u", Name, Dev.LutMode);
+    Fill(0x1234 + Mode);
+    /// Data words go out with RS high
+    P16SetHighRegSelPin(&Dev);
+
+    Capture();
+    for(uint32_t n = 0; n < 64; n++){
+        P16ComWrite(&Dev, Data[n]);
+    }
+    Expect(Name, Data, 64, 1);
+
+    Capture();
+    P16ComWriteArray(&Dev, Data, WORDS);
+    uint32_t stores = HostBus.Accesses;
+    Expect(Name, Data, WORDS, 1);
+
+    uint32_t changes = 1;
+    for(uint32_t n = 1; n < WORDS; n++){
+        changes += (Data[n] != Data[n - 1]);
+    }
+
+    static P16Data_t same[300];
+    for(uint32_t n = 0; n < 300; n++){
+        same[n] = 0xA5C3;
+    }
+    Capture();
+    P16ComWriteRepeat(&Dev, 0xA5C3, 300);
+    Expect(Name, same, 300, 1);
+
+    /// A solid fill through the burst path: the data lines are driven once
+    Capture();
+    P16ComWriteArray(&Dev, same, 300);
+    uint32_t fill = HostBus.Accesses;
+    Expect(Name, same, 300, 1);
+
+    /// Host time is only a relative figure: every store is a call into the model
+    uint64_t t0 = HostNowNs();
+    for(uint32_t r = 0; r < 100; r++){
+        P16ComWriteArray(&Dev, Data, WORDS);
+    }
+    double ns = (double) (HostNowNs() - t0) / (100.0 * WORDS);
+    printf("  %-8s %.2f register stores per word (%u changes in %u words), %.2f per word of a fill, %.1f ns per word on the host\n",
+           Name, (double) stores / WORDS, changes, WORDS, (double) fill / 300, ns);
+    if(Mode == P16COM_LUT_COMPACT){
+        /// New word: clear (low data lines, WR), set (high data lines), set (WR);
+        /// repeated word: clear (WR), set (WR)
+        HostCheck(stores == 3 * changes + 2 * (WORDS - changes), "%s: %u stores for %u words, %u changes",
+                  Name, stores, WORDS, changes);
+        HostCheck(fill == 3 + 2 * 299, "%s: %u stores for a 300-word fill", Name, fill);
+    }
+}
+
+/// @brief OnWrite hook: an ISR toggling the backlight (GPIO 1) between two WR edges
+static uint32_t Toggles;
+static void ToggleOther(uint32_t Word){
+    (void) Word;
+    if(HostRand(&Toggles) & 1){
+        HostGpioRegs.out ^= Mask32(1);
+    }
+}
+
+/// @brief Pins outside the bus keep whatever another task drove them to during a burst
+static void TestForeignPin(void){
+    HostP16Open(&Dev, &Lut, HostP16BoardPins);
+    Fill(0x77);
+    Toggles = 0x9E37;
+    HostBus.OnWrite = ToggleOther;
+    P16ComWriteArray(&Dev, Data, WORDS);
+    HostGpioSync();
+    HostBus.OnWrite = NULL;
+    /// Replay the hook's coin flips
+    uint32_t seed = 0x9E37, level = 0;
+    for(uint32_t n = 0; n < WORDS; n++){
+        level ^= HostRand(&seed) & 1;
+    }
+    HostCheck(((HostGpioRegs.out >> 1) & 1) == level, "GPIO 1 reverted by the burst");
+    HostCheck((HostGpioRegs.out & Mask32(HOST_P16_CS)) != 0, "CS moved by the burst");
+}
+
+/// @brief Command list: RS low for commands, high for args, CS high across a delay
+static void TestCmdList(void){
+    static const uint8_t List[] = {
+        0x36, 1, 0x48,
+        0x2A, 4 | P16COM_CL_PARAMS,
+        0x11, 0 | P16COM_CL_DELAY, 120,
+        0x2C, 2, 0xBE, 0xEF,
+        P16COM_CL_END
+    };
+    static const P16Data_t Params[] = { 0x0000, 0x00EF, 0x1234, 0xFFFF };
+    static const uint32_t Exp[] = {
+        0x36, 0x48 | HOST_BUS_RS,
+        0x2A, 0x0000 | HOST_BUS_RS, 0x00EF | HOST_BUS_RS, 0x1234 | HOST_BUS_RS, 0xFFFF | HOST_BUS_RS,
+        0x11,
+        0x2C, 0xBE | HOST_BUS_RS, 0xEF | HOST_BUS_RS,
+    };
+    for(uint32_t m = 0; m < 2; m++){
+        HostP16Open(&Dev, &Lut, (m == 0) ? HostP16BoardPins : WidePins);
+        Capture();
+        int64_t t0 = HostTimeUs;
+        HostCheck(P16ComRunCmdList(&Dev, List, Params, 1) == STAT_OKE, "list refused");
+        HostGpioSync();
+        HostCheck(HostBus.CapNum == sizeof(Exp) / sizeof(Exp[0]), "map %u: %u words latched", m, HostBus.CapNum);
+        for(uint32_t n = 0; n < sizeof(Exp) / sizeof(Exp[0]); n++){
+            HostCheck(Cap[n] == Exp[n], "map %u, word %u: 0x%05X, expected 0x%05X", m, n, Cap[n], Exp[n]);
+        }
+        HostCheck(HostTimeUs - t0 >= 120000, "map %u: slept %lld us", m, (long long) (HostTimeUs - t0));
+        HostCheck((HostGpioRegs.out & Mask32(HOST_P16_CS)) != 0, "map %u: CS left low", m);
+    }
+}
+
+int main(void){
+    TestPaths("compact", HostP16BoardPins, P16COM_LUT_COMPACT);
+    TestPaths("wide", WidePins, P16COM_LUT_WIDE);
+    TestForeignPin();
+    TestCmdList();
+    return HostTestEnd("TestP16ComWrite");
+}
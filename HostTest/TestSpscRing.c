@@ -0,0 +1,187 @@
+/**
+ * @file TestSpscRing.c
+ * @brief Host test of SpscRing / SpscPool under two threads, and of the ARLink event link
+ * @details A producer thread takes pool blocks, fills them with a pattern derived from the
+ *          message number and pushes them through a small ring; the consumer thread pops them,
+ *          checks the sequence numbers are consecutive and the payload intact, and puts the
+ *          blocks back. Both sides spin when full / empty, so the indexes wrap the ring and the
+ *          free list millions of times. Throughput is printed. ARLink is then fed decoder
+ *          events until its pool runs dry and must hand them over in order, counting the rest.
+ * @author Nguyen Thanh Phu
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include "HostTest.h"
+#include "SpscRing.h"
+#include "ARLink.h"
+
+#define SLOTS           8
+#define BLOCKS          6
+#define BLOCK_BYTES     64
+#define MESSAGES        4000000
+
+static SpscRing_t Ring;
+static SpscPool_t Pool;
+static SpscBlock_t RingSlots[SLOTS];
+static SpscBlock_t FreeSlots[SLOTS];
+static uint32_t Mem[BLOCKS * BLOCK_BYTES / 4];
+
+/// @brief Consumer findings, read by main after the join
+static uint32_t BadSeq, BadData, BadPut, Received;
+
+/// @brief Word `i` of message `n`
+static inline uint32_t Pattern(uint32_t n, uint32_t i){
+    return (n * 2654435761U) ^ (i * 40503U);
+}
+
+static void * Producer(void * pv){
+    (void) pv;
+    for(uint32_t n = 0; n < MESSAGES; n++){
+        uint32_t * blk;
+        while((blk = (uint32_t *) SpscPoolGet(&Pool)) == NULL){
+            sched_yield();
+        }
+        /// Length varies with the message so Len is checked too
+        uint32_t words = 1 + n % (BLOCK_BYTES / 4);
+        for(uint32_t i = 0; i < words; i++){
+            blk[i] = Pattern(n, i);
+        }
+        while(SpscRingPush(&Ring, blk, words * 4, (uint16_t) n, (uint16_t) (n >> 16)) != STAT_OKE){
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void * Consumer(void * pv){
+    (void) pv;
+    SpscBlock_t b;
+    for(uint32_t n = 0; n < MESSAGES; n++){
+        while(SpscRingPop(&Ring, &b) != STAT_OKE){
+            sched_yield();
+        }
+        const uint32_t * blk = (const uint32_t *) b.Data;
+        uint32_t words = 1 + n % (BLOCK_BYTES / 4);
+        BadSeq += (b.Seq != n) || (b.Tag != (uint16_t) n) || (b.Arg != (uint16_t) (n >> 16)) || (b.Len != words * 4);
+        for(uint32_t i = 0; i < words; i++){
+            BadData += (blk[i] != Pattern(n, i));
+        }
+        BadPut += (SpscPoolPut(&Pool, b.Data) != STAT_OKE);
+        Received++;
+    }
+    return NULL;
+}
+
+/// @brief Two threads through an 8-slot ring and a 6-block pool
+static void TestStress(void){
+    HostCheck(SpscRingInit(&Ring, RingSlots, SLOTS) == STAT_OKE, "ring init");
+    HostCheck(SpscPoolInit(&Pool, Mem, BLOCK_BYTES, BLOCKS, FreeSlots, SLOTS) == STAT_OKE, "pool init");
+
+    pthread_t prod, cons;
+    uint64_t t0 = HostNowNs();
+    pthread_create(&cons, NULL, Consumer, NULL);
+    pthread_create(&prod, NULL, Producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    uint64_t t1 = HostNowNs();
+
+    printf("  %u messages through %u slots: %.1f ns per message, %u pushes refused\n",
+           MESSAGES, SLOTS, (double) (t1 - t0) / MESSAGES, Ring.Refused);
+    HostCheck(Received == MESSAGES, "%u messages received", Received);
+    HostCheck(BadSeq == 0, "%u descriptors out of sequence", BadSeq);
+    HostCheck(BadData == 0, "%u payload words corrupted", BadData);
+    HostCheck(BadPut == 0, "%u blocks refused by the pool", BadPut);
+    HostCheck(SpscRingCount(&Ring) == 0, "ring not empty at the end");
+    HostCheck(SpscPoolAvail(&Pool) == BLOCKS, "%u of %u blocks back in the pool", SpscPoolAvail(&Pool), BLOCKS);
+}
+
+/// @brief Argument checks and the single-thread edges
+static void TestEdges(void){
+    static SpscBlock_t slots[4];
+    SpscRing_t ring;
+    SpscBlock_t b;
+    HostCheck(SpscRingInit(&ring, slots, 3) != STAT_OKE, "3 slots accepted");
+    HostCheck(SpscRingInit(&ring, slots, 4) == STAT_OKE, "4 slots refused");
+    HostCheck(SpscRingPop(&ring, &b) == STAT_ERR_UNDERFLOW, "pop from an empty ring");
+    for(uint32_t i = 0; i < 4; i++){
+        HostCheck(SpscRingPush(&ring, NULL, i, 0, 0) == STAT_OKE, "push %u", i);
+    }
+    HostCheck(SpscRingPush(&ring, NULL, 9, 0, 0) == STAT_ERR_OVERFLOW, "push into a full ring");
+    HostCheck(ring.Refused == 1, "refused %u", ring.Refused);
+    HostCheck((SpscRingPop(&ring, &b) == STAT_OKE) && (b.Len == 0) && (b.Seq == 0), "oldest first");
+
+    HostCheck(SpscPoolInit(&Pool, Mem, BLOCK_BYTES, BLOCKS, FreeSlots, SLOTS) == STAT_OKE, "pool init");
+    HostCheck(SpscPoolInit(&Pool, Mem, BLOCK_BYTES, SLOTS + 1, FreeSlots, SLOTS) != STAT_OKE, "more blocks than slots");
+    HostCheck(SpscPoolInit(&Pool, Mem, BLOCK_BYTES + 2, BLOCKS, FreeSlots, SLOTS) != STAT_OKE, "unaligned block size");
+    SpscPoolInit(&Pool, Mem, BLOCK_BYTES, BLOCKS, FreeSlots, SLOTS);
+    uint8_t * blk = (uint8_t *) SpscPoolGet(&Pool);
+    uint32_t other;
+    HostCheck(SpscPoolPut(&Pool, &other) == STAT_ERR_INVALID_ARG, "foreign pointer accepted");
+    HostCheck(SpscPoolPut(&Pool, blk + 4) == STAT_ERR_INVALID_ARG, "pointer inside a block accepted");
+    HostCheck(SpscPoolPut(&Pool, (uint8_t *) Mem + BLOCKS * BLOCK_BYTES) == STAT_ERR_INVALID_ARG, "pointer past the pool accepted");
+    HostCheck(SpscPoolPut(&Pool, NULL) == STAT_ERR_INVALID_ARG, "NULL accepted");
+    HostCheck(SpscPoolPut(&Pool, blk) == STAT_OKE, "own block refused");
+    HostCheck(SpscPoolAvail(&Pool) == BLOCKS, "%u blocks free", SpscPoolAvail(&Pool));
+}
+
+/// @brief Decoder events through the reader -> drawing task link
+static void TestLink(void){
+    static ARLink_t link;
+    HostCheck(ARLinkInit(&link) == STAT_OKE, "link init");
+    const uint32_t perSpi = AR_LINK_BLOCK_BYTES / sizeof(ARSpiEvent_t);
+    const uint32_t perI2c = AR_LINK_BLOCK_BYTES / sizeof(ARI2cEvent_t);
+
+    /// Two and a half blocks of SPI words, then I2C bytes: the kind change starts a block
+    uint32_t spiNum = 2 * perSpi + perSpi / 2, i2cNum = 3;
+    for(uint32_t n = 0; n < spiNum; n++){
+        ARSpiEvent_t ev = { .Kind = AR_SPI_EV_WORD, .Bits = 8, .Mosi = n, .Miso = ~n, .Sample = n };
+        ARLinkOnSpi(&link, &ev);
+    }
+    for(uint32_t n = 0; n < i2cNum; n++){
+        ARI2cEvent_t ev = { .Kind = AR_I2C_EV_DATA, .Value = n, .Ack = 1, .Sample = n };
+        ARLinkOnI2c(&link, &ev);
+    }
+    ARLinkFlush(&link);
+    HostCheck(link.Sent == spiNum + i2cNum, "%u events sent", link.Sent);
+
+    SpscBlock_t b;
+    uint32_t spi = 0, i2c = 0, blocks = 0;
+    while(ARLinkPop(&link, &b) == STAT_OKE){
+        if(b.Tag == AR_LINK_SPI){
+            const ARSpiEvent_t * ev = (const ARSpiEvent_t *) b.Data;
+            for(uint32_t k = 0; k < b.Len / sizeof(ARSpiEvent_t); k++, spi++){
+                HostCheck((ev[k].Mosi == spi) && (ev[k].Miso == ~spi), "SPI event %u: %u", spi, ev[k].Mosi);
+            }
+        } else {
+            HostCheck((b.Tag == AR_LINK_I2C) && (spi == spiNum), "block %u: tag %u after %u SPI events", blocks, b.Tag, spi);
+            const ARI2cEvent_t * ev = (const ARI2cEvent_t *) b.Data;
+            for(uint32_t k = 0; k < b.Len / sizeof(ARI2cEvent_t); k++, i2c++){
+                HostCheck(ev[k].Value == i2c, "I2C event %u: %u", i2c, ev[k].Value);
+            }
+        }
+        HostCheck(ARLinkRelease(&link, b.Data) == STAT_OKE, "block %u refused", blocks);
+        blocks++;
+    }
+    HostCheck((spi == spiNum) && (i2c == i2cNum) && (blocks == 4), "%u SPI, %u I2C events in %u blocks", spi, i2c, blocks);
+
+    /// Nobody reading: the pool runs dry, later events are counted, the reader never blocks
+    uint32_t fed = AR_LINK_BLOCKS * perI2c + 100;
+    for(uint32_t n = 0; n < fed; n++){
+        ARI2cEvent_t ev = { .Kind = AR_I2C_EV_DATA, .Value = n };
+        ARLinkOnI2c(&link, &ev);
+    }
+    ARLinkFlush(&link);
+    HostCheck(link.Dropped == 100, "%u events dropped, expected 100", link.Dropped);
+    HostCheck(SpscRingCount(&link.Ring) == AR_LINK_BLOCKS, "%u blocks waiting", SpscRingCount(&link.Ring));
+    HostCheck(ARLinkPop(&link, &b) == STAT_OKE && ((const ARI2cEvent_t *) b.Data)[0].Value == 0, "oldest block first");
+}
+
+int main(void){
+    TestEdges();
+    TestStress();
+    TestLink();
+    return HostTestEnd("TestSpscRing");
+}
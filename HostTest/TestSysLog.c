@@ -0,0 +1,144 @@
+/**
+ * @file TestSysLog.c
+ * @brief Host test of the compile-time log levels and the rate-limited / sampled log calls
+ * @details P16Com is built at SYS_LOG_LEVEL_ERR here: its calls above that level must not
+ *          evaluate their arguments nor queue a record, its error calls must. SysRateMs must
+ *          print once per interval of the test clock with the count of calls skipped, and
+ *          SysEvery one call in n from the first. The cost of a stripped call, of a skipped
+ *          rate-limited call and of a deferred record is printed.
+ * @author Nguyen Thanh Phu
+ */
+
+/// This file only: P16Com logs errors and nothing else
+#define P16COM_LOG_LEVEL    SYS_LOG_LEVEL_ERR
+
+#include <string.h>
+
+#include "HostTest.h"
+#include "rom/ets_sys.h"
+#include "P16Com.h"
+
+/// @brief Argument calls evaluated
+static uint32_t Evaluated;
+
+static uint32_t Bump(void){
+    return ++Evaluated;
+}
+
+/// @brief Lines printed by the deferred log so far, the last one in HostLine
+static uint32_t Drain(void){
+    return CoreLogDrain();
+}
+
+static DefaultRet_t Returns(void){
+    P16ReturnWithLog(STAT_ERR_BUSY, "Returns(%u) : STAT_ERR_BUSY", Bump());
+}
+
+static void Hot(uint32_t N){
+    P16ErrHot("hot %u", N);
+}
+
+/// @brief Calls above the module level vanish with their arguments
+static void TestLevels(void){
+    Evaluated = 0;
+    P16Log("log %u", Bump());
+    P16LogHot("log %u", Bump());
+    P16Log1("verb %u", Bump());
+    P16Entry("entry %u", Bump());
+    P16EntryHot("entry %u", Bump());
+    P16Exit("exit %u", Bump());
+    P16ExitHot("exit %u", Bump());
+    HostCheck(Returns() == STAT_ERR_BUSY, "return value lost with the log");
+    HostCheck(Evaluated == 0, "%u stripped calls evaluated their arguments", Evaluated);
+    HostCheck(Drain() == 0, "stripped calls queued records: %s", HostLine);
+
+    P16Err("err %u", Bump());
+    HostCheck(Evaluated == 1, "error call evaluated %u arguments", Evaluated);
+    HostCheck((Drain() == 1) && (strstr(HostLine, "[err] err 1") != NULL), "error line: %s", HostLine);
+
+    /// Outside the modules the global level applies (TRACE)
+    SysEntry("entry %u", Bump());
+    HostCheck((Evaluated == 2) && (Drain() == 1) && (strstr(HostLine, "[>>>] entry 2") != NULL), "system entry line: %s", HostLine);
+}
+
+/// @brief One line per interval, carrying the calls skipped since the last one
+static void TestRate(void){
+    uint32_t lines = 0, bad = 0;
+    HostTimeUs = 0;
+    for(uint32_t n = 0; n < 35000; n++, HostTimeUs += 100){
+        SysRateMs(1000, SysInfo, "tick %u", n);
+        if(Drain() == 1){
+            char exp[64];
+            /// 10000 calls per second: the first line skips none
+            snprintf(exp, sizeof(exp), "[Info] tick %u (+%u)", n, (lines == 0) ? 0 : 9999);
+            bad += (n != lines * 10000) || (strstr(HostLine, exp) == NULL);
+            lines++;
+        }
+    }
+    HostCheck(lines == 4, "%u rate-limited lines in 3.5 s", lines);
+    HostCheck(bad == 0, "%u rate-limited lines wrong, last: %s", bad, HostLine);
+
+    /// Module Hot calls use SYSTEM_LOG_HOT_MS, per call site
+    lines = 0;
+    for(uint32_t n = 0; n < 1000; n++, HostTimeUs += SYSTEM_LOG_HOT_MS * 10){
+        Hot(n);
+        lines += Drain();
+    }
+    HostCheck(lines == 10, "%u hot lines for 10 intervals", lines);
+}
+
+/// @brief The first call and then one in n
+static void TestEvery(void){
+    uint32_t lines = 0, bad = 0;
+    for(uint32_t n = 0; n < 100; n++){
+        SysEvery(10, SysInfo, "every %u", n);
+        if(Drain() == 1){
+            char exp[32];
+            snprintf(exp, sizeof(exp), "[Info] every %u\n", lines * 10);
+            bad += (strstr(HostLine, exp) == NULL);
+            lines++;
+        }
+    }
+    HostCheck((lines == 10) && (bad == 0), "%u sampled lines, %u wrong", lines, bad);
+}
+
+/// @brief Host cost of each kind of call (the drain, done by CoreLogTask on the chip, excluded)
+static void Bench(void){
+    enum { CALLS = 1000000, BATCH = 32 };
+    uint64_t t0 = HostNowNs();
+    for(uint32_t n = 0; n < CALLS; n++){
+        P16Log("stripped %u %u", n, Bump());
+    }
+    double stripped = (double) (HostNowNs() - t0) / CALLS;
+
+    HostTimeUs = 0;
+    SysRateMs(1000, SysInfo, "skipped %u", 0U);
+    Drain();
+    t0 = HostNowNs();
+    for(uint32_t n = 0; n < CALLS; n++){
+        SysRateMs(1000, SysInfo, "skipped %u", n);
+    }
+    double skipped = (double) (HostNowNs() - t0) / CALLS;
+
+    uint64_t spent = 0;
+    for(uint32_t r = 0; r < CALLS / BATCH / 10; r++){
+        t0 = HostNowNs();
+        for(uint32_t n = 0; n < BATCH; n++){
+            SysInfo("record %u %d %s", n, -1, "flash");
+        }
+        spent += HostNowNs() - t0;
+        Drain();
+    }
+    double record = (double) spent / (CALLS / 10);
+    printf("  stripped call %.2f ns, skipped rate-limited call %.2f ns, deferred record %.1f ns on the host\n",
+           stripped, skipped, record);
+}
+
+int main(void){
+    HostQuiet = 1;
+    TestLevels();
+    TestRate();
+    TestEvery();
+    Bench();
+    return HostTestEnd("TestSysLog");
+}
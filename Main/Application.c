@@ -4,6 +4,7 @@
 
 void AppInitialize(){
     SysEntry("AppInitialize()");
+#if (FIRMWARE_TYPE == TYPE_ANALYZER_MASTER)
     /// TaskSystemMonitor
 
     SysLog("[AppInitialize] [+Task] TaskSystemMonitor");
@@ -14,6 +15,16 @@ void AppInitialize(){
 
     SysLog("[AppInitialize] [+Task] TaskScreen");
     CreateTaskCPU0(TaskScreen, "TaskScreen", 4096, NULL, 2, NULL);
+#elif (FIRMWARE_TYPE == TYPE_ANALYZER_READER)
+    /// Capture runs on CPU1, away from the WiFi/system tasks on CPU0
+    #if (AR_SCOPE_EN == 1)
+        SysLog("[AppInitialize] [+Task] TaskScope");
+        CreateTaskCPU1(TaskScope, "TaskScope", AR_TASK_STACK, NULL, AR_TASK_PRIO, NULL);
+    #else
+        SysLog("[AppInitialize] [+Task] TaskReader");
+        CreateTaskCPU1(TaskReader, "TaskReader", AR_TASK_STACK, NULL, AR_TASK_PRIO, NULL);
+    #endif
+#endif
 
     SysExit("AppInitialize()");
 }
@@ -22,6 +33,8 @@ void AppInitialize(){
 /// @details This function is called by the ESP-IDF startup code. Its primary role is to
 ///          initialize the application by creating tasks and then delete itself to free up memory.
 void app_main(void){
+    // Start draining the deferred log first; records taken before it runs are kept.
+    CoreLogInit();
     SysEntry("app_main() : User SW entry point! ");
     // Call the main initialization routine which sets up all application tasks.
     AppInitialize();
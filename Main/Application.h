@@ -17,6 +17,8 @@
 /// @brief Application's firmware
 #if (FIRMWARE_TYPE == TYPE_ANALYZER_MASTER)
     #include "../AppCore/AnalyzerMaster/All.h"
+#elif (FIRMWARE_TYPE == TYPE_ANALYZER_READER)
+    #include "../AppCore/AnalyzerReader/All.h"
 #endif
 
 